@@ -0,0 +1,127 @@
+#include "broydencostfunction.h"
+
+using namespace Backend::Core;
+using namespace Eigen;
+
+BroydenCostFunction::BroydenCostFunction(ResidualFun residualFun, int numParameters, int numResiduals, double diffStepSize,
+                                         int maxNumUpdates, double minRatio)
+    : mResidualFun(residualFun)
+    , mkDiffStepSize(diffStepSize)
+    , mkMaxNumUpdates(maxNumUpdates)
+    , mkMinRatio(minRatio)
+    , mIsRefreshRequested(true)
+    , mNumSequentialUpdates(0)
+    , mNumRefreshes(0)
+    , mNumUpdates(0)
+{
+    mutable_parameter_block_sizes()->push_back(numParameters);
+    set_num_residuals(numResiduals);
+}
+
+//! Compute the residuals and, if requested, the Jacobian at the point
+bool BroydenCostFunction::Evaluate(double const* const* parameters, double* residuals, double** jacobians) const
+{
+    int numParameters = parameter_block_sizes()[0];
+    int numResiduals = num_residuals();
+
+    // Evaluate the residuals
+    if (!mResidualFun(parameters, residuals))
+        return false;
+    VectorXd const point = Map<VectorXd const>(parameters[0], numParameters);
+    VectorXd const values = Map<VectorXd const>(residuals, numResiduals);
+
+    // Check the quality of the linear model at the trial point
+    QMutexLocker locker(&mMutex);
+    if (!jacobians || !jacobians[0])
+    {
+        if (!mIsRefreshRequested && reductionRatio(point, values) < mkMinRatio)
+            mIsRefreshRequested = true;
+        return true;
+    }
+
+    // Refresh or update the Jacobian at the accepted point
+    bool isRefresh = mIsRefreshRequested || mNumSequentialUpdates >= mkMaxNumUpdates || reductionRatio(point, values) < mkMinRatio;
+    if (isRefresh)
+    {
+        if (!differentiate(point, values))
+            return false;
+    }
+    else if (point != mPoint)
+    {
+        update(point, values);
+    }
+    mPoint = point;
+    mResiduals = values;
+
+    // Copy the Jacobian in the row-major order
+    Map<Matrix<double, Dynamic, Dynamic, RowMajor>>(jacobians[0], numResiduals, numParameters) = mJacobian;
+    return true;
+}
+
+//! Get the number of Jacobians computed by finite differences
+int BroydenCostFunction::numRefreshes() const
+{
+    QMutexLocker locker(&mMutex);
+    return mNumRefreshes;
+}
+
+//! Get the number of rank-one updates of the Jacobian
+int BroydenCostFunction::numUpdates() const
+{
+    QMutexLocker locker(&mMutex);
+    return mNumUpdates;
+}
+
+//! Compute the Jacobian by forward finite differences using the relative step as Ceres does
+bool BroydenCostFunction::differentiate(VectorXd const& point, VectorXd const& residuals) const
+{
+    int numParameters = point.size();
+    int numResiduals = residuals.size();
+    MatrixXd jacobian(numResiduals, numParameters);
+    VectorXd perturbedPoint = point;
+    VectorXd perturbedResiduals(numResiduals);
+    double const* perturbedParameters = perturbedPoint.data();
+    for (int i = 0; i != numParameters; ++i)
+    {
+        double step = std::abs(point[i]) * mkDiffStepSize;
+        if (step == 0.0)
+            step = mkDiffStepSize;
+        perturbedPoint[i] = point[i] + step;
+        if (!mResidualFun(&perturbedParameters, perturbedResiduals.data()))
+            return false;
+        jacobian.col(i) = (perturbedResiduals - residuals) / step;
+        perturbedPoint[i] = point[i];
+    }
+    mJacobian = std::move(jacobian);
+    mIsRefreshRequested = false;
+    mNumSequentialUpdates = 0;
+    ++mNumRefreshes;
+    return true;
+}
+
+//! Correct the Jacobian, so that it reproduces the change of the residuals along the step
+void BroydenCostFunction::update(VectorXd const& point, VectorXd const& residuals) const
+{
+    VectorXd const step = point - mPoint;
+    double squaredNorm = step.squaredNorm();
+    if (squaredNorm == 0.0)
+        return;
+    VectorXd const defect = residuals - mResiduals - mJacobian * step;
+    mJacobian += defect * step.transpose() / squaredNorm;
+    ++mNumSequentialUpdates;
+    ++mNumUpdates;
+}
+
+//! Evaluate the ratio of the actual cost reduction to the one predicted by the linear model
+double BroydenCostFunction::reductionRatio(VectorXd const& point, VectorXd const& residuals) const
+{
+    if (mJacobian.size() == 0)
+        return 0.0;
+    double cost = mResiduals.squaredNorm();
+    double predictedCost = (mResiduals + mJacobian * (point - mPoint)).squaredNorm();
+    double predictedReduction = cost - predictedCost;
+    double actualReduction = cost - residuals.squaredNorm();
+    if (predictedReduction <= 0.0)
+        return actualReduction >= 0.0 ? 1.0 : 0.0;
+    return actualReduction / predictedReduction;
+}
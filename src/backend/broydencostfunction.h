@@ -0,0 +1,76 @@
+#ifndef BROYDENCOSTFUNCTION_H
+#define BROYDENCOSTFUNCTION_H
+
+#include <Eigen/Core>
+#include <ceres/ceres.h>
+#include <QMutex>
+
+#include <functional>
+
+namespace Backend::Core
+{
+
+using ResidualFun = std::function<bool(double const* const*, double*)>;
+
+/*!
+ * Cost function which approximates the Jacobian by forward finite differences and then corrects it by rank-one Broyden updates
+ * along the accepted steps. The finite differences are recomputed once the ratio of the actual and predicted cost reductions degrades
+ * or the maximum number of consecutive updates is reached
+ */
+class BroydenCostFunction : public ceres::CostFunction
+{
+public:
+    BroydenCostFunction(ResidualFun residualFun, int numParameters, int numResiduals, double diffStepSize, int maxNumUpdates,
+                        double minRatio);
+    ~BroydenCostFunction() = default;
+
+    bool Evaluate(double const* const* parameters, double* residuals, double** jacobians) const override;
+
+    int numRefreshes() const;
+    int numUpdates() const;
+
+private:
+    bool differentiate(Eigen::VectorXd const& point, Eigen::VectorXd const& residuals) const;
+    void update(Eigen::VectorXd const& point, Eigen::VectorXd const& residuals) const;
+    double reductionRatio(Eigen::VectorXd const& point, Eigen::VectorXd const& residuals) const;
+
+private:
+    ResidualFun mResidualFun;
+    double const mkDiffStepSize;
+    int const mkMaxNumUpdates;
+    double const mkMinRatio;
+
+    // Linear model
+    mutable QMutex mMutex;
+    mutable Eigen::VectorXd mPoint;
+    mutable Eigen::VectorXd mResiduals;
+    mutable Eigen::MatrixXd mJacobian;
+    mutable bool mIsRefreshRequested;
+    mutable int mNumSequentialUpdates;
+
+    // Statistics
+    mutable int mNumRefreshes;
+    mutable int mNumUpdates;
+};
+
+//! Create the cost function which differentiates the functor numerically, updating the Jacobian by Broyden's method if requested
+template<typename Functor>
+ceres::CostFunction* createCostFunction(Functor& functor, int numParameters, int numResiduals, double diffStepSize, int maxNumBroydenUpdates,
+                                        double minBroydenRatio)
+{
+    if (maxNumBroydenUpdates > 0)
+    {
+        ResidualFun residualFun = [&functor](double const* const* parameters, double* residuals) { return functor(parameters, residuals); };
+        return new BroydenCostFunction(residualFun, numParameters, numResiduals, diffStepSize, maxNumBroydenUpdates, minBroydenRatio);
+    }
+    ceres::NumericDiffOptions diffOptions;
+    diffOptions.relative_step_size = diffStepSize;
+    auto* pCostFunction = new ceres::DynamicNumericDiffCostFunction<Functor, ceres::FORWARD>(&functor, ceres::DO_NOT_TAKE_OWNERSHIP,
+                                                                                          diffOptions);
+    pCostFunction->AddParameterBlock(numParameters);
+    pCostFunction->SetNumResiduals(numResiduals);
+    return pCostFunction;
+}
+}
+
+#endif // BROYDENCOSTFUNCTION_H
@@ -0,0 +1,80 @@
+#include "eigendeduplicator.h"
+#include "solvermetrics.h"
+
+using namespace Backend::Core;
+
+EigenDeduplicator::EigenDeduplicator(int numParameters, int capacity)
+    : mkNumParameters(numParameters)
+    , mkCapacity(capacity)
+    , mNumHits(0)
+    , mNumLookups(0)
+{
+}
+
+//! Retrieve the solution obtained at the point, marking it as the most recently used one
+bool EigenDeduplicator::find(double const* parameters, ModalSolution& solution)
+{
+    QByteArray const currentKey = key(parameters);
+    QMutexLocker locker(&mMutex);
+    ++mNumLookups;
+    auto iter = mSolutions.constFind(currentKey);
+    bool isFound = iter != mSolutions.cend();
+    if (isFound)
+    {
+        solution = iter.value();
+        mKeys.removeOne(currentKey);
+        mKeys.push_back(currentKey);
+        ++mNumHits;
+    }
+    SolverMetrics::instance().addEigenDeduplicatorLookup(isFound);
+    return isFound;
+}
+
+//! Store the solution, evicting the least recently used one if the capacity is exceeded
+void EigenDeduplicator::insert(double const* parameters, ModalSolution const& solution)
+{
+    if (mkCapacity <= 0)
+        return;
+    QByteArray const currentKey = key(parameters);
+    QMutexLocker locker(&mMutex);
+    if (mSolutions.contains(currentKey))
+        mKeys.removeOne(currentKey);
+    else if (mKeys.size() == mkCapacity)
+        mSolutions.remove(mKeys.takeFirst());
+    mSolutions[currentKey] = solution;
+    mKeys.push_back(currentKey);
+}
+
+//! Remove all the solutions and statistics
+void EigenDeduplicator::clear()
+{
+    QMutexLocker locker(&mMutex);
+    mSolutions.clear();
+    mKeys.clear();
+    mNumHits = 0;
+    mNumLookups = 0;
+}
+
+int EigenDeduplicator::size() const
+{
+    QMutexLocker locker(&mMutex);
+    return mSolutions.size();
+}
+
+int EigenDeduplicator::numHits() const
+{
+    QMutexLocker locker(&mMutex);
+    return mNumHits;
+}
+
+int EigenDeduplicator::numLookups() const
+{
+    QMutexLocker locker(&mMutex);
+    return mNumLookups;
+}
+
+//! Points are matched bitwise, since the optimizer revisits exactly the same values
+QByteArray EigenDeduplicator::key(double const* parameters) const
+{
+    return QByteArray((char const*) parameters, mkNumParameters * sizeof(double));
+}
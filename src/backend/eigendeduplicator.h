@@ -0,0 +1,47 @@
+#ifndef EIGENDEDUPLICATOR_H
+#define EIGENDEDUPLICATOR_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+
+#include "modalsolver.h"
+
+namespace Backend::Core
+{
+
+/*!
+ * Thread-safe store of the eigen solutions obtained at the most recently evaluated points of the parameter space.
+ * It removes the duplicate solves of the points which the optimizer evaluates again bitwise, e.g. the accepted ones.
+ * The other points are solved from scratch, since the eigen solver is not warm-started by the stored solutions
+ */
+class EigenDeduplicator
+{
+public:
+    EigenDeduplicator(int numParameters, int capacity = 8);
+    ~EigenDeduplicator() = default;
+
+    bool find(double const* parameters, ModalSolution& solution);
+    void insert(double const* parameters, ModalSolution const& solution);
+    void clear();
+
+    int size() const;
+    int numHits() const;
+    int numLookups() const;
+
+private:
+    QByteArray key(double const* parameters) const;
+
+private:
+    int const mkNumParameters;
+    int const mkCapacity;
+    mutable QMutex mMutex;
+    QHash<QByteArray, ModalSolution> mSolutions;
+    QList<QByteArray> mKeys;
+    int mNumHits;
+    int mNumLookups;
+};
+}
+
+#endif // EIGENDEDUPLICATOR_H
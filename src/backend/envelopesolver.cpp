@@ -0,0 +1,496 @@
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QXmlStreamWriter>
+
+#include "constants.h"
+#include "envelopesolver.h"
+#include "fileutility.h"
+#include "parametricstudy.h"
+
+using namespace Backend;
+using namespace Backend::Core;
+using namespace Eigen;
+
+KCL::AbstractElement* findElement(KCL::Model& model, Selection const& selection);
+
+EnvelopeTable::EnvelopeTable()
+    : fields(0, kNumFieldColumns)
+{
+}
+
+bool EnvelopeTable::isEmpty() const
+{
+    return names.isEmpty();
+}
+
+int EnvelopeTable::numCases() const
+{
+    return names.size();
+}
+
+int EnvelopeTable::numFields() const
+{
+    return fields.rows();
+}
+
+//! Append the case which keeps the data of the base model
+int EnvelopeTable::addCase(QString const& name)
+{
+    int iCase = names.size();
+    names.push_back(name);
+    values.conservativeResize(iCase + 1, fields.rows());
+    values.row(iCase).setConstant(std::numeric_limits<double>::quiet_NaN());
+    return iCase;
+}
+
+//! Append the data value of the element to override
+int EnvelopeTable::addField(Selection const& selection, int iData, bool isFactor)
+{
+    int iField = fields.rows();
+    fields.conservativeResize(iField + 1, kNumFieldColumns);
+    fields(iField, kSurface) = selection.iSurface;
+    fields(iField, kType) = (int) selection.type;
+    fields(iField, kElement) = selection.iElement;
+    fields(iField, kData) = iData;
+    fields(iField, kFactor) = isFactor;
+    values.conservativeResize(names.size(), iField + 1);
+    values.col(iField).setConstant(std::numeric_limits<double>::quiet_NaN());
+    return iField;
+}
+
+//! Get the element which the field refers to
+Selection EnvelopeTable::selection(int iField) const
+{
+    return Selection(fields(iField, kSurface), (KCL::ElementType) fields(iField, kType), fields(iField, kElement));
+}
+
+//! Override the data of the model elements by the values of the case
+bool EnvelopeTable::apply(KCL::Model& model, int iCase) const
+{
+    if (iCase < 0 || iCase >= numCases())
+        return false;
+    int numValues = numFields();
+    for (int i = 0; i != numValues; ++i)
+    {
+        // Check if the value is specified
+        double value = values(iCase, i);
+        if (std::isnan(value))
+            continue;
+
+        // Find the element data
+        KCL::AbstractElement* pElement = findElement(model, selection(i));
+        if (!pElement)
+            return false;
+        KCL::VecN data = pElement->get();
+        int iData = fields(i, kData);
+        if (iData < 0 || iData >= (int) data.size())
+            return false;
+
+        // Set the value
+        if (fields(i, kFactor))
+            data[iData] *= value;
+        else
+            data[iData] = value;
+        try
+        {
+            pElement->set(data);
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void EnvelopeTable::clear()
+{
+    names.clear();
+    fields.resize(0, kNumFieldColumns);
+    values.resize(0, 0);
+}
+
+bool EnvelopeTable::operator==(EnvelopeTable const& another) const
+{
+    return Utility::areEqual(*this, another);
+}
+
+bool EnvelopeTable::operator!=(EnvelopeTable const& another) const
+{
+    return !(*this == another);
+}
+
+void EnvelopeTable::serialize(QXmlStreamWriter& stream, QString const& elementName) const
+{
+    stream.writeStartElement(elementName);
+    Utility::serialize(stream, "names", "name", names);
+    Utility::serialize(stream, "fields", fields);
+    Utility::serialize(stream, "values", values);
+    stream.writeEndElement();
+}
+
+void EnvelopeTable::deserialize(QXmlStreamReader& stream)
+{
+    while (stream.readNextStartElement())
+    {
+        if (stream.name() == "names")
+            Utility::deserialize(stream, "name", names);
+        else if (stream.name() == "fields")
+            Utility::deserialize(stream, fields);
+        else if (stream.name() == "values")
+            Utility::deserialize(stream, values);
+        else
+            stream.skipCurrentElement();
+    }
+}
+
+EnvelopeOptions::EnvelopeOptions()
+    : numThreads(1)
+    , isKeepSolutions(false)
+{
+}
+
+bool EnvelopeOptions::operator==(EnvelopeOptions const& another) const
+{
+    return Utility::areEqual(*this, another);
+}
+
+bool EnvelopeOptions::operator!=(EnvelopeOptions const& another) const
+{
+    return !(*this == another);
+}
+
+void EnvelopeOptions::serialize(QXmlStreamWriter& stream, QString const& elementName) const
+{
+    Utility::serializeProperties(stream, elementName, *this);
+}
+
+void EnvelopeOptions::deserialize(QXmlStreamReader& stream)
+{
+    Utility::deserializeProperties(stream, *this);
+}
+
+EnvelopeSolution::EnvelopeSolution()
+{
+}
+
+bool EnvelopeSolution::isEmpty() const
+{
+    return critSpeed.size() == 0;
+}
+
+int EnvelopeSolution::numCases() const
+{
+    return critSpeed.size();
+}
+
+//! Find the case with the lowest critical speed. Returns -1 if none of the cases flutters
+int EnvelopeSolution::findCriticalCase() const
+{
+    int result = -1;
+    int numValues = critSpeed.size();
+    for (int i = 0; i != numValues; ++i)
+    {
+        if (std::isfinite(critSpeed[i]) && (result < 0 || critSpeed[i] < critSpeed[result]))
+            result = i;
+    }
+    return result;
+}
+
+bool EnvelopeSolution::operator==(EnvelopeSolution const& another) const
+{
+    return Utility::areEqual(*this, another);
+}
+
+bool EnvelopeSolution::operator!=(EnvelopeSolution const& another) const
+{
+    return !(*this == another);
+}
+
+void EnvelopeSolution::serialize(QXmlStreamWriter& stream, QString const& elementName) const
+{
+    stream.writeStartElement(elementName);
+    Utility::serialize(stream, "names", "name", names);
+    Utility::serialize(stream, "critFlow", critFlow);
+    Utility::serialize(stream, "critSpeed", critSpeed);
+    Utility::serialize(stream, "critFrequency", critFrequency);
+    Utility::serialize(stream, "solutions", "solution", solutions);
+    stream.writeEndElement();
+}
+
+void EnvelopeSolution::deserialize(QXmlStreamReader& stream)
+{
+    while (stream.readNextStartElement())
+    {
+        if (stream.name() == "names")
+            Utility::deserialize(stream, "name", names);
+        else if (stream.name() == "critFlow")
+            Utility::deserialize(stream, critFlow);
+        else if (stream.name() == "critSpeed")
+            Utility::deserialize(stream, critSpeed);
+        else if (stream.name() == "critFrequency")
+            Utility::deserialize(stream, critFrequency);
+        else if (stream.name() == "solutions")
+            Utility::deserialize(stream, "solution", solutions);
+        else
+            stream.skipCurrentElement();
+    }
+}
+
+EnvelopeSolver::EnvelopeSolver()
+{
+}
+
+EnvelopeSolver::EnvelopeSolver(EnvelopeSolver const& another)
+    : model(another.model)
+    , table(another.table)
+    , flutterOptions(another.flutterOptions)
+    , options(another.options)
+    , solution(another.solution)
+{
+}
+
+EnvelopeSolver::EnvelopeSolver(EnvelopeSolver&& another)
+{
+    mID = std::move(another.mID);
+    model = std::move(another.model);
+    table = std::move(another.table);
+    flutterOptions = std::move(another.flutterOptions);
+    options = std::move(another.options);
+    solution = std::move(another.solution);
+}
+
+EnvelopeSolver& EnvelopeSolver::operator=(EnvelopeSolver const& another)
+{
+    model = another.model;
+    table = another.table;
+    flutterOptions = another.flutterOptions;
+    options = another.options;
+    solution = another.solution;
+    return *this;
+}
+
+ISolver::Type EnvelopeSolver::type() const
+{
+    return ISolver::kEnvelope;
+}
+
+ISolver* EnvelopeSolver::clone() const
+{
+    EnvelopeSolver* pSolver = new EnvelopeSolver;
+    *pSolver = *this;
+    return pSolver;
+}
+
+void EnvelopeSolver::clear()
+{
+    solution = EnvelopeSolution();
+    log.clear();
+}
+
+//! Solve the flutter problems of all the model variants concurrently, so that only the critical values are retained by default
+void EnvelopeSolver::solve()
+{
+    TraceSpan span("solve", "envelope");
+
+    // Clear the previous solution
+    clear();
+    appendLog("Solver started\n");
+    mProfiler.reset();
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
+    // Check the table
+    int numCases = table.numCases();
+    if (numCases == 0 || table.values.rows() != numCases || table.values.cols() != table.numFields())
+    {
+        appendLog("The table of cases is empty or inconsistent\n", QtMsgType::QtCriticalMsg);
+        emit solverFinished();
+        return;
+    }
+    appendLog(QString("Number of cases: %1\n").arg(numCases));
+
+    // Set the analysis parameters once for all the cases
+    KCL::Model baseModel = model;
+    flutterOptions.setAnalysisParameters(baseModel);
+
+    // Allocate the results
+    double const kNaN = std::numeric_limits<double>::quiet_NaN();
+    solution.names = table.names;
+    solution.critFlow.setConstant(numCases, kNaN);
+    solution.critSpeed.setConstant(numCases, kNaN);
+    solution.critFrequency.setConstant(numCases, kNaN);
+    if (options.isKeepSolutions)
+        solution.solutions.resize(numCases);
+    double* pCritFlow = solution.critFlow.data();
+    double* pCritSpeed = solution.critSpeed.data();
+    double* pCritFrequency = solution.critFrequency.data();
+    FlutterSolution* pSolutions = solution.solutions.data();
+
+    // Solve the cases concurrently
+    appendLog(QString("* Evaluating %1 flutter solutions\n").arg(numCases));
+    std::atomic<int> numInvalid = 0;
+    std::atomic<int> numFailed = 0;
+    runConcurrently(numCases, options.numThreads,
+                    [&](int k)
+                    {
+                        // Override the element data
+                        KCL::Model currentModel = baseModel;
+                        {
+                            ProfileTimer timer(mProfiler, "applyCase");
+                            if (!table.apply(currentModel, k))
+                            {
+                                ++numInvalid;
+                                return;
+                            }
+                        }
+
+                        // Solve the flutter problem
+                        FlutterSolution currentSolution = solveFlutter(currentModel, flutterOptions.timeout, mProfiler);
+                        if (currentSolution.isEmpty())
+                        {
+                            ++numFailed;
+                            return;
+                        }
+
+                        // Retain the critical values
+                        setCritData(currentSolution, pCritFlow[k], pCritSpeed[k], pCritFrequency[k]);
+                        if (pSolutions)
+                        {
+                            if (flutterOptions.isTrackRoots)
+                                currentSolution.trackRoots();
+                            pSolutions[k] = std::move(currentSolution);
+                        }
+                    });
+    if (numInvalid > 0)
+        appendLog(QString("Could not apply the table to %1 cases\n").arg(numInvalid.load()), QtMsgType::QtWarningMsg);
+    if (numFailed > 0)
+        appendLog(QString("Could not evaluate %1 flutter solutions\n").arg(numFailed.load()), QtMsgType::QtWarningMsg);
+    if (numInvalid.load() + numFailed.load() == numCases)
+    {
+        solution = EnvelopeSolution();
+        appendLog("None of the cases has been evaluated\n", QtMsgType::QtCriticalMsg);
+        emit solverFinished();
+        return;
+    }
+    appendLog("Solver terminated successfully\n");
+
+    // Log the report
+    QString message;
+    QTextStream stream(&message);
+    stream << tr("Envelope Report") << Qt::endl;
+    stream << tr("-> Cases:        %1").arg(numCases) << Qt::endl;
+    stream << tr("-> Fields:       %1").arg(table.numFields()) << Qt::endl;
+    stream << tr("-> Duration:     %1 s").arg(QString::number(totalTimer.nsecsElapsed() * 1e-9, 'f', 3)) << Qt::endl;
+    int iCritCase = solution.findCriticalCase();
+    if (iCritCase >= 0)
+        stream << tr("-> Critical:     %1").arg(solution.names[iCritCase]) << Qt::endl;
+    stream << Qt::endl;
+    stream << QString("%1 %2 %3 %4").arg(tr("Case"), -24).arg("q", 14).arg("Vtas", 14).arg("f (Hz)", 14) << Qt::endl;
+    for (int i = 0; i != numCases; ++i)
+    {
+        stream << QString("%1 %2 %3 %4")
+                      .arg(solution.names[i], -24)
+                      .arg(QString::number(solution.critFlow[i], 'g', 6), 14)
+                      .arg(QString::number(solution.critSpeed[i], 'g', 6), 14)
+                      .arg(QString::number(solution.critFrequency[i], 'g', 6), 14)
+               << Qt::endl;
+    }
+    if (mProfiler.isEnabled())
+        stream << Qt::endl << tr("Profile") << Qt::endl << mProfiler.report().toString();
+    appendLog(message, QtMsgType::QtInfoMsg, "report");
+
+    emit solverFinished();
+}
+
+void EnvelopeSolver::serialize(QXmlStreamWriter& stream, QString const& elementName) const
+{
+    stream.writeStartElement(elementName);
+    stream.writeAttribute("type", Utility::toString((int) type()));
+    stream.writeTextElement("id", mID.toString());
+    stream.writeTextElement("name", name);
+    Utility::serialize(stream, "model", model);
+    table.serialize(stream, "table");
+    flutterOptions.serialize(stream, "flutterOptions");
+    options.serialize(stream, "options");
+    solution.serialize(stream, "solution");
+    log.serialize(stream, "log");
+    stream.writeEndElement();
+}
+
+void EnvelopeSolver::deserialize(QXmlStreamReader& stream)
+{
+    while (stream.readNextStartElement())
+    {
+        if (stream.name() == "id")
+            mID = QUuid::fromString(stream.readElementText());
+        else if (stream.name() == "name")
+            name = stream.readElementText();
+        else if (stream.name() == "model")
+            Utility::deserialize(stream, model);
+        else if (stream.name() == "table")
+            table.deserialize(stream);
+        else if (stream.name() == "flutterOptions")
+            flutterOptions.deserialize(stream);
+        else if (stream.name() == "options")
+            options.deserialize(stream);
+        else if (stream.name() == "solution")
+            solution.deserialize(stream);
+        else if (stream.name() == "log")
+            log.deserialize(stream);
+        else
+            stream.skipCurrentElement();
+    }
+}
+
+bool EnvelopeSolver::operator==(ISolver const* pBaseSolver) const
+{
+    if (type() != pBaseSolver->type())
+        return false;
+    EnvelopeSolver* pSolver = (EnvelopeSolver*) pBaseSolver;
+    return Utility::areEqual(*this, *pSolver);
+}
+
+bool EnvelopeSolver::operator!=(ISolver const* pBaseSolver) const
+{
+    return !(*this == pBaseSolver);
+}
+
+//! Estimate the number of bytes held by the solver
+MemoryUsage EnvelopeSolver::memoryUsage() const
+{
+    MemoryUsage result;
+    result.models = Utility::numBytes(model);
+    result.other = Utility::numBytes(table.fields) + Utility::numBytes(table.values);
+    result.other += Utility::numBytes(solution.critFlow) + Utility::numBytes(solution.critSpeed) + Utility::numBytes(solution.critFrequency);
+    for (FlutterSolution const& flutterSolution : solution.solutions)
+    {
+        result.roots += Utility::numBytes(flutterSolution.roots);
+        result.critModeShapes += Utility::numBytes(flutterSolution.critModeShapes);
+        result.other += Utility::numBytes(flutterSolution, false, false);
+    }
+    result.logs = log.numBytes();
+    return result;
+}
+
+//! Get the profiler which accumulates the durations of the solver phases
+Profiler& EnvelopeSolver::profiler()
+{
+    return mProfiler;
+}
+
+void EnvelopeSolver::appendLog(QString const& message, QtMsgType type, QString const& category)
+{
+    log.append(message, type, category);
+    emit logAppended(message);
+}
+
+//! Helper function to find the element of the model by the selection
+KCL::AbstractElement* findElement(KCL::Model& model, Selection const& selection)
+{
+    if (selection.iSurface == Constants::skISpecialSurface)
+        return model.specialSurface.element(selection.type, selection.iElement);
+    if (selection.iSurface < 0 || selection.iSurface >= (int) model.surfaces.size())
+        return nullptr;
+    return model.surfaces[selection.iSurface].element(selection.type, selection.iElement);
+}
@@ -0,0 +1,180 @@
+#ifndef ENVELOPESOLVER_H
+#define ENVELOPESOLVER_H
+
+#include <kcl/model.h>
+
+#include "fluttersolver.h"
+#include "isolver.h"
+#include "profiler.h"
+#include "selectionset.h"
+#include "solverlog.h"
+#include "solvermetrics.h"
+
+namespace Backend::Core
+{
+
+/*!
+ * Table of the model variants to sweep
+ *
+ * Each field refers to a data value of an element, which is either replaced or multiplied by the values given for every case.
+ * NaN values keep the data of the base model
+ */
+struct EnvelopeTable : public ISerializable
+{
+    Q_GADGET
+    Q_PROPERTY(QStringList names MEMBER names)
+    Q_PROPERTY(Eigen::MatrixXi fields MEMBER fields)
+    Q_PROPERTY(Eigen::MatrixXd values MEMBER values)
+
+public:
+    enum FieldColumn
+    {
+        kSurface,
+        kType,
+        kElement,
+        kData,
+        kFactor,
+        kNumFieldColumns
+    };
+
+    EnvelopeTable();
+    ~EnvelopeTable() = default;
+
+    bool isEmpty() const;
+    int numCases() const;
+    int numFields() const;
+
+    int addCase(QString const& name);
+    int addField(Selection const& selection, int iData, bool isFactor = false);
+    Selection selection(int iField) const;
+    bool apply(KCL::Model& model, int iCase) const;
+    void clear();
+
+    bool operator==(EnvelopeTable const& another) const;
+    bool operator!=(EnvelopeTable const& another) const;
+
+    void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
+    void deserialize(QXmlStreamReader& stream) override;
+
+    //! Names of the cases
+    QStringList names;
+
+    //! Element data to override (fields by rows, columns are defined by FieldColumn)
+    Eigen::MatrixXi fields;
+
+    //! Values of the fields (cases by rows)
+    Eigen::MatrixXd values;
+};
+
+struct EnvelopeOptions : public ISerializable
+{
+    Q_GADGET
+    Q_PROPERTY(int numThreads MEMBER numThreads)
+    Q_PROPERTY(bool isKeepSolutions MEMBER isKeepSolutions)
+
+public:
+    EnvelopeOptions();
+    ~EnvelopeOptions() = default;
+
+    bool operator==(EnvelopeOptions const& another) const;
+    bool operator!=(EnvelopeOptions const& another) const;
+
+    void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
+    void deserialize(QXmlStreamReader& stream) override;
+
+    //! Number of cases solved concurrently
+    int numThreads;
+
+    //! Retain the full flutter solutions of the cases
+    bool isKeepSolutions;
+};
+
+struct EnvelopeSolution : public ISerializable
+{
+    Q_GADGET
+    Q_PROPERTY(QStringList names MEMBER names)
+    Q_PROPERTY(Eigen::VectorXd critFlow MEMBER critFlow)
+    Q_PROPERTY(Eigen::VectorXd critSpeed MEMBER critSpeed)
+    Q_PROPERTY(Eigen::VectorXd critFrequency MEMBER critFrequency)
+    Q_PROPERTY(QList<FlutterSolution> solutions MEMBER solutions)
+
+public:
+    EnvelopeSolution();
+    ~EnvelopeSolution() = default;
+
+    bool isEmpty() const;
+    int numCases() const;
+    int findCriticalCase() const;
+
+    bool operator==(EnvelopeSolution const& another) const;
+    bool operator!=(EnvelopeSolution const& another) const;
+
+    void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
+    void deserialize(QXmlStreamReader& stream) override;
+
+    //! Names of the cases
+    QStringList names;
+
+    //! Lowest critical values of every case (NaN if there is no flutter within the flow range)
+    Eigen::VectorXd critFlow;
+    Eigen::VectorXd critSpeed;
+    Eigen::VectorXd critFrequency;
+
+    //! Full solutions of the cases, if requested
+    QList<FlutterSolution> solutions;
+};
+
+class EnvelopeSolver : public QObject, public ISolver
+{
+    Q_OBJECT
+    Q_PROPERTY(KCL::Model model MEMBER model)
+    Q_PROPERTY(EnvelopeTable table MEMBER table)
+    Q_PROPERTY(FlutterOptions flutterOptions MEMBER flutterOptions)
+    Q_PROPERTY(EnvelopeOptions options MEMBER options)
+    Q_PROPERTY(EnvelopeSolution solution MEMBER solution)
+    Q_PROPERTY(Backend::Core::SolverLog log MEMBER log)
+
+public:
+    EnvelopeSolver();
+    ~EnvelopeSolver() = default;
+    EnvelopeSolver(EnvelopeSolver const& another);
+    EnvelopeSolver(EnvelopeSolver&& another);
+    EnvelopeSolver& operator=(EnvelopeSolver const& another);
+
+    ISolver::Type type() const override;
+    ISolver* clone() const override;
+
+    void clear() override;
+    void solve() override;
+    MemoryUsage memoryUsage() const override;
+
+    void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
+    void deserialize(QXmlStreamReader& stream) override;
+
+    bool operator==(ISolver const* pBaseSolver) const override;
+    bool operator!=(ISolver const* pBaseSolver) const override;
+
+    Profiler& profiler();
+
+signals:
+    void solverFinished();
+    void logAppended(QString message);
+
+private:
+    void appendLog(QString const& message, QtMsgType type = QtMsgType::QtInfoMsg, QString const& category = QString());
+
+public:
+    QString name;
+    KCL::Model model;
+    EnvelopeTable table;
+    FlutterOptions flutterOptions;
+    EnvelopeOptions options;
+    EnvelopeSolution solution;
+    SolverLog log;
+
+private:
+    Profiler mProfiler;
+};
+}
+
+#endif // ENVELOPESOLVER_H
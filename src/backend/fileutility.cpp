@@ -1,11 +1,14 @@
 #include <kcl/model.h>
 #include <QUuid>
 
+#include "envelopesolver.h"
 #include "fileutility.h"
 #include "fluttersolver.h"
 #include "optimsolver.h"
 #include "selectionset.h"
+#include "sensitivitysolver.h"
 #include "subproject.h"
+#include "uncertaintysolver.h"
 
 using namespace Backend::Core;
 
@@ -57,30 +60,6 @@ QString toString(QVariant const& variant)
     return QString();
 }
 
-void appendLog(QString& log, QString const& message, QtMsgType type)
-{
-    QTextStream stream(&log);
-    QString prefix;
-    switch (type)
-    {
-    case QtMsgType::QtWarningMsg:
-        prefix = "Warning";
-        break;
-    case QtMsgType::QtFatalMsg:
-        prefix = "Error";
-        break;
-    case QtMsgType::QtCriticalMsg:
-        prefix = "Error";
-        break;
-    default:
-        break;
-    }
-    stream << Qt::endl << QString("[%1]").arg(QTime::currentTime().toString()) << Qt::endl;
-    if (!prefix.isEmpty())
-        stream << QString("[%1]: ").arg(prefix);
-    stream << message;
-}
-
 QString toString(bool value)
 {
     return QString::number(value);
@@ -282,10 +261,26 @@ bool areEqual(QVariant const& first, QVariant const& second)
         flag = first.value<FlutterOptions>() == second.value<FlutterOptions>();
     else if (type == qMetaTypeId<FlutterSolution>())
         flag = first.value<FlutterSolution>() == second.value<FlutterSolution>();
+    else if (type == qMetaTypeId<SensitivityOptions>())
+        flag = first.value<SensitivityOptions>() == second.value<SensitivityOptions>();
+    else if (type == qMetaTypeId<SensitivitySolution>())
+        flag = first.value<SensitivitySolution>() == second.value<SensitivitySolution>();
+    else if (type == qMetaTypeId<UncertaintyOptions>())
+        flag = first.value<UncertaintyOptions>() == second.value<UncertaintyOptions>();
+    else if (type == qMetaTypeId<UncertaintySolution>())
+        flag = first.value<UncertaintySolution>() == second.value<UncertaintySolution>();
+    else if (type == qMetaTypeId<EnvelopeTable>())
+        flag = first.value<EnvelopeTable>() == second.value<EnvelopeTable>();
+    else if (type == qMetaTypeId<EnvelopeOptions>())
+        flag = first.value<EnvelopeOptions>() == second.value<EnvelopeOptions>();
+    else if (type == qMetaTypeId<EnvelopeSolution>())
+        flag = first.value<EnvelopeSolution>() == second.value<EnvelopeSolution>();
     else if (type == qMetaTypeId<QList<SelectionSet>>())
         flag = first.value<QList<SelectionSet>>() == second.value<QList<SelectionSet>>();
     else if (type == qMetaTypeId<QList<OptimSolution>>())
         flag = first.value<QList<OptimSolution>>() == second.value<QList<OptimSolution>>();
+    else if (type == qMetaTypeId<QList<FlutterSolution>>())
+        flag = first.value<QList<FlutterSolution>>() == second.value<QList<FlutterSolution>>();
     else if (type == qMetaTypeId<QList<Subproject>>())
         flag = first.value<QList<Subproject>>() == second.value<QList<Subproject>>();
     else if (type == qMetaTypeId<QList<ISolver*>>())
@@ -362,6 +357,30 @@ bool areEqual(QList<Core::ISolver*> const& first, QList<Core::ISolver*> const& s
                 return false;
             break;
         }
+        case Core::ISolver::kSensitivity:
+        {
+            auto pFirstSolver = (Core::SensitivitySolver*) first[i];
+            auto pSecondSolver = (Core::SensitivitySolver*) second[i];
+            if (!areEqual(*pFirstSolver, *pSecondSolver))
+                return false;
+            break;
+        }
+        case Core::ISolver::kUncertainty:
+        {
+            auto pFirstSolver = (Core::UncertaintySolver*) first[i];
+            auto pSecondSolver = (Core::UncertaintySolver*) second[i];
+            if (!areEqual(*pFirstSolver, *pSecondSolver))
+                return false;
+            break;
+        }
+        case Core::ISolver::kEnvelope:
+        {
+            auto pFirstSolver = (Core::EnvelopeSolver*) first[i];
+            auto pSecondSolver = (Core::EnvelopeSolver*) second[i];
+            if (!areEqual(*pFirstSolver, *pSecondSolver))
+                return false;
+            break;
+        }
         }
     }
     return true;
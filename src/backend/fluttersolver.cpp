@@ -3,6 +3,9 @@
 #include "mathutility.h"
 
 using namespace Backend::Core;
+using namespace Eigen;
+
+QList<int> pairRoots(VectorXcd const& predicted, VectorXcd const& current);
 
 FlutterOptions::FlutterOptions()
     : numModes(15)
@@ -10,6 +13,7 @@ FlutterOptions::FlutterOptions()
     , initFlow(0.0)
     , flowStep(10)
     , numFlowSteps(60)
+    , isTrackRoots(false)
 {
 }
 
@@ -26,6 +30,16 @@ bool FlutterOptions::operator!=(FlutterOptions const& another) const
     return !(*this == another);
 }
 
+//! Set the parameters of the flutter analysis to the model
+void FlutterOptions::setAnalysisParameters(KCL::Model& model) const
+{
+    auto pParameters = (KCL::AnalysisParameters*) model.specialSurface.element(KCL::WP);
+    pParameters->numLowModes = numModes;
+    pParameters->initFlow = initFlow;
+    pParameters->flowStep = flowStep;
+    pParameters->numFlowSteps = numFlowSteps;
+}
+
 void FlutterOptions::serialize(QXmlStreamWriter& stream, QString const& elementName) const
 {
     Utility::serializeProperties(stream, "options", *this);
@@ -74,6 +88,60 @@ int FlutterSolution::numCrit() const
     return critFlow.size();
 }
 
+//! Find the index of the critical point with the lowest flow. Returns -1 if there is no flutter within the flow range
+int FlutterSolution::findLowestCrit() const
+{
+    if (critFlow.size() == 0)
+        return -1;
+    int iCrit;
+    critFlow.minCoeff(&iCrit);
+    return iCrit;
+}
+
+//! Reorder the roots by continuation along the flow, so that each row corresponds to the same physical mode.
+//! The roots at the next step are predicted by linear extrapolation of the two previous ones and corrected by the nearest computed roots.
+//! Returns the number of flow steps at which the roots have been reordered
+int FlutterSolution::trackRoots()
+{
+    int numModes = roots.rows();
+    int numSteps = roots.cols();
+    if (numModes < 2 || numSteps < 2 || flow.size() != numSteps)
+        return 0;
+
+    // Loop through the flow steps
+    int numReordered = 0;
+    VectorXcd predicted(numModes);
+    VectorXcd current(numModes);
+    for (int iStep = 1; iStep != numSteps; ++iStep)
+    {
+        // Predict the roots
+        predicted = roots.col(iStep - 1);
+        if (iStep > 1)
+        {
+            double prevStep = flow[iStep - 1] - flow[iStep - 2];
+            if (std::abs(prevStep) > std::numeric_limits<double>::epsilon())
+            {
+                double ratio = (flow[iStep] - flow[iStep - 1]) / prevStep;
+                predicted += ratio * (roots.col(iStep - 1) - roots.col(iStep - 2));
+            }
+        }
+
+        // Correct the predicted roots by the computed ones
+        current = roots.col(iStep);
+        QList<int> indices = pairRoots(predicted, current);
+        bool isReordered = false;
+        for (int i = 0; i != numModes; ++i)
+        {
+            roots(i, iStep) = current[indices[i]];
+            if (indices[i] != i)
+                isReordered = true;
+        }
+        if (isReordered)
+            ++numReordered;
+    }
+    return numReordered;
+}
+
 bool FlutterSolution::operator==(FlutterSolution const& another) const
 {
     return Utility::areEqual(*this, another);
@@ -186,28 +254,42 @@ void FlutterSolver::clear()
     options = FlutterOptions();
     model = KCL::Model();
     solution = FlutterSolution();
-    log = QString();
+    log.clear();
 }
 
 void FlutterSolver::solve()
 {
+    TraceSpan span("solve", "flutter");
+
     // Copy the model
     KCL::Model currentModel = model;
 
     // Set the analysis parameters
-    auto pParameters = (KCL::AnalysisParameters*) currentModel.specialSurface.element(KCL::WP);
-    pParameters->numLowModes = options.numModes;
-    pParameters->initFlow = options.initFlow;
-    pParameters->flowStep = options.flowStep;
-    pParameters->numFlowSteps = options.numFlowSteps;
+    options.setAnalysisParameters(currentModel);
 
     // Create the auxiliary function
     std::ostringstream stream;
     std::function<KCL::FlutterSolution()> fun = [&currentModel, &stream]() { return currentModel.solveFlutter(stream); };
 
     // Run the solution
-    solution = Utility::solve(fun, options.timeout);
-    appendLog(stream.str().data());
+    mProfiler.reset();
+    {
+        ProfileTimer timer(mProfiler, "solveFlutter");
+        KernelScope kernel(SolverMetrics::kFlutter);
+        solution = Utility::solve(fun, options.timeout);
+    }
+    appendLog(stream.str().data(), QtMsgType::QtInfoMsg, "kcl");
+
+    // Track the roots, so that the modes do not switch near coalescence
+    if (options.isTrackRoots)
+    {
+        ProfileTimer timer(mProfiler, "trackRoots");
+        int numReordered = solution.trackRoots();
+        if (numReordered > 0)
+            appendLog(QString("Roots are reordered at %1 flow steps\n").arg(numReordered));
+    }
+    if (mProfiler.isEnabled())
+        appendLog(mProfiler.report().toString(), QtMsgType::QtInfoMsg, "profile");
 
     emit solverFinished();
 }
@@ -221,7 +303,7 @@ void FlutterSolver::serialize(QXmlStreamWriter& stream, QString const& elementNa
     Utility::serialize(stream, "model", model);
     options.serialize(stream, "options");
     solution.serialize(stream, "solution");
-    Utility::serialize(stream, "log", log);
+    log.serialize(stream, "log");
     stream.writeEndElement();
 }
 
@@ -240,7 +322,7 @@ void FlutterSolver::deserialize(QXmlStreamReader& stream)
         else if (stream.name() == "solution")
             solution.deserialize(stream);
         else if (stream.name() == "log")
-            Utility::deserialize(stream, log);
+            log.deserialize(stream);
         else
             stream.skipCurrentElement();
     }
@@ -259,8 +341,64 @@ bool FlutterSolver::operator!=(ISolver const* pBaseSolver) const
     return !(*this == pBaseSolver);
 }
 
-void FlutterSolver::appendLog(QString const& message, QtMsgType type)
+//! Estimate the number of bytes held by the solver
+MemoryUsage FlutterSolver::memoryUsage() const
+{
+    MemoryUsage result;
+    result.models = Utility::numBytes(model);
+    result.roots = Utility::numBytes(solution.roots);
+    result.critModeShapes = Utility::numBytes(solution.critModeShapes);
+    result.other = Utility::numBytes(solution, false, false);
+    result.logs = log.numBytes();
+    return result;
+}
+
+//! Get the profiler which accumulates the durations of the solver phases
+Profiler& FlutterSolver::profiler()
 {
-    Utility::appendLog(log, message, type);
+    return mProfiler;
+}
+
+void FlutterSolver::appendLog(QString const& message, QtMsgType type, QString const& category)
+{
+    log.append(message, type, category);
     emit logAppended(message);
 }
+
+//! Helper function to pair the predicted roots with the computed ones by the smallest distances first
+QList<int> pairRoots(VectorXcd const& predicted, VectorXcd const& current)
+{
+    int numRoots = predicted.size();
+
+    // Sort all the possible pairs by the distances
+    QList<std::pair<double, int>> pairs;
+    pairs.reserve(numRoots * numRoots);
+    for (int i = 0; i != numRoots; ++i)
+    {
+        for (int j = 0; j != numRoots; ++j)
+        {
+            double distance = std::abs(predicted[i] - current[j]);
+            if (!std::isfinite(distance))
+                distance = std::numeric_limits<double>::infinity();
+            pairs.push_back({distance, i * numRoots + j});
+        }
+    }
+    std::stable_sort(pairs.begin(), pairs.end(), [](auto const& first, auto const& second) { return first.first < second.first; });
+
+    // Select the nearest roots which have not been paired yet
+    QList<int> result(numRoots, -1);
+    QList<bool> isPaired(numRoots, false);
+    int numPaired = 0;
+    for (auto const& pair : pairs)
+    {
+        int i = pair.second / numRoots;
+        int j = pair.second % numRoots;
+        if (result[i] >= 0 || isPaired[j])
+            continue;
+        result[i] = j;
+        isPaired[j] = true;
+        if (++numPaired == numRoots)
+            break;
+    }
+    return result;
+}
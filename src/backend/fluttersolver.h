@@ -5,6 +5,9 @@
 
 #include "isolver.h"
 #include "geometry.h"
+#include "profiler.h"
+#include "solverlog.h"
+#include "solvermetrics.h"
 
 namespace Backend::Core
 {
@@ -17,6 +20,7 @@ struct FlutterOptions : public ISerializable
     Q_PROPERTY(double initFlow MEMBER initFlow)
     Q_PROPERTY(double flowStep MEMBER flowStep)
     Q_PROPERTY(int numFlowSteps MEMBER numFlowSteps)
+    Q_PROPERTY(bool isTrackRoots MEMBER isTrackRoots)
 
 public:
     FlutterOptions();
@@ -25,6 +29,8 @@ public:
     bool operator==(FlutterOptions const& another) const;
     bool operator!=(FlutterOptions const& another) const;
 
+    void setAnalysisParameters(KCL::Model& model) const;
+
     void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
     void deserialize(QXmlStreamReader& stream) override;
 
@@ -42,6 +48,9 @@ public:
 
     //! Number of flow steps
     int numFlowSteps;
+
+    //! Reorder the roots by continuation along the flow instead of keeping the order computed at each step
+    bool isTrackRoots;
 };
 
 struct FlutterSolution : public ISerializable
@@ -68,6 +77,8 @@ public:
 
     bool isEmpty() const;
     int numCrit() const;
+    int findLowestCrit() const;
+    int trackRoots();
 
     bool operator==(FlutterSolution const& another) const;
     bool operator!=(FlutterSolution const& another) const;
@@ -96,7 +107,7 @@ class FlutterSolver : public QObject, public ISolver
     Q_PROPERTY(KCL::Model model MEMBER model)
     Q_PROPERTY(FlutterOptions options MEMBER options)
     Q_PROPERTY(FlutterSolution solution MEMBER solution)
-    Q_PROPERTY(QString log MEMBER log)
+    Q_PROPERTY(Backend::Core::SolverLog log MEMBER log)
 
 public:
     FlutterSolver();
@@ -110,6 +121,7 @@ public:
 
     void clear() override;
     void solve() override;
+    MemoryUsage memoryUsage() const override;
 
     void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
     void deserialize(QXmlStreamReader& stream) override;
@@ -117,19 +129,24 @@ public:
     bool operator==(ISolver const* pBaseSolver) const override;
     bool operator!=(ISolver const* pBaseSolver) const override;
 
+    Profiler& profiler();
+
 signals:
     void solverFinished();
     void logAppended(QString const& message);
 
 private:
-    void appendLog(QString const& message, QtMsgType type = QtMsgType::QtInfoMsg);
+    void appendLog(QString const& message, QtMsgType type = QtMsgType::QtInfoMsg, QString const& category = QString());
 
 public:
     QString name;
     KCL::Model model;
     FlutterOptions options;
     FlutterSolution solution;
-    QString log;
+    SolverLog log;
+
+private:
+    Profiler mProfiler;
 };
 }
 
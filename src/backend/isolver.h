@@ -3,6 +3,7 @@
 
 #include "identifier.h"
 #include "iserializable.h"
+#include "memoryusage.h"
 
 namespace Backend::Core
 {
@@ -14,12 +15,16 @@ public:
     {
         kModal,
         kOptim,
-        kFlutter
+        kFlutter,
+        kSensitivity,
+        kUncertainty,
+        kEnvelope
     };
     virtual Type type() const = 0;
     virtual ISolver* clone() const = 0;
     virtual void clear() = 0;
     virtual void solve() = 0;
+    virtual MemoryUsage memoryUsage() const = 0;
     virtual bool operator==(ISolver const* pBaseSolver) const = 0;
     virtual bool operator!=(ISolver const* pBaseSolver) const = 0;
     virtual ~ISolver() = default;
@@ -1,6 +1,7 @@
 #include <future>
 #include <kcl/solver.h>
 #include <QList>
+#include <QRandomGenerator>
 
 #include "mathutility.h"
 #include "subproject.h"
@@ -184,6 +185,27 @@ Core::ModalPairs pairByMAC(MatrixXd const& MAC, double threshold)
     return result;
 }
 
+//! Sample the unit hypercube so that every stratum of each dimension contains exactly one point. The samples are stored by rows
+MatrixXd latinHypercube(int numSamples, int numDimensions, quint32 seed)
+{
+    MatrixXd result(numSamples, numDimensions);
+    QRandomGenerator generator(seed);
+    QList<int> strata(numSamples);
+    for (int j = 0; j != numDimensions; ++j)
+    {
+        // Shuffle the strata
+        for (int i = 0; i != numSamples; ++i)
+            strata[i] = i;
+        for (int i = numSamples - 1; i > 0; --i)
+            std::swap(strata[i], strata[generator.bounded(i + 1)]);
+
+        // Place the points randomly within the strata
+        for (int i = 0; i != numSamples; ++i)
+            result(i, j) = (strata[i] + generator.generateDouble()) / numSamples;
+    }
+    return result;
+}
+
 // Explicit template instantiation
 template QList<QUuid> getIDs(QList<Core::Subproject> const&);
 template int getIndexByID(QList<Core::Subproject> const&, QUuid const&);
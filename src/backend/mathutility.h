@@ -29,6 +29,7 @@ Eigen::VectorXi rowIndicesAbsMax(Eigen::MatrixXd const& data);
 double computeMAC(Eigen::VectorXd const& first, Eigen::VectorXd const& second);
 double computeMAC(Eigen::MatrixXd const& first, Eigen::MatrixXd const& second, Backend::Core::Matches const& matches);
 Core::ModalPairs pairByMAC(Eigen::MatrixXd const& MAC, double threshold);
+Eigen::MatrixXd latinHypercube(int numSamples, int numDimensions, quint32 seed);
 }
 
 #endif // MATHUTILITY_H
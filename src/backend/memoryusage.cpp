@@ -0,0 +1,152 @@
+#include <QLocale>
+#include <QObject>
+
+#include <kcl/model.h>
+
+#include "fluttersolver.h"
+#include "memoryusage.h"
+#include "modalsolver.h"
+
+using namespace Backend;
+using namespace Backend::Core;
+
+// Helper functions
+qint64 numBytes(KCL::ElasticSurface const& surface);
+
+MemoryUsage::MemoryUsage()
+    : models(0)
+    , modeShapes(0)
+    , roots(0)
+    , critModeShapes(0)
+    , solutions(0)
+    , logs(0)
+    , other(0)
+{
+}
+
+bool MemoryUsage::isEmpty() const
+{
+    return total() == 0;
+}
+
+//! Get the total number of bytes
+qint64 MemoryUsage::total() const
+{
+    return models + modeShapes + roots + critModeShapes + solutions + logs + other;
+}
+
+//! Represent the usage as a multiline text
+QString MemoryUsage::toString() const
+{
+    QLocale locale;
+    QString result = QObject::tr("Memory: %1").arg(locale.formattedDataSize(total()));
+    QList<QPair<QString, qint64>> const items = {{QObject::tr("Models"), models},
+                                                 {QObject::tr("Mode shapes"), modeShapes},
+                                                 {QObject::tr("Flutter roots"), roots},
+                                                 {QObject::tr("Critical mode shapes"), critModeShapes},
+                                                 {QObject::tr("Iterations"), solutions},
+                                                 {QObject::tr("Logs"), logs},
+                                                 {QObject::tr("Other"), other}};
+    for (auto const& item : items)
+    {
+        if (item.second > 0)
+            result.append(QString("\n  %1: %2").arg(item.first, locale.formattedDataSize(item.second)));
+    }
+    return result;
+}
+
+MemoryUsage& MemoryUsage::operator+=(MemoryUsage const& another)
+{
+    models += another.models;
+    modeShapes += another.modeShapes;
+    roots += another.roots;
+    critModeShapes += another.critModeShapes;
+    solutions += another.solutions;
+    logs += another.logs;
+    other += another.other;
+    return *this;
+}
+
+MemoryUsage MemoryUsage::operator+(MemoryUsage const& another) const
+{
+    MemoryUsage result = *this;
+    result += another;
+    return result;
+}
+
+//! Number of bytes allocated for the characters
+qint64 Utility::numBytes(QString const& text)
+{
+    return text.capacity() * sizeof(QChar);
+}
+
+//! Estimate the number of bytes held by the elements of the model
+qint64 Utility::numBytes(KCL::Model const& model)
+{
+    qint64 result = sizeof(KCL::Model);
+    for (KCL::ElasticSurface const& surface : model.surfaces)
+        result += ::numBytes(surface);
+    result += ::numBytes(model.specialSurface);
+    return result;
+}
+
+//! Number of bytes held by the vertices and cells
+qint64 Utility::numBytes(Geometry const& geometry)
+{
+    qint64 result = geometry.vertices.capacity() * sizeof(Vertex);
+    for (Vertex const& vertex : geometry.vertices)
+        result += numBytes(vertex.name);
+    result += geometry.slaves.capacity() * sizeof(Slave);
+    for (Slave const& slave : geometry.slaves)
+        result += numBytes(slave.masterIndices);
+    result += numBytes(geometry.lines) + numBytes(geometry.triangles) + numBytes(geometry.quadrangles);
+    return result;
+}
+
+//! Number of bytes held by the modal solution
+qint64 Utility::numBytes(ModalSolution const& solution, bool isModeShapes)
+{
+    qint64 result = numBytes(solution.geometry) + numBytes(solution.frequencies);
+    result += solution.names.capacity() * sizeof(QString);
+    for (QString const& name : solution.names)
+        result += numBytes(name);
+    if (isModeShapes)
+        result += numBytes(solution.modeShapes);
+    return result;
+}
+
+//! Number of bytes held by the comparison of modal solutions
+qint64 Utility::numBytes(ModalComparison const& comparison)
+{
+    qint64 result = numBytes(comparison.diffFrequencies) + numBytes(comparison.errorFrequencies) + numBytes(comparison.errorsMAC);
+    result += comparison.pairs.capacity() * sizeof(QPair<int, double>);
+    return result;
+}
+
+//! Number of bytes held by the flutter solution
+qint64 Utility::numBytes(FlutterSolution const& solution, bool isRoots, bool isCritModeShapes)
+{
+    qint64 result = numBytes(solution.geometry) + numBytes(solution.frequencies) + numBytes(solution.flow);
+    result += numBytes(solution.critFlow) + numBytes(solution.critSpeed) + numBytes(solution.critFrequency);
+    result += numBytes(solution.critCircFrequency) + numBytes(solution.critStrouhal) + numBytes(solution.critDamping);
+    result += numBytes(solution.critPartFactor) + numBytes(solution.critPartPhase);
+    if (isRoots)
+        result += numBytes(solution.roots);
+    if (isCritModeShapes)
+        result += numBytes(solution.critModeShapes);
+    return result;
+}
+
+//! Estimate the number of bytes held by the elements of the surface
+qint64 numBytes(KCL::ElasticSurface const& surface)
+{
+    qint64 result = 0;
+    auto types = surface.types();
+    for (KCL::ElementType type : types)
+    {
+        std::vector<KCL::AbstractElement const*> elements = surface.elements(type);
+        for (KCL::AbstractElement const* pElement : elements)
+            result += sizeof(KCL::AbstractElement) + pElement->get().size() * sizeof(double);
+    }
+    return result;
+}
@@ -0,0 +1,87 @@
+#ifndef MEMORYUSAGE_H
+#define MEMORYUSAGE_H
+
+#include <Eigen/Core>
+#include <QList>
+#include <QString>
+
+namespace KCL
+{
+struct Model;
+}
+
+namespace Backend::Core
+{
+
+struct Geometry;
+struct ModalSolution;
+struct ModalComparison;
+struct FlutterSolution;
+
+//! Estimation of the number of bytes held by solvers grouped by the kind of data
+struct MemoryUsage
+{
+    MemoryUsage();
+    ~MemoryUsage() = default;
+
+    bool isEmpty() const;
+    qint64 total() const;
+    QString toString() const;
+
+    MemoryUsage& operator+=(MemoryUsage const& another);
+    MemoryUsage operator+(MemoryUsage const& another) const;
+
+    //! Copies of the KCL models
+    qint64 models;
+
+    //! Mode shapes of the modal solutions
+    qint64 modeShapes;
+
+    //! Roots of the flutter solutions
+    qint64 roots;
+
+    //! Critical mode shapes of the flutter solutions
+    qint64 critModeShapes;
+
+    //! History of the optimization iterations
+    qint64 solutions;
+
+    //! Solver logs
+    qint64 logs;
+
+    //! Everything else (geometries, frequencies, comparisons, etc.)
+    qint64 other;
+};
+
+}
+
+namespace Backend::Utility
+{
+
+qint64 numBytes(QString const& text);
+qint64 numBytes(KCL::Model const& model);
+qint64 numBytes(Core::Geometry const& geometry);
+qint64 numBytes(Core::ModalSolution const& solution, bool isModeShapes = true);
+qint64 numBytes(Core::ModalComparison const& comparison);
+qint64 numBytes(Core::FlutterSolution const& solution, bool isRoots = true, bool isCritModeShapes = true);
+
+//! Number of bytes allocated for the matrix coefficients
+template<typename Scalar, int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+qint64 numBytes(Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols> const& matrix)
+{
+    return matrix.size() * sizeof(Scalar);
+}
+
+//! Number of bytes allocated for the matrices
+template<typename Scalar, int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+qint64 numBytes(QList<Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols>> const& matrices)
+{
+    qint64 result = matrices.capacity() * sizeof(Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols>);
+    for (auto const& matrix : matrices)
+        result += numBytes(matrix);
+    return result;
+}
+
+}
+
+#endif // MEMORYUSAGE_H
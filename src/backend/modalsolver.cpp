@@ -53,29 +53,85 @@ bool ModalSolution::isEmpty() const
     return numModes() == 0;
 }
 
+ModalCandidates::ModalCandidates()
+    : relBand(0.0)
+    , numNeighbors(0)
+{
+}
+
+ModalCandidates::ModalCandidates(double aRelBand, int aNumNeighbors)
+    : relBand(aRelBand)
+    , numNeighbors(aNumNeighbors)
+{
+}
+
+//! Check if the modes are supposed to be pruned
+bool ModalCandidates::isEnabled() const
+{
+    return relBand > 0.0;
+}
+
 int ModalSolution::numModes() const
 {
     return frequencies.size();
 }
 
 //! Compare the modal and eigen solutions
-ModalComparison ModalSolution::compare(ModalSolution const& another, VectorXi const& indices, Matches const& matches, double minMAC) const
+ModalComparison ModalSolution::compare(ModalSolution const& another, VectorXi const& indices, Matches const& matches, double minMAC,
+                                       ModalCandidates const& candidates) const
 {
     ModalComparison result;
 
-    // Compute MAC table
+    // Compute MAC table, evaluating only the candidate modes if requested
     int numBaseModes = indices.size();
     int numCompareModes = another.numModes();
-    MatrixXd tableMAC(numBaseModes, numCompareModes);
+    MatrixXd tableMAC = MatrixXd::Constant(numBaseModes, numCompareModes, skDummy);
+    QList<bool> isFullRows(numBaseModes, !candidates.isEnabled());
     for (int i = 0; i != numBaseModes; ++i)
     {
         int iBaseMode = indices[i];
-        MatrixXd baseModeShape = modeShapes[iBaseMode];
+        MatrixXd const& baseModeShape = modeShapes[iBaseMode];
+        if (isFullRows[i])
+        {
+            for (int j = 0; j != numCompareModes; ++j)
+                tableMAC(i, j) = Utility::computeMAC(baseModeShape, another.modeShapes[j], matches);
+            continue;
+        }
+
+        // Select the modes within the frequency band
+        double baseFrequency = frequencies[iBaseMode];
+        double halfBand = candidates.relBand * std::abs(baseFrequency);
+        QList<bool> mask(numCompareModes, false);
+        for (int j = 0; j != numCompareModes; ++j)
+            mask[j] = std::abs(another.frequencies[j] - baseFrequency) <= halfBand;
+
+        // Add the neighbors of the previously paired mode
+        if (i < candidates.previousPairs.size() && candidates.previousPairs[i].first >= 0)
+        {
+            int iPrevious = candidates.previousPairs[i].first;
+            int iStart = std::max(0, iPrevious - candidates.numNeighbors);
+            int iEnd = std::min(numCompareModes - 1, iPrevious + candidates.numNeighbors);
+            for (int j = iStart; j <= iEnd; ++j)
+                mask[j] = true;
+        }
+
+        // Evaluate the candidates and fall back to all the modes if none of them is acceptable
+        double maxValue = 0.0;
         for (int j = 0; j != numCompareModes; ++j)
         {
-            int iCompareMode = j;
-            MatrixXd compareModeShape = another.modeShapes[iCompareMode];
-            tableMAC(i, j) = Utility::computeMAC(baseModeShape, compareModeShape, matches);
+            if (!mask[j])
+                continue;
+            tableMAC(i, j) = Utility::computeMAC(baseModeShape, another.modeShapes[j], matches);
+            maxValue = std::max(maxValue, std::abs(tableMAC(i, j)));
+        }
+        if (maxValue <= minMAC)
+        {
+            for (int j = 0; j != numCompareModes; ++j)
+            {
+                if (!mask[j])
+                    tableMAC(i, j) = Utility::computeMAC(baseModeShape, another.modeShapes[j], matches);
+            }
+            isFullRows[i] = true;
         }
     }
 
@@ -83,6 +139,23 @@ ModalComparison ModalSolution::compare(ModalSolution const& another, VectorXi co
     result.resize(numBaseModes);
     result.pairs = Utility::pairByMAC(tableMAC, minMAC);
 
+    // Complete the rows whose candidates have been taken by other modes and pair again
+    bool isCompleted = false;
+    for (int i = 0; i != numBaseModes; ++i)
+    {
+        if (result.pairs[i].first >= 0 || isFullRows[i])
+            continue;
+        MatrixXd const& baseModeShape = modeShapes[indices[i]];
+        for (int j = 0; j != numCompareModes; ++j)
+        {
+            if (std::isnan(tableMAC(i, j)))
+                tableMAC(i, j) = Utility::computeMAC(baseModeShape, another.modeShapes[j], matches);
+        }
+        isCompleted = true;
+    }
+    if (isCompleted)
+        result.pairs = Utility::pairByMAC(tableMAC, minMAC);
+
     // Compute the errors
     for (int i = 0; i != numBaseModes; ++i)
     {
@@ -385,11 +458,13 @@ void ModalSolver::clear()
 {
     options = ModalOptions();
     solution = ModalSolution();
-    log = QString();
+    log.clear();
 }
 
 void ModalSolver::solve()
 {
+    TraceSpan span("solve", "modal");
+
     // Copy the model
     KCL::Model currentModel = model;
 
@@ -402,8 +477,15 @@ void ModalSolver::solve()
     std::function<KCL::EigenSolution()> fun = [&currentModel, &stream]() { return currentModel.solveEigen(stream); };
 
     // Run the solution
-    solution = Utility::solve(fun, options.timeout);
-    appendLog(stream.str().data());
+    mProfiler.reset();
+    {
+        ProfileTimer timer(mProfiler, "solveEigen");
+        KernelScope kernel(SolverMetrics::kEigen);
+        solution = Utility::solve(fun, options.timeout);
+    }
+    appendLog(stream.str().data(), QtMsgType::QtInfoMsg, "kcl");
+    if (mProfiler.isEnabled())
+        appendLog(mProfiler.report().toString(), QtMsgType::QtInfoMsg, "profile");
 
     emit solverFinished();
 }
@@ -417,7 +499,7 @@ void ModalSolver::serialize(QXmlStreamWriter& stream, QString const& elementName
     Utility::serialize(stream, "model", model);
     options.serialize(stream, "options");
     solution.serialize(stream, "solution");
-    Utility::serialize(stream, "log", log);
+    log.serialize(stream, "log");
     stream.writeEndElement();
 }
 
@@ -436,7 +518,7 @@ void ModalSolver::deserialize(QXmlStreamReader& stream)
         else if (stream.name() == "solution")
             solution.deserialize(stream);
         else if (stream.name() == "log")
-            Utility::deserialize(stream, log);
+            log.deserialize(stream);
         else
             stream.skipCurrentElement();
     }
@@ -455,8 +537,25 @@ bool ModalSolver::operator!=(ISolver const* pBaseSolver) const
     return !(this == pBaseSolver);
 }
 
-void ModalSolver::appendLog(QString const& message, QtMsgType type)
+//! Estimate the number of bytes held by the solver
+MemoryUsage ModalSolver::memoryUsage() const
+{
+    MemoryUsage result;
+    result.models = Utility::numBytes(model);
+    result.modeShapes = Utility::numBytes(solution.modeShapes);
+    result.other = Utility::numBytes(solution, false);
+    result.logs = log.numBytes();
+    return result;
+}
+
+//! Get the profiler which accumulates the durations of the solver phases
+Profiler& ModalSolver::profiler()
+{
+    return mProfiler;
+}
+
+void ModalSolver::appendLog(QString const& message, QtMsgType type, QString const& category)
 {
-    Utility::appendLog(log, message, type);
+    log.append(message, type, category);
     emit logAppended(message);
 }
@@ -10,12 +10,34 @@
 #include "geometry.h"
 #include "iserializable.h"
 #include "isolver.h"
+#include "profiler.h"
+#include "solverlog.h"
+#include "solvermetrics.h"
 
 namespace Backend::Core
 {
 
 struct ModalComparison;
 
+//! Modes of another solution which are considered while pairing with the base ones
+struct ModalCandidates
+{
+    ModalCandidates();
+    ModalCandidates(double aRelBand, int aNumNeighbors = 0);
+    ~ModalCandidates() = default;
+
+    bool isEnabled() const;
+
+    //! Relative half-width of the frequency band around every base mode (zero to compare all the modes)
+    double relBand;
+
+    //! Number of modes on each side of the previously paired one to consider as well
+    int numNeighbors;
+
+    //! Pairs obtained previously
+    ModalPairs previousPairs;
+};
+
 struct ModalSolution : public ISerializable
 {
     Q_GADGET
@@ -32,7 +54,8 @@ public:
 
     bool isEmpty() const;
     int numModes() const;
-    ModalComparison compare(ModalSolution const& another, Eigen::VectorXi const& indices, Matches const& matches, double minMAC) const;
+    ModalComparison compare(ModalSolution const& another, Eigen::VectorXi const& indices, Matches const& matches, double minMAC,
+                            ModalCandidates const& candidates = ModalCandidates()) const;
 
     void read(QDir const& directory);
 
@@ -108,7 +131,7 @@ class ModalSolver : public QObject, public ISolver
     Q_PROPERTY(KCL::Model model MEMBER model)
     Q_PROPERTY(ModalOptions options MEMBER options)
     Q_PROPERTY(ModalSolution solution MEMBER solution)
-    Q_PROPERTY(QString log MEMBER log)
+    Q_PROPERTY(Backend::Core::SolverLog log MEMBER log)
 
 public:
     ModalSolver();
@@ -122,6 +145,7 @@ public:
 
     void clear() override;
     void solve() override;
+    MemoryUsage memoryUsage() const override;
 
     void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
     void deserialize(QXmlStreamReader& stream) override;
@@ -129,19 +153,24 @@ public:
     bool operator==(ISolver const* pBaseSolver) const override;
     bool operator!=(ISolver const* pBaseSolver) const override;
 
+    Profiler& profiler();
+
 signals:
     void solverFinished();
     void logAppended(QString message);
 
 private:
-    void appendLog(QString const& message, QtMsgType type = QtMsgType::QtInfoMsg);
+    void appendLog(QString const& message, QtMsgType type = QtMsgType::QtInfoMsg, QString const& category = QString());
 
 public:
     QString name;
     KCL::Model model;
     ModalOptions options;
     ModalSolution solution;
-    QString log;
+    SolverLog log;
+
+private:
+    Profiler mProfiler;
 };
 }
 
@@ -0,0 +1,480 @@
+#include <QDataStream>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QThread>
+
+#include "optimrecorder.h"
+#include "optimsolver.h"
+#include "solvermetrics.h"
+
+using namespace Backend;
+using namespace Backend::Core;
+using namespace Eigen;
+
+// Helper functions
+template<typename Vector>
+void writeVector(QDataStream& stream, Vector const& vector);
+template<typename Vector>
+void readVector(QDataStream& stream, Vector& vector);
+
+//! Signature of recording files
+static quint32 const skMagic = 0x4D4F5252;
+
+//! Version of the binary layout of recordings
+static qint32 const skVersion = 3;
+
+OptimRecording::OptimRecording()
+    : maxNumIterations(0)
+    , numThreads(1)
+    , diffStepSize(0.0)
+    , minMAC(0.0)
+    , penaltyMAC(0.0)
+    , maxNumBroydenUpdates(0)
+    , minBroydenRatio(0.0)
+    , maxRelError(0.0)
+    , numSurrogateSamples(0)
+    , numResiduals(0)
+{
+}
+
+bool OptimRecording::isEmpty() const
+{
+    return initParameters.isEmpty() || numResiduals == 0;
+}
+
+int OptimRecording::numParameters() const
+{
+    return initParameters.size();
+}
+
+//! Read the recording from the binary file
+bool OptimRecording::read(QString const& pathFile)
+{
+    QFile file(pathFile);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << QObject::tr("Could not open the recording: %1").arg(pathFile);
+        return false;
+    }
+
+    // Check the header
+    QDataStream fileStream(&file);
+    fileStream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic;
+    qint32 version;
+    QByteArray data;
+    fileStream >> magic >> version >> data;
+    if (magic != skMagic || version < 1 || version > skVersion || fileStream.status() != QDataStream::Ok)
+    {
+        qWarning() << QObject::tr("The file is not a supported optimization recording: %1").arg(pathFile);
+        return false;
+    }
+
+    // Read the data
+    *this = OptimRecording();
+    data = qUncompress(data);
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream >> maxNumIterations >> numThreads >> diffStepSize >> minMAC >> penaltyMAC;
+    if (version > 1)
+        stream >> maxNumBroydenUpdates >> minBroydenRatio;
+    if (version > 2)
+        stream >> maxRelError >> numSurrogateSamples;
+    stream >> initParameters >> scales >> bounds;
+    readVector(stream, indices);
+    readVector(stream, frequencies);
+    readVector(stream, weights);
+    stream >> numResiduals;
+    qint32 numEvaluations;
+    stream >> numEvaluations;
+    evaluations.resize(numEvaluations);
+    for (OptimEvaluation& item : evaluations)
+    {
+        stream >> item.parameters >> item.residuals >> item.isValid;
+        item.maxError = 0.0;
+        if (version > 2)
+            stream >> item.maxError;
+    }
+    qint32 numIterates;
+    stream >> numIterates;
+    iterates.resize(numIterates);
+    for (OptimIterate& item : iterates)
+        stream >> item.iteration >> item.cost >> item.parameters;
+    if (stream.status() != QDataStream::Ok)
+    {
+        qWarning() << QObject::tr("The recording is corrupted: %1").arg(pathFile);
+        *this = OptimRecording();
+        return false;
+    }
+    return true;
+}
+
+//! Write the recording as a compressed binary file
+bool OptimRecording::write(QString const& pathFile) const
+{
+    // Pack the data
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << maxNumIterations << numThreads << diffStepSize << minMAC << penaltyMAC;
+    stream << maxNumBroydenUpdates << minBroydenRatio;
+    stream << maxRelError << numSurrogateSamples;
+    stream << initParameters << scales << bounds;
+    writeVector(stream, indices);
+    writeVector(stream, frequencies);
+    writeVector(stream, weights);
+    stream << numResiduals;
+    stream << (qint32) evaluations.size();
+    for (OptimEvaluation const& item : evaluations)
+        stream << item.parameters << item.residuals << item.isValid << item.maxError;
+    stream << (qint32) iterates.size();
+    for (OptimIterate const& item : iterates)
+        stream << item.iteration << item.cost << item.parameters;
+
+    // Write the file
+    QSaveFile file(pathFile);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << QObject::tr("Could not open the file to write the recording: %1").arg(pathFile);
+        return false;
+    }
+    QDataStream fileStream(&file);
+    fileStream.setVersion(QDataStream::Qt_6_0);
+    fileStream << skMagic << skVersion << qCompress(data);
+    return file.commit();
+}
+
+QString OptimRecording::fileSuffix()
+{
+    return "optimrec";
+}
+
+OptimRecorder::OptimRecorder()
+    : mIsEnabled(qEnvironmentVariableIsSet("MODUS_RECORD"))
+{
+}
+
+bool OptimRecorder::isEnabled() const
+{
+    return mIsEnabled.load(std::memory_order_relaxed);
+}
+
+void OptimRecorder::setEnabled(bool flag)
+{
+    mIsEnabled.store(flag, std::memory_order_relaxed);
+}
+
+//! Begin a new recording by saving the problem setup
+void OptimRecorder::start(OptimOptions const& options, QList<double> const& parameters, QList<double> const& scales,
+                          QList<PairDouble> const& bounds, OptimTarget const& target, int numResiduals)
+{
+    QMutexLocker locker(&mMutex);
+    mRecording = OptimRecording();
+    if (!isEnabled())
+        return;
+    mRecording.maxNumIterations = options.maxNumIterations;
+    mRecording.numThreads = options.numThreads;
+    mRecording.diffStepSize = options.diffStepSize;
+    mRecording.minMAC = options.minMAC;
+    mRecording.penaltyMAC = options.penaltyMAC;
+    mRecording.maxNumBroydenUpdates = options.maxNumBroydenUpdates;
+    mRecording.minBroydenRatio = options.minBroydenRatio;
+    mRecording.maxRelError = options.maxRelError;
+    mRecording.numSurrogateSamples = options.numSurrogateSamples;
+    mRecording.initParameters = parameters;
+    mRecording.scales = scales;
+    mRecording.bounds = bounds;
+    mRecording.indices = target.indices;
+    mRecording.frequencies = target.frequencies;
+    mRecording.weights = target.weights;
+    mRecording.numResiduals = numResiduals;
+}
+
+//! Add the point evaluated by the objective function (thread-safe)
+void OptimRecorder::recordEvaluation(double const* parameters, double const* residuals, bool isValid, double maxError)
+{
+    if (!isEnabled())
+        return;
+    QMutexLocker locker(&mMutex);
+    int numParameters = mRecording.numParameters();
+    OptimEvaluation item;
+    item.parameters = QList<double>(parameters, parameters + numParameters);
+    if (isValid)
+        item.residuals = QList<double>(residuals, residuals + mRecording.numResiduals);
+    item.isValid = isValid;
+    item.maxError = maxError;
+    mRecording.evaluations.push_back(std::move(item));
+}
+
+//! Add the point accepted by the optimizer
+void OptimRecorder::recordIterate(int iteration, double cost, QList<double> const& parameters)
+{
+    if (!isEnabled())
+        return;
+    QMutexLocker locker(&mMutex);
+    mRecording.iterates.push_back({iteration, cost, parameters});
+}
+
+void OptimRecorder::clear()
+{
+    QMutexLocker locker(&mMutex);
+    mRecording = OptimRecording();
+}
+
+OptimRecording OptimRecorder::recording() const
+{
+    QMutexLocker locker(&mMutex);
+    return mRecording;
+}
+
+ReplayStatistics::ReplayStatistics()
+    : numEvaluations(0)
+    , numHits(0)
+    , numNearest(0)
+    , numMisses(0)
+    , numIterations(0)
+    , isConverged(false)
+    , initCost(0.0)
+    , finalCost(0.0)
+    , duration(0.0)
+    , isSuccess(false)
+{
+}
+
+QString ReplayStatistics::toString() const
+{
+    QString result;
+    QTextStream stream(&result);
+    stream << QObject::tr("Replay Report") << Qt::endl;
+    stream << QObject::tr("-> Iterations:   %1").arg(numIterations) << Qt::endl;
+    stream << QObject::tr("-> Converged:    %1").arg(isConverged ? QObject::tr("yes") : QObject::tr("no")) << Qt::endl;
+    stream << QObject::tr("-> Evaluations:  %1").arg(numEvaluations) << Qt::endl;
+    stream << QObject::tr("-> Cache:        %1 hits, %2 nearest, %3 misses").arg(numHits).arg(numNearest).arg(numMisses) << Qt::endl;
+    stream << QObject::tr("-> Initial cost: %1").arg(QString::number(initCost, 'e', 3)) << Qt::endl;
+    stream << QObject::tr("-> Final cost:   %1").arg(QString::number(finalCost, 'e', 3)) << Qt::endl;
+    stream << QObject::tr("-> Duration:     %1 s").arg(QString::number(duration, 'f', 3)) << Qt::endl;
+    stream << QObject::tr("-> Message:      %1").arg(message) << Qt::endl;
+    return result;
+}
+
+//! Prepare the oracle. The points not recorded exactly are substituted by the nearest ones within the relative radius
+OptimReplayer::OptimReplayer(OptimRecording const& recording, double radius)
+    : mRecording(recording)
+    , mkRadius(radius)
+    , mNumEvaluations(0)
+    , mNumHits(0)
+    , mNumNearest(0)
+    , mNumMisses(0)
+{
+    // Use the settings of the recorded run
+    OptimOptions options;
+    options.maxNumIterations = mRecording.maxNumIterations;
+    options.numThreads = mRecording.numThreads;
+    mOptions = OptimSolver::solverOptions(options);
+
+    // Index the evaluations
+    int numParameters = mRecording.numParameters();
+    int numEvaluations = mRecording.evaluations.size();
+    mIndices.reserve(numEvaluations);
+    for (int i = 0; i != numEvaluations; ++i)
+    {
+        OptimEvaluation const& item = mRecording.evaluations[i];
+        if (item.parameters.size() == numParameters)
+            mIndices.insert(key(item.parameters.data(), numParameters), i);
+    }
+}
+
+//! Settings of the optimizer to be tested
+ceres::Solver::Options& OptimReplayer::options()
+{
+    return mOptions;
+}
+
+//! Run the optimizer using the recorded residuals
+ReplayStatistics OptimReplayer::replay()
+{
+    ReplayStatistics result;
+    if (mRecording.isEmpty())
+    {
+        result.message = QObject::tr("Recording is empty");
+        return result;
+    }
+    if (mRecording.numSurrogateSamples > 0)
+    {
+        result.message = QObject::tr("Surrogate-assisted runs cannot be replayed, since the optimizer works on the fitted model");
+        qWarning() << result.message;
+        return result;
+    }
+    mNumEvaluations = 0;
+    mNumHits = 0;
+    mNumNearest = 0;
+    mNumMisses = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    // Create the cost function
+    int numParameters = mRecording.numParameters();
+    ceres::CostFunction* costFunction = createCostFunction(*this, numParameters, mRecording.numResiduals, mRecording.diffStepSize,
+                                                           mRecording.maxNumBroydenUpdates, mRecording.minBroydenRatio);
+
+    // Set the problem
+    QList<double> parameterValues = mRecording.initParameters;
+    double* values = parameterValues.data();
+    ceres::Problem problem;
+    problem.AddResidualBlock(costFunction, nullptr, values);
+    for (int i = 0; i != numParameters; ++i)
+    {
+        PairDouble const& bounds = mRecording.bounds[i];
+        problem.SetParameterLowerBound(values, i, bounds.first);
+        problem.SetParameterUpperBound(values, i, bounds.second);
+    }
+
+    // Stop at the same tolerance of the frequency errors as the recorded run
+    ceres::Solver::Options options = mOptions;
+    ReplayCallback callback(*this, mRecording, parameterValues);
+    options.update_state_every_iteration = true;
+    options.callbacks.push_back(&callback);
+
+    // Solve the problem
+    ceres::Solver::Summary summary;
+    ceres::Solve(options, &problem, &summary);
+
+    // Collect the statistics
+    result.numEvaluations = mNumEvaluations;
+    result.numHits = mNumHits;
+    result.numNearest = mNumNearest;
+    result.numMisses = mNumMisses;
+    result.numIterations = summary.iterations.size();
+    result.isConverged = callback.isConverged();
+    result.initCost = summary.initial_cost;
+    result.finalCost = summary.final_cost;
+    result.duration = timer.nsecsElapsed() * 1e-9;
+    result.isSuccess = summary.IsSolutionUsable();
+    result.message = summary.message.c_str();
+    result.parameters = parameterValues;
+    return result;
+}
+
+//! Look up the residuals evaluated at the point
+bool OptimReplayer::operator()(double const* const* parameters, double* residuals) const
+{
+    ++mNumEvaluations;
+    SolverMetrics& metrics = SolverMetrics::instance();
+    metrics.addEvaluation();
+    int numParameters = mRecording.numParameters();
+    int index = mIndices.value(key(*parameters, numParameters), -1);
+    metrics.addReplayLookup(index >= 0);
+    if (index >= 0)
+    {
+        ++mNumHits;
+    }
+    else
+    {
+        index = findNearest(*parameters);
+        if (index < 0)
+        {
+            ++mNumMisses;
+            return false;
+        }
+        ++mNumNearest;
+    }
+    OptimEvaluation const& item = mRecording.evaluations[index];
+    if (!item.isValid)
+        return false;
+    std::copy(item.residuals.begin(), item.residuals.end(), residuals);
+    return true;
+}
+
+//! Find the evaluation recorded at the point or the nearest one within the radius
+int OptimReplayer::find(double const* parameters) const
+{
+    int index = mIndices.value(key(parameters, mRecording.numParameters()), -1);
+    if (index < 0)
+        index = findNearest(parameters);
+    return index;
+}
+
+//! Find the recorded point closest to the given one in terms of the maximum relative difference
+int OptimReplayer::findNearest(double const* parameters) const
+{
+    if (mkRadius <= 0.0)
+        return -1;
+    int numParameters = mRecording.numParameters();
+    int numEvaluations = mRecording.evaluations.size();
+    int result = -1;
+    double minDistance = mkRadius;
+    for (int i = 0; i != numEvaluations; ++i)
+    {
+        QList<double> const& values = mRecording.evaluations[i].parameters;
+        double distance = 0.0;
+        for (int j = 0; j != numParameters && distance <= minDistance; ++j)
+            distance = std::max(distance, std::abs(parameters[j] - values[j]) / std::max(std::abs(values[j]), 1.0));
+        if (distance <= minDistance)
+        {
+            minDistance = distance;
+            result = i;
+        }
+    }
+    return result;
+}
+
+//! Represent the point as a hash key
+QByteArray OptimReplayer::key(double const* parameters, int numParameters)
+{
+    return QByteArray((char const*) parameters, numParameters * sizeof(double));
+}
+
+ReplayCallback::ReplayCallback(OptimReplayer const& replayer, OptimRecording const& recording, QList<double> const& parameterValues)
+    : mReplayer(replayer)
+    , mRecording(recording)
+    , mParameterValues(parameterValues)
+    , mIsConverged(false)
+{
+}
+
+//! Terminate successfully, if the maximum error in frequencies at the accepted point is below the tolerance
+ceres::CallbackReturnType ReplayCallback::operator()(ceres::IterationSummary const& /*summary*/)
+{
+    if (QThread::currentThread()->isInterruptionRequested())
+        return ceres::SOLVER_ABORT;
+    int index = mReplayer.find(mParameterValues.data());
+    if (index < 0)
+        return ceres::SOLVER_CONTINUE;
+    OptimEvaluation const& item = mRecording.evaluations[index];
+    if (item.isValid && item.maxError < mRecording.maxRelError)
+    {
+        mIsConverged = true;
+        return ceres::SOLVER_TERMINATE_SUCCESSFULLY;
+    }
+    return ceres::SOLVER_CONTINUE;
+}
+
+//! Check if the replay was stopped by the tolerance of the frequency errors
+bool ReplayCallback::isConverged() const
+{
+    return mIsConverged;
+}
+
+//! Write the coefficients of the vector
+template<typename Vector>
+void writeVector(QDataStream& stream, Vector const& vector)
+{
+    qint32 size = vector.size();
+    stream << size;
+    for (int i = 0; i != size; ++i)
+        stream << vector[i];
+}
+
+//! Read the coefficients of the vector
+template<typename Vector>
+void readVector(QDataStream& stream, Vector& vector)
+{
+    qint32 size = 0;
+    stream >> size;
+    vector.resize(std::max(0, size));
+    for (int i = 0; i != size && stream.status() == QDataStream::Ok; ++i)
+        stream >> vector[i];
+}
@@ -0,0 +1,172 @@
+#ifndef OPTIMRECORDER_H
+#define OPTIMRECORDER_H
+
+#include <Eigen/Core>
+#include <ceres/ceres.h>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+
+#include <atomic>
+
+#include "aliasdata.h"
+
+namespace Backend::Core
+{
+
+struct OptimOptions;
+struct OptimTarget;
+
+//! Evaluation of the objective function at the point
+struct OptimEvaluation
+{
+    QList<double> parameters;
+    QList<double> residuals;
+    bool isValid;
+
+    //! Maximum relative error in frequencies, %
+    double maxError;
+};
+
+//! Point accepted by the optimizer
+struct OptimIterate
+{
+    int iteration;
+    double cost;
+    QList<double> parameters;
+};
+
+//! Data required to reproduce an optimization run without the model
+struct OptimRecording
+{
+    OptimRecording();
+    ~OptimRecording() = default;
+
+    bool isEmpty() const;
+    int numParameters() const;
+
+    bool read(QString const& pathFile);
+    bool write(QString const& pathFile) const;
+    static QString fileSuffix();
+
+    // Options
+    int maxNumIterations;
+    int numThreads;
+    double diffStepSize;
+    double minMAC;
+    double penaltyMAC;
+    int maxNumBroydenUpdates;
+    double minBroydenRatio;
+    double maxRelError;
+    int numSurrogateSamples;
+
+    // Parameters
+    QList<double> initParameters;
+    QList<double> scales;
+    QList<PairDouble> bounds;
+
+    // Target
+    Eigen::VectorXi indices;
+    Eigen::VectorXd frequencies;
+    Eigen::VectorXd weights;
+    int numResiduals;
+
+    // History
+    QList<OptimEvaluation> evaluations;
+    QList<OptimIterate> iterates;
+};
+
+//! Thread-safe recorder of the points evaluated by the optimizer
+class OptimRecorder
+{
+public:
+    OptimRecorder();
+    ~OptimRecorder() = default;
+
+    bool isEnabled() const;
+    void setEnabled(bool flag);
+
+    void start(OptimOptions const& options, QList<double> const& parameters, QList<double> const& scales, QList<PairDouble> const& bounds,
+               OptimTarget const& target, int numResiduals);
+    void recordEvaluation(double const* parameters, double const* residuals, bool isValid, double maxError);
+    void recordIterate(int iteration, double cost, QList<double> const& parameters);
+    void clear();
+
+    OptimRecording recording() const;
+
+private:
+    std::atomic<bool> mIsEnabled;
+    mutable QMutex mMutex;
+    OptimRecording mRecording;
+};
+
+//! Statistics of the optimization run against the recorded evaluations
+struct ReplayStatistics
+{
+    ReplayStatistics();
+    ~ReplayStatistics() = default;
+
+    QString toString() const;
+
+    int numEvaluations;
+    int numHits;
+    int numNearest;
+    int numMisses;
+    int numIterations;
+    bool isConverged;
+    double initCost;
+    double finalCost;
+    double duration;
+    bool isSuccess;
+    QString message;
+    QList<double> parameters;
+};
+
+//! Class to rerun the optimizer using the recorded evaluations instead of the eigen solutions
+class OptimReplayer
+{
+public:
+    OptimReplayer(OptimRecording const& recording, double radius = 0.0);
+    ~OptimReplayer() = default;
+
+    ceres::Solver::Options& options();
+    ReplayStatistics replay();
+
+    bool operator()(double const* const* parameters, double* residuals) const;
+    int find(double const* parameters) const;
+
+private:
+    int findNearest(double const* parameters) const;
+    static QByteArray key(double const* parameters, int numParameters);
+
+private:
+    OptimRecording const& mRecording;
+    double const mkRadius;
+    ceres::Solver::Options mOptions;
+    QHash<QByteArray, int> mIndices;
+    mutable std::atomic<int> mNumEvaluations;
+    mutable std::atomic<int> mNumHits;
+    mutable std::atomic<int> mNumNearest;
+    mutable std::atomic<int> mNumMisses;
+};
+
+//! Callback to stop the replay once the recorded errors at the accepted point satisfy the tolerance, as the solver does
+class ReplayCallback : public ceres::IterationCallback
+{
+public:
+    ReplayCallback(OptimReplayer const& replayer, OptimRecording const& recording, QList<double> const& parameters);
+    ~ReplayCallback() = default;
+
+    ceres::CallbackReturnType operator()(ceres::IterationSummary const& summary);
+    bool isConverged() const;
+
+private:
+    OptimReplayer const& mReplayer;
+    OptimRecording const& mRecording;
+    QList<double> const& mParameterValues;
+    bool mIsConverged;
+};
+}
+
+#endif // OPTIMRECORDER_H
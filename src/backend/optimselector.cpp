@@ -71,17 +71,19 @@ SelectionSet& OptimSelector::get(int index)
 //! Merge all the selection sets into one
 QList<Selection> OptimSelector::allSelections() const
 {
-    QMap<Selection, bool> mapSelections;
-    for (SelectionSet const& set : mSelectionSets)
-    {
-        auto setSelections = set.selections();
-        for (auto const [selection, flag] : setSelections.asKeyValueRange())
-        {
-            if (flag)
-                mapSelections[selection] = true;
-        }
-    }
-    return mapSelections.keys();
+    return united().selected();
+}
+
+//! Unite all the selection sets
+SelectionSet OptimSelector::united() const
+{
+    if (mSelectionSets.isEmpty())
+        return SelectionSet();
+    SelectionSet result = mSelectionSets.first();
+    int numSets = mSelectionSets.size();
+    for (int i = 1; i != numSets; ++i)
+        result.unite(mSelectionSets[i]);
+    return result;
 }
 
 //! Find a selection set by a name
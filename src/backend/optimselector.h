@@ -33,6 +33,7 @@ public:
     QList<Backend::Core::SelectionSet>& get();
     SelectionSet& get(int index);
     QList<Selection> allSelections() const;
+    SelectionSet united() const;
 
     int find(QString const& name) const;
     bool contains(QString const& name) const;
@@ -1,10 +1,12 @@
 #include <kcl/model.h>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QMutex>
 #include <QObject>
 #include <QThread>
+#include <QThreadPool>
 #include <QXmlStreamWriter>
 
-#include "constants.h"
 #include "fileutility.h"
 #include "mathutility.h"
 #include "optimsolver.h"
@@ -14,24 +16,41 @@ using namespace Backend::Core;
 using namespace KCL;
 
 QList<double> getStiffnessVector(SpringDamper const* pElement);
+double printComparison(QTextStream& stream, OptimTarget const& target, ModalSolution const& solution, ModalComparison const& comparison);
 
 ObjectiveFunctor::ObjectiveFunctor(OptimTarget const& target, OptimOptions const& options, UnwrapFun unwrapFun, SolverFun solverFun,
-                                   CompareFun compareFun)
+                                   CompareFun compareFun, OptimRecorder& recorder, EigenDeduplicator& deduplicator)
     : mTarget(target)
     , mOptions(options)
     , mUnwrapFun(unwrapFun)
     , mSolverFun(solverFun)
     , mCompareFun(compareFun)
+    , mRecorder(recorder)
+    , mDeduplicator(deduplicator)
 {
 }
 
-//! Compute the residuals
+//! Compute the residuals and record the evaluated point
 bool ObjectiveFunctor::operator()(double const* const* parameters, double* residuals) const
 {
-    Model model = mUnwrapFun(*parameters);
+    double maxError = 0.0;
+    bool isValid = evaluate(*parameters, residuals, maxError);
+    SolverMetrics::instance().addEvaluation();
+    mRecorder.recordEvaluation(*parameters, residuals, isValid, maxError);
+    return isValid;
+}
 
-    // Obtain the solution
-    ModalSolution solution = mSolverFun(model);
+//! Compute the residuals and the maximum relative error in frequencies
+bool ObjectiveFunctor::evaluate(double const* parameters, double* residuals, double& maxError) const
+{
+    // Obtain the solution, reusing the one computed at the same point
+    ModalSolution solution;
+    if (!mDeduplicator.find(parameters, solution))
+    {
+        Model model = mUnwrapFun(parameters);
+        solution = mSolverFun(model);
+        mDeduplicator.insert(parameters, solution);
+    }
     if (solution.isEmpty())
         return false;
 
@@ -41,31 +60,65 @@ bool ObjectiveFunctor::operator()(double const* const* parameters, double* resid
         return false;
 
     // Set the residuals
-    int numTargets = mTarget.indices.size();
+    setResiduals(mTarget, mOptions, comparison.errorFrequencies, comparison.errorsMAC, residuals);
+    maxError = ObjectiveFunctor::maxError(mTarget, comparison);
+    return true;
+}
+
+//! Combine the errors of the target modes into the residuals
+void ObjectiveFunctor::setResiduals(OptimTarget const& target, OptimOptions const& options, Eigen::VectorXd const& errorFrequencies,
+                                    Eigen::VectorXd const& errorsMAC, double* residuals)
+{
+    int numTargets = target.indices.size();
     int iResidual = 0;
     for (int i = 0; i != numTargets; ++i)
     {
-        double errorFrequency = comparison.errorFrequencies[i];
-        double errorMAC = comparison.errorsMAC[i];
-        double weight = mTarget.weights[i];
+        double errorFrequency = errorFrequencies[i];
+        double errorMAC = errorsMAC[i];
+        double weight = target.weights[i];
         if (weight > std::numeric_limits<double>::epsilon())
         {
-            residuals[iResidual] = weight * (std::pow(errorFrequency, 2.0) + mOptions.penaltyMAC * std::pow(errorMAC, 2.0));
+            residuals[iResidual] = weight * (std::pow(errorFrequency, 2.0) + options.penaltyMAC * std::pow(errorMAC, 2.0));
             ++iResidual;
         }
     }
+}
 
+//! Get the maximum relative error in frequencies of the target modes, %
+double ObjectiveFunctor::maxError(OptimTarget const& target, ModalComparison const& comparison)
+{
+    int numTargets = target.indices.size();
+    if (numTargets == 0)
+        return 0.0;
+    return comparison.errorFrequencies.head(numTargets).cwiseAbs().maxCoeff() * 100;
+}
+
+SurrogateFunctor::SurrogateFunctor(OptimTarget const& target, OptimOptions const& options, SurrogateModel const& model)
+    : mTarget(target)
+    , mOptions(options)
+    , mModel(model)
+{
+}
+
+//! Compute the residuals using the errors predicted by the surrogate model
+bool SurrogateFunctor::operator()(double const* const* parameters, double* residuals) const
+{
+    int numTargets = mTarget.indices.size();
+    Eigen::VectorXd outputs = mModel.evaluate(*parameters);
+    ObjectiveFunctor::setResiduals(mTarget, mOptions, outputs.head(numTargets), outputs.tail(numTargets), residuals);
     return true;
 }
 
 OptimCallback::OptimCallback(QList<double>& parameterValues, OptimTarget const& target, OptimOptions const& options, UnwrapFun unwrapFun,
-                             SolverFun solverFun, CompareFun compareFun)
+                             SolverFun solverFun, CompareFun compareFun, Profiler& profiler, EigenDeduplicator& deduplicator)
     : mParameterValues(parameterValues)
     , mTarget(target)
     , mOptions(options)
     , mUnwrapFun(unwrapFun)
     , mSolverFun(solverFun)
     , mCompareFun(compareFun)
+    , mProfiler(profiler)
+    , mDeduplicator(deduplicator)
 {
 }
 
@@ -75,10 +128,16 @@ ceres::CallbackReturnType OptimCallback::operator()(ceres::IterationSummary cons
     // Check if the user requested to stop the solver
     if (QThread::currentThread()->isInterruptionRequested())
         return ceres::SOLVER_ABORT;
+    ProfileTimer timer(mProfiler, "callback");
 
-    // Obtain the solution
+    // Obtain the solution, which has been usually computed while evaluating the Jacobian at the accepted point
     Model model = mUnwrapFun(mParameterValues.data());
-    ModalSolution modalSolution = mSolverFun(model);
+    ModalSolution modalSolution;
+    if (!mDeduplicator.find(mParameterValues.data(), modalSolution))
+    {
+        modalSolution = mSolverFun(model);
+        mDeduplicator.insert(mParameterValues.data(), modalSolution);
+    }
     if (modalSolution.isEmpty())
         return ceres::SOLVER_CONTINUE;
 
@@ -97,24 +156,7 @@ ceres::CallbackReturnType OptimCallback::operator()(ceres::IterationSummary cons
     stream << Qt::endl << Qt::endl;
 
     // Print the data
-    int numTargets = mTarget.indices.size();
-    auto constexpr dataFormat = "  {:^3d} {:^3d} {:^9.3f} {:^6.3g} {:^6.3g} {:10.2e}";
-    double maxError = 0;
-    for (int i = 0; i != numTargets; ++i)
-    {
-        int iTargetMode = mTarget.indices[i];
-        int iCurrentMode = modalComparison.pairs[i].first;
-        double MAC = modalComparison.pairs[i].second;
-        double targetFrequency = mTarget.solution.frequencies[i];
-        double currentFrequency = modalSolution.frequencies[iCurrentMode];
-        double error = modalComparison.errorFrequencies[i] * 100;
-        double weight = mTarget.weights[i];
-        maxError = std::max(maxError, std::abs(error));
-        stream << std::format(dataFormat, 1 + iTargetMode, 1 + iCurrentMode, MAC, currentFrequency, targetFrequency, error).c_str();
-        if (weight < std::numeric_limits<double>::epsilon())
-            stream << std::format("{:^10}", "skip").c_str();
-        stream << Qt::endl;
-    }
+    double maxError = printComparison(stream, mTarget, modalSolution, modalComparison);
 
     // Indicate that the iteration is finished
     OptimSolution solution;
@@ -125,7 +167,7 @@ ceres::CallbackReturnType OptimCallback::operator()(ceres::IterationSummary cons
     solution.model = model;
     solution.modalSolution = modalSolution;
     solution.modalComparison = modalComparison;
-    emit iterationFinished(solution);
+    emit iterationFinished(solution, mParameterValues);
     emit logRequested(message);
 
     if (maxError < mOptions.maxRelError)
@@ -142,6 +184,7 @@ OptimSolver::OptimSolver(OptimSolver const& another)
     , options(another.options)
     , solutions(another.solutions)
 {
+    resetProgress();
 }
 
 OptimSolver::OptimSolver(OptimSolver&& another)
@@ -150,6 +193,7 @@ OptimSolver::OptimSolver(OptimSolver&& another)
     problem = std::move(another.problem);
     options = std::move(another.options);
     solutions = std::move(another.solutions);
+    resetProgress();
 }
 
 OptimSolver& OptimSolver::operator=(OptimSolver const& another)
@@ -157,6 +201,7 @@ OptimSolver& OptimSolver::operator=(OptimSolver const& another)
     problem = another.problem;
     options = another.options;
     solutions = another.solutions;
+    resetProgress();
     return *this;
 }
 
@@ -174,22 +219,23 @@ ISolver* OptimSolver::clone() const
 
 void OptimSolver::clear()
 {
-    mInitModel = KCL::Model();
-    mSelections.clear();
-    mConstraints = OptimConstraints();
-    mParameterScales.clear();
-    mParameterBounds.clear();
-    log = QString();
+    mParametricModel = ParametricModel();
+    mRecorder.clear();
+    log.clear();
 }
 
 //! Perform the updating
 void OptimSolver::solve()
 {
+    TraceSpan span("solve", "optim");
+
     // Clear the previous solution
     clear();
 
     // Intialize the resulting set
     appendLog("Solver started\n");
+    mProfiler.reset();
+    mProgressChannel.clear();
     solutions.clear();
     solutions.reserve(options.maxNumIterations);
 
@@ -200,19 +246,12 @@ void OptimSolver::solve()
         return;
     }
 
-    // Initialize the fields
-    mInitModel = problem.model;
-    mSelections = problem.selector.allSelections();
-    mConstraints = problem.constraints;
-    mTarget = problem.target;
-
-    // Set the model parameters
+    // Wrap the model
     QString message;
     message.append("* Preparing the model parameters to be updated\n");
-    setModelParameters();
-
-    // Wrap the model
-    QList<double> parameterValues = wrapModel();
+    mTarget = problem.target;
+    mParametricModel = ParametricModel(problem.model, problem.selector, problem.constraints, options.numModes);
+    QList<double> parameterValues = mParametricModel.values();
     int numParameters = parameterValues.size();
     message.append(QString("Number of parameters: %1\n").arg(numParameters));
 
@@ -230,16 +269,28 @@ void OptimSolver::solve()
     UnwrapFun unwrapFun = [this, &numParameters](const double* const x)
     {
         QList<double> params(x, x + numParameters);
-        return unwrapModel(params);
+        return mParametricModel.unwrap(params, mProfiler);
     };
     SolverFun solverFun = [this](Model const& model)
     {
+        ProfileTimer timer(mProfiler, "solveEigen");
+        KernelScope kernel(SolverMetrics::kEigen);
         std::ostringstream stream;
         std::function<EigenSolution()> fun = [&model, &stream]() { return model.solveEigen(stream); };
         return Utility::solve(fun, options.timeoutIteration);
     };
-    CompareFun compareFun = [this](ModalSolution const& solution)
-    { return mTarget.solution.compare(solution, mTarget.indices, mTarget.matches, options.minMAC); };
+    ModalCandidates candidates(options.candidateBand, options.numCandidateNeighbors);
+    QMutex candidatesMutex;
+    CompareFun compareFun = [this, &candidates, &candidatesMutex](ModalSolution const& solution)
+    {
+        ProfileTimer timer(mProfiler, "compare");
+        ModalCandidates currentCandidates;
+        {
+            QMutexLocker locker(&candidatesMutex);
+            currentCandidates = candidates;
+        }
+        return mTarget.solution.compare(solution, mTarget.indices, mTarget.matches, options.minMAC, currentCandidates);
+    };
 
     // Set up the target solution and matches
     setTargetSolution(solverFun);
@@ -249,18 +300,35 @@ void OptimSolver::solve()
         return;
     }
     setTargetMatches();
+    mRecorder.start(options, parameterValues, mParametricModel.scales(), mParametricModel.bounds(), mTarget, numResiduals);
 
-    // Assign options to compute Jacobian
-    ceres::NumericDiffOptions diffOptions;
-    diffOptions.relative_step_size = options.diffStepSize;
+    // Follow the pairs of the accepted iterates only, since the trial points could be far from them
+    QMetaObject::Connection candidatesConnection = connect(
+        this, &OptimSolver::iterationFinished, this,
+        [&candidates, &candidatesMutex](OptimSolution const& solution)
+        {
+            if (!candidates.isEnabled() || !solution.modalComparison.isValid())
+                return;
+            QMutexLocker locker(&candidatesMutex);
+            candidates.previousPairs = solution.modalComparison.pairs;
+        },
+        Qt::DirectConnection);
+
+    // Optimize the surrogate model, if requested
+    if (options.numSurrogateSamples > 0)
+    {
+        solveSurrogate(parameterValues, unwrapFun, solverFun, compareFun, numResiduals);
+        disconnect(candidatesConnection);
+        emit solverFinished();
+        return;
+    }
 
     // Create the cost function
     appendLog("* Constructing the cost function\n");
-    ObjectiveFunctor functor(mTarget, options, unwrapFun, solverFun, compareFun);
-    auto* costFunction = new ceres::DynamicNumericDiffCostFunction<ObjectiveFunctor, ceres::FORWARD>(&functor, ceres::DO_NOT_TAKE_OWNERSHIP,
-                                                                                                     diffOptions);
-    costFunction->AddParameterBlock(numParameters);
-    costFunction->SetNumResiduals(numResiduals);
+    EigenDeduplicator deduplicator(numParameters);
+    ObjectiveFunctor functor(mTarget, options, unwrapFun, solverFun, compareFun, mRecorder, deduplicator);
+    ceres::CostFunction* costFunction = createCostFunction(functor, numParameters, numResiduals, options.diffStepSize,
+                                                           options.maxNumBroydenUpdates, options.minBroydenRatio);
 
     // Set the problem
     double* values = parameterValues.data();
@@ -270,536 +338,396 @@ void OptimSolver::solve()
     // Set the boundaries
     for (int i = 0; i != numParameters; ++i)
     {
-        PairDouble const& bounds = mParameterBounds[i];
+        PairDouble const& bounds = mParametricModel.bounds()[i];
         ceresProblem.SetParameterLowerBound(values, i, bounds.first);
         ceresProblem.SetParameterUpperBound(values, i, bounds.second);
     }
 
     // Assign the solver settings
-    ceres::Solver::Options ceresOptions;
-    ceresOptions.max_num_iterations = options.maxNumIterations;
-    ceresOptions.num_threads = options.numThreads;
-    ceresOptions.minimizer_type = ceres::TRUST_REGION;
-    ceresOptions.linear_solver_type = ceres::DENSE_QR;
-    ceresOptions.use_nonmonotonic_steps = true;
-    ceresOptions.logging_type = ceres::SILENT;
-    ceresOptions.minimizer_progress_to_stdout = false;
+    ceres::Solver::Options ceresOptions = solverOptions(options);
 
     // Set the callback functions
     ceresOptions.update_state_every_iteration = true;
-    OptimCallback callback(parameterValues, mTarget, options, unwrapFun, solverFun, compareFun);
-    connect(&callback, &OptimCallback::iterationFinished, this,
-            [this](OptimSolution solution)
-            {
-                solutions.push_back(solution);
-                emit iterationFinished(solution);
-            });
-    connect(&callback, &OptimCallback::logRequested, this, [this](QString const& message) { appendLog(message); });
+    // The callback is invoked by the thread running the solver, which could differ from the one owning the solver
+    OptimCallback callback(parameterValues, mTarget, options, unwrapFun, solverFun, compareFun, mProfiler, deduplicator);
+    connect(&callback, &OptimCallback::iterationFinished, this, &OptimSolver::finishIteration, Qt::DirectConnection);
+    connect(
+        &callback, &OptimCallback::logRequested, this,
+        [this](QString const& message) { appendLog(message, QtMsgType::QtInfoMsg, "iteration"); }, Qt::DirectConnection);
     ceresOptions.callbacks.push_back(&callback);
 
     // Solve the problem
     appendLog("* Running optimization process\n");
     ceres::Solver::Summary ceresSummary;
     ceres::Solve(ceresOptions, &ceresProblem, &ceresSummary);
+
+    // Add the phases measured by Ceres
+    mProfiler.record("residuals", ceresSummary.residual_evaluation_time_in_seconds, ceresSummary.num_residual_evaluations);
+    mProfiler.record("jacobian", ceresSummary.jacobian_evaluation_time_in_seconds, ceresSummary.num_jacobian_evaluations);
+    mProfiler.record("linearSolver", ceresSummary.linear_solver_time_in_seconds, ceresSummary.num_linear_solves);
+    mProfiler.count("dedupLookups", deduplicator.numLookups());
+    mProfiler.count("dedupHits", deduplicator.numHits());
+    if (auto pBroydenFunction = dynamic_cast<BroydenCostFunction*>(costFunction))
+    {
+        appendLog(QString("Jacobians computed by finite differences: %1, updated by Broyden's method: %2\n")
+                      .arg(pBroydenFunction->numRefreshes())
+                      .arg(pBroydenFunction->numUpdates()));
+        mProfiler.count("jacobianRefreshes", pBroydenFunction->numRefreshes());
+        mProfiler.count("broydenUpdates", pBroydenFunction->numUpdates());
+    }
     if (!solutions.empty())
     {
         OptimSolution& lastSolution = solutions.back();
         lastSolution.isSuccess = ceresSummary.IsSolutionUsable();
         lastSolution.message = ceresSummary.message.c_str();
+        if (mProfiler.isEnabled())
+            lastSolution.profile = mProfiler.report();
     }
     appendLog("Solver terminated successfully\n");
 
     // Log the report
-    printReport(ceresSummary);
+    printReport(ceresSummary, deduplicator);
 
+    disconnect(candidatesConnection);
     emit solverFinished();
 }
 
-//! Set the target modal solution (compute, if necessary)
-void OptimSolver::setTargetSolution(SolverFun solverFun)
+//! Minimize the response surface fitted to the true solutions within the trust region, which follows the best point found
+void OptimSolver::solveSurrogate(QList<double>& parameterValues, UnwrapFun unwrapFun, SolverFun solverFun, CompareFun compareFun,
+                                 int numResiduals)
 {
-    if (!mTarget.solution.isEmpty())
-        return;
-    appendLog("* Evaluating the target solution\n");
+    double const kMinRadius = 1e-4;
+    double const kMaxRadius = 1.0;
+    double const kMinStep = 1e-6;
+    double const kFitExtent = 2.0;
+    quint32 const kSeed = 0;
 
-    // Obtain the modal solution
-    mTarget.solution = solverFun(mInitModel);
-
-    // Distribute the target frequencies
-    int numModes = mTarget.solution.numModes();
+    int numParameters = parameterValues.size();
     int numTargets = mTarget.indices.size();
-    for (int i = 0; i != numTargets; ++i)
-    {
-        int iTarget = mTarget.indices[i];
-        if (iTarget >= 0 && iTarget < numModes)
-        {
-            mTarget.solution.frequencies[iTarget] = mTarget.frequencies[i];
-        }
-        else
-        {
-            appendLog("Could not set the target modal solution\n", QtMsgType::QtCriticalMsg);
-            break;
-        }
-    }
-}
+    QElapsedTimer totalTimer;
+    totalTimer.start();
 
-//! Set the target matches (fill, if necessary)
-void OptimSolver::setTargetMatches()
-{
-    if (!mTarget.matches.isEmpty())
-        return;
-
-    int numVertices = mTarget.solution.geometry.numVertices();
-    mTarget.matches.resize(numVertices);
-    for (int i = 0; i != numVertices; ++i)
-        mTarget.matches[i] = {i, i};
-}
-
-//! Set model parameters for further updating
-void OptimSolver::setModelParameters()
-{
-    auto pParameters = (AnalysisParameters*) mInitModel.specialSurface.element(KCL::WP);
-    pParameters->numLowModes = options.numModes;
-}
-
-//! Wrap the model parameters according to the constraints
-QList<double> OptimSolver::wrapModel()
-{
-    QList<double> parameterValues;
-
-    // Clear the previous parameters
-    mParameterScales.clear();
-    mParameterBounds.clear();
-
-    // Obtain the selected elements
-    auto surfaceElements = getSurfaceElements(mInitModel);
-
-    // Process the elastic surfaces
-    int numSurfaces = surfaceElements.size();
-    auto elementVariables = getElementVariables();
-    for (int iSurface = 0; iSurface != numSurfaces; ++iSurface)
+    // Create the function to obtain the true solutions at the points (one per row) concurrently
+    int numSolves = 0;
+    auto evaluateFun = [&](Eigen::MatrixXd const& points)
     {
-        if (!surfaceElements.contains(iSurface))
-            continue;
-        ElementMap const& elementMap = surfaceElements[iSurface];
-        QList<ElementType> types = elementMap.keys();
-        int numTypes = types.size();
-        for (int iType = 0; iType != numTypes; ++iType)
+        int numPoints = points.rows();
+        QList<SurrogateSample> samples(numPoints);
+        SurrogateSample* pSamples = samples.data();
+        QThreadPool pool;
+        pool.setMaxThreadCount(std::max(1, options.numThreads));
+        for (int i = 0; i != numPoints; ++i)
         {
-            ElementType type = types[iType];
-            QList<AbstractElement*> const& elements = elementMap[type];
-            if (elementVariables.contains(type))
-            {
-                QList<VariableType> const& variables = elementVariables[type];
-                int numVariables = variables.size();
-                for (int iVariable = 0; iVariable != numVariables; ++iVariable)
+            pool.start(
+                [&, i]()
                 {
-                    auto variable = variables[iVariable];
-                    MatrixXd properties = getProperties(elements, variable);
-                    wrapProperties(parameterValues, properties, variable);
-                }
-            }
+                    SurrogateSample& sample = pSamples[i];
+                    sample.parameters = points.row(i).transpose();
+                    double const* parameters = sample.parameters.data();
+                    QList<double> residuals(numResiduals, 0.0);
+                    Model model = unwrapFun(parameters);
+                    sample.modalSolution = solverFun(model);
+                    if (!sample.modalSolution.isEmpty())
+                        sample.modalComparison = compareFun(sample.modalSolution);
+                    bool isValid = !sample.modalSolution.isEmpty() && sample.modalComparison.isValid();
+                    double maxError = 0.0;
+                    if (isValid)
+                    {
+                        Eigen::VectorXd const& errorFrequencies = sample.modalComparison.errorFrequencies;
+                        Eigen::VectorXd const& errorsMAC = sample.modalComparison.errorsMAC;
+                        sample.outputs.resize(2 * numTargets);
+                        sample.outputs << errorFrequencies.head(numTargets), errorsMAC.head(numTargets);
+                        ObjectiveFunctor::setResiduals(mTarget, options, errorFrequencies, errorsMAC, residuals.data());
+                        sample.cost = 0.5 * Eigen::Map<Eigen::VectorXd>(residuals.data(), numResiduals).squaredNorm();
+                        maxError = ObjectiveFunctor::maxError(mTarget, sample.modalComparison);
+                    }
+                    SolverMetrics::instance().addEvaluation();
+                    mRecorder.recordEvaluation(parameters, residuals.data(), isValid, maxError);
+                });
         }
-    }
+        pool.waitForDone();
+        numSolves += numPoints;
+        return samples;
+    };
 
-    // Process the special surface
-    if (surfaceElements.contains(Constants::skISpecialSurface))
+    // Retain only the data required to fit the surrogate model
+    QList<SurrogateSample> history;
+    auto storeFun = [&history](SurrogateSample sample)
     {
-        ElementMap elementMap = surfaceElements[Constants::skISpecialSurface];
-        if (elementMap.contains(PR))
-        {
-            QList<AbstractElement*> const& elements = elementMap[PR];
-            int numElements = elements.size();
-            for (int iElement = 0; iElement != numElements; ++iElement)
-            {
-                SpringDamper* pElement = (SpringDamper*) elements[iElement];
-                QList<bool> mask;
-                MatrixXd properties = getProperties(pElement, mask);
-                wrapProperties(parameterValues, properties, VariableType::kSpringStiffness);
-            }
-        }
-    }
-    return parameterValues;
-}
-
-//! Unwrap the model parameters according to the constraints
-Model OptimSolver::unwrapModel(QList<double> const& parameterValues)
-{
-    int iParameter = -1;
-    Model model = mInitModel;
-
-    // Obtain the selected elements
-    auto surfaceElements = getSurfaceElements(model);
+        if (!sample.isValid())
+            return;
+        sample.modalSolution = ModalSolution();
+        sample.modalComparison = ModalComparison();
+        history.push_back(sample);
+    };
 
-    // Process the elastic surfaces
-    int numSurfaces = surfaceElements.size();
-    auto elementVariables = getElementVariables();
-    for (int iSurface = 0; iSurface != numSurfaces; ++iSurface)
+    // Evaluate the initial point
+    appendLog("* Evaluating the initial point\n");
+    Eigen::VectorXd center = Eigen::Map<Eigen::VectorXd>(parameterValues.data(), numParameters);
+    SurrogateSample best = evaluateFun(center.transpose()).first();
+    if (!best.isValid())
     {
-        if (!surfaceElements.contains(iSurface))
-            continue;
-        ElementMap& elementMap = surfaceElements[iSurface];
-        QList<ElementType> types = elementMap.keys();
-        int numTypes = types.size();
-        for (int iType = 0; iType != numTypes; ++iType)
-        {
-            ElementType type = types[iType];
-            QList<AbstractElement*>& elements = elementMap[type];
-            if (elementVariables.contains(type))
-            {
-                QList<VariableType> const& variables = elementVariables[type];
-                int numVariables = variables.size();
-                for (int iVariable = 0; iVariable != numVariables; ++iVariable)
-                {
-                    auto variable = variables[iVariable];
-                    MatrixXd initProperties = getProperties(elements, variable);
-                    MatrixXd properties = unwrapProperties(iParameter, parameterValues, initProperties, variable);
-                    setProperties(properties, elements, variable);
-                }
-            }
-        }
+        appendLog("Could not evaluate the initial point\n", QtMsgType::QtCriticalMsg);
+        return;
     }
+    storeFun(best);
+    double initCost = best.cost;
 
-    // Process the special surface
-    if (surfaceElements.contains(Constants::skISpecialSurface))
+    // Set the boundaries
+    Eigen::VectorXd lower(numParameters);
+    Eigen::VectorXd upper(numParameters);
+    for (int i = 0; i != numParameters; ++i)
     {
-        ElementMap elementMap = surfaceElements[Constants::skISpecialSurface];
-        if (elementMap.contains(PR))
-        {
-            QList<AbstractElement*> const& elements = elementMap[PR];
-            int numElements = elements.size();
-            for (int iElement = 0; iElement != numElements; ++iElement)
-            {
-                SpringDamper* pElement = (SpringDamper*) elements[iElement];
-                QList<bool> mask;
-                MatrixXd initProperties = getProperties(pElement, mask);
-                MatrixXd properties = unwrapProperties(iParameter, parameterValues, initProperties, VariableType::kSpringStiffness);
-                setProperties(properties, pElement, mask);
-            }
-        }
+        lower[i] = mParametricModel.bounds()[i].first;
+        upper[i] = mParametricModel.bounds()[i].second;
     }
 
-    // Check if all the parameters are processed
-    if (iParameter != parameterValues.size() - 1)
-        qWarning() << QObject::tr("Some parameters were not unwrapped during updating. Check the results carefully");
-    return model;
-}
-
-//! Retrieve element properties by indices
-MatrixXd OptimSolver::getProperties(QList<AbstractElement*> const& elements, VariableType type)
-{
-    MatrixXd result;
-    auto variableIndices = getVariableIndices();
-    if (mConstraints.isEnabled(type) && variableIndices.contains(type))
+    // Refine the surrogate model iteratively
+    appendLog("* Running surrogate optimization process\n");
+    double radius = options.surrogateRadius;
+    int numIterations = 0;
+    bool isConverged = false;
+    QString termination = tr("Maximum number of iterations reached");
+    for (int iteration = 0; iteration != options.maxNumIterations; ++iteration)
     {
-        QList<int> indices = variableIndices[type];
-        int numIndices = indices.size();
-        int numElements = elements.size();
-        result.resize(numElements, numIndices);
-        for (int i = 0; i != numElements; ++i)
+        // Check if the user requested to stop the solver
+        if (QThread::currentThread()->isInterruptionRequested())
         {
-            VecN values = elements[i]->get();
-            for (int j = 0; j != numIndices; ++j)
-                result(i, j) = values[indices[j]];
+            termination = tr("Interrupted by user");
+            break;
         }
-    }
-    return result;
-}
+        QElapsedTimer timer;
+        timer.start();
 
-//! Retrieve spring properties
-MatrixXd OptimSolver::getProperties(SpringDamper* pElement, QList<bool>& mask)
-{
-    MatrixXd result;
-    VariableType type = VariableType::kSpringStiffness;
+        // Set the trust region
+        Eigen::VectorXd scales = radius * center.cwiseAbs().cwiseMax(1.0);
+        Eigen::VectorXd regionLower = (center - scales).cwiseMax(lower);
+        Eigen::VectorXd regionUpper = (center + scales).cwiseMin(upper);
 
-    // Check if springs are enabled for updating
-    if (!mConstraints.isEnabled(type))
-        return result;
-
-    // Retrieve the stiffness matrix
-    auto stiffness = pElement->stiffness;
-    int numMat = stiffness.size();
-    int numValues = pElement->iSwitch;
-
-    // Slice the values
-    QList<double> values(numValues);
-    if (numValues == numMat)
-    {
-        for (int i = 0; i != numMat; ++i)
-            values[i] = stiffness[i][i];
-    }
-    else
-    {
-        int k = 0;
-        for (int i = 0; i != numMat; ++i)
+        // Complement the samples within the region by the design of experiments
+        int numInside = 0;
+        for (SurrogateSample const& sample : history)
         {
-            for (int j = 0; j != numMat; ++j)
-            {
-                values[k] = stiffness[i][j];
-                ++k;
-            }
+            if ((sample.parameters - center).cwiseQuotient(scales).lpNorm<Eigen::Infinity>() <= 1.0)
+                ++numInside;
+        }
+        int numDesign = options.numSurrogateSamples - numInside;
+        if (numDesign > 0)
+        {
+            ProfileTimer designTimer(mProfiler, "design");
+            Eigen::MatrixXd points = Utility::latinHypercube(numDesign, numParameters, kSeed + iteration);
+            points = points * (regionUpper - regionLower).asDiagonal();
+            points.rowwise() += regionLower.transpose();
+            for (SurrogateSample const& sample : evaluateFun(points))
+                storeFun(sample);
         }
-    }
 
-    // Build up the mask of stiffness values
-    PairDouble bounds = mConstraints.bounds(type);
-    mask.resize(numValues);
-    int numProperties = 0;
-    for (int i = 0; i != numValues; ++i)
-    {
-        double value = values[i];
-        bool flag = false;
-        if (value <= bounds.second)
+        // Fit the surrogate model to the samples around the region
+        SurrogateModel surrogate;
         {
-            if (mConstraints.isNonzero(type))
+            ProfileTimer fitTimer(mProfiler, "fit");
+            QList<int> indices;
+            int numSamples = history.size();
+            for (int i = 0; i != numSamples; ++i)
             {
-                if (value > std::numeric_limits<double>::epsilon())
-                    flag = true;
+                if ((history[i].parameters - center).cwiseQuotient(scales).lpNorm<Eigen::Infinity>() <= kFitExtent)
+                    indices.push_back(i);
             }
-            else
+            int numPoints = indices.size();
+            Eigen::MatrixXd points(numPoints, numParameters);
+            Eigen::MatrixXd values(numPoints, 2 * numTargets);
+            for (int i = 0; i != numPoints; ++i)
             {
-                flag = true;
+                points.row(i) = history[indices[i]].parameters.transpose();
+                values.row(i) = history[indices[i]].outputs.transpose();
+            }
+            if (!surrogate.fit(points, values, center, scales))
+            {
+                termination = tr("Surrogate model could not be fitted");
+                break;
             }
         }
-        if (flag)
-            ++numProperties;
-        mask[i] = flag;
-    }
 
-    // Slice the enabled values
-    result.resize(1, numProperties);
-    numProperties = 0;
-    for (int i = 0; i != numValues; ++i)
-    {
-        if (mask[i])
+        // Minimize the surrogate model within the region
+        Eigen::VectorXd candidate = center;
+        SurrogateFunctor functor(mTarget, options, surrogate);
+        ceres::Problem surrogateProblem;
+        surrogateProblem.AddResidualBlock(createCostFunction(functor, numParameters, numResiduals, options.diffStepSize, 0, 0.0), nullptr,
+                                          candidate.data());
+        for (int i = 0; i != numParameters; ++i)
         {
-            result(0, numProperties) = values[i];
-            ++numProperties;
+            surrogateProblem.SetParameterLowerBound(candidate.data(), i, regionLower[i]);
+            surrogateProblem.SetParameterUpperBound(candidate.data(), i, regionUpper[i]);
         }
-    }
-    return result;
-}
-
-//! Set element properties by indices
-void OptimSolver::setProperties(Eigen::MatrixXd const& properties, QList<AbstractElement*>& elements, VariableType type)
-{
-    auto variableIndices = getVariableIndices();
-    QList<int> indices = variableIndices[type];
-    int numIndices = indices.size();
-    int numElements = elements.size();
-    for (int i = 0; i != numElements; ++i)
-    {
-        VecN values = elements[i]->get();
-        for (int j = 0; j != numIndices; ++j)
-            values[indices[j]] = properties(i, j);
-        elements[i]->set(values);
-    }
-}
-
-//! Set spring properties by mask
-void OptimSolver::setProperties(Eigen::MatrixXd const& properties, SpringDamper* pElement, QList<bool> const& mask)
-{
-    Mat6x6& stiffness = pElement->stiffness;
-    int numMat = stiffness.size();
-    int iSlice = 0;
-    if (mask.size() == numMat)
-    {
-        for (int i = 0; i != numMat; ++i)
+        ceres::Solver::Summary surrogateSummary;
         {
-            if (mask[i])
-            {
-                stiffness[i][i] = properties(0, iSlice);
-                ++iSlice;
-            }
+            ProfileTimer minimizeTimer(mProfiler, "minimize");
+            ceres::Solve(solverOptions(options), &surrogateProblem, &surrogateSummary);
         }
-    }
-    else
-    {
-        int k = 0;
-        for (int i = 0; i != numMat; ++i)
+        double predictedCost = surrogateSummary.final_cost;
+
+        // Confirm the candidate by the true solution
+        double stepNorm = (candidate - center).cwiseQuotient(scales).lpNorm<Eigen::Infinity>();
+        double predictedReduction = best.cost - predictedCost;
+        double ratio = 0.0;
+        bool isAccepted = false;
+        if (stepNorm > kMinStep && predictedReduction > 0.0)
         {
-            for (int j = 0; j != numMat; ++j)
+            SurrogateSample sample = evaluateFun(candidate.transpose()).first();
+            storeFun(sample);
+            if (sample.isValid())
             {
-                if (mask[k])
+                ratio = (best.cost - sample.cost) / predictedReduction;
+                if (sample.cost < best.cost)
                 {
-                    stiffness[i][j] = properties(0, iSlice);
-                    ++iSlice;
+                    best = sample;
+                    center = candidate;
+                    isAccepted = true;
                 }
-                ++k;
             }
         }
-    }
-}
 
-//! Vectorize properties
-void OptimSolver::wrapProperties(QList<double>& parameterValues, Eigen::MatrixXd const& properties, VariableType type)
-{
-    // Check if there are any properties to vectorize
-    if (properties.size() == 0)
-        return;
+        // Update the trust region
+        if (ratio > 0.75 && stepNorm > 0.9)
+            radius = std::min(2.0 * radius, kMaxRadius);
+        else if (ratio < 0.25)
+            radius = 0.5 * radius;
 
-    // Acquire the state and constraints
-    bool isUnite = mConstraints.isUnited(type);
-    bool isMultiply = mConstraints.isMultiplied(type);
-    bool isNonzero = mConstraints.isNonzero(type);
-    double propertyScale = mConstraints.scale(type);
-    PairDouble propertyBounds = mConstraints.bounds(type);
-
-    // Find the indices of maximum valies
-    auto indices = Utility::rowIndicesAbsMax(properties);
-
-    // Slice property values
-    QList<double> values;
-    int numRows = properties.rows();
-    int numCols = properties.cols();
-    if (isUnite)
-    {
-        values.resize(numRows);
-        for (int i = 0; i != numRows; ++i)
-            values[i] = properties(i, indices[i]);
-    }
-    else if (isMultiply)
-    {
-        values.push_back(properties(0, indices[0]));
-    }
-    else
-    {
-        for (int i = 0; i != numRows; ++i)
+        // Print the iteration
+        QString message;
+        QTextStream stream(&message);
+        if (iteration == 0)
         {
-            for (int j = 0; j != numCols; ++j)
-            {
-                bool isInsert = true;
-                double value = properties(i, j);
-                if (isNonzero && std::abs(value) <= std::numeric_limits<double>::epsilon())
-                    isInsert = false;
-                if (isInsert)
-                    values.push_back(value);
-            }
+            stream << std::format("{:^8} {:>6} {:>11} {:>10} {:>10} {:>8}", "Iter", "Fun", "Pred", "Ratio", "Radius", "Solves").c_str();
+            stream << Qt::endl;
         }
-    }
-
-    // Duplicate scales and limits
-    int numValues = values.size();
-    QList<double> scales(numValues);
-    QList<PairDouble> bounds(numValues);
-    scales.fill(propertyScale);
-    bounds.fill(propertyBounds);
-
-    // Check if the logarithmic scale could be applied
-    for (int i = 0; i != numValues; ++i)
-    {
-        if (scales[i] == 0.0 && values[i] <= std::numeric_limits<double>::epsilon())
-            scales[i] = 1.0;
-    }
-
-    // Apply the scales
-    for (int i = 0; i != numValues; ++i)
-    {
-        double factor = scales[i];
-        if (factor != 0)
+        auto constexpr headFormat = "{:^7d} {:10.3e} {:10.3e} {:10.3e} {:10.3e} {:^8d}";
+        stream << std::format(headFormat, iteration, best.cost, predictedCost, ratio, radius, numSolves).c_str();
+        stream << Qt::endl << Qt::endl;
+        double maxError = printComparison(stream, mTarget, best.modalSolution, best.modalComparison);
+        appendLog(message, QtMsgType::QtInfoMsg, "iteration");
+
+        // Indicate that the iteration is finished
+        std::copy(center.begin(), center.end(), parameterValues.begin());
+        OptimSolution solution;
+        solution.iteration = iteration;
+        solution.isSuccess = isAccepted;
+        solution.duration = timer.nsecsElapsed() * 1e-9;
+        solution.cost = best.cost;
+        solution.model = unwrapFun(center.data());
+        solution.modalSolution = best.modalSolution;
+        solution.modalComparison = best.modalComparison;
+        finishIteration(solution, parameterValues);
+        ++numIterations;
+
+        // Check the termination criteria
+        if (maxError < options.maxRelError)
         {
-            values[i] *= factor;
-            bounds[i].first *= factor;
-            bounds[i].second *= factor;
+            isConverged = true;
+            termination = tr("Frequency errors are within the tolerance");
+            break;
         }
-        else
+        if (radius < kMinRadius)
         {
-            values[i] = log10(values[i]);
-            bounds[i].first = log10(bounds[i].first);
-            bounds[i].second = log10(bounds[i].second);
+            termination = tr("Trust region is too small");
+            break;
         }
     }
+    double duration = totalTimer.nsecsElapsed() * 1e-9;
+
+    // Set the final state
+    std::copy(center.begin(), center.end(), parameterValues.begin());
+    mProfiler.count("trueSolves", numSolves);
+    if (!solutions.empty())
+    {
+        OptimSolution& lastSolution = solutions.back();
+        if (isConverged)
+            lastSolution.isSuccess = true;
+        lastSolution.message = termination;
+        if (mProfiler.isEnabled())
+            lastSolution.profile = mProfiler.report();
+    }
+    appendLog("Solver terminated successfully\n");
+
+    // Log the report
+    QString message;
+    QTextStream stream(&message);
+    stream << tr("Surrogate Optimization Report") << Qt::endl;
+    stream << tr("-> Iterations:   %1").arg(numIterations) << Qt::endl;
+    stream << tr("-> True solves:  %1").arg(numSolves) << Qt::endl;
+    stream << tr("-> Initial cost: %1").arg(QString::number(initCost, 'e', 3)) << Qt::endl;
+    stream << tr("-> Final cost:   %1").arg(QString::number(best.cost, 'e', 3)) << Qt::endl;
+    stream << tr("-> Duration:     %1 s").arg(QString::number(duration, 'f', 3)) << Qt::endl;
+    stream << tr("-> Termination:  %1").arg(termination) << Qt::endl;
+    if (mProfiler.isEnabled())
+        stream << Qt::endl << tr("Profile") << Qt::endl << mProfiler.report().toString();
+    appendLog(message, QtMsgType::QtInfoMsg, "report");
+}
+
+//! Store the solution obtained at the end of the iteration and notify the listeners
+void OptimSolver::finishIteration(OptimSolution solution, QList<double> const& parameterValues)
+{
+    if (mProfiler.isEnabled())
+        solution.profile = mProfiler.report();
+    mRecorder.recordIterate(solution.iteration, solution.cost, parameterValues);
+    SolverMetrics::instance().addIteration();
+    solutions.push_back(solution);
+    mProgressChannel.post(SolverProgress(solution));
+    emit iterationFinished(solution);
+}
 
-    // Append the result
-    parameterValues = Utility::combine(parameterValues, values);
-    mParameterScales = Utility::combine(mParameterScales, scales);
-    mParameterBounds = Utility::combine(mParameterBounds, bounds);
+//! Replace the delivered progress by the one of the solutions computed before
+void OptimSolver::resetProgress()
+{
+    int numSolutions = solutions.size();
+    QList<SolverProgress> progresses(numSolutions);
+    for (int i = 0; i != numSolutions; ++i)
+        progresses[i] = SolverProgress(solutions[i]);
+    mProgressChannel.setHistory(progresses);
 }
 
-//! Unwrap properties from a vector
-MatrixXd OptimSolver::unwrapProperties(int& iParameter, QList<double> const& parameterValues, MatrixXd const& initProperties, VariableType type)
+//! Set the target modal solution (compute, if necessary)
+void OptimSolver::setTargetSolution(SolverFun solverFun)
 {
-    MatrixXd properties = initProperties;
-
-    // Check if there are any variables to slice
-    if (properties.size() == 0)
-        return properties;
-
-    // Acquire the state and constraints
-    bool isUnite = mConstraints.isUnited(type);
-    bool isMultiply = mConstraints.isMultiplied(type);
-    bool isNonzero = mConstraints.isNonzero(type);
-
-    // Find the indices of maximum valies
-    auto indices = Utility::rowIndicesAbsMax(properties);
-
-    // Slice property values
-    int numRows = properties.rows();
-    int numCols = properties.cols();
-    int iStart = iParameter + 1;
-    int iEnd;
-    if (isUnite)
+    if (!mTarget.solution.isEmpty())
+        return;
+    appendLog("* Evaluating the target solution\n");
+
+    // Obtain the modal solution
+    mTarget.solution = solverFun(mParametricModel.initModel());
+
+    // Distribute the target frequencies
+    int numModes = mTarget.solution.numModes();
+    int numTargets = mTarget.indices.size();
+    for (int i = 0; i != numTargets; ++i)
     {
-        int numValues = numRows;
-        iEnd = iParameter + numValues;
-        for (int i = 0; i != numValues; ++i)
+        int iTarget = mTarget.indices[i];
+        if (iTarget >= 0 && iTarget < numModes)
         {
-            double scale = mParameterScales[iStart + i];
-            double value = parameterValues[iStart + i];
-            if (scale != 0)
-                value /= scale;
-            else
-                value = std::pow(10, value);
-            double factor = value / properties(i, indices(i));
-            for (int j = 0; j != numCols; ++j)
-                properties(i, j) *= factor;
+            mTarget.solution.frequencies[iTarget] = mTarget.frequencies[i];
         }
-    }
-    else if (isMultiply)
-    {
-        iEnd = iStart;
-        double scale = mParameterScales[iEnd];
-        double value = parameterValues[iEnd];
-        if (scale != 0)
-            value /= scale;
         else
-            value = std::pow(10, value);
-        double factor = value / properties(0, indices(0));
-        properties *= factor;
-    }
-    else
-    {
-        int numValues = numRows * numCols;
-        iEnd = iParameter + numValues;
-        int k = 0;
-        for (int i = 0; i != numRows; ++i)
         {
-            for (int j = 0; j != numCols; ++j)
-            {
-                bool isInsert = true;
-                if (isNonzero && std::abs(initProperties(i, j)) <= std::numeric_limits<double>::epsilon())
-                    isInsert = false;
-                if (isInsert)
-                {
-                    double scale = mParameterScales[iStart + k];
-                    double value = parameterValues[iStart + k];
-                    if (scale != 0)
-                        value /= scale;
-                    else
-                        value = std::pow(10, value);
-                    properties(i, j) = value;
-                    ++k;
-                }
-            }
+            appendLog("Could not set the target modal solution\n", QtMsgType::QtCriticalMsg);
+            break;
         }
     }
-    iParameter = iEnd;
+}
 
-    return properties;
+//! Set the target matches (fill, if necessary)
+void OptimSolver::setTargetMatches()
+{
+    if (!mTarget.matches.isEmpty())
+        return;
+
+    int numVertices = mTarget.solution.geometry.numVertices();
+    mTarget.matches.resize(numVertices);
+    for (int i = 0; i != numVertices; ++i)
+        mTarget.matches[i] = {i, i};
 }
 
 //! Output the report to log
-void OptimSolver::printReport(ceres::Solver::Summary const& summary)
+void OptimSolver::printReport(ceres::Solver::Summary const& summary, EigenDeduplicator const& deduplicator)
 {
     QString message;
     QTextStream stream(&message);
@@ -809,60 +737,19 @@ void OptimSolver::printReport(ceres::Solver::Summary const& summary)
     stream << tr("-> Final cost:   %1").arg(QString::number(summary.final_cost, 'e', 3)) << Qt::endl;
     stream << tr("-> Duration:     %1 s").arg(QString::number(summary.total_time_in_seconds, 'f', 3)) << Qt::endl;
     stream << tr("-> Termination:  %1").arg(ceres::TerminationTypeToString(summary.termination_type)) << Qt::endl;
-    appendLog(message);
+    stream << tr("-> Reused modes: %1 of %2").arg(deduplicator.numHits()).arg(deduplicator.numLookups()) << Qt::endl;
+    if (mProfiler.isEnabled())
+        stream << Qt::endl << tr("Profile") << Qt::endl << mProfiler.report().toString();
+    appendLog(message, QtMsgType::QtInfoMsg, "report");
 }
 
 //! Add a message to a log
-void OptimSolver::appendLog(QString const& message, QtMsgType type)
+void OptimSolver::appendLog(QString const& message, QtMsgType type, QString const& category)
 {
-    Utility::appendLog(log, message, type);
+    log.append(message, type, category);
     emit logAppended(message);
 }
 
-//! Retrieve surface elements
-QMap<int, ElementMap> OptimSolver::getSurfaceElements(Model& model)
-{
-    QMap<int, ElementMap> result;
-    int numSelections = mSelections.size();
-    for (int i = 0; i != numSelections; ++i)
-    {
-        Selection const& selection = mSelections[i];
-        AbstractElement* pElement = nullptr;
-        if (selection.iSurface == Constants::skISpecialSurface)
-            pElement = model.specialSurface.element(selection.type, selection.iElement);
-        else
-            pElement = model.surfaces[selection.iSurface].element(selection.type, selection.iElement);
-        if (pElement)
-            result[selection.iSurface][selection.type].push_back(pElement);
-    }
-    return result;
-}
-
-//! Retrieve indices of variable associated data of elements
-QMap<VariableType, QList<int>> OptimSolver::getVariableIndices()
-{
-    QMap<VariableType, QList<int>> result;
-    result[VariableType::kBeamStiffness] = {4, 5, 6, 7};
-    result[VariableType::kYoungsModulus1] = {12};
-    result[VariableType::kYoungsModulus2] = {17};
-    result[VariableType::kShearModulus] = {14};
-    result[VariableType::kPoissonRatio] = {13};
-    return result;
-}
-
-//! Retrieve a group of variables associated with an element
-QMap<ElementType, QList<VariableType>> OptimSolver::getElementVariables()
-{
-    QMap<ElementType, QList<VariableType>> result;
-    result[BI] = {VariableType::kBeamStiffness};
-    result[DB] = {VariableType::kBeamStiffness};
-    result[BK] = {VariableType::kBeamStiffness};
-    result[PN] = {VariableType::kThickness, VariableType::kYoungsModulus1, VariableType::kPoissonRatio};
-    result[OP] = {VariableType::kThickness, VariableType::kYoungsModulus1, VariableType::kYoungsModulus2, VariableType::kShearModulus,
-                  VariableType::kPoissonRatio};
-    return result;
-}
-
 void OptimSolver::serialize(QXmlStreamWriter& stream, QString const& elementName) const
 {
     stream.writeStartElement(elementName);
@@ -872,7 +759,7 @@ void OptimSolver::serialize(QXmlStreamWriter& stream, QString const& elementName
     problem.serialize(stream, "problem");
     options.serialize(stream, "options");
     Utility::serialize(stream, "solutions", "solution", solutions);
-    Utility::serialize(stream, "log", log);
+    log.serialize(stream, "log");
     stream.writeEndElement();
 }
 
@@ -891,10 +778,11 @@ void OptimSolver::deserialize(QXmlStreamReader& stream)
         else if (stream.name() == "solutions")
             Utility::deserialize(stream, "solution", solutions);
         else if (stream.name() == "log")
-            Utility::deserialize(stream, log);
+            log.deserialize(stream);
         else
             stream.skipCurrentElement();
     }
+    resetProgress();
 }
 
 bool OptimSolver::operator==(ISolver const* pBaseSolver) const
@@ -910,6 +798,61 @@ bool OptimSolver::operator!=(ISolver const* pBaseSolver) const
     return !(*this == pBaseSolver);
 }
 
+//! Get the channel which delivers the progress of iterations
+SolverProgressChannel& OptimSolver::progressChannel()
+{
+    return mProgressChannel;
+}
+
+//! Estimate the number of bytes held by the solver, including the copies of the problem data
+MemoryUsage OptimSolver::memoryUsage() const
+{
+    MemoryUsage result;
+
+    // Problem
+    result.models = Utility::numBytes(problem.model) + Utility::numBytes(mParametricModel.initModel());
+    result.modeShapes = Utility::numBytes(problem.target.solution.modeShapes) + Utility::numBytes(mTarget.solution.modeShapes);
+    result.other = Utility::numBytes(problem.target.solution, false) + Utility::numBytes(mTarget.solution, false);
+
+    // Iterations
+    result.solutions = solutions.capacity() * sizeof(OptimSolution);
+    for (OptimSolution const& solution : solutions)
+    {
+        result.solutions += Utility::numBytes(solution.model) + Utility::numBytes(solution.modalSolution);
+        result.solutions += Utility::numBytes(solution.modalComparison) + Utility::numBytes(solution.message);
+    }
+
+    // Log
+    result.logs = log.numBytes();
+    return result;
+}
+
+//! Get the profiler which accumulates the durations of the solver phases
+Profiler& OptimSolver::profiler()
+{
+    return mProfiler;
+}
+
+//! Retrieve the recorder of evaluated points. Recording is enabled by the environment variable MODUS_RECORD
+OptimRecorder& OptimSolver::recorder()
+{
+    return mRecorder;
+}
+
+//! Create the settings of the trust region solver
+ceres::Solver::Options OptimSolver::solverOptions(OptimOptions const& options)
+{
+    ceres::Solver::Options result;
+    result.max_num_iterations = options.maxNumIterations;
+    result.num_threads = options.numThreads;
+    result.minimizer_type = ceres::TRUST_REGION;
+    result.linear_solver_type = ceres::DENSE_QR;
+    result.use_nonmonotonic_steps = true;
+    result.logging_type = ceres::SILENT;
+    result.minimizer_progress_to_stdout = false;
+    return result;
+}
+
 OptimTarget::OptimTarget()
 {
 }
@@ -1027,6 +970,12 @@ OptimOptions::OptimOptions()
     , penaltyMAC(0.1)
     , maxRelError(1e-3)
     , numModes(20)
+    , maxNumBroydenUpdates(0)
+    , minBroydenRatio(0.25)
+    , candidateBand(0.0)
+    , numCandidateNeighbors(2)
+    , numSurrogateSamples(0)
+    , surrogateRadius(0.1)
 {
 }
 
@@ -1075,6 +1024,8 @@ void OptimSolution::serialize(QXmlStreamWriter& stream, QString const& elementNa
     modalSolution.serialize(stream, "modalSolution");
     modalComparison.serialize(stream, "modalComparison");
     stream.writeTextElement("message", message);
+    if (!profile.isEmpty())
+        profile.serialize(stream, "profile");
     stream.writeEndElement();
 }
 
@@ -1094,7 +1045,33 @@ void OptimSolution::deserialize(QXmlStreamReader& stream)
             modalComparison.deserialize(stream);
         else if (stream.name() == "message")
             message = stream.readElementText();
+        else if (stream.name() == "profile")
+            profile.deserialize(stream);
         else
             stream.skipCurrentElement();
     }
 }
+
+//! Helper function to print the target modes paired with the current ones. Returns the maximum relative error in frequencies, %
+double printComparison(QTextStream& stream, OptimTarget const& target, ModalSolution const& solution, ModalComparison const& comparison)
+{
+    int numTargets = target.indices.size();
+    auto constexpr dataFormat = "  {:^3d} {:^3d} {:^9.3f} {:^6.3g} {:^6.3g} {:10.2e}";
+    double maxError = 0;
+    for (int i = 0; i != numTargets; ++i)
+    {
+        int iTargetMode = target.indices[i];
+        int iCurrentMode = comparison.pairs[i].first;
+        double MAC = comparison.pairs[i].second;
+        double targetFrequency = target.solution.frequencies[i];
+        double currentFrequency = solution.frequencies[iCurrentMode];
+        double error = comparison.errorFrequencies[i] * 100;
+        double weight = target.weights[i];
+        maxError = std::max(maxError, std::abs(error));
+        stream << std::format(dataFormat, 1 + iTargetMode, 1 + iCurrentMode, MAC, currentFrequency, targetFrequency, error).c_str();
+        if (weight < std::numeric_limits<double>::epsilon())
+            stream << std::format("{:^10}", "skip").c_str();
+        stream << Qt::endl;
+    }
+    return maxError;
+}
@@ -5,10 +5,19 @@
 #include <ceres/ceres.h>
 #include <kcl/model.h>
 
+#include "broydencostfunction.h"
+#include "eigendeduplicator.h"
 #include "isolver.h"
 #include "modalsolver.h"
 #include "optimconstraints.h"
+#include "optimrecorder.h"
 #include "optimselector.h"
+#include "parametricstudy.h"
+#include "profiler.h"
+#include "solverlog.h"
+#include "solvermetrics.h"
+#include "solverprogress.h"
+#include "surrogatemodel.h"
 
 namespace KCL
 {
@@ -21,7 +30,6 @@ namespace Backend::Core
 using UnwrapFun = std::function<KCL::Model(const double* const)>;
 using SolverFun = std::function<KCL::EigenSolution(KCL::Model const&)>;
 using CompareFun = std::function<ModalComparison(ModalSolution const& solution)>;
-using ElementMap = QMap<KCL::ElementType, QList<KCL::AbstractElement*>>;
 
 struct OptimTarget : public ISerializable
 {
@@ -105,6 +113,12 @@ struct OptimOptions : public ISerializable
     Q_PROPERTY(double penaltyMAC MEMBER penaltyMAC)
     Q_PROPERTY(double maxRelError MEMBER maxRelError)
     Q_PROPERTY(int numModes MEMBER numModes)
+    Q_PROPERTY(int maxNumBroydenUpdates MEMBER maxNumBroydenUpdates)
+    Q_PROPERTY(double minBroydenRatio MEMBER minBroydenRatio)
+    Q_PROPERTY(double candidateBand MEMBER candidateBand)
+    Q_PROPERTY(int numCandidateNeighbors MEMBER numCandidateNeighbors)
+    Q_PROPERTY(int numSurrogateSamples MEMBER numSurrogateSamples)
+    Q_PROPERTY(double surrogateRadius MEMBER surrogateRadius)
 
 public:
     OptimOptions();
@@ -139,6 +153,24 @@ public:
 
     //! Number of modes to compute
     int numModes;
+
+    //! Maximum number of sequential rank-one updates of the Jacobian between finite-difference ones (zero to disable)
+    int maxNumBroydenUpdates;
+
+    //! Minimum ratio of the actual and predicted cost reductions to keep updating the Jacobian
+    double minBroydenRatio;
+
+    //! Relative frequency band of the modes to be paired with the target ones (zero to compare all the modes)
+    double candidateBand;
+
+    //! Number of modes around the previously paired one to be compared as well
+    int numCandidateNeighbors;
+
+    //! Number of true solutions to fit the surrogate model within the trust region (zero to optimize the true model)
+    int numSurrogateSamples;
+
+    //! Initial half-width of the trust region relative to the parameter values
+    double surrogateRadius;
 };
 
 struct OptimSolution : public ISerializable
@@ -171,6 +203,7 @@ public:
     ModalSolution modalSolution;
     ModalComparison modalComparison;
     QString message;
+    ProfileReport profile;
 };
 
 class OptimSolver : public QObject, public ISolver
@@ -179,7 +212,7 @@ class OptimSolver : public QObject, public ISolver
     Q_PROPERTY(OptimProblem problem MEMBER problem)
     Q_PROPERTY(OptimOptions options MEMBER options)
     Q_PROPERTY(QList<OptimSolution> solutions MEMBER solutions)
-    Q_PROPERTY(QString log MEMBER log)
+    Q_PROPERTY(Backend::Core::SolverLog log MEMBER log)
 
 public:
     OptimSolver();
@@ -194,6 +227,7 @@ public:
 
     void clear() override;
     void solve() override;
+    MemoryUsage memoryUsage() const override;
 
     void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
     void deserialize(QXmlStreamReader& stream) override;
@@ -201,70 +235,86 @@ public:
     bool operator==(ISolver const* pBaseSolver) const override;
     bool operator!=(ISolver const* pBaseSolver) const override;
 
+    SolverProgressChannel& progressChannel();
+    Profiler& profiler();
+    OptimRecorder& recorder();
+
+    static ceres::Solver::Options solverOptions(OptimOptions const& options);
+
 signals:
     void solverFinished();
     void iterationFinished(Backend::Core::OptimSolution solution);
     void logAppended(QString message);
 
 private:
+    // Optimize
+    void solveSurrogate(QList<double>& parameterValues, UnwrapFun unwrapFun, SolverFun solverFun, CompareFun compareFun, int numResiduals);
+    void finishIteration(OptimSolution solution, QList<double> const& parameterValues);
+    void resetProgress();
+
     // Process targets
     void setTargetSolution(SolverFun solverFun);
     void setTargetMatches();
 
-    // Process model
-    void setModelParameters();
-    QList<double> wrapModel();
-    KCL::Model unwrapModel(QList<double> const& paramValues);
-
-    // Process properties
-    Eigen::MatrixXd getProperties(QList<KCL::AbstractElement*> const& elements, VariableType type);
-    Eigen::MatrixXd getProperties(KCL::SpringDamper* pElement, QList<bool>& mask);
-    void setProperties(Eigen::MatrixXd const& properties, QList<KCL::AbstractElement*>& elements, VariableType type);
-    void setProperties(Eigen::MatrixXd const& properties, KCL::SpringDamper* pElement, QList<bool> const& mask);
-    void wrapProperties(QList<double>& parameterValues, Eigen::MatrixXd const& properties, VariableType type);
-    Eigen::MatrixXd unwrapProperties(int& iParameter, QList<double> const& parameterValues, Eigen::MatrixXd const& initProperties,
-                                     VariableType type);
-
     // Logging
-    void printReport(ceres::Solver::Summary const& summary);
-    void appendLog(QString const& message, QtMsgType type = QtMsgType::QtInfoMsg);
-
-    // Slicing
-    QMap<int, ElementMap> getSurfaceElements(KCL::Model& model);
-    QMap<VariableType, QList<int>> getVariableIndices();
-    QMap<KCL::ElementType, QList<VariableType>> getElementVariables();
+    void printReport(ceres::Solver::Summary const& summary, EigenDeduplicator const& deduplicator);
+    void appendLog(QString const& message, QtMsgType type = QtMsgType::QtInfoMsg, QString const& category = QString());
 
 public:
     QString name;
     OptimProblem problem;
     OptimOptions options;
     QList<OptimSolution> solutions;
-    QString log;
+    SolverLog log;
 
 private:
-    KCL::Model mInitModel;
-    QList<Selection> mSelections;
-    OptimConstraints mConstraints;
-    QList<double> mParameterScales;
-    QList<PairDouble> mParameterBounds;
+    ParametricModel mParametricModel;
     OptimTarget mTarget;
+    SolverProgressChannel mProgressChannel;
+    Profiler mProfiler;
+    OptimRecorder mRecorder;
 };
 
 //! Functor to compute residuals
 class ObjectiveFunctor
 {
 public:
-    ObjectiveFunctor(OptimTarget const& target, OptimOptions const& options, UnwrapFun unwrapFun, SolverFun solverFun, CompareFun compareFun);
+    ObjectiveFunctor(OptimTarget const& target, OptimOptions const& options, UnwrapFun unwrapFun, SolverFun solverFun, CompareFun compareFun,
+                     OptimRecorder& recorder, EigenDeduplicator& deduplicator);
     ~ObjectiveFunctor() = default;
 
     bool operator()(double const* const* parameters, double* residuals) const;
 
+    static void setResiduals(OptimTarget const& target, OptimOptions const& options, Eigen::VectorXd const& errorFrequencies,
+                             Eigen::VectorXd const& errorsMAC, double* residuals);
+    static double maxError(OptimTarget const& target, ModalComparison const& comparison);
+
+private:
+    bool evaluate(double const* parameters, double* residuals, double& maxError) const;
+
 private:
     OptimTarget const& mTarget;
     OptimOptions const& mOptions;
     UnwrapFun mUnwrapFun;
     SolverFun mSolverFun;
     CompareFun mCompareFun;
+    OptimRecorder& mRecorder;
+    EigenDeduplicator& mDeduplicator;
+};
+
+//! Functor to compute residuals predicted by the surrogate model
+class SurrogateFunctor
+{
+public:
+    SurrogateFunctor(OptimTarget const& target, OptimOptions const& options, SurrogateModel const& model);
+    ~SurrogateFunctor() = default;
+
+    bool operator()(double const* const* parameters, double* residuals) const;
+
+private:
+    OptimTarget const& mTarget;
+    OptimOptions const& mOptions;
+    SurrogateModel const& mModel;
 };
 
 //! Functor to be called after every optimization iteration
@@ -274,13 +324,13 @@ class OptimCallback : public QObject, public ceres::IterationCallback
 
 public:
     OptimCallback(QList<double>& parameters, OptimTarget const& target, OptimOptions const& options, UnwrapFun unwrapFun, SolverFun solverFun,
-                  CompareFun compareFun);
+                  CompareFun compareFun, Profiler& profiler, EigenDeduplicator& deduplicator);
     ~OptimCallback() = default;
 
     ceres::CallbackReturnType operator()(ceres::IterationSummary const& summary);
 
 signals:
-    void iterationFinished(Backend::Core::OptimSolution solution);
+    void iterationFinished(Backend::Core::OptimSolution solution, QList<double> parameterValues);
     void logRequested(QString message);
 
 private:
@@ -290,6 +340,8 @@ private:
     UnwrapFun mUnwrapFun;
     SolverFun mSolverFun;
     CompareFun mCompareFun;
+    Profiler& mProfiler;
+    EigenDeduplicator& mDeduplicator;
 };
 }
 
@@ -0,0 +1,607 @@
+#include <QDebug>
+#include <QObject>
+#include <QThreadPool>
+
+#include "constants.h"
+#include "mathutility.h"
+#include "parametricstudy.h"
+#include "solvermetrics.h"
+
+using namespace Backend;
+using namespace Backend::Core;
+using namespace KCL;
+
+ParametricModel::ParametricModel()
+{
+}
+
+//! Wrap the properties of the selected elements according to the constraints
+ParametricModel::ParametricModel(KCL::Model const& model, OptimSelector const& selector, OptimConstraints const& constraints,
+                                 int numModes)
+    : mInitModel(model)
+    , mSelections(selector.allSelections())
+    , mConstraints(constraints)
+{
+    setModelParameters(numModes);
+    wrapModel();
+}
+
+int ParametricModel::numParameters() const
+{
+    return mValues.size();
+}
+
+//! Get the model which the parameters are applied to
+KCL::Model const& ParametricModel::initModel() const
+{
+    return mInitModel;
+}
+
+//! Get the parameter values of the initial model
+QList<double> const& ParametricModel::values() const
+{
+    return mValues;
+}
+
+//! Get the scales of the parameters, which are zero for the ones varied logarithmically
+QList<double> const& ParametricModel::scales() const
+{
+    return mScales;
+}
+
+//! Get the bounds of the parameters, so that the solver does not leave the feasible region
+QList<PairDouble> const& ParametricModel::bounds() const
+{
+    return mBounds;
+}
+
+QList<VariableType> const& ParametricModel::types() const
+{
+    return mTypes;
+}
+
+//! Create the model associated with the parameter values, measuring the duration
+KCL::Model ParametricModel::unwrap(QList<double> const& values, Profiler& profiler) const
+{
+    ProfileTimer timer(profiler, "unwrapModel");
+    return unwrap(values);
+}
+
+//! Set model parameters for further updating
+void ParametricModel::setModelParameters(int numModes)
+{
+    auto pParameters = (AnalysisParameters*) mInitModel.specialSurface.element(KCL::WP);
+    pParameters->numLowModes = numModes;
+}
+
+//! Wrap the model parameters according to the constraints
+void ParametricModel::wrapModel()
+{
+    QList<double> parameterValues;
+
+    // Clear the previous parameters
+    mScales.clear();
+    mBounds.clear();
+    mTypes.clear();
+
+    // Obtain the selected elements
+    auto surfaceElements = getSurfaceElements(mInitModel);
+
+    // Process the elastic surfaces
+    int numSurfaces = surfaceElements.size();
+    auto elementVariables = getElementVariables();
+    for (int iSurface = 0; iSurface != numSurfaces; ++iSurface)
+    {
+        if (!surfaceElements.contains(iSurface))
+            continue;
+        ElementMap const& elementMap = surfaceElements[iSurface];
+        QList<ElementType> types = elementMap.keys();
+        int numTypes = types.size();
+        for (int iType = 0; iType != numTypes; ++iType)
+        {
+            ElementType type = types[iType];
+            QList<AbstractElement*> const& elements = elementMap[type];
+            if (elementVariables.contains(type))
+            {
+                QList<VariableType> const& variables = elementVariables[type];
+                int numVariables = variables.size();
+                for (int iVariable = 0; iVariable != numVariables; ++iVariable)
+                {
+                    auto variable = variables[iVariable];
+                    MatrixXd properties = getProperties(elements, variable);
+                    wrapProperties(parameterValues, properties, variable);
+                }
+            }
+        }
+    }
+
+    // Process the special surface
+    if (surfaceElements.contains(Constants::skISpecialSurface))
+    {
+        ElementMap elementMap = surfaceElements[Constants::skISpecialSurface];
+        if (elementMap.contains(PR))
+        {
+            QList<AbstractElement*> const& elements = elementMap[PR];
+            int numElements = elements.size();
+            for (int iElement = 0; iElement != numElements; ++iElement)
+            {
+                SpringDamper* pElement = (SpringDamper*) elements[iElement];
+                QList<bool> mask;
+                MatrixXd properties = getProperties(pElement, mask);
+                wrapProperties(parameterValues, properties, VariableType::kSpringStiffness);
+            }
+        }
+    }
+    mValues = parameterValues;
+}
+
+//! Create the model associated with the parameter values. It could be called concurrently
+Model ParametricModel::unwrap(QList<double> const& parameterValues) const
+{
+    int iParameter = -1;
+    Model model = mInitModel;
+
+    // Obtain the selected elements
+    auto surfaceElements = getSurfaceElements(model);
+
+    // Process the elastic surfaces
+    int numSurfaces = surfaceElements.size();
+    auto elementVariables = getElementVariables();
+    for (int iSurface = 0; iSurface != numSurfaces; ++iSurface)
+    {
+        if (!surfaceElements.contains(iSurface))
+            continue;
+        ElementMap& elementMap = surfaceElements[iSurface];
+        QList<ElementType> types = elementMap.keys();
+        int numTypes = types.size();
+        for (int iType = 0; iType != numTypes; ++iType)
+        {
+            ElementType type = types[iType];
+            QList<AbstractElement*>& elements = elementMap[type];
+            if (elementVariables.contains(type))
+            {
+                QList<VariableType> const& variables = elementVariables[type];
+                int numVariables = variables.size();
+                for (int iVariable = 0; iVariable != numVariables; ++iVariable)
+                {
+                    auto variable = variables[iVariable];
+                    MatrixXd initProperties = getProperties(elements, variable);
+                    MatrixXd properties = unwrapProperties(iParameter, parameterValues, initProperties, variable);
+                    setProperties(properties, elements, variable);
+                }
+            }
+        }
+    }
+
+    // Process the special surface
+    if (surfaceElements.contains(Constants::skISpecialSurface))
+    {
+        ElementMap elementMap = surfaceElements[Constants::skISpecialSurface];
+        if (elementMap.contains(PR))
+        {
+            QList<AbstractElement*> const& elements = elementMap[PR];
+            int numElements = elements.size();
+            for (int iElement = 0; iElement != numElements; ++iElement)
+            {
+                SpringDamper* pElement = (SpringDamper*) elements[iElement];
+                QList<bool> mask;
+                MatrixXd initProperties = getProperties(pElement, mask);
+                MatrixXd properties = unwrapProperties(iParameter, parameterValues, initProperties, VariableType::kSpringStiffness);
+                setProperties(properties, pElement, mask);
+            }
+        }
+    }
+
+    // Check if all the parameters are processed
+    if (iParameter != parameterValues.size() - 1)
+        qWarning() << QObject::tr("Some parameters were not unwrapped during updating. Check the results carefully");
+    return model;
+}
+
+//! Retrieve element properties by indices
+MatrixXd ParametricModel::getProperties(QList<AbstractElement*> const& elements, VariableType type) const
+{
+    MatrixXd result;
+    auto variableIndices = getVariableIndices();
+    if (mConstraints.isEnabled(type) && variableIndices.contains(type))
+    {
+        QList<int> indices = variableIndices[type];
+        int numIndices = indices.size();
+        int numElements = elements.size();
+        result.resize(numElements, numIndices);
+        for (int i = 0; i != numElements; ++i)
+        {
+            VecN values = elements[i]->get();
+            for (int j = 0; j != numIndices; ++j)
+                result(i, j) = values[indices[j]];
+        }
+    }
+    return result;
+}
+
+//! Retrieve spring properties
+MatrixXd ParametricModel::getProperties(SpringDamper* pElement, QList<bool>& mask) const
+{
+    MatrixXd result;
+    VariableType type = VariableType::kSpringStiffness;
+
+    // Check if springs are enabled for updating
+    if (!mConstraints.isEnabled(type))
+        return result;
+
+    // Retrieve the stiffness matrix
+    auto stiffness = pElement->stiffness;
+    int numMat = stiffness.size();
+    int numValues = pElement->iSwitch;
+
+    // Slice the values
+    QList<double> values(numValues);
+    if (numValues == numMat)
+    {
+        for (int i = 0; i != numMat; ++i)
+            values[i] = stiffness[i][i];
+    }
+    else
+    {
+        int k = 0;
+        for (int i = 0; i != numMat; ++i)
+        {
+            for (int j = 0; j != numMat; ++j)
+            {
+                values[k] = stiffness[i][j];
+                ++k;
+            }
+        }
+    }
+
+    // Build up the mask of stiffness values
+    PairDouble bounds = mConstraints.bounds(type);
+    mask.resize(numValues);
+    int numProperties = 0;
+    for (int i = 0; i != numValues; ++i)
+    {
+        double value = values[i];
+        bool flag = false;
+        if (value <= bounds.second)
+        {
+            if (mConstraints.isNonzero(type))
+            {
+                if (value > std::numeric_limits<double>::epsilon())
+                    flag = true;
+            }
+            else
+            {
+                flag = true;
+            }
+        }
+        if (flag)
+            ++numProperties;
+        mask[i] = flag;
+    }
+
+    // Slice the enabled values
+    result.resize(1, numProperties);
+    numProperties = 0;
+    for (int i = 0; i != numValues; ++i)
+    {
+        if (mask[i])
+        {
+            result(0, numProperties) = values[i];
+            ++numProperties;
+        }
+    }
+    return result;
+}
+
+//! Set element properties by indices
+void ParametricModel::setProperties(Eigen::MatrixXd const& properties, QList<AbstractElement*>& elements, VariableType type) const
+{
+    auto variableIndices = getVariableIndices();
+    QList<int> indices = variableIndices[type];
+    int numIndices = indices.size();
+    int numElements = elements.size();
+    for (int i = 0; i != numElements; ++i)
+    {
+        VecN values = elements[i]->get();
+        for (int j = 0; j != numIndices; ++j)
+            values[indices[j]] = properties(i, j);
+        elements[i]->set(values);
+    }
+}
+
+//! Set spring properties by mask
+void ParametricModel::setProperties(Eigen::MatrixXd const& properties, SpringDamper* pElement, QList<bool> const& mask) const
+{
+    Mat6x6& stiffness = pElement->stiffness;
+    int numMat = stiffness.size();
+    int iSlice = 0;
+    if (mask.size() == numMat)
+    {
+        for (int i = 0; i != numMat; ++i)
+        {
+            if (mask[i])
+            {
+                stiffness[i][i] = properties(0, iSlice);
+                ++iSlice;
+            }
+        }
+    }
+    else
+    {
+        int k = 0;
+        for (int i = 0; i != numMat; ++i)
+        {
+            for (int j = 0; j != numMat; ++j)
+            {
+                if (mask[k])
+                {
+                    stiffness[i][j] = properties(0, iSlice);
+                    ++iSlice;
+                }
+                ++k;
+            }
+        }
+    }
+}
+
+//! Vectorize properties
+void ParametricModel::wrapProperties(QList<double>& parameterValues, Eigen::MatrixXd const& properties, VariableType type)
+{
+    // Check if there are any properties to vectorize
+    if (properties.size() == 0)
+        return;
+
+    // Acquire the state and constraints
+    bool isUnite = mConstraints.isUnited(type);
+    bool isMultiply = mConstraints.isMultiplied(type);
+    bool isNonzero = mConstraints.isNonzero(type);
+    double propertyScale = mConstraints.scale(type);
+    PairDouble propertyBounds = mConstraints.bounds(type);
+
+    // Find the indices of maximum valies
+    auto indices = Utility::rowIndicesAbsMax(properties);
+
+    // Slice property values
+    QList<double> values;
+    int numRows = properties.rows();
+    int numCols = properties.cols();
+    if (isUnite)
+    {
+        values.resize(numRows);
+        for (int i = 0; i != numRows; ++i)
+            values[i] = properties(i, indices[i]);
+    }
+    else if (isMultiply)
+    {
+        values.push_back(properties(0, indices[0]));
+    }
+    else
+    {
+        for (int i = 0; i != numRows; ++i)
+        {
+            for (int j = 0; j != numCols; ++j)
+            {
+                bool isInsert = true;
+                double value = properties(i, j);
+                if (isNonzero && std::abs(value) <= std::numeric_limits<double>::epsilon())
+                    isInsert = false;
+                if (isInsert)
+                    values.push_back(value);
+            }
+        }
+    }
+
+    // Duplicate scales and limits
+    int numValues = values.size();
+    QList<double> scales(numValues);
+    QList<PairDouble> bounds(numValues);
+    scales.fill(propertyScale);
+    bounds.fill(propertyBounds);
+
+    // Check if the logarithmic scale could be applied
+    for (int i = 0; i != numValues; ++i)
+    {
+        if (scales[i] == 0.0 && values[i] <= std::numeric_limits<double>::epsilon())
+            scales[i] = 1.0;
+    }
+
+    // Apply the scales
+    for (int i = 0; i != numValues; ++i)
+    {
+        double factor = scales[i];
+        if (factor != 0)
+        {
+            values[i] *= factor;
+            bounds[i].first *= factor;
+            bounds[i].second *= factor;
+        }
+        else
+        {
+            values[i] = log10(values[i]);
+            bounds[i].first = log10(bounds[i].first);
+            bounds[i].second = log10(bounds[i].second);
+        }
+    }
+
+    // Append the result
+    parameterValues = Utility::combine(parameterValues, values);
+    mScales = Utility::combine(mScales, scales);
+    mBounds = Utility::combine(mBounds, bounds);
+    mTypes.append(QList<VariableType>(numValues, type));
+}
+
+//! Unwrap properties from a vector
+MatrixXd ParametricModel::unwrapProperties(int& iParameter, QList<double> const& parameterValues, MatrixXd const& initProperties,
+                                           VariableType type) const
+{
+    MatrixXd properties = initProperties;
+
+    // Check if there are any variables to slice
+    if (properties.size() == 0)
+        return properties;
+
+    // Acquire the state and constraints
+    bool isUnite = mConstraints.isUnited(type);
+    bool isMultiply = mConstraints.isMultiplied(type);
+    bool isNonzero = mConstraints.isNonzero(type);
+
+    // Find the indices of maximum valies
+    auto indices = Utility::rowIndicesAbsMax(properties);
+
+    // Slice property values
+    int numRows = properties.rows();
+    int numCols = properties.cols();
+    int iStart = iParameter + 1;
+    int iEnd;
+    if (isUnite)
+    {
+        int numValues = numRows;
+        iEnd = iParameter + numValues;
+        for (int i = 0; i != numValues; ++i)
+        {
+            double scale = mScales[iStart + i];
+            double value = parameterValues[iStart + i];
+            if (scale != 0)
+                value /= scale;
+            else
+                value = std::pow(10, value);
+            double factor = value / properties(i, indices(i));
+            for (int j = 0; j != numCols; ++j)
+                properties(i, j) *= factor;
+        }
+    }
+    else if (isMultiply)
+    {
+        iEnd = iStart;
+        double scale = mScales[iEnd];
+        double value = parameterValues[iEnd];
+        if (scale != 0)
+            value /= scale;
+        else
+            value = std::pow(10, value);
+        double factor = value / properties(0, indices(0));
+        properties *= factor;
+    }
+    else
+    {
+        int numValues = numRows * numCols;
+        iEnd = iParameter + numValues;
+        int k = 0;
+        for (int i = 0; i != numRows; ++i)
+        {
+            for (int j = 0; j != numCols; ++j)
+            {
+                bool isInsert = true;
+                if (isNonzero && std::abs(initProperties(i, j)) <= std::numeric_limits<double>::epsilon())
+                    isInsert = false;
+                if (isInsert)
+                {
+                    double scale = mScales[iStart + k];
+                    double value = parameterValues[iStart + k];
+                    if (scale != 0)
+                        value /= scale;
+                    else
+                        value = std::pow(10, value);
+                    properties(i, j) = value;
+                    ++k;
+                }
+            }
+        }
+    }
+    iParameter = iEnd;
+
+    return properties;
+}
+
+//! Retrieve surface elements
+QMap<int, ElementMap> ParametricModel::getSurfaceElements(Model& model) const
+{
+    QMap<int, ElementMap> result;
+    int numSelections = mSelections.size();
+    for (int i = 0; i != numSelections; ++i)
+    {
+        Selection const& selection = mSelections[i];
+        AbstractElement* pElement = nullptr;
+        if (selection.iSurface == Constants::skISpecialSurface)
+            pElement = model.specialSurface.element(selection.type, selection.iElement);
+        else
+            pElement = model.surfaces[selection.iSurface].element(selection.type, selection.iElement);
+        if (pElement)
+            result[selection.iSurface][selection.type].push_back(pElement);
+    }
+    return result;
+}
+
+//! Retrieve indices of variable associated data of elements
+QMap<VariableType, QList<int>> ParametricModel::getVariableIndices() const
+{
+    QMap<VariableType, QList<int>> result;
+    result[VariableType::kBeamStiffness] = {4, 5, 6, 7};
+    result[VariableType::kYoungsModulus1] = {12};
+    result[VariableType::kYoungsModulus2] = {17};
+    result[VariableType::kShearModulus] = {14};
+    result[VariableType::kPoissonRatio] = {13};
+    return result;
+}
+
+//! Retrieve a group of variables associated with an element
+QMap<ElementType, QList<VariableType>> ParametricModel::getElementVariables() const
+{
+    QMap<ElementType, QList<VariableType>> result;
+    result[BI] = {VariableType::kBeamStiffness};
+    result[DB] = {VariableType::kBeamStiffness};
+    result[BK] = {VariableType::kBeamStiffness};
+    result[PN] = {VariableType::kThickness, VariableType::kYoungsModulus1, VariableType::kPoissonRatio};
+    result[OP] = {VariableType::kThickness, VariableType::kYoungsModulus1, VariableType::kYoungsModulus2, VariableType::kShearModulus,
+                  VariableType::kPoissonRatio};
+    return result;
+}
+
+namespace Backend::Core
+{
+
+//! Obtain the modal solution, counting it as an evaluation
+ModalSolution solveModal(KCL::Model const& model, double timeout, Profiler& profiler)
+{
+    ProfileTimer timer(profiler, "solveEigen");
+    KernelScope kernel(SolverMetrics::kEigen);
+    std::ostringstream stream;
+    std::function<KCL::EigenSolution()> fun = [&model, &stream]() { return model.solveEigen(stream); };
+    ModalSolution result = Utility::solve(fun, timeout);
+    SolverMetrics::instance().addEvaluation();
+    return result;
+}
+
+//! Obtain the flutter solution, counting it as an evaluation
+FlutterSolution solveFlutter(KCL::Model const& model, double timeout, Profiler& profiler)
+{
+    ProfileTimer timer(profiler, "solveFlutter");
+    KernelScope kernel(SolverMetrics::kFlutter);
+    std::ostringstream stream;
+    std::function<KCL::FlutterSolution()> fun = [&model, &stream]() { return model.solveFlutter(stream); };
+    FlutterSolution result = Utility::solve(fun, timeout);
+    SolverMetrics::instance().addEvaluation();
+    return result;
+}
+
+//! Run the tasks indexed from zero using the thread budget and wait until all of them are finished
+void runConcurrently(int numTasks, int numThreads, std::function<void(int)> const& task)
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(std::max(1, numThreads));
+    for (int i = 0; i != numTasks; ++i)
+        pool.start([&task, i]() { task(i); });
+    pool.waitForDone();
+}
+
+//! Retrieve the critical values of the lowest flutter boundary, leaving the values unchanged if there is none
+void setCritData(FlutterSolution const& solution, double& critFlow, double& critSpeed, double& critFrequency)
+{
+    int iCrit = solution.findLowestCrit();
+    if (iCrit < 0)
+        return;
+    critFlow = solution.critFlow[iCrit];
+    critSpeed = solution.critSpeed[iCrit];
+    critFrequency = solution.critFrequency[iCrit];
+}
+}
@@ -0,0 +1,70 @@
+#ifndef PARAMETRICSTUDY_H
+#define PARAMETRICSTUDY_H
+
+#include <kcl/model.h>
+
+#include "fluttersolver.h"
+#include "modalsolver.h"
+#include "optimconstraints.h"
+#include "optimselector.h"
+#include "profiler.h"
+
+namespace Backend::Core
+{
+
+using ElementMap = QMap<KCL::ElementType, QList<KCL::AbstractElement*>>;
+
+//! Model varied by the parameters, which are wrapped from the properties of the selected elements according to the constraints
+class ParametricModel
+{
+public:
+    ParametricModel();
+    ParametricModel(KCL::Model const& model, OptimSelector const& selector, OptimConstraints const& constraints, int numModes);
+    ~ParametricModel() = default;
+
+    int numParameters() const;
+    KCL::Model const& initModel() const;
+    QList<double> const& values() const;
+    QList<double> const& scales() const;
+    QList<PairDouble> const& bounds() const;
+    QList<VariableType> const& types() const;
+
+    KCL::Model unwrap(QList<double> const& values) const;
+    KCL::Model unwrap(QList<double> const& values, Profiler& profiler) const;
+
+private:
+    // Process model
+    void setModelParameters(int numModes);
+    void wrapModel();
+
+    // Process properties
+    Eigen::MatrixXd getProperties(QList<KCL::AbstractElement*> const& elements, VariableType type) const;
+    Eigen::MatrixXd getProperties(KCL::SpringDamper* pElement, QList<bool>& mask) const;
+    void setProperties(Eigen::MatrixXd const& properties, QList<KCL::AbstractElement*>& elements, VariableType type) const;
+    void setProperties(Eigen::MatrixXd const& properties, KCL::SpringDamper* pElement, QList<bool> const& mask) const;
+    void wrapProperties(QList<double>& parameterValues, Eigen::MatrixXd const& properties, VariableType type);
+    Eigen::MatrixXd unwrapProperties(int& iParameter, QList<double> const& parameterValues, Eigen::MatrixXd const& initProperties,
+                                     VariableType type) const;
+
+    // Slicing
+    QMap<int, ElementMap> getSurfaceElements(KCL::Model& model) const;
+    QMap<VariableType, QList<int>> getVariableIndices() const;
+    QMap<KCL::ElementType, QList<VariableType>> getElementVariables() const;
+
+private:
+    KCL::Model mInitModel;
+    QList<Selection> mSelections;
+    OptimConstraints mConstraints;
+    QList<double> mValues;
+    QList<double> mScales;
+    QList<PairDouble> mBounds;
+    QList<VariableType> mTypes;
+};
+
+ModalSolution solveModal(KCL::Model const& model, double timeout, Profiler& profiler);
+FlutterSolution solveFlutter(KCL::Model const& model, double timeout, Profiler& profiler);
+void runConcurrently(int numTasks, int numThreads, std::function<void(int)> const& task);
+void setCritData(FlutterSolution const& solution, double& critFlow, double& critSpeed, double& critFrequency);
+}
+
+#endif // PARAMETRICSTUDY_H
@@ -0,0 +1,210 @@
+#include <QObject>
+#include <QTextStream>
+
+#include <format>
+
+#include "fileutility.h"
+#include "profiler.h"
+
+using namespace Backend;
+using namespace Backend::Core;
+
+ProfilePhase::ProfilePhase()
+    : count(0)
+    , duration(0.0)
+    , maxDuration(0.0)
+{
+}
+
+ProfilePhase::ProfilePhase(QString const& aName)
+    : name(aName)
+    , count(0)
+    , duration(0.0)
+    , maxDuration(0.0)
+{
+}
+
+void ProfilePhase::serialize(QXmlStreamWriter& stream, QString const& elementName) const
+{
+    stream.writeStartElement(elementName);
+    stream.writeAttribute("name", name);
+    stream.writeAttribute("count", QString::number(count));
+    stream.writeAttribute("duration", Utility::toString(duration));
+    stream.writeAttribute("maxDuration", Utility::toString(maxDuration));
+    stream.writeEndElement();
+}
+
+void ProfilePhase::deserialize(QXmlStreamReader& stream)
+{
+    name = stream.attributes().value("name").toString();
+    count = stream.attributes().value("count").toLongLong();
+    duration = stream.attributes().value("duration").toDouble();
+    maxDuration = stream.attributes().value("maxDuration").toDouble();
+    stream.skipCurrentElement();
+}
+
+ProfileReport::ProfileReport()
+    : duration(0.0)
+{
+}
+
+bool ProfileReport::isEmpty() const
+{
+    return phases.isEmpty();
+}
+
+//! Find the phase by name (returns an empty phase, if not found)
+ProfilePhase ProfileReport::phase(QString const& name) const
+{
+    for (ProfilePhase const& item : phases)
+    {
+        if (item.name == name)
+            return item;
+    }
+    return ProfilePhase(name);
+}
+
+//! Format the breakdown as a table
+QString ProfileReport::toString() const
+{
+    QString result;
+    QTextStream stream(&result);
+    stream << std::format("{:<16} {:>8} {:>11} {:>10} {:>10} {:>7}", "Phase", "Count", "Total, ms", "Mean, ms", "Max, ms", "Share").c_str();
+    stream << Qt::endl;
+    for (ProfilePhase const& item : phases)
+    {
+        std::string name = item.name.toStdString();
+        if (item.duration > 0.0)
+        {
+            double total = 1e3 * item.duration;
+            double mean = item.count > 0 ? total / item.count : 0.0;
+            double share = duration > 0.0 ? 100.0 * item.duration / duration : 0.0;
+            std::string max = item.maxDuration > 0.0 ? std::format("{:.3f}", 1e3 * item.maxDuration) : "-";
+            auto constexpr format = "{:<16} {:>8d} {:>11.2f} {:>10.3f} {:>10} {:>6.1f}%";
+            stream << std::format(format, name, item.count, total, mean, max, share).c_str();
+        }
+        else
+        {
+            stream << std::format("{:<16} {:>8d} {:>11} {:>10} {:>10} {:>7}", name, item.count, "-", "-", "-", "-").c_str();
+        }
+        stream << Qt::endl;
+    }
+    stream << QObject::tr("Wall time: %1 ms").arg(QString::number(1e3 * duration, 'f', 2)) << Qt::endl;
+    return result;
+}
+
+void ProfileReport::serialize(QXmlStreamWriter& stream, QString const& elementName) const
+{
+    stream.writeStartElement(elementName);
+    stream.writeAttribute("duration", Utility::toString(duration));
+    for (ProfilePhase const& item : phases)
+        item.serialize(stream, "phase");
+    stream.writeEndElement();
+}
+
+void ProfileReport::deserialize(QXmlStreamReader& stream)
+{
+    duration = stream.attributes().value("duration").toDouble();
+    phases.clear();
+    while (stream.readNextStartElement())
+    {
+        if (stream.name() == "phase")
+        {
+            ProfilePhase item;
+            item.deserialize(stream);
+            phases.push_back(item);
+        }
+        else
+        {
+            stream.skipCurrentElement();
+        }
+    }
+}
+
+Profiler::Profiler(bool isEnabled)
+    : mIsEnabled(isEnabled)
+{
+    mTimer.start();
+}
+
+bool Profiler::isEnabled() const
+{
+    return mIsEnabled.load(std::memory_order_relaxed);
+}
+
+//! Switch the recording on or off. Disabled profiler reduces timers to a single check
+void Profiler::setEnabled(bool isEnabled)
+{
+    mIsEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+//! Accumulate the duration of the phase in seconds (thread-safe). The duration of several calls does not affect the maximum one
+void Profiler::record(char const* name, double duration, qint64 count)
+{
+    if (!isEnabled())
+        return;
+    QMutexLocker locker(&mMutex);
+    ProfilePhase& item = findPhase(name);
+    item.count += count;
+    item.duration += duration;
+    if (count == 1)
+        item.maxDuration = std::max(item.maxDuration, duration);
+}
+
+//! Increment the counter of events (thread-safe)
+void Profiler::count(char const* name, qint64 increment)
+{
+    if (!isEnabled())
+        return;
+    QMutexLocker locker(&mMutex);
+    findPhase(name).count += increment;
+}
+
+//! Take the snapshot of the phases recorded since the last reset
+ProfileReport Profiler::report() const
+{
+    ProfileReport result;
+    QMutexLocker locker(&mMutex);
+    result.duration = mTimer.nsecsElapsed() * 1e-9;
+    result.phases = mPhases;
+    return result;
+}
+
+//! Remove all the phases and restart the wall clock
+void Profiler::reset()
+{
+    QMutexLocker locker(&mMutex);
+    mPhases.clear();
+    mTimer.restart();
+}
+
+//! Find the phase by name or create a new one, so that the name is converted only once
+ProfilePhase& Profiler::findPhase(char const* name)
+{
+    QLatin1StringView key(name);
+    for (ProfilePhase& item : mPhases)
+    {
+        if (item.name == key)
+            return item;
+    }
+    mPhases.push_back(ProfilePhase(key));
+    return mPhases.last();
+}
+
+ProfileTimer::ProfileTimer(Profiler& profiler, char const* name)
+    : mpProfiler(nullptr)
+    , mName(name)
+    , mSpan(name, "solver")
+{
+    if (profiler.isEnabled())
+    {
+        mpProfiler = &profiler;
+        mTimer.start();
+    }
+}
+
+ProfileTimer::~ProfileTimer()
+{
+    if (mpProfiler)
+        mpProfiler->record(mName, mTimer.nsecsElapsed() * 1e-9);
+}
@@ -0,0 +1,100 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+
+#include <atomic>
+
+#include "iserializable.h"
+#include "tracer.h"
+
+namespace Backend::Core
+{
+
+//! Accumulated statistics of a profiled phase
+struct ProfilePhase : public ISerializable
+{
+    ProfilePhase();
+    ProfilePhase(QString const& aName);
+    virtual ~ProfilePhase() = default;
+
+    void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
+    void deserialize(QXmlStreamReader& stream) override;
+
+    //! Name of the phase
+    QString name;
+
+    //! Number of calls or counted events
+    qint64 count;
+
+    //! Total duration in seconds (zero for counters)
+    double duration;
+
+    //! Maximum duration of a single call in seconds (zero, if only aggregated durations have been recorded)
+    double maxDuration;
+};
+
+//! Breakdown of the phases of a solver run
+struct ProfileReport : public ISerializable
+{
+    ProfileReport();
+    virtual ~ProfileReport() = default;
+
+    bool isEmpty() const;
+    ProfilePhase phase(QString const& name) const;
+    QString toString() const;
+
+    void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
+    void deserialize(QXmlStreamReader& stream) override;
+
+    //! Wall time of the run in seconds
+    double duration;
+
+    //! Phases ordered by their first occurrence
+    QList<ProfilePhase> phases;
+};
+
+//! Thread-safe accumulator of scoped timings and counters
+class Profiler
+{
+public:
+    Profiler(bool isEnabled = false);
+    ~Profiler() = default;
+
+    bool isEnabled() const;
+    void setEnabled(bool isEnabled);
+
+    void record(char const* name, double duration, qint64 count = 1);
+    void count(char const* name, qint64 increment = 1);
+
+    ProfileReport report() const;
+    void reset();
+
+private:
+    ProfilePhase& findPhase(char const* name);
+
+private:
+    std::atomic<bool> mIsEnabled;
+    mutable QMutex mMutex;
+    QList<ProfilePhase> mPhases;
+    QElapsedTimer mTimer;
+};
+
+//! Timer which records the duration of the enclosing scope to the profiler and tracer
+class ProfileTimer
+{
+public:
+    ProfileTimer(Profiler& profiler, char const* name);
+    ~ProfileTimer();
+
+private:
+    Profiler* mpProfiler;
+    char const* mName;
+    QElapsedTimer mTimer;
+    TraceSpan mSpan;
+};
+}
+
+#endif // PROFILER_H
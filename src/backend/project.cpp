@@ -3,6 +3,7 @@
 #include "fileutility.h"
 #include "mathutility.h"
 #include "project.h"
+#include "tracer.h"
 
 using namespace Backend;
 using namespace Backend::Core;
@@ -52,6 +53,11 @@ QString const& Project::pathFile() const
     return mPathFile;
 }
 
+QList<Subproject> const& Project::subprojects() const
+{
+    return mSubprojects;
+}
+
 QList<Subproject>& Project::subprojects()
 {
     return mSubprojects;
@@ -95,6 +101,15 @@ bool Project::isEmpty() const
     return mSubprojects.empty();
 }
 
+//! Estimate the number of bytes held by all the subprojects
+MemoryUsage Project::memoryUsage() const
+{
+    MemoryUsage result;
+    for (Subproject const& subproject : mSubprojects)
+        result += subproject.memoryUsage();
+    return result;
+}
+
 QString Project::fileSuffix()
 {
     return "xmod";
@@ -131,7 +146,10 @@ bool Project::read(const QString& pathFile)
     clear();
 
     // Retrieve the project data
-    deserialize(stream);
+    {
+        TraceSpan span("deserialize", "project");
+        deserialize(stream);
+    }
 
     // Remember the filepath
     mPathFile = pathFile;
@@ -152,7 +170,10 @@ bool Project::write(const QString& pathFile)
     stream.writeStartDocument(skProjectIOVersion);
 
     // Write the data
-    serialize(stream, "project");
+    {
+        TraceSpan span("serialize", "project");
+        serialize(stream, "project");
+    }
 
     // Close the file
     stream.writeEndDocument();
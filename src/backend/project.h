@@ -27,6 +27,7 @@ public:
     bool operator!=(Project const& another) const;
 
     QString const& pathFile() const;
+    QList<Subproject> const& subprojects() const;
     QList<Subproject>& subprojects();
 
     void setPathFile(QString const& pathFile);
@@ -37,6 +38,7 @@ public:
 
     int numSubprojects() const;
     bool isEmpty() const;
+    MemoryUsage memoryUsage() const;
     static QString fileSuffix();
 
     bool read(QString const& pathFile);
@@ -1,5 +1,13 @@
 #include <kcl/model.h>
+#include <QDebug>
 #include <QMap>
+#include <QObject>
+#include <QStringList>
+#include <QXmlStreamWriter>
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
 
 #include "constants.h"
 #include "fileutility.h"
@@ -8,6 +16,13 @@
 using namespace Backend;
 using namespace Backend::Core;
 
+int const skNumWordBits = 64;
+
+int numWords(int numBits);
+quint64 readBits(QList<quint64> const& words, int iBit, int numBits);
+void writeBits(QList<quint64>& words, int iBit, int numBits, quint64 value);
+void copyBits(QList<quint64> const& source, int iSource, QList<quint64>& destination, int iDestination, int numBits);
+
 SelectionSet::SelectionSet()
 {
 }
@@ -34,66 +49,95 @@ QString& SelectionSet::name()
 
 bool SelectionSet::isSelected(Selection const& selection) const
 {
-    if (mDataSet.contains(selection))
-        return mDataSet[selection];
-    else
+    int iBit = findBit(selection);
+    if (iBit < 0)
         return false;
+    return (mWords[iBit / skNumWordBits] >> (iBit % skNumWordBits)) & 1;
 }
 
 int SelectionSet::numSelected() const
 {
-    return selected().size();
+    int result = 0;
+    for (quint64 word : mWords)
+        result += std::popcount(word);
+    return result;
+}
+
+//! Get the number of elements which could be selected
+int SelectionSet::numElements() const
+{
+    if (mRanges.isEmpty())
+        return 0;
+    SelectionRange const& range = mRanges.last();
+    return range.offset + range.numElements;
 }
 
 QList<Selection> SelectionSet::selected() const
 {
     QList<Selection> result;
-    QList<Selection> const selections = mDataSet.keys();
-    for (Selection const& selection : selections)
+    result.reserve(numSelected());
+    int iRange = 0;
+    int numStoredWords = mWords.size();
+    for (int iWord = 0; iWord != numStoredWords; ++iWord)
     {
-        if (mDataSet[selection])
-            result.push_back(selection);
+        quint64 word = mWords[iWord];
+        while (word)
+        {
+            int iBit = iWord * skNumWordBits + std::countr_zero(word);
+            while (iBit >= mRanges[iRange].offset + mRanges[iRange].numElements)
+                ++iRange;
+            SelectionRange const& range = mRanges[iRange];
+            result.push_back(Selection(range.iSurface, range.type, iBit - range.offset));
+            word &= word - 1;
+        }
     }
     return result;
 }
 
-QMap<Selection, bool> const& SelectionSet::selections() const
+//! Get the ranges sorted by surface indices and element types
+QList<SelectionRange> const& SelectionSet::ranges() const
 {
-    return mDataSet;
+    return mRanges;
+}
+
+//! Get the bits of selected states
+QList<quint64> const& SelectionSet::words() const
+{
+    return mWords;
 }
 
 //! Select all elements
 void SelectionSet::selectAll()
 {
-    QList<Selection> const selections = mDataSet.keys();
-    for (Selection const& selection : selections)
-        mDataSet[selection] = true;
+    mWords.fill(~quint64(0));
+    clearPadding();
 }
 
 //! Deselect all elements
 void SelectionSet::selectNone()
 {
-    QList<Selection> const selections = mDataSet.keys();
-    for (Selection const& selection : selections)
-        mDataSet[selection] = false;
+    mWords.fill(0);
 }
 
 //! Inverse the selections
 void SelectionSet::inverse()
 {
-    QList<Selection> const selections = mDataSet.keys();
-    for (Selection const& selection : selections)
-    {
-        bool flag = mDataSet[selection];
-        mDataSet[selection] = !flag;
-    }
+    for (quint64& word : mWords)
+        word = ~word;
+    clearPadding();
 }
 
 //! Set the selected state of the element
 void SelectionSet::setSelected(Selection const& selection, bool flag)
 {
-    if (mDataSet.contains(selection))
-        mDataSet[selection] = flag;
+    int iBit = findBit(selection);
+    if (iBit < 0)
+        return;
+    quint64 mask = quint64(1) << (iBit % skNumWordBits);
+    if (flag)
+        mWords[iBit / skNumWordBits] |= mask;
+    else
+        mWords[iBit / skNumWordBits] &= ~mask;
 }
 
 //! Set the selected state of the elements
@@ -106,40 +150,96 @@ void SelectionSet::setSelected(QList<Selection> const& selections, bool flag)
 //! Set the selected state by surface index
 void SelectionSet::setSelected(int iSurface, bool flag)
 {
-    QList<Selection> const selections = mDataSet.keys();
-    for (Selection const& selection : selections)
+    for (SelectionRange const& range : mRanges)
     {
-        if (selection.iSurface == iSurface)
-            mDataSet[selection] = flag;
+        if (range.iSurface == iSurface)
+            setBits(range.offset, range.offset + range.numElements, flag);
     }
 }
 
 //! Set the selected state by element type
 void SelectionSet::setSelected(KCL::ElementType type, bool flag)
 {
-    QList<Selection> const selections = mDataSet.keys();
-    for (Selection const& selection : selections)
+    for (SelectionRange const& range : mRanges)
     {
-        if (selection.type == type)
-            mDataSet[selection] = flag;
+        if (range.type == type)
+            setBits(range.offset, range.offset + range.numElements, flag);
     }
 }
 
 //! Set the selected state by surface index and element type
 void SelectionSet::setSelected(int iSurface, KCL::ElementType type, bool flag)
 {
-    QList<Selection> const selections = mDataSet.keys();
-    for (Selection const& selection : selections)
+    int iRange = findRange(iSurface, type);
+    if (iRange < 0)
+        return;
+    SelectionRange const& range = mRanges[iRange];
+    setBits(range.offset, range.offset + range.numElements, flag);
+}
+
+//! Insert unselected elements before the given one, shifting the states of the subsequent elements
+void SelectionSet::insert(Selection const& selection, int numElements)
+{
+    if (numElements <= 0)
+        return;
+
+    // Create the empty range, if necessary
+    int iRange = findRange(selection.iSurface, selection.type);
+    if (iRange < 0)
     {
-        if (selection.iSurface == iSurface && selection.type == type)
-            mDataSet[selection] = flag;
+        SelectionRange range(selection.iSurface, selection.type);
+        auto iter = std::lower_bound(mRanges.begin(), mRanges.end(), range);
+        range.offset = iter == mRanges.end() ? this->numElements() : iter->offset;
+        iRange = iter - mRanges.begin();
+        mRanges.insert(iRange, range);
+        updateIndices();
     }
+
+    // Shift the states
+    SelectionRange& range = mRanges[iRange];
+    int iElement = std::clamp(selection.iElement, 0, range.numElements);
+    splice(range.offset + iElement, 0, numElements);
+    range.numElements += numElements;
+    int numRanges = mRanges.size();
+    for (int i = iRange + 1; i != numRanges; ++i)
+        mRanges[i].offset += numElements;
+}
+
+//! Remove the elements starting from the given one, shifting the states of the subsequent elements
+void SelectionSet::remove(Selection const& selection, int numElements)
+{
+    int iRange = findRange(selection.iSurface, selection.type);
+    if (iRange < 0 || selection.iElement < 0)
+        return;
+    SelectionRange& range = mRanges[iRange];
+    numElements = std::min(numElements, range.numElements - selection.iElement);
+    if (numElements <= 0)
+        return;
+    splice(range.offset + selection.iElement, numElements, 0);
+    range.numElements -= numElements;
+    int numRanges = mRanges.size();
+    for (int i = iRange + 1; i != numRanges; ++i)
+        mRanges[i].offset -= numElements;
+}
+
+//! Set the layout of the elements and deselect them
+void SelectionSet::reset(QList<SelectionRange> const& ranges)
+{
+    mRanges = ranges;
+    int offset = 0;
+    for (SelectionRange& range : mRanges)
+    {
+        range.offset = offset;
+        offset += range.numElements;
+    }
+    mWords = QList<quint64>(numWords(offset), 0);
+    updateIndices();
 }
 
-//! Clean up the selections
+//! Set the layout of the model elements and deselect them
 void SelectionSet::reset(KCL::Model const& model)
 {
-    mDataSet.clear();
+    QList<SelectionRange> ranges;
 
     // Process elastic surfaces
     auto const& surfaces = model.surfaces;
@@ -148,55 +248,240 @@ void SelectionSet::reset(KCL::Model const& model)
     {
         auto const& surface = surfaces[iSurface];
         auto types = surface.types();
-        int numTypes = types.size();
-        for (int iType = 0; iType != numTypes; ++iType)
-        {
-            auto type = types[iType];
-            int numElements = surface.numElements(type);
-            for (int iElement = 0; iElement != numElements; ++iElement)
-            {
-                Selection selection;
-                selection.iSurface = iSurface;
-                selection.type = type;
-                selection.iElement = iElement;
-                mDataSet[selection] = false;
-            }
-        }
+        for (auto type : types)
+            ranges.push_back(SelectionRange(iSurface, type, surface.numElements(type)));
     }
 
     // Process the special surface
     auto types = model.specialSurface.types();
-    int numTypes = types.size();
-    for (int iType = 0; iType != numTypes; ++iType)
+    for (auto type : types)
+        ranges.push_back(SelectionRange(Constants::skISpecialSurface, type, model.specialSurface.numElements(type)));
+
+    // Order the ranges as the selections
+    std::sort(ranges.begin(), ranges.end());
+    reset(ranges);
+}
+
+/*!
+ * Update the selected items in case the model has been changed.
+ * The states are matched by the element indices within each range, so the elements inserted or removed in the middle of a range
+ * have to be reported by insert() and remove() beforehand to keep the states of the subsequent elements
+ */
+void SelectionSet::update(KCL::Model const& model)
+{
+    QList<SelectionRange> const oldRanges = mRanges;
+    QList<quint64> const oldWords = mWords;
+    reset(model);
+
+    // Keep the states, if the layout has not been changed
+    if (mRanges == oldRanges)
+    {
+        mWords = oldWords;
+        return;
+    }
+
+    // Copy the states of the ranges which are still present
+    for (SelectionRange const& oldRange : oldRanges)
+    {
+        int iRange = findRange(oldRange.iSurface, oldRange.type);
+        if (iRange < 0)
+            continue;
+        SelectionRange const& range = mRanges[iRange];
+        copyBits(oldWords, oldRange.offset, mWords, range.offset, std::min(oldRange.numElements, range.numElements));
+    }
+}
+
+/*!
+ * Apply the bitwise operation to the words of both sets.
+ * If the layouts differ, the ranges are matched by surfaces and types, and the elements absent in this set are ignored.
+ * Therefore, the layout has to be extended beforehand, if those elements matter
+ */
+template<typename Operation>
+void SelectionSet::combine(SelectionSet const& another, Operation operation)
+{
+    // Process the words at once
+    if (isCompatible(another))
+    {
+        int numStoredWords = mWords.size();
+        for (int i = 0; i != numStoredWords; ++i)
+            mWords[i] = operation(mWords[i], another.mWords[i]);
+        return;
+    }
+
+    // Align the ranges
+    for (SelectionRange const& range : mRanges)
     {
-        auto type = types[iType];
-        int numElements = model.specialSurface.numElements(type);
-        for (int iElement = 0; iElement != numElements; ++iElement)
+        int iAnotherRange = another.findRange(range.iSurface, range.type);
+        int numAnotherElements = iAnotherRange < 0 ? 0 : another.mRanges[iAnotherRange].numElements;
+        for (int i = 0; i < range.numElements; i += skNumWordBits)
         {
-            Selection selection;
-            selection.iSurface = Constants::skISpecialSurface;
-            selection.type = type;
-            selection.iElement = iElement;
-            mDataSet[selection] = false;
+            int numBits = std::min(skNumWordBits, range.numElements - i);
+            int numAnotherBits = std::min(numBits, numAnotherElements - i);
+            quint64 second = 0;
+            if (numAnotherBits > 0)
+                second = readBits(another.mWords, another.mRanges[iAnotherRange].offset + i, numAnotherBits);
+            quint64 first = readBits(mWords, range.offset + i, numBits);
+            writeBits(mWords, range.offset + i, numBits, operation(first, second));
         }
     }
 }
 
-//! Update the selected items in case the model has been changed
-void SelectionSet::update(KCL::Model const& model)
+//! Add the unselected elements of another set which are absent in this one, so that the layout covers the elements of both sets
+void SelectionSet::extend(SelectionSet const& another)
 {
-    QMap<Selection, bool> const oldDataSet = mDataSet;
-    reset(model);
-    for (auto const& [selection, flag] : oldDataSet.asKeyValueRange())
+    if (isCompatible(another))
+        return;
+    for (SelectionRange const& anotherRange : another.mRanges)
     {
-        if (mDataSet.contains(selection))
-            mDataSet[selection] = flag;
+        int iRange = findRange(anotherRange.iSurface, anotherRange.type);
+        int numElements = iRange < 0 ? 0 : mRanges[iRange].numElements;
+        if (numElements < anotherRange.numElements)
+            insert(Selection(anotherRange.iSurface, anotherRange.type, numElements), anotherRange.numElements - numElements);
     }
 }
 
+//! Check if the elements of both sets are laid out identically, so that their words could be combined directly
+bool SelectionSet::isCompatible(SelectionSet const& another) const
+{
+    return mRanges == another.mRanges;
+}
+
+//! Check if any element is selected in both sets
+bool SelectionSet::intersects(SelectionSet const& another) const
+{
+    if (!isCompatible(another))
+        return (*this & another).numSelected() > 0;
+    int numStoredWords = mWords.size();
+    for (int i = 0; i != numStoredWords; ++i)
+    {
+        if (mWords[i] & another.mWords[i])
+            return true;
+    }
+    return false;
+}
+
+//! Select the elements which are selected in another set, adding the ones absent in this set
+SelectionSet& SelectionSet::unite(SelectionSet const& another)
+{
+    extend(another);
+    combine(another, [](quint64 first, quint64 second) { return first | second; });
+    return *this;
+}
+
+//! Keep selected only the elements which are selected in another set
+SelectionSet& SelectionSet::intersect(SelectionSet const& another)
+{
+    combine(another, [](quint64 first, quint64 second) { return first & second; });
+    return *this;
+}
+
+//! Deselect the elements which are selected in another set
+SelectionSet& SelectionSet::subtract(SelectionSet const& another)
+{
+    combine(another, [](quint64 first, quint64 second) { return first & ~second; });
+    return *this;
+}
+
+SelectionSet& SelectionSet::operator|=(SelectionSet const& another)
+{
+    return unite(another);
+}
+
+SelectionSet& SelectionSet::operator&=(SelectionSet const& another)
+{
+    return intersect(another);
+}
+
+SelectionSet& SelectionSet::operator-=(SelectionSet const& another)
+{
+    return subtract(another);
+}
+
+SelectionSet SelectionSet::operator|(SelectionSet const& another) const
+{
+    SelectionSet result = *this;
+    return result.unite(another);
+}
+
+SelectionSet SelectionSet::operator&(SelectionSet const& another) const
+{
+    SelectionSet result = *this;
+    return result.intersect(another);
+}
+
+SelectionSet SelectionSet::operator-(SelectionSet const& another) const
+{
+    SelectionSet result = *this;
+    return result.subtract(another);
+}
+
+//! Find the range associated with the surface and element type
+int SelectionSet::findRange(int iSurface, KCL::ElementType type) const
+{
+    return mIndices.value({iSurface, (int) type}, -1);
+}
+
+//! Find the bit associated with the selection
+int SelectionSet::findBit(Selection const& selection) const
+{
+    int iRange = findRange(selection.iSurface, selection.type);
+    if (iRange < 0)
+        return -1;
+    SelectionRange const& range = mRanges[iRange];
+    if (selection.iElement < 0 || selection.iElement >= range.numElements)
+        return -1;
+    return range.offset + selection.iElement;
+}
+
+//! Assign the state to the bits in the interval [iStart, iEnd)
+void SelectionSet::setBits(int iStart, int iEnd, bool flag)
+{
+    while (iStart < iEnd)
+    {
+        int iWord = iStart / skNumWordBits;
+        int iShift = iStart % skNumWordBits;
+        int numBits = std::min(skNumWordBits - iShift, iEnd - iStart);
+        quint64 mask = numBits == skNumWordBits ? ~quint64(0) : ((quint64(1) << numBits) - 1) << iShift;
+        if (flag)
+            mWords[iWord] |= mask;
+        else
+            mWords[iWord] &= ~mask;
+        iStart += numBits;
+    }
+}
+
+//! Replace the given number of bits starting from the specified one with unselected ones
+void SelectionSet::splice(int iBit, int numRemoved, int numInserted)
+{
+    int numBits = numElements();
+    int iTail = iBit + numRemoved;
+    QList<quint64> words(numWords(numBits - numRemoved + numInserted), 0);
+    copyBits(mWords, 0, words, 0, iBit);
+    copyBits(mWords, iTail, words, iBit + numInserted, numBits - iTail);
+    mWords = std::move(words);
+}
+
+//! Deselect the bits which are not associated with any element
+void SelectionSet::clearPadding()
+{
+    int numBits = numElements() % skNumWordBits;
+    if (numBits > 0 && !mWords.isEmpty())
+        mWords.last() &= (quint64(1) << numBits) - 1;
+}
+
+//! Map the surfaces and types to the ranges
+void SelectionSet::updateIndices()
+{
+    mIndices.clear();
+    int numRanges = mRanges.size();
+    mIndices.reserve(numRanges);
+    for (int i = 0; i != numRanges; ++i)
+        mIndices[{mRanges[i].iSurface, (int) mRanges[i].type}] = i;
+}
+
 bool SelectionSet::operator==(SelectionSet const& another) const
 {
-    return Utility::areEqual(*this, another);
+    return mName == another.mName && mRanges == another.mRanges && mWords == another.mWords;
 }
 
 bool SelectionSet::operator!=(SelectionSet const& another) const
@@ -204,26 +489,165 @@ bool SelectionSet::operator!=(SelectionSet const& another) const
     return !(*this == another);
 }
 
+//! Write the ranges, each of which contains the lengths of alternating unselected and selected runs
 void SelectionSet::serialize(QXmlStreamWriter& stream, QString const& elementName) const
 {
     stream.writeStartElement(elementName);
     stream.writeAttribute("name", mName);
-    Utility::serialize(stream, "dataSet", mDataSet);
+    stream.writeStartElement("ranges");
+    for (SelectionRange const& range : mRanges)
+    {
+        QStringList runs;
+        bool flag = false;
+        int numRun = 0;
+        for (int i = 0; i != range.numElements; ++i)
+        {
+            int iBit = range.offset + i;
+            bool isBitSelected = (mWords[iBit / skNumWordBits] >> (iBit % skNumWordBits)) & 1;
+            if (isBitSelected != flag)
+            {
+                runs << Utility::toString(numRun);
+                flag = !flag;
+                numRun = 0;
+            }
+            ++numRun;
+        }
+        runs << Utility::toString(numRun);
+        stream.writeStartElement("range");
+        stream.writeAttribute("iSurface", Utility::toString(range.iSurface));
+        stream.writeAttribute("type", Utility::toString((int) range.type));
+        stream.writeAttribute("numElements", Utility::toString(range.numElements));
+        stream.writeCharacters(runs.join(' '));
+        stream.writeEndElement();
+    }
+    stream.writeEndElement();
     stream.writeEndElement();
 }
 
 void SelectionSet::deserialize(QXmlStreamReader& stream)
 {
     mName = stream.attributes().value("name").toString();
+    reset(QList<SelectionRange>());
+    while (stream.readNextStartElement())
+    {
+        if (stream.name() == "ranges")
+            readRanges(stream);
+        else if (stream.name() == "dataSet")
+            readDataSet(stream);
+        else
+            stream.skipCurrentElement();
+    }
+}
+
+//! Read the run-length encoded ranges
+void SelectionSet::readRanges(QXmlStreamReader& stream)
+{
+    // Read the layout and runs
+    QList<SelectionRange> ranges;
+    QList<QList<int>> rangeRuns;
     while (stream.readNextStartElement())
     {
-        if (stream.name() == "dataSet")
-            Utility::deserialize(stream, mDataSet);
+        if (stream.name() == "range")
+        {
+            SelectionRange range;
+            range.iSurface = stream.attributes().value("iSurface").toInt();
+            range.type = (KCL::ElementType) stream.attributes().value("type").toInt();
+            range.numElements = std::max(0, stream.attributes().value("numElements").toInt());
+            QList<int> runs;
+            QStringList const items = stream.readElementText().split(' ', Qt::SkipEmptyParts);
+            for (QString const& item : items)
+                runs.push_back(item.toInt());
+            ranges.push_back(range);
+            rangeRuns.push_back(runs);
+        }
         else
+        {
             stream.skipCurrentElement();
+        }
+    }
+
+    // Sort the ranges along with the runs
+    int numRanges = ranges.size();
+    QList<int> indices(numRanges);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::stable_sort(indices.begin(), indices.end(), [&ranges](int i, int j) { return ranges[i] < ranges[j]; });
+    QList<SelectionRange> sortedRanges(numRanges);
+    for (int i = 0; i != numRanges; ++i)
+        sortedRanges[i] = ranges[indices[i]];
+    reset(sortedRanges);
+
+    // Decode the selected states
+    for (int i = 0; i != numRanges; ++i)
+    {
+        SelectionRange const& range = mRanges[i];
+        QList<int> const& runs = rangeRuns[indices[i]];
+        int iElement = 0;
+        bool flag = false;
+        for (int numRun : runs)
+        {
+            int iEnd = std::min(iElement + std::max(numRun, 0), range.numElements);
+            if (flag)
+                setBits(range.offset + iElement, range.offset + iEnd, true);
+            iElement = iEnd;
+            flag = !flag;
+        }
+        if (iElement != range.numElements)
+            qWarning() << QObject::tr("Runs of the selection set %1 do not match the number of elements").arg(mName);
     }
 }
 
+//! Read the selected states written per element
+void SelectionSet::readDataSet(QXmlStreamReader& stream)
+{
+    QMap<Selection, bool> dataSet;
+    Utility::deserialize(stream, dataSet);
+
+    // Restore the layout from the elements
+    QList<SelectionRange> ranges;
+    for (Selection const& selection : dataSet.keys())
+    {
+        if (ranges.isEmpty() || ranges.last().iSurface != selection.iSurface || ranges.last().type != selection.type)
+            ranges.push_back(SelectionRange(selection.iSurface, selection.type));
+        ranges.last().numElements = std::max(ranges.last().numElements, selection.iElement + 1);
+    }
+    reset(ranges);
+
+    // Set the states
+    for (auto const& [selection, flag] : dataSet.asKeyValueRange())
+        setSelected(selection, flag);
+}
+
+SelectionRange::SelectionRange()
+    : iSurface(-1)
+    , type(KCL::ElementType::OD)
+    , offset(0)
+    , numElements(0)
+{
+}
+
+SelectionRange::SelectionRange(int aISurface, KCL::ElementType aType, int aNumElements)
+    : iSurface(aISurface)
+    , type(aType)
+    , offset(0)
+    , numElements(aNumElements)
+{
+}
+
+bool SelectionRange::operator==(SelectionRange const& another) const
+{
+    return std::tie(iSurface, type, offset, numElements) == std::tie(another.iSurface, another.type, another.offset, another.numElements);
+}
+
+bool SelectionRange::operator!=(SelectionRange const& another) const
+{
+    return !(*this == another);
+}
+
+bool SelectionRange::operator<(SelectionRange const& another) const
+{
+    return std::tie(iSurface, type) < std::tie(another.iSurface, another.type);
+}
+
 Selection::Selection()
     : iSurface(-1)
     , type(KCL::ElementType::OD)
@@ -300,3 +724,48 @@ void Selection::deserialize(QXmlStreamReader& stream)
     iElement = stream.attributes().value("iElement").toInt();
     stream.readNextStartElement();
 }
+
+//! Helper function to compute the number of words to store the bits
+int numWords(int numBits)
+{
+    return (numBits + skNumWordBits - 1) / skNumWordBits;
+}
+
+//! Helper function to read up to 64 bits starting from the given one
+quint64 readBits(QList<quint64> const& words, int iBit, int numBits)
+{
+    int iWord = iBit / skNumWordBits;
+    int iShift = iBit % skNumWordBits;
+    quint64 result = words[iWord] >> iShift;
+    if (iShift > 0 && iShift + numBits > skNumWordBits)
+        result |= words[iWord + 1] << (skNumWordBits - iShift);
+    if (numBits < skNumWordBits)
+        result &= (quint64(1) << numBits) - 1;
+    return result;
+}
+
+//! Helper function to write up to 64 bits starting from the given one
+void writeBits(QList<quint64>& words, int iBit, int numBits, quint64 value)
+{
+    int iWord = iBit / skNumWordBits;
+    int iShift = iBit % skNumWordBits;
+    quint64 mask = numBits < skNumWordBits ? (quint64(1) << numBits) - 1 : ~quint64(0);
+    value &= mask;
+    words[iWord] = (words[iWord] & ~(mask << iShift)) | (value << iShift);
+    if (iShift > 0 && iShift + numBits > skNumWordBits)
+    {
+        int numHighBits = iShift + numBits - skNumWordBits;
+        quint64 highMask = (quint64(1) << numHighBits) - 1;
+        words[iWord + 1] = (words[iWord + 1] & ~highMask) | (value >> (skNumWordBits - iShift));
+    }
+}
+
+//! Helper function to copy the bits word by word
+void copyBits(QList<quint64> const& source, int iSource, QList<quint64>& destination, int iDestination, int numBits)
+{
+    for (int i = 0; i < numBits; i += skNumWordBits)
+    {
+        int numCopy = std::min(skNumWordBits, numBits - i);
+        writeBits(destination, iDestination + i, numCopy, readBits(source, iSource + i, numCopy));
+    }
+}
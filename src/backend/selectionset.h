@@ -2,11 +2,12 @@
 #define SELECTIONSET_H
 
 #include <kcl/element.h>
+#include <QHash>
 #include <QList>
-#include <QMap>
 #include <QMetaObject>
 #include <QString>
 
+#include "aliasdata.h"
 #include "iserializable.h"
 
 namespace KCL
@@ -48,16 +49,33 @@ public:
     int iElement;
 };
 
+//! Elements of the same type which belong to a surface, stored contiguously in a selection set
+struct SelectionRange
+{
+    SelectionRange();
+    SelectionRange(int aISurface, KCL::ElementType aType, int aNumElements = 0);
+    ~SelectionRange() = default;
+
+    bool operator==(SelectionRange const& another) const;
+    bool operator!=(SelectionRange const& another) const;
+    bool operator<(SelectionRange const& another) const;
+
+    int iSurface;
+    KCL::ElementType type;
+    int offset;
+    int numElements;
+};
+
 /*!
  * Class to select model entities
  * 
+ * The selected states are packed into a bitset, where the elements of each surface and type occupy a contiguous range.
  * By default none of entities are selected 
  */
 class SelectionSet : public ISerializable
 {
     Q_GADGET
     Q_PROPERTY(QString name MEMBER mName)
-    Q_PROPERTY(QMap<Selection, bool> dataSet MEMBER mDataSet)
 
 public:
     SelectionSet();
@@ -68,8 +86,10 @@ public:
     QString& name();
     bool isSelected(Selection const& selection) const;
     int numSelected() const;
+    int numElements() const;
     QList<Selection> selected() const;
-    QMap<Selection, bool> const& selections() const;
+    QList<SelectionRange> const& ranges() const;
+    QList<quint64> const& words() const;
 
     void selectAll();
     void selectNone();
@@ -79,8 +99,22 @@ public:
     void setSelected(int iSurface, bool flag);
     void setSelected(KCL::ElementType type, bool flag);
     void setSelected(int iSurface, KCL::ElementType type, bool flag);
+    void insert(Selection const& selection, int numElements = 1);
+    void remove(Selection const& selection, int numElements = 1);
     void update(KCL::Model const& model);
 
+    bool isCompatible(SelectionSet const& another) const;
+    bool intersects(SelectionSet const& another) const;
+    SelectionSet& unite(SelectionSet const& another);
+    SelectionSet& intersect(SelectionSet const& another);
+    SelectionSet& subtract(SelectionSet const& another);
+
+    SelectionSet& operator|=(SelectionSet const& another);
+    SelectionSet& operator&=(SelectionSet const& another);
+    SelectionSet& operator-=(SelectionSet const& another);
+    SelectionSet operator|(SelectionSet const& another) const;
+    SelectionSet operator&(SelectionSet const& another) const;
+    SelectionSet operator-(SelectionSet const& another) const;
     bool operator==(SelectionSet const& another) const;
     bool operator!=(SelectionSet const& another) const;
 
@@ -88,11 +122,25 @@ public:
     void deserialize(QXmlStreamReader& stream) override;
 
 private:
+    void reset(QList<SelectionRange> const& ranges);
     void reset(KCL::Model const& model);
+    int findRange(int iSurface, KCL::ElementType type) const;
+    int findBit(Selection const& selection) const;
+    void setBits(int iStart, int iEnd, bool flag);
+    void splice(int iBit, int numRemoved, int numInserted);
+    void clearPadding();
+    void updateIndices();
+    template<typename Operation>
+    void combine(SelectionSet const& another, Operation operation);
+    void extend(SelectionSet const& another);
+    void readRanges(QXmlStreamReader& stream);
+    void readDataSet(QXmlStreamReader& stream);
 
 private:
     QString mName;
-    QMap<Selection, bool> mDataSet;
+    QList<SelectionRange> mRanges;
+    QHash<PairInt, int> mIndices;
+    QList<quint64> mWords;
 };
 
 inline size_t qHash(const Selection& key, size_t seed)
@@ -0,0 +1,360 @@
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QXmlStreamWriter>
+
+#include "fileutility.h"
+#include "parametricstudy.h"
+#include "sensitivitysolver.h"
+
+using namespace Backend;
+using namespace Backend::Core;
+using namespace Eigen;
+
+double getRelativeChange(double value, double scale, double step);
+
+SensitivityOptions::SensitivityOptions()
+    : numModes(20)
+    , timeout(10.0)
+    , numThreads(1)
+    , stepSize(1e-2)
+    , minMAC(0.0)
+{
+}
+
+bool SensitivityOptions::operator==(SensitivityOptions const& another) const
+{
+    return Utility::areEqual(*this, another);
+}
+
+bool SensitivityOptions::operator!=(SensitivityOptions const& another) const
+{
+    return !(*this == another);
+}
+
+void SensitivityOptions::serialize(QXmlStreamWriter& stream, QString const& elementName) const
+{
+    Utility::serializeProperties(stream, elementName, *this);
+}
+
+void SensitivityOptions::deserialize(QXmlStreamReader& stream)
+{
+    Utility::deserializeProperties(stream, *this);
+}
+
+SensitivitySolution::SensitivitySolution()
+{
+}
+
+bool SensitivitySolution::isEmpty() const
+{
+    return sensitivityFrequencies.size() == 0;
+}
+
+int SensitivitySolution::numModes() const
+{
+    return sensitivityFrequencies.rows();
+}
+
+int SensitivitySolution::numParameters() const
+{
+    return sensitivityFrequencies.cols();
+}
+
+bool SensitivitySolution::operator==(SensitivitySolution const& another) const
+{
+    return Utility::areEqual(*this, another);
+}
+
+bool SensitivitySolution::operator!=(SensitivitySolution const& another) const
+{
+    return !(*this == another);
+}
+
+void SensitivitySolution::serialize(QXmlStreamWriter& stream, QString const& elementName) const
+{
+    stream.writeStartElement(elementName);
+    Utility::serialize(stream, "frequencies", frequencies);
+    Utility::serialize(stream, "parameters", parameters);
+    Utility::serialize(stream, "types", types);
+    Utility::serialize(stream, "sensitivityFrequencies", sensitivityFrequencies);
+    Utility::serialize(stream, "errorsMAC", errorsMAC);
+    stream.writeEndElement();
+}
+
+void SensitivitySolution::deserialize(QXmlStreamReader& stream)
+{
+    while (stream.readNextStartElement())
+    {
+        if (stream.name() == "frequencies")
+            Utility::deserialize(stream, frequencies);
+        else if (stream.name() == "parameters")
+            Utility::deserialize(stream, parameters);
+        else if (stream.name() == "types")
+            Utility::deserialize(stream, types);
+        else if (stream.name() == "sensitivityFrequencies")
+            Utility::deserialize(stream, sensitivityFrequencies);
+        else if (stream.name() == "errorsMAC")
+            Utility::deserialize(stream, errorsMAC);
+        else
+            stream.skipCurrentElement();
+    }
+}
+
+SensitivitySolver::SensitivitySolver()
+{
+}
+
+SensitivitySolver::SensitivitySolver(SensitivitySolver const& another)
+    : model(another.model)
+    , selector(another.selector)
+    , constraints(another.constraints)
+    , options(another.options)
+    , solution(another.solution)
+{
+}
+
+SensitivitySolver::SensitivitySolver(SensitivitySolver&& another)
+{
+    mID = std::move(another.mID);
+    model = std::move(another.model);
+    selector = std::move(another.selector);
+    constraints = std::move(another.constraints);
+    options = std::move(another.options);
+    solution = std::move(another.solution);
+}
+
+SensitivitySolver& SensitivitySolver::operator=(SensitivitySolver const& another)
+{
+    model = another.model;
+    selector = another.selector;
+    constraints = another.constraints;
+    options = another.options;
+    solution = another.solution;
+    return *this;
+}
+
+ISolver::Type SensitivitySolver::type() const
+{
+    return ISolver::kSensitivity;
+}
+
+ISolver* SensitivitySolver::clone() const
+{
+    SensitivitySolver* pSolver = new SensitivitySolver;
+    *pSolver = *this;
+    return pSolver;
+}
+
+void SensitivitySolver::clear()
+{
+    solution = SensitivitySolution();
+    log.clear();
+}
+
+//! Perturb every parameter in both directions and compare the perturbed modal solutions with the base one
+void SensitivitySolver::solve()
+{
+    TraceSpan span("solve", "sensitivity");
+
+    // Clear the previous solution
+    clear();
+    appendLog("Solver started\n");
+    mProfiler.reset();
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
+    // Wrap the model using the same parameters as the optimization solver does
+    ParametricModel parametricModel(model, selector, constraints, options.numModes);
+    QList<double> parameterValues = parametricModel.values();
+    QList<double> const& scales = parametricModel.scales();
+    QList<VariableType> const& variables = parametricModel.types();
+    int numParameters = parametricModel.numParameters();
+    if (numParameters == 0)
+    {
+        appendLog("No parameters are selected\n", QtMsgType::QtCriticalMsg);
+        emit solverFinished();
+        return;
+    }
+    appendLog(QString("Number of parameters: %1\n").arg(numParameters));
+
+    // Create the function to obtain the modal solution at the point
+    auto solverFun = [this, &parametricModel](QList<double> const& values)
+    { return solveModal(parametricModel.unwrap(values, mProfiler), options.timeout, mProfiler); };
+
+    // Evaluate the base solution
+    appendLog("* Evaluating the base solution\n");
+    ModalSolution baseSolution = solverFun(parameterValues);
+    if (baseSolution.isEmpty())
+    {
+        appendLog("Could not evaluate the base solution\n", QtMsgType::QtCriticalMsg);
+        emit solverFinished();
+        return;
+    }
+    int numModes = baseSolution.numModes();
+    VectorXi indices = VectorXi::LinSpaced(numModes, 0, numModes - 1);
+    int numVertices = baseSolution.geometry.numVertices();
+    Matches matches(numVertices);
+    for (int i = 0; i != numVertices; ++i)
+        matches[i] = {i, i};
+
+    // Set the perturbations of the wrapped parameters
+    VectorXd steps(numParameters);
+    VectorXd relChanges(numParameters);
+    for (int i = 0; i != numParameters; ++i)
+    {
+        double value = parameterValues[i];
+        if (scales[i] == 0.0)
+            steps[i] = std::log10(1.0 + options.stepSize);
+        else
+            steps[i] = options.stepSize * std::max(std::abs(value), 1.0);
+        relChanges[i] = getRelativeChange(value, scales[i], steps[i]);
+    }
+
+    // Compare the perturbed solutions concurrently, so that only the comparisons are retained
+    appendLog(QString("* Evaluating %1 perturbed solutions\n").arg(2 * numParameters));
+    int numPerturbations = 2 * numParameters;
+    QList<ModalComparison> comparisons(numPerturbations);
+    ModalComparison* pComparisons = comparisons.data();
+    runConcurrently(numPerturbations, options.numThreads,
+                    [&](int k)
+                    {
+                        int iParameter = k / 2;
+                        double sign = k % 2 == 0 ? 1.0 : -1.0;
+                        QList<double> values = parameterValues;
+                        values[iParameter] += sign * steps[iParameter];
+                        ModalSolution currentSolution = solverFun(values);
+                        if (currentSolution.isEmpty())
+                            return;
+                        ProfileTimer compareTimer(mProfiler, "compare");
+                        pComparisons[k] = baseSolution.compare(currentSolution, indices, matches, options.minMAC);
+                    });
+
+    // Differentiate the comparisons
+    double const kNaN = std::numeric_limits<double>::quiet_NaN();
+    solution.frequencies = baseSolution.frequencies;
+    solution.parameters = Map<VectorXd>(parameterValues.data(), numParameters);
+    solution.types.resize(numParameters);
+    solution.sensitivityFrequencies.setConstant(numModes, numParameters, kNaN);
+    solution.errorsMAC.setConstant(numModes, numParameters, kNaN);
+    int numFailed = 0;
+    for (int j = 0; j != numParameters; ++j)
+    {
+        solution.types[j] = (int) variables[j];
+        ModalComparison const& plus = comparisons[2 * j];
+        ModalComparison const& minus = comparisons[2 * j + 1];
+        if (plus.isEmpty() || minus.isEmpty())
+        {
+            ++numFailed;
+            continue;
+        }
+        for (int i = 0; i != numModes; ++i)
+        {
+            double diffFrequency = 0.5 * (plus.errorFrequencies[i] - minus.errorFrequencies[i]);
+            solution.sensitivityFrequencies(i, j) = diffFrequency / relChanges[j];
+            solution.errorsMAC(i, j) = 0.5 * (plus.errorsMAC[i] + minus.errorsMAC[i]);
+        }
+    }
+    if (numFailed > 0)
+        appendLog(QString("Could not evaluate the perturbed solutions of %1 parameters\n").arg(numFailed), QtMsgType::QtWarningMsg);
+    appendLog("Solver terminated successfully\n");
+
+    // Log the report
+    QString message;
+    QTextStream stream(&message);
+    stream << tr("Sensitivity Report") << Qt::endl;
+    stream << tr("-> Parameters:   %1").arg(numParameters) << Qt::endl;
+    stream << tr("-> Modes:        %1").arg(numModes) << Qt::endl;
+    stream << tr("-> Solutions:    %1").arg(1 + numPerturbations) << Qt::endl;
+    stream << tr("-> Duration:     %1 s").arg(QString::number(totalTimer.nsecsElapsed() * 1e-9, 'f', 3)) << Qt::endl;
+    if (mProfiler.isEnabled())
+        stream << Qt::endl << tr("Profile") << Qt::endl << mProfiler.report().toString();
+    appendLog(message, QtMsgType::QtInfoMsg, "report");
+
+    emit solverFinished();
+}
+
+void SensitivitySolver::serialize(QXmlStreamWriter& stream, QString const& elementName) const
+{
+    stream.writeStartElement(elementName);
+    stream.writeAttribute("type", Utility::toString((int) type()));
+    stream.writeTextElement("id", mID.toString());
+    stream.writeTextElement("name", name);
+    Utility::serialize(stream, "model", model);
+    selector.serialize(stream, "selector");
+    constraints.serialize(stream, "constraints");
+    options.serialize(stream, "options");
+    solution.serialize(stream, "solution");
+    log.serialize(stream, "log");
+    stream.writeEndElement();
+}
+
+void SensitivitySolver::deserialize(QXmlStreamReader& stream)
+{
+    while (stream.readNextStartElement())
+    {
+        if (stream.name() == "id")
+            mID = QUuid::fromString(stream.readElementText());
+        else if (stream.name() == "name")
+            name = stream.readElementText();
+        else if (stream.name() == "model")
+            Utility::deserialize(stream, model);
+        else if (stream.name() == "selector")
+            selector.deserialize(stream);
+        else if (stream.name() == "constraints")
+            constraints.deserialize(stream);
+        else if (stream.name() == "options")
+            options.deserialize(stream);
+        else if (stream.name() == "solution")
+            solution.deserialize(stream);
+        else if (stream.name() == "log")
+            log.deserialize(stream);
+        else
+            stream.skipCurrentElement();
+    }
+}
+
+bool SensitivitySolver::operator==(ISolver const* pBaseSolver) const
+{
+    if (type() != pBaseSolver->type())
+        return false;
+    SensitivitySolver* pSolver = (SensitivitySolver*) pBaseSolver;
+    return Utility::areEqual(*this, *pSolver);
+}
+
+bool SensitivitySolver::operator!=(ISolver const* pBaseSolver) const
+{
+    return !(*this == pBaseSolver);
+}
+
+//! Estimate the number of bytes held by the solver
+MemoryUsage SensitivitySolver::memoryUsage() const
+{
+    MemoryUsage result;
+    result.models = Utility::numBytes(model);
+    result.other = Utility::numBytes(solution.frequencies) + Utility::numBytes(solution.parameters) + Utility::numBytes(solution.types);
+    result.other += Utility::numBytes(solution.sensitivityFrequencies) + Utility::numBytes(solution.errorsMAC);
+    result.logs = log.numBytes();
+    return result;
+}
+
+//! Get the profiler which accumulates the durations of the solver phases
+Profiler& SensitivitySolver::profiler()
+{
+    return mProfiler;
+}
+
+void SensitivitySolver::appendLog(QString const& message, QtMsgType type, QString const& category)
+{
+    log.append(message, type, category);
+    emit logAppended(message);
+}
+
+//! Helper function to compute the half of the relative change of a parameter perturbed by the step in both directions
+double getRelativeChange(double value, double scale, double step)
+{
+    if (scale == 0.0)
+        return 0.5 * (std::pow(10.0, step) - std::pow(10.0, -step));
+    if (std::abs(value) < std::numeric_limits<double>::epsilon())
+        return step;
+    return step / std::abs(value);
+}
@@ -0,0 +1,144 @@
+#ifndef SENSITIVITYSOLVER_H
+#define SENSITIVITYSOLVER_H
+
+#include <kcl/model.h>
+
+#include "isolver.h"
+#include "modalsolver.h"
+#include "optimconstraints.h"
+#include "optimselector.h"
+#include "profiler.h"
+#include "solverlog.h"
+#include "solvermetrics.h"
+
+namespace Backend::Core
+{
+
+struct SensitivityOptions : public ISerializable
+{
+    Q_GADGET
+    Q_PROPERTY(int numModes MEMBER numModes)
+    Q_PROPERTY(double timeout MEMBER timeout)
+    Q_PROPERTY(int numThreads MEMBER numThreads)
+    Q_PROPERTY(double stepSize MEMBER stepSize)
+    Q_PROPERTY(double minMAC MEMBER minMAC)
+
+public:
+    SensitivityOptions();
+    ~SensitivityOptions() = default;
+
+    bool operator==(SensitivityOptions const& another) const;
+    bool operator!=(SensitivityOptions const& another) const;
+
+    void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
+    void deserialize(QXmlStreamReader& stream) override;
+
+    //! Number of modes to compute
+    int numModes;
+
+    //! Maximum duration of each modal solution
+    double timeout;
+
+    //! Number of modal solutions computed concurrently
+    int numThreads;
+
+    //! Relative perturbation of the parameters
+    double stepSize;
+
+    //! Minimum MAC acceptance threshold while pairing the perturbed modes with the base ones
+    double minMAC;
+};
+
+struct SensitivitySolution : public ISerializable
+{
+    Q_GADGET
+    Q_PROPERTY(Eigen::VectorXd frequencies MEMBER frequencies)
+    Q_PROPERTY(Eigen::VectorXd parameters MEMBER parameters)
+    Q_PROPERTY(Eigen::VectorXi types MEMBER types)
+    Q_PROPERTY(Eigen::MatrixXd sensitivityFrequencies MEMBER sensitivityFrequencies)
+    Q_PROPERTY(Eigen::MatrixXd errorsMAC MEMBER errorsMAC)
+
+public:
+    SensitivitySolution();
+    ~SensitivitySolution() = default;
+
+    bool isEmpty() const;
+    int numModes() const;
+    int numParameters() const;
+
+    bool operator==(SensitivitySolution const& another) const;
+    bool operator!=(SensitivitySolution const& another) const;
+
+    void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
+    void deserialize(QXmlStreamReader& stream) override;
+
+    //! Frequencies of the base modes
+    Eigen::VectorXd frequencies;
+
+    //! Wrapped values of the parameters
+    Eigen::VectorXd parameters;
+
+    //! Variable types of the parameters
+    Eigen::VectorXi types;
+
+    //! Relative changes of the frequencies divided by the relative changes of the parameters (modes by rows)
+    Eigen::MatrixXd sensitivityFrequencies;
+
+    //! Mean values of 1 - MAC between the base and perturbed modes at the given step (modes by rows)
+    Eigen::MatrixXd errorsMAC;
+};
+
+class SensitivitySolver : public QObject, public ISolver
+{
+    Q_OBJECT
+    Q_PROPERTY(KCL::Model model MEMBER model)
+    Q_PROPERTY(OptimSelector selector MEMBER selector)
+    Q_PROPERTY(OptimConstraints constraints MEMBER constraints)
+    Q_PROPERTY(SensitivityOptions options MEMBER options)
+    Q_PROPERTY(SensitivitySolution solution MEMBER solution)
+    Q_PROPERTY(Backend::Core::SolverLog log MEMBER log)
+
+public:
+    SensitivitySolver();
+    ~SensitivitySolver() = default;
+    SensitivitySolver(SensitivitySolver const& another);
+    SensitivitySolver(SensitivitySolver&& another);
+    SensitivitySolver& operator=(SensitivitySolver const& another);
+
+    ISolver::Type type() const override;
+    ISolver* clone() const override;
+
+    void clear() override;
+    void solve() override;
+    MemoryUsage memoryUsage() const override;
+
+    void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
+    void deserialize(QXmlStreamReader& stream) override;
+
+    bool operator==(ISolver const* pBaseSolver) const override;
+    bool operator!=(ISolver const* pBaseSolver) const override;
+
+    Profiler& profiler();
+
+signals:
+    void solverFinished();
+    void logAppended(QString message);
+
+private:
+    void appendLog(QString const& message, QtMsgType type = QtMsgType::QtInfoMsg, QString const& category = QString());
+
+public:
+    QString name;
+    KCL::Model model;
+    OptimSelector selector;
+    OptimConstraints constraints;
+    SensitivityOptions options;
+    SensitivitySolution solution;
+    SolverLog log;
+
+private:
+    Profiler mProfiler;
+};
+}
+
+#endif // SENSITIVITYSOLVER_H
@@ -0,0 +1,288 @@
+#include <QDataStream>
+#include <QDateTime>
+#include <QIODevice>
+#include <QXmlStreamReader>
+
+#include "fileutility.h"
+#include "solverlog.h"
+
+using namespace Backend;
+using namespace Backend::Core;
+
+//! Version of the binary layout of records
+static int const skRecordsVersion = 1;
+
+LogRecord::LogRecord()
+    : time(0)
+    , level(QtMsgType::QtInfoMsg)
+{
+}
+
+LogRecord::LogRecord(QString const& aPayload, QtMsgType aLevel, QString const& aCategory)
+    : time(QDateTime::currentMSecsSinceEpoch())
+    , level(aLevel)
+    , category(aCategory)
+    , payload(aPayload)
+{
+}
+
+bool LogRecord::operator==(LogRecord const& another) const
+{
+    return time == another.time && level == another.level && category == another.category && payload == another.payload;
+}
+
+bool LogRecord::operator!=(LogRecord const& another) const
+{
+    return !(*this == another);
+}
+
+SolverLog::SolverLog(int capacity)
+    : mCapacity(std::max(1, capacity))
+    , mHead(0)
+    , mNumAppended(0)
+    , mGeneration(0)
+{
+}
+
+SolverLog::SolverLog(SolverLog const& another)
+{
+    QMutexLocker locker(&another.mMutex);
+    mCapacity = another.mCapacity;
+    mRecords = another.mRecords;
+    mHead = another.mHead;
+    mNumAppended = another.mNumAppended;
+    mGeneration = another.mGeneration;
+}
+
+SolverLog& SolverLog::operator=(SolverLog const& another)
+{
+    if (this == &another)
+        return *this;
+    QList<LogRecord> records = another.records();
+    int capacity = another.capacity();
+    qint64 numAppended = another.numAppended();
+    QMutexLocker locker(&mMutex);
+    mCapacity = capacity;
+    mRecords = records;
+    mHead = 0;
+    mNumAppended = numAppended;
+    ++mGeneration;
+    return *this;
+}
+
+bool SolverLog::isEmpty() const
+{
+    QMutexLocker locker(&mMutex);
+    return mRecords.isEmpty();
+}
+
+int SolverLog::size() const
+{
+    QMutexLocker locker(&mMutex);
+    return mRecords.size();
+}
+
+int SolverLog::capacity() const
+{
+    QMutexLocker locker(&mMutex);
+    return mCapacity;
+}
+
+//! Get the number of records appended since the log was cleared
+qint64 SolverLog::numAppended() const
+{
+    QMutexLocker locker(&mMutex);
+    return mNumAppended;
+}
+
+//! Get the number of records dropped due to the capacity
+qint64 SolverLog::numEvicted() const
+{
+    QMutexLocker locker(&mMutex);
+    return mNumAppended - mRecords.size();
+}
+
+//! Estimate the number of bytes held by the records
+qint64 SolverLog::numBytes() const
+{
+    QMutexLocker locker(&mMutex);
+    qint64 result = mRecords.capacity() * sizeof(LogRecord);
+    for (LogRecord const& record : mRecords)
+        result += (record.category.capacity() + record.payload.capacity()) * sizeof(QChar);
+    return result;
+}
+
+//! Get the counter which is incremented each time the records are replaced or cleared
+qint64 SolverLog::generation() const
+{
+    QMutexLocker locker(&mMutex);
+    return mGeneration;
+}
+
+//! Change the maximum number of records keeping the most recent ones
+void SolverLog::setCapacity(int capacity)
+{
+    QList<LogRecord> items = records();
+    capacity = std::max(1, capacity);
+    QMutexLocker locker(&mMutex);
+    mCapacity = capacity;
+    if (items.size() > mCapacity)
+        items.remove(0, items.size() - mCapacity);
+    mRecords = items;
+    mHead = 0;
+}
+
+//! Add the message to the log (thread-safe)
+void SolverLog::append(QString const& message, QtMsgType level, QString const& category)
+{
+    LogRecord record(message, level, category);
+    QMutexLocker locker(&mMutex);
+    if (mRecords.size() < mCapacity)
+    {
+        mRecords.push_back(std::move(record));
+    }
+    else
+    {
+        mRecords[mHead] = std::move(record);
+        mHead = (mHead + 1) % mCapacity;
+    }
+    ++mNumAppended;
+}
+
+//! Remove all the records
+void SolverLog::clear()
+{
+    QMutexLocker locker(&mMutex);
+    mRecords.clear();
+    mHead = 0;
+    mNumAppended = 0;
+    ++mGeneration;
+}
+
+/*!
+ * Retrieve the records in chronological order starting from the given index of the appended ones.
+ * The index to continue from is written to pNextIndex within the same lock, so that no record is skipped
+ */
+QList<LogRecord> SolverLog::records(qint64 fromIndex, qint64* pNextIndex) const
+{
+    QMutexLocker locker(&mMutex);
+    if (pNextIndex)
+        *pNextIndex = mNumAppended;
+    int numRecords = mRecords.size();
+    qint64 firstIndex = mNumAppended - numRecords;
+    int offset = (int) std::clamp(fromIndex - firstIndex, (qint64) 0, (qint64) numRecords);
+    QList<LogRecord> result;
+    result.reserve(numRecords - offset);
+    for (int i = offset; i != numRecords; ++i)
+        result.push_back(mRecords[(mHead + i) % numRecords]);
+    return result;
+}
+
+//! Represent all the records as a text
+QString SolverLog::toString() const
+{
+    QString result;
+    for (LogRecord const& record : records())
+        result.append(format(record));
+    return result;
+}
+
+//! Format the record by prepending the time and severity
+QString SolverLog::format(LogRecord const& record)
+{
+    QString prefix;
+    switch (record.level)
+    {
+    case QtMsgType::QtWarningMsg:
+        prefix = "Warning";
+        break;
+    case QtMsgType::QtFatalMsg:
+    case QtMsgType::QtCriticalMsg:
+        prefix = "Error";
+        break;
+    default:
+        break;
+    }
+    QString result = QString("\n[%1]\n").arg(QDateTime::fromMSecsSinceEpoch(record.time).time().toString());
+    if (!prefix.isEmpty())
+        result.append(QString("[%1]: ").arg(prefix));
+    result.append(record.payload);
+    return result;
+}
+
+bool SolverLog::operator==(SolverLog const& another) const
+{
+    return capacity() == another.capacity() && records() == another.records();
+}
+
+bool SolverLog::operator!=(SolverLog const& another) const
+{
+    return !(*this == another);
+}
+
+//! Write the records in the compressed binary form
+void SolverLog::serialize(QXmlStreamWriter& stream, QString const& elementName) const
+{
+    QList<LogRecord> items = records();
+
+    // Pack the records
+    QByteArray data;
+    QDataStream dataStream(&data, QIODevice::WriteOnly);
+    dataStream.setVersion(QDataStream::Qt_6_0);
+    dataStream << (qint32) items.size();
+    for (LogRecord const& record : items)
+        dataStream << record.time << (qint8) record.level << record.category << record.payload;
+
+    // Write the element
+    stream.writeStartElement(elementName);
+    stream.writeAttribute("version", Utility::toString(skRecordsVersion));
+    stream.writeAttribute("capacity", Utility::toString(capacity()));
+    stream.writeAttribute("numAppended", QString::number(numAppended()));
+    if (!items.isEmpty())
+        stream.writeCharacters(QString::fromLatin1(qCompress(data).toBase64()));
+    stream.writeEndElement();
+}
+
+//! Read the records or convert the plain text written by the previous versions
+void SolverLog::deserialize(QXmlStreamReader& stream)
+{
+    clear();
+    QXmlStreamAttributes attributes = stream.attributes();
+
+    // Read the text log as a single record
+    if (!attributes.hasAttribute("version"))
+    {
+        QString text;
+        Utility::deserialize(stream, text);
+        if (!text.isEmpty())
+            append(text);
+        return;
+    }
+
+    // Unpack the records
+    int capacity = attributes.value("capacity").toInt();
+    qint64 numAppended = attributes.value("numAppended").toLongLong();
+    QByteArray data = qUncompress(QByteArray::fromBase64(stream.readElementText().toLatin1()));
+    QDataStream dataStream(data);
+    dataStream.setVersion(QDataStream::Qt_6_0);
+    qint32 numRecords = 0;
+    dataStream >> numRecords;
+    QList<LogRecord> items;
+    items.reserve(numRecords);
+    for (int i = 0; i != numRecords && dataStream.status() == QDataStream::Ok; ++i)
+    {
+        LogRecord record;
+        qint8 level;
+        dataStream >> record.time >> level >> record.category >> record.payload;
+        record.level = (QtMsgType) level;
+        items.push_back(record);
+    }
+
+    // Set the state
+    QMutexLocker locker(&mMutex);
+    mCapacity = std::max({1, capacity, (int) items.size()});
+    mRecords = items;
+    mHead = 0;
+    mNumAppended = std::max(numAppended, (qint64) items.size());
+    ++mGeneration;
+}
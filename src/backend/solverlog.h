@@ -0,0 +1,82 @@
+#ifndef SOLVERLOG_H
+#define SOLVERLOG_H
+
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+#include "iserializable.h"
+
+namespace Backend::Core
+{
+
+//! Entry of a solver log
+struct LogRecord
+{
+    LogRecord();
+    LogRecord(QString const& aPayload, QtMsgType aLevel, QString const& aCategory);
+    ~LogRecord() = default;
+
+    bool operator==(LogRecord const& another) const;
+    bool operator!=(LogRecord const& another) const;
+
+    //! Number of milliseconds since epoch
+    qint64 time;
+
+    //! Severity of the message
+    QtMsgType level;
+
+    //! Origin of the message
+    QString category;
+
+    //! Text of the message
+    QString payload;
+};
+
+//! Bounded log of structured records. The oldest records are evicted, when the capacity is exceeded
+class SolverLog : public ISerializable
+{
+    Q_GADGET
+
+public:
+    SolverLog(int capacity = skDefaultCapacity);
+    virtual ~SolverLog() = default;
+
+    SolverLog(SolverLog const& another);
+    SolverLog& operator=(SolverLog const& another);
+
+    bool isEmpty() const;
+    int size() const;
+    int capacity() const;
+    qint64 numAppended() const;
+    qint64 numEvicted() const;
+    qint64 numBytes() const;
+    qint64 generation() const;
+
+    void setCapacity(int capacity);
+    void append(QString const& message, QtMsgType level = QtMsgType::QtInfoMsg, QString const& category = QString());
+    void clear();
+
+    QList<LogRecord> records(qint64 fromIndex = 0, qint64* pNextIndex = nullptr) const;
+    QString toString() const;
+    static QString format(LogRecord const& record);
+
+    bool operator==(SolverLog const& another) const;
+    bool operator!=(SolverLog const& another) const;
+
+    void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
+    void deserialize(QXmlStreamReader& stream) override;
+
+    static int const skDefaultCapacity = 4096;
+
+private:
+    mutable QMutex mMutex;
+    int mCapacity;
+    QList<LogRecord> mRecords;
+    int mHead;
+    qint64 mNumAppended;
+    qint64 mGeneration;
+};
+}
+
+#endif // SOLVERLOG_H
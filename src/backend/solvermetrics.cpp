@@ -0,0 +1,194 @@
+#include <QObject>
+#include <QStringList>
+
+#include "solvermetrics.h"
+
+using namespace Backend::Core;
+
+double hitRatio(std::atomic<qint64> const& numHits, std::atomic<qint64> const& numMisses);
+
+SolverMetricsSnapshot::SolverMetricsSnapshot()
+    : evaluationsRate(0.0)
+    , iterationsRate(0.0)
+    , eigenDedupHitRatio(-1.0)
+    , replayHitRatio(-1.0)
+    , eigenDuration(0.0)
+    , numActiveWorkers(0)
+    , queueDepth(0)
+    , numEvaluations(0)
+    , numIterations(0)
+    , numEigenSolves(0)
+{
+}
+
+//! Check if nothing is being solved
+bool SolverMetricsSnapshot::isIdle() const
+{
+    return numActiveWorkers == 0 && queueDepth == 0;
+}
+
+//! Represent the snapshot as a single line
+QString SolverMetricsSnapshot::toString() const
+{
+    QStringList items;
+    items << QObject::tr("Workers: %1").arg(numActiveWorkers);
+    if (queueDepth > 0)
+        items << QObject::tr("Queue: %1").arg(queueDepth);
+    if (numEigenSolves > 0)
+        items << QObject::tr("Eigen: %1 ms").arg(QString::number(eigenDuration, 'f', 1));
+    if (numEvaluations > 0)
+        items << QObject::tr("Evaluations: %1/s").arg(QString::number(evaluationsRate, 'f', 1));
+    if (numIterations > 0)
+        items << QObject::tr("Iterations: %1/s").arg(QString::number(iterationsRate, 'f', 2));
+    if (eigenDedupHitRatio >= 0.0)
+        items << QObject::tr("Deduplicated eigen solves: %1%").arg(QString::number(100.0 * eigenDedupHitRatio, 'f', 0));
+    if (replayHitRatio >= 0.0)
+        items << QObject::tr("Replay hits: %1%").arg(QString::number(100.0 * replayHitRatio, 'f', 0));
+    return items.join(" | ");
+}
+
+SolverMetrics::SolverMetrics()
+    : mNumActiveWorkers(0)
+    , mQueueDepth(0)
+{
+    reset();
+}
+
+//! Get the registry shared by all the solvers
+SolverMetrics& SolverMetrics::instance()
+{
+    static SolverMetrics sMetrics;
+    return sMetrics;
+}
+
+//! Count an evaluation of the objective function
+void SolverMetrics::addEvaluation()
+{
+    mNumEvaluations.fetch_add(1, std::memory_order_relaxed);
+}
+
+//! Count an accepted optimization step
+void SolverMetrics::addIteration()
+{
+    mNumIterations.fetch_add(1, std::memory_order_relaxed);
+}
+
+//! Count a lookup of the eigen solution obtained at the same point
+void SolverMetrics::addEigenDedupLookup(bool isHit)
+{
+    if (isHit)
+        mNumEigenDedupHits.fetch_add(1, std::memory_order_relaxed);
+    else
+        mNumEigenDedupMisses.fetch_add(1, std::memory_order_relaxed);
+}
+
+//! Count a lookup of the recorded evaluations which is resolved exactly or not
+void SolverMetrics::addReplayLookup(bool isHit)
+{
+    if (isHit)
+        mNumReplayHits.fetch_add(1, std::memory_order_relaxed);
+    else
+        mNumReplayMisses.fetch_add(1, std::memory_order_relaxed);
+}
+
+//! Count the finished kernel which took the given number of nanoseconds
+void SolverMetrics::addKernel(Kernel kernel, qint64 duration)
+{
+    if (kernel != kEigen)
+        return;
+    mNumEigenSolves.fetch_add(1, std::memory_order_relaxed);
+    mEigenDuration.fetch_add(duration, std::memory_order_relaxed);
+}
+
+void SolverMetrics::changeActiveWorkers(int increment)
+{
+    mNumActiveWorkers.fetch_add(increment, std::memory_order_relaxed);
+}
+
+void SolverMetrics::changeQueueDepth(int increment)
+{
+    mQueueDepth.fetch_add(increment, std::memory_order_relaxed);
+}
+
+//! Compute the rates since the previous snapshot
+SolverMetricsSnapshot SolverMetrics::snapshot()
+{
+    SolverMetricsSnapshot result;
+    result.numEvaluations = mNumEvaluations.load(std::memory_order_relaxed);
+    result.numIterations = mNumIterations.load(std::memory_order_relaxed);
+    result.numEigenSolves = mNumEigenSolves.load(std::memory_order_relaxed);
+    result.numActiveWorkers = mNumActiveWorkers.load(std::memory_order_relaxed);
+    result.queueDepth = mQueueDepth.load(std::memory_order_relaxed);
+    qint64 eigenDuration = mEigenDuration.load(std::memory_order_relaxed);
+    result.eigenDedupHitRatio = hitRatio(mNumEigenDedupHits, mNumEigenDedupMisses);
+    result.replayHitRatio = hitRatio(mNumReplayHits, mNumReplayMisses);
+
+    // Differentiate the counters
+    QMutexLocker locker(&mMutex);
+    qint64 time = mTimer.nsecsElapsed();
+    double interval = (time - mLastTime) * 1e-9;
+    if (interval > 0.0)
+    {
+        result.evaluationsRate = (result.numEvaluations - mLastNumEvaluations) / interval;
+        result.iterationsRate = (result.numIterations - mLastNumIterations) / interval;
+    }
+
+    // Average the eigen solves within the interval, if any, or since the reset otherwise
+    qint64 numEigenSolves = result.numEigenSolves - mLastNumEigenSolves;
+    if (numEigenSolves > 0)
+        result.eigenDuration = (eigenDuration - mLastEigenDuration) * 1e-6 / numEigenSolves;
+    else if (result.numEigenSolves > 0)
+        result.eigenDuration = eigenDuration * 1e-6 / result.numEigenSolves;
+
+    // Remember the state
+    mLastTime = time;
+    mLastNumEvaluations = result.numEvaluations;
+    mLastNumIterations = result.numIterations;
+    mLastNumEigenSolves = result.numEigenSolves;
+    mLastEigenDuration = eigenDuration;
+    return result;
+}
+
+//! Zero the counters except for the ones describing the running solvers
+void SolverMetrics::reset()
+{
+    mNumEvaluations = 0;
+    mNumIterations = 0;
+    mNumEigenDedupHits = 0;
+    mNumEigenDedupMisses = 0;
+    mNumReplayHits = 0;
+    mNumReplayMisses = 0;
+    mNumEigenSolves = 0;
+    mEigenDuration = 0;
+    QMutexLocker locker(&mMutex);
+    mTimer.start();
+    mLastTime = 0;
+    mLastNumEvaluations = 0;
+    mLastNumIterations = 0;
+    mLastNumEigenSolves = 0;
+    mLastEigenDuration = 0;
+}
+
+KernelScope::KernelScope(SolverMetrics::Kernel kernel)
+    : mKernel(kernel)
+{
+    SolverMetrics::instance().changeActiveWorkers(1);
+    mTimer.start();
+}
+
+KernelScope::~KernelScope()
+{
+    SolverMetrics& metrics = SolverMetrics::instance();
+    metrics.addKernel(mKernel, mTimer.nsecsElapsed());
+    metrics.changeActiveWorkers(-1);
+}
+
+//! Compute the ratio of the hits to the lookups, or -1 if there were none
+double hitRatio(std::atomic<qint64> const& numHits, std::atomic<qint64> const& numMisses)
+{
+    qint64 hits = numHits.load(std::memory_order_relaxed);
+    qint64 numLookups = hits + numMisses.load(std::memory_order_relaxed);
+    if (numLookups == 0)
+        return -1.0;
+    return (double) hits / numLookups;
+}
@@ -0,0 +1,112 @@
+#ifndef SOLVERMETRICS_H
+#define SOLVERMETRICS_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+
+#include <atomic>
+
+namespace Backend::Core
+{
+
+//! Throughput of the solvers observed since the previous snapshot
+struct SolverMetricsSnapshot
+{
+    SolverMetricsSnapshot();
+    ~SolverMetricsSnapshot() = default;
+
+    bool isIdle() const;
+    QString toString() const;
+
+    //! Number of objective evaluations per second
+    double evaluationsRate;
+
+    //! Number of optimization iterations per second
+    double iterationsRate;
+
+    //! Ratio of the eigen solves skipped, since the same point had been solved before
+    double eigenDedupHitRatio;
+
+    //! Ratio of the lookups resolved exactly by the replay oracle
+    double replayHitRatio;
+
+    //! Mean duration of an eigen solve, ms
+    double eigenDuration;
+
+    //! Number of solver kernels running at the moment
+    int numActiveWorkers;
+
+    //! Number of solvers waiting to be run
+    int queueDepth;
+
+    //! Total numbers since the metrics were reset
+    qint64 numEvaluations;
+    qint64 numIterations;
+    qint64 numEigenSolves;
+};
+
+//! Process-wide registry of solver counters. Updates are lock-free, so that they could be made from the hot paths
+class SolverMetrics
+{
+public:
+    enum Kernel
+    {
+        kEigen,
+        kFlutter
+    };
+
+    static SolverMetrics& instance();
+
+    void addEvaluation();
+    void addIteration();
+    void addEigenDedupLookup(bool isHit);
+    void addReplayLookup(bool isHit);
+    void addKernel(Kernel kernel, qint64 duration);
+    void changeActiveWorkers(int increment);
+    void changeQueueDepth(int increment);
+
+    SolverMetricsSnapshot snapshot();
+    void reset();
+
+private:
+    SolverMetrics();
+    ~SolverMetrics() = default;
+
+private:
+    // Counters
+    std::atomic<qint64> mNumEvaluations;
+    std::atomic<qint64> mNumIterations;
+    std::atomic<qint64> mNumEigenDedupHits;
+    std::atomic<qint64> mNumEigenDedupMisses;
+    std::atomic<qint64> mNumReplayHits;
+    std::atomic<qint64> mNumReplayMisses;
+    std::atomic<qint64> mNumEigenSolves;
+    std::atomic<qint64> mEigenDuration;
+    std::atomic<int> mNumActiveWorkers;
+    std::atomic<int> mQueueDepth;
+
+    // State of the previous snapshot
+    QMutex mMutex;
+    QElapsedTimer mTimer;
+    qint64 mLastTime;
+    qint64 mLastNumEvaluations;
+    qint64 mLastNumIterations;
+    qint64 mLastNumEigenSolves;
+    qint64 mLastEigenDuration;
+};
+
+//! Scope of a solver kernel which is counted as an active worker and timed
+class KernelScope
+{
+public:
+    KernelScope(SolverMetrics::Kernel kernel);
+    ~KernelScope();
+
+private:
+    SolverMetrics::Kernel mKernel;
+    QElapsedTimer mTimer;
+};
+}
+
+#endif // SOLVERMETRICS_H
@@ -0,0 +1,131 @@
+#include <QMetaMethod>
+#include <QTimer>
+
+#include "optimsolver.h"
+#include "solverprogress.h"
+
+using namespace Backend::Core;
+
+SolverProgress::SolverProgress()
+    : iteration(-1)
+    , cost(0.0)
+{
+}
+
+//! Extract the progress from the solution of the optimization iteration
+SolverProgress::SolverProgress(OptimSolution const& solution)
+    : iteration(solution.iteration)
+    , cost(solution.cost)
+{
+    ModalComparison const& comparison = solution.modalComparison;
+    int numTargets = comparison.pairs.size();
+    int numModes = solution.modalSolution.numModes();
+    indices.resize(numTargets);
+    frequencies.resize(numTargets);
+    for (int i = 0; i != numTargets; ++i)
+    {
+        int iMode = comparison.pairs[i].first;
+        indices[i] = iMode;
+        if (iMode >= 0 && iMode < numModes)
+            frequencies[i] = solution.modalSolution.frequencies[iMode];
+        else
+            frequencies[i] = std::numeric_limits<double>::quiet_NaN();
+    }
+    errorFrequencies = comparison.errorFrequencies;
+    errorsMAC = comparison.errorsMAC;
+}
+
+SolverProgressChannel::SolverProgressChannel(int interval, QObject* pParent)
+    : QObject(pParent)
+    , mInterval(interval)
+    , mIsScheduled(false)
+{
+    mTimer.start();
+}
+
+//! Get the minimum duration between deliveries in milliseconds
+int SolverProgressChannel::interval() const
+{
+    return mInterval;
+}
+
+//! Set the minimum duration between deliveries in milliseconds
+void SolverProgressChannel::setInterval(int interval)
+{
+    mInterval = std::max(0, interval);
+}
+
+//! Get the progress which has been already delivered (thread-safe)
+QList<SolverProgress> SolverProgressChannel::history() const
+{
+    QMutexLocker locker(&mMutex);
+    return mHistory;
+}
+
+//! Replace the delivered progress, for instance, by the one restored from a file
+void SolverProgressChannel::setHistory(QList<SolverProgress> const& history)
+{
+    QMutexLocker locker(&mMutex);
+    mHistory.clear();
+    appendHistory(history);
+}
+
+//! Queue the progress to be delivered (thread-safe). Without subscribers, the progress is only stored, since there may be no event loop
+void SolverProgressChannel::post(SolverProgress const& progress)
+{
+    QMutexLocker locker(&mMutex);
+    if (!isSignalConnected(QMetaMethod::fromSignal(&SolverProgressChannel::progressed)))
+    {
+        appendHistory({progress});
+        return;
+    }
+    mPending.push_back(progress);
+    if (mIsScheduled)
+        return;
+    mIsScheduled = true;
+    QMetaObject::invokeMethod(this, &SolverProgressChannel::schedule, Qt::QueuedConnection);
+}
+
+//! Deliver all the queued progress at once
+void SolverProgressChannel::flush()
+{
+    QList<SolverProgress> progresses;
+    {
+        QMutexLocker locker(&mMutex);
+        progresses.swap(mPending);
+        appendHistory(progresses);
+        mIsScheduled = false;
+    }
+    mTimer.restart();
+    if (!progresses.empty())
+        emit progressed(progresses);
+}
+
+//! Drop the progress which has been queued or delivered
+void SolverProgressChannel::clear()
+{
+    QMutexLocker locker(&mMutex);
+    mPending.clear();
+    mHistory.clear();
+}
+
+//! Postpone the delivery to keep the interval between the consecutive ones
+void SolverProgressChannel::schedule()
+{
+    int delay = std::max<qint64>(0, mInterval - mTimer.elapsed());
+    QTimer::singleShot(delay, this, &SolverProgressChannel::flush);
+}
+
+//! Store the delivered progress, keeping every second item up to the latest one once the history is full (the mutex must be locked)
+void SolverProgressChannel::appendHistory(QList<SolverProgress> const& progresses)
+{
+    mHistory.append(progresses);
+    while (mHistory.size() > skMaxHistory)
+    {
+        qsizetype numItems = mHistory.size();
+        qsizetype iLast = 0;
+        for (qsizetype i = (numItems - 1) % 2; i < numItems; i += 2)
+            mHistory[iLast++] = mHistory[i];
+        mHistory.resize(iLast);
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef SOLVERPROGRESS_H
+#define SOLVERPROGRESS_H
+
+#include <Eigen/Core>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+
+namespace Backend::Core
+{
+
+struct OptimSolution;
+
+//! Incremental state of a running solver
+struct SolverProgress
+{
+    SolverProgress();
+    SolverProgress(OptimSolution const& solution);
+    ~SolverProgress() = default;
+
+    //! Index of the iteration
+    int iteration;
+
+    //! Value of the objective function
+    double cost;
+
+    //! Indices of the modes paired with the target ones
+    Eigen::VectorXi indices;
+
+    //! Frequencies of the paired modes
+    Eigen::VectorXd frequencies;
+
+    //! Relative errors in frequencies
+    Eigen::VectorXd errorFrequencies;
+
+    //! MAC errors of the paired modes
+    Eigen::VectorXd errorsMAC;
+};
+
+/*!
+ * Throttled channel to deliver the solver progress to subscribers.
+ * The delivered progress is kept as a history which is decimated, once it exceeds the limit, so that it still spans the whole run
+ */
+class SolverProgressChannel : public QObject
+{
+    Q_OBJECT
+
+public:
+    SolverProgressChannel(int interval = 100, QObject* pParent = nullptr);
+    virtual ~SolverProgressChannel() = default;
+
+    int interval() const;
+    void setInterval(int interval);
+
+    QList<SolverProgress> history() const;
+    void setHistory(QList<SolverProgress> const& history);
+
+    void post(SolverProgress const& progress);
+    void flush();
+    void clear();
+
+signals:
+    void progressed(QList<Backend::Core::SolverProgress> const& progresses);
+
+private:
+    void schedule();
+    void appendHistory(QList<SolverProgress> const& progresses);
+
+private:
+    static int const skMaxHistory = 4096;
+
+    int mInterval;
+    mutable QMutex mMutex;
+    QList<SolverProgress> mPending;
+    QList<SolverProgress> mHistory;
+    bool mIsScheduled;
+    QElapsedTimer mTimer;
+};
+}
+
+#endif // SOLVERPROGRESS_H
@@ -1,6 +1,9 @@
 #include "subproject.h"
+#include "envelopesolver.h"
 #include "fileutility.h"
 #include "fluttersolver.h"
+#include "sensitivitysolver.h"
+#include "uncertaintysolver.h"
 
 using namespace Backend::Core;
 
@@ -66,6 +69,16 @@ int Subproject::numSolvers() const
     return mSolvers.size();
 }
 
+//! Estimate the number of bytes held by the model and solvers
+MemoryUsage Subproject::memoryUsage() const
+{
+    MemoryUsage result;
+    result.models = Utility::numBytes(mModel);
+    for (ISolver const* pSolver : mSolvers)
+        result += pSolver->memoryUsage();
+    return result;
+}
+
 QString& Subproject::name()
 {
     return mName;
@@ -210,6 +223,15 @@ ISolver* createSolver(ISolver::Type type)
     case ISolver::kFlutter:
         pSolver = new FlutterSolver;
         break;
+    case ISolver::kSensitivity:
+        pSolver = new SensitivitySolver;
+        break;
+    case ISolver::kUncertainty:
+        pSolver = new UncertaintySolver;
+        break;
+    case ISolver::kEnvelope:
+        pSolver = new EnvelopeSolver;
+        break;
     }
     return pSolver;
 }
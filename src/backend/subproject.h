@@ -33,6 +33,7 @@ public:
     KCL::Model const& model() const;
     QList<ISolver*> const& solvers() const;
     int numSolvers() const;
+    MemoryUsage memoryUsage() const;
 
     QString& name();
     KCL::Model& model();
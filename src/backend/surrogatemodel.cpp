@@ -0,0 +1,131 @@
+#include <Eigen/Dense>
+
+#include "surrogatemodel.h"
+
+using namespace Backend::Core;
+using namespace Eigen;
+
+double computeKernel(VectorXd const& first, VectorXd const& second);
+
+SurrogateSample::SurrogateSample()
+    : cost(std::numeric_limits<double>::quiet_NaN())
+{
+}
+
+//! Check if the solution has been obtained and compared with the target one
+bool SurrogateSample::isValid() const
+{
+    return outputs.size() > 0 && outputs.allFinite() && std::isfinite(cost);
+}
+
+SurrogateModel::SurrogateModel()
+{
+}
+
+bool SurrogateModel::isEmpty() const
+{
+    return mPoints.cols() == 0;
+}
+
+int SurrogateModel::numPoints() const
+{
+    return mPoints.cols();
+}
+
+int SurrogateModel::numParameters() const
+{
+    return mPoints.rows();
+}
+
+int SurrogateModel::numOutputs() const
+{
+    return mWeights.cols();
+}
+
+//! Interpolate the values given at the points (one per row). The coordinates are shifted by the center and divided by the scales
+bool SurrogateModel::fit(MatrixXd const& points, MatrixXd const& values, VectorXd const& center, VectorXd const& scales)
+{
+    clear();
+    int numPoints = points.rows();
+    int numParameters = points.cols();
+    int numOutputs = values.cols();
+    if (numPoints == 0 || values.rows() != numPoints || center.size() != numParameters || scales.size() != numParameters)
+        return false;
+
+    // Normalize the points
+    mCenter = center;
+    mScales = scales;
+    for (int i = 0; i != numParameters; ++i)
+    {
+        if (mScales[i] < std::numeric_limits<double>::epsilon())
+            mScales[i] = 1.0;
+    }
+    mPoints.resize(numParameters, numPoints);
+    for (int i = 0; i != numPoints; ++i)
+        mPoints.col(i) = normalize(points.row(i).transpose());
+
+    // Assemble the interpolation matrix augmented with the polynomial terms
+    int numTerms = 1 + numParameters;
+    int numEquations = numPoints + numTerms;
+    MatrixXd matrix = MatrixXd::Zero(numEquations, numEquations);
+    for (int i = 0; i != numPoints; ++i)
+    {
+        for (int j = i + 1; j != numPoints; ++j)
+        {
+            double kernel = computeKernel(mPoints.col(i), mPoints.col(j));
+            matrix(i, j) = kernel;
+            matrix(j, i) = kernel;
+        }
+        matrix(i, numPoints) = 1.0;
+        matrix(numPoints, i) = 1.0;
+        matrix.block(i, numPoints + 1, 1, numParameters) = mPoints.col(i).transpose();
+        matrix.block(numPoints + 1, i, numParameters, 1) = mPoints.col(i);
+    }
+    MatrixXd rhs = MatrixXd::Zero(numEquations, numOutputs);
+    rhs.topRows(numPoints) = values;
+
+    // Solve the system, so that the minimum norm solution is obtained if the samples are not enough to fit the polynomial
+    MatrixXd solution = matrix.completeOrthogonalDecomposition().solve(rhs);
+    if (!solution.allFinite())
+    {
+        clear();
+        return false;
+    }
+    mWeights = solution.topRows(numPoints);
+    mCoefficients = solution.bottomRows(numTerms);
+    return true;
+}
+
+//! Predict the values at the point
+VectorXd SurrogateModel::evaluate(double const* parameters) const
+{
+    int numPoints = mPoints.cols();
+    int numParameters = mPoints.rows();
+    VectorXd point = normalize(Map<VectorXd const>(parameters, numParameters));
+    VectorXd kernels(numPoints);
+    for (int i = 0; i != numPoints; ++i)
+        kernels[i] = computeKernel(mPoints.col(i), point);
+    VectorXd result = mWeights.transpose() * kernels + mCoefficients.row(0).transpose();
+    result += mCoefficients.bottomRows(numParameters).transpose() * point;
+    return result;
+}
+
+void SurrogateModel::clear()
+{
+    mCenter.resize(0);
+    mScales.resize(0);
+    mPoints.resize(0, 0);
+    mWeights.resize(0, 0);
+    mCoefficients.resize(0, 0);
+}
+
+VectorXd SurrogateModel::normalize(VectorXd const& parameters) const
+{
+    return (parameters - mCenter).cwiseQuotient(mScales);
+}
+
+//! Helper function to compute the cubic radial basis function
+double computeKernel(VectorXd const& first, VectorXd const& second)
+{
+    return std::pow((first - second).norm(), 3.0);
+}
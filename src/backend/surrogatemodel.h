@@ -0,0 +1,61 @@
+#ifndef SURROGATEMODEL_H
+#define SURROGATEMODEL_H
+
+#include <Eigen/Core>
+
+#include "modalsolver.h"
+
+namespace Backend::Core
+{
+
+//! True solution at the point of the parameter space used to fit the surrogate model
+struct SurrogateSample
+{
+    SurrogateSample();
+    ~SurrogateSample() = default;
+
+    bool isValid() const;
+
+    //! Values of the wrapped parameters
+    Eigen::VectorXd parameters;
+
+    //! Relative errors in frequencies followed by errors in MAC for every target mode
+    Eigen::VectorXd outputs;
+
+    //! Value of the objective function
+    double cost;
+
+    // Data retained only for the points reported to the user
+    ModalSolution modalSolution;
+    ModalComparison modalComparison;
+};
+
+//! Response surface which interpolates the samples by cubic radial basis functions augmented with a linear polynomial
+class SurrogateModel
+{
+public:
+    SurrogateModel();
+    ~SurrogateModel() = default;
+
+    bool isEmpty() const;
+    int numPoints() const;
+    int numParameters() const;
+    int numOutputs() const;
+
+    bool fit(Eigen::MatrixXd const& points, Eigen::MatrixXd const& values, Eigen::VectorXd const& center, Eigen::VectorXd const& scales);
+    Eigen::VectorXd evaluate(double const* parameters) const;
+    void clear();
+
+private:
+    Eigen::VectorXd normalize(Eigen::VectorXd const& parameters) const;
+
+private:
+    Eigen::VectorXd mCenter;
+    Eigen::VectorXd mScales;
+    Eigen::MatrixXd mPoints;
+    Eigen::MatrixXd mWeights;
+    Eigen::MatrixXd mCoefficients;
+};
+}
+
+#endif // SURROGATEMODEL_H
@@ -0,0 +1,145 @@
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QThread>
+
+#include "fileutility.h"
+#include "tracer.h"
+
+using namespace Backend;
+using namespace Backend::Core;
+
+//! Maximum number of spans kept until they are written, so that a long run does not exhaust the memory
+static qsizetype const skMaxNumEvents = 1 << 20;
+
+Tracer::Tracer()
+    : mIsEnabled(false)
+    , mNumDropped(0)
+{
+    mTimer.start();
+}
+
+//! Get the instance shared by all the solvers
+Tracer& Tracer::instance()
+{
+    static Tracer sTracer;
+    return sTracer;
+}
+
+bool Tracer::isEnabled() const
+{
+    return mIsEnabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::setEnabled(bool isEnabled)
+{
+    mIsEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+//! Get the number of nanoseconds elapsed since the tracer was created
+qint64 Tracer::timestamp() const
+{
+    return mTimer.nsecsElapsed();
+}
+
+//! Add the span executed by the current thread (thread-safe). Names must outlive the tracer. New spans are dropped if the buffer is full
+void Tracer::record(char const* name, char const* category, qint64 start, qint64 duration)
+{
+    quint64 threadID = (quint64) QThread::currentThreadId();
+    QMutexLocker locker(&mMutex);
+    if (mEvents.size() < skMaxNumEvents)
+        mEvents.push_back({name, category, start, duration, threadID});
+    else
+        ++mNumDropped;
+}
+
+bool Tracer::isEmpty() const
+{
+    QMutexLocker locker(&mMutex);
+    return mEvents.isEmpty();
+}
+
+//! Get the number of spans which have not fitted into the buffer since it was cleared
+qint64 Tracer::numDropped() const
+{
+    QMutexLocker locker(&mMutex);
+    return mNumDropped;
+}
+
+void Tracer::clear()
+{
+    QMutexLocker locker(&mMutex);
+    mEvents.clear();
+    mNumDropped = 0;
+}
+
+//! Write the spans as complete events which can be opened in Perfetto or chrome://tracing. The written spans are removed from the buffer
+bool Tracer::write(QString const& pathFile)
+{
+    QList<TraceEvent> events;
+    qint64 numDropped = 0;
+    {
+        QMutexLocker locker(&mMutex);
+        events.swap(mEvents);
+        std::swap(numDropped, mNumDropped);
+    }
+
+    // Convert the events
+    qint64 processID = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+    for (TraceEvent const& event : events)
+    {
+        QJsonObject object;
+        object["name"] = event.name;
+        object["cat"] = event.category;
+        object["ph"] = "X";
+        object["ts"] = event.start * 1e-3;
+        object["dur"] = event.duration * 1e-3;
+        object["pid"] = processID;
+        object["tid"] = (qint64) event.threadID;
+        traceEvents.append(object);
+    }
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+    root["otherData"] = QJsonObject{{"numDropped", numDropped}};
+
+    // Write the document
+    QSaveFile file(pathFile);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << QObject::tr("Could not write the trace to the file: %1").arg(pathFile);
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return file.commit();
+}
+
+//! Get the path to the trace file located next to the project
+QString Tracer::pathFile(QString const& projectPathFile)
+{
+    QFileInfo info(projectPathFile);
+    return Utility::combineFilePath(info.absolutePath(), info.completeBaseName() + ".trace.json");
+}
+
+TraceSpan::TraceSpan(char const* name, char const* category)
+    : mName(name)
+    , mCategory(category)
+    , mStart(-1)
+{
+    Tracer& tracer = Tracer::instance();
+    if (tracer.isEnabled())
+        mStart = tracer.timestamp();
+}
+
+TraceSpan::~TraceSpan()
+{
+    if (mStart < 0)
+        return;
+    Tracer& tracer = Tracer::instance();
+    tracer.record(mName, mCategory, mStart, tracer.timestamp() - mStart);
+}
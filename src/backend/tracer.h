@@ -0,0 +1,68 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+
+#include <atomic>
+
+namespace Backend::Core
+{
+
+//! Span of execution on a thread
+struct TraceEvent
+{
+    char const* name;
+    char const* category;
+    qint64 start;
+    qint64 duration;
+    quint64 threadID;
+};
+
+//! Process-wide recorder of execution spans to be exported in the Trace Event format
+class Tracer
+{
+public:
+    static Tracer& instance();
+
+    bool isEnabled() const;
+    void setEnabled(bool isEnabled);
+
+    qint64 timestamp() const;
+    void record(char const* name, char const* category, qint64 start, qint64 duration);
+
+    bool isEmpty() const;
+    qint64 numDropped() const;
+    void clear();
+
+    bool write(QString const& pathFile);
+    static QString pathFile(QString const& projectPathFile);
+
+private:
+    Tracer();
+    ~Tracer() = default;
+
+private:
+    std::atomic<bool> mIsEnabled;
+    QElapsedTimer mTimer;
+    mutable QMutex mMutex;
+    QList<TraceEvent> mEvents;
+    qint64 mNumDropped;
+};
+
+//! Span which records the duration of the enclosing scope to the tracer
+class TraceSpan
+{
+public:
+    TraceSpan(char const* name, char const* category);
+    ~TraceSpan();
+
+private:
+    char const* mName;
+    char const* mCategory;
+    qint64 mStart;
+};
+}
+
+#endif // TRACER_H
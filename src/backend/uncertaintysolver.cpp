@@ -0,0 +1,428 @@
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QXmlStreamWriter>
+
+#include "fileutility.h"
+#include "mathutility.h"
+#include "parametricstudy.h"
+#include "uncertaintysolver.h"
+
+using namespace Backend;
+using namespace Backend::Core;
+using namespace Eigen;
+
+void printStatistics(QTextStream& stream, QString const& title, VectorXd const& values);
+void printConvergence(QTextStream& stream, VectorXd const& values);
+
+UncertaintyOptions::UncertaintyOptions()
+    : numSamples(256)
+    , seed(0)
+    , deviation(0.05)
+    , numThreads(1)
+{
+}
+
+bool UncertaintyOptions::operator==(UncertaintyOptions const& another) const
+{
+    return Utility::areEqual(*this, another);
+}
+
+bool UncertaintyOptions::operator!=(UncertaintyOptions const& another) const
+{
+    return !(*this == another);
+}
+
+void UncertaintyOptions::serialize(QXmlStreamWriter& stream, QString const& elementName) const
+{
+    Utility::serializeProperties(stream, elementName, *this);
+}
+
+void UncertaintyOptions::deserialize(QXmlStreamReader& stream)
+{
+    Utility::deserializeProperties(stream, *this);
+}
+
+UncertaintySolution::UncertaintySolution()
+    : nominalFlow(std::numeric_limits<double>::quiet_NaN())
+    , nominalSpeed(std::numeric_limits<double>::quiet_NaN())
+    , nominalFrequency(std::numeric_limits<double>::quiet_NaN())
+{
+}
+
+bool UncertaintySolution::isEmpty() const
+{
+    return critSpeed.size() == 0;
+}
+
+int UncertaintySolution::numSamples() const
+{
+    return critSpeed.size();
+}
+
+//! Count the samples which flutter within the flow range
+int UncertaintySolution::numFlutter() const
+{
+    return critSpeed.array().isFinite().count();
+}
+
+bool UncertaintySolution::operator==(UncertaintySolution const& another) const
+{
+    return Utility::areEqual(*this, another);
+}
+
+bool UncertaintySolution::operator!=(UncertaintySolution const& another) const
+{
+    return !(*this == another);
+}
+
+void UncertaintySolution::serialize(QXmlStreamWriter& stream, QString const& elementName) const
+{
+    stream.writeStartElement(elementName);
+    stream.writeTextElement("nominalFlow", Utility::toString(nominalFlow));
+    stream.writeTextElement("nominalSpeed", Utility::toString(nominalSpeed));
+    stream.writeTextElement("nominalFrequency", Utility::toString(nominalFrequency));
+    Utility::serialize(stream, "critFlow", critFlow);
+    Utility::serialize(stream, "critSpeed", critSpeed);
+    Utility::serialize(stream, "critFrequency", critFrequency);
+    stream.writeEndElement();
+}
+
+void UncertaintySolution::deserialize(QXmlStreamReader& stream)
+{
+    while (stream.readNextStartElement())
+    {
+        if (stream.name() == "nominalFlow")
+            Utility::fromString(stream.readElementText(), nominalFlow);
+        else if (stream.name() == "nominalSpeed")
+            Utility::fromString(stream.readElementText(), nominalSpeed);
+        else if (stream.name() == "nominalFrequency")
+            Utility::fromString(stream.readElementText(), nominalFrequency);
+        else if (stream.name() == "critFlow")
+            Utility::deserialize(stream, critFlow);
+        else if (stream.name() == "critSpeed")
+            Utility::deserialize(stream, critSpeed);
+        else if (stream.name() == "critFrequency")
+            Utility::deserialize(stream, critFrequency);
+        else
+            stream.skipCurrentElement();
+    }
+}
+
+UncertaintySolver::UncertaintySolver()
+{
+}
+
+UncertaintySolver::UncertaintySolver(UncertaintySolver const& another)
+    : model(another.model)
+    , selector(another.selector)
+    , constraints(another.constraints)
+    , flutterOptions(another.flutterOptions)
+    , options(another.options)
+    , solution(another.solution)
+{
+}
+
+UncertaintySolver::UncertaintySolver(UncertaintySolver&& another)
+{
+    mID = std::move(another.mID);
+    model = std::move(another.model);
+    selector = std::move(another.selector);
+    constraints = std::move(another.constraints);
+    flutterOptions = std::move(another.flutterOptions);
+    options = std::move(another.options);
+    solution = std::move(another.solution);
+}
+
+UncertaintySolver& UncertaintySolver::operator=(UncertaintySolver const& another)
+{
+    model = another.model;
+    selector = another.selector;
+    constraints = another.constraints;
+    flutterOptions = another.flutterOptions;
+    options = another.options;
+    solution = another.solution;
+    return *this;
+}
+
+ISolver::Type UncertaintySolver::type() const
+{
+    return ISolver::kUncertainty;
+}
+
+ISolver* UncertaintySolver::clone() const
+{
+    UncertaintySolver* pSolver = new UncertaintySolver;
+    *pSolver = *this;
+    return pSolver;
+}
+
+void UncertaintySolver::clear()
+{
+    solution = UncertaintySolution();
+    log.clear();
+}
+
+/*! Solve the flutter problem of the models whose parameters are sampled by Latin hypercube uniformly within the relative bounds.
+ *  The spread of the critical values reflects these bounds only, since no distributions of the parameters are assumed
+ */
+void UncertaintySolver::solve()
+{
+    TraceSpan span("solve", "uncertainty");
+
+    // Clear the previous solution
+    clear();
+    appendLog("Solver started\n");
+    mProfiler.reset();
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
+    // Wrap the model using the same parameters as the optimization solver does
+    ParametricModel parametricModel(model, selector, constraints, flutterOptions.numModes);
+    QList<double> const& parameterValues = parametricModel.values();
+    QList<double> const& scales = parametricModel.scales();
+    int numParameters = parametricModel.numParameters();
+    int numSamples = std::max(0, options.numSamples);
+    if (numParameters == 0 || numSamples == 0)
+    {
+        appendLog("No parameters are selected or no samples are requested\n", QtMsgType::QtCriticalMsg);
+        emit solverFinished();
+        return;
+    }
+    appendLog(QString("Number of parameters: %1\n").arg(numParameters));
+
+    // Create the function to obtain the flutter solution at the point
+    auto solverFun = [this, &parametricModel](QList<double> const& values)
+    {
+        KCL::Model currentModel = parametricModel.unwrap(values, mProfiler);
+        flutterOptions.setAnalysisParameters(currentModel);
+        return solveFlutter(currentModel, flutterOptions.timeout, mProfiler);
+    };
+
+    // Evaluate the nominal solution
+    appendLog("* Evaluating the nominal solution\n");
+    {
+        FlutterSolution nominalSolution = solverFun(parameterValues);
+        if (nominalSolution.isEmpty())
+        {
+            appendLog("Could not evaluate the nominal solution\n", QtMsgType::QtCriticalMsg);
+            emit solverFinished();
+            return;
+        }
+        setCritData(nominalSolution, solution.nominalFlow, solution.nominalSpeed, solution.nominalFrequency);
+    }
+
+    // Sample the relative deviations, so that the same seed results in the same samples
+    double deviation = std::clamp(options.deviation, 0.0, 1.0 - std::numeric_limits<double>::epsilon());
+    MatrixXd samples;
+    {
+        ProfileTimer timer(mProfiler, "sample");
+        samples = Utility::latinHypercube(numSamples, numParameters, (quint32) options.seed);
+    }
+
+    // Solve the perturbed models concurrently, so that only the critical values are retained
+    appendLog(QString("* Evaluating %1 perturbed solutions\n").arg(numSamples));
+    double const kNaN = std::numeric_limits<double>::quiet_NaN();
+    solution.critFlow.setConstant(numSamples, kNaN);
+    solution.critSpeed.setConstant(numSamples, kNaN);
+    solution.critFrequency.setConstant(numSamples, kNaN);
+    double* pCritFlow = solution.critFlow.data();
+    double* pCritSpeed = solution.critSpeed.data();
+    double* pCritFrequency = solution.critFrequency.data();
+    std::atomic<int> numFailed = 0;
+    runConcurrently(numSamples, options.numThreads,
+                    [&](int k)
+                    {
+                        // Perturb the wrapped parameters by the sampled factors
+                        QList<double> values = parameterValues;
+                        for (int i = 0; i != numParameters; ++i)
+                        {
+                            double factor = 1.0 + deviation * (2.0 * samples(k, i) - 1.0);
+                            if (scales[i] == 0.0)
+                                values[i] += std::log10(factor);
+                            else
+                                values[i] *= factor;
+                        }
+
+                        // Retain the critical values only
+                        FlutterSolution currentSolution = solverFun(values);
+                        if (currentSolution.isEmpty())
+                        {
+                            ++numFailed;
+                            return;
+                        }
+                        setCritData(currentSolution, pCritFlow[k], pCritSpeed[k], pCritFrequency[k]);
+                    });
+    if (numFailed > 0)
+        appendLog(QString("Could not evaluate %1 perturbed solutions\n").arg(numFailed.load()), QtMsgType::QtWarningMsg);
+    appendLog("Solver terminated successfully\n");
+
+    // Log the report
+    QString message;
+    QTextStream stream(&message);
+    stream << tr("Uniform Sampling Report") << Qt::endl;
+    stream << tr("-> Parameters:   %1").arg(numParameters) << Qt::endl;
+    stream << tr("-> Samples:      %1").arg(numSamples) << Qt::endl;
+    stream << tr("-> Bounds:       ±%1%").arg(QString::number(deviation * 100, 'g', 3)) << Qt::endl;
+    stream << tr("-> Flutter:      %1").arg(solution.numFlutter()) << Qt::endl;
+    stream << tr("-> Failed:       %1").arg(numFailed.load()) << Qt::endl;
+    stream << tr("-> Nominal:      Vtas = %1, f = %2 Hz")
+                  .arg(QString::number(solution.nominalSpeed, 'g', 6), QString::number(solution.nominalFrequency, 'g', 6))
+           << Qt::endl;
+    stream << tr("-> Duration:     %1 s").arg(QString::number(totalTimer.nsecsElapsed() * 1e-9, 'f', 3)) << Qt::endl;
+    printStatistics(stream, tr("Flow"), solution.critFlow);
+    printStatistics(stream, tr("Speed"), solution.critSpeed);
+    printStatistics(stream, tr("Frequency"), solution.critFrequency);
+    printConvergence(stream, solution.critSpeed);
+    if (mProfiler.isEnabled())
+        stream << Qt::endl << tr("Profile") << Qt::endl << mProfiler.report().toString();
+    appendLog(message, QtMsgType::QtInfoMsg, "report");
+
+    emit solverFinished();
+}
+
+void UncertaintySolver::serialize(QXmlStreamWriter& stream, QString const& elementName) const
+{
+    stream.writeStartElement(elementName);
+    stream.writeAttribute("type", Utility::toString((int) type()));
+    stream.writeTextElement("id", mID.toString());
+    stream.writeTextElement("name", name);
+    Utility::serialize(stream, "model", model);
+    selector.serialize(stream, "selector");
+    constraints.serialize(stream, "constraints");
+    flutterOptions.serialize(stream, "flutterOptions");
+    options.serialize(stream, "options");
+    solution.serialize(stream, "solution");
+    log.serialize(stream, "log");
+    stream.writeEndElement();
+}
+
+void UncertaintySolver::deserialize(QXmlStreamReader& stream)
+{
+    while (stream.readNextStartElement())
+    {
+        if (stream.name() == "id")
+            mID = QUuid::fromString(stream.readElementText());
+        else if (stream.name() == "name")
+            name = stream.readElementText();
+        else if (stream.name() == "model")
+            Utility::deserialize(stream, model);
+        else if (stream.name() == "selector")
+            selector.deserialize(stream);
+        else if (stream.name() == "constraints")
+            constraints.deserialize(stream);
+        else if (stream.name() == "flutterOptions")
+            flutterOptions.deserialize(stream);
+        else if (stream.name() == "options")
+            options.deserialize(stream);
+        else if (stream.name() == "solution")
+            solution.deserialize(stream);
+        else if (stream.name() == "log")
+            log.deserialize(stream);
+        else
+            stream.skipCurrentElement();
+    }
+}
+
+bool UncertaintySolver::operator==(ISolver const* pBaseSolver) const
+{
+    if (type() != pBaseSolver->type())
+        return false;
+    UncertaintySolver* pSolver = (UncertaintySolver*) pBaseSolver;
+    return Utility::areEqual(*this, *pSolver);
+}
+
+bool UncertaintySolver::operator!=(ISolver const* pBaseSolver) const
+{
+    return !(*this == pBaseSolver);
+}
+
+//! Estimate the number of bytes held by the solver
+MemoryUsage UncertaintySolver::memoryUsage() const
+{
+    MemoryUsage result;
+    result.models = Utility::numBytes(model);
+    result.other = Utility::numBytes(solution.critFlow) + Utility::numBytes(solution.critSpeed) + Utility::numBytes(solution.critFrequency);
+    result.logs = log.numBytes();
+    return result;
+}
+
+//! Get the profiler which accumulates the durations of the solver phases
+Profiler& UncertaintySolver::profiler()
+{
+    return mProfiler;
+}
+
+void UncertaintySolver::appendLog(QString const& message, QtMsgType type, QString const& category)
+{
+    log.append(message, type, category);
+    emit logAppended(message);
+}
+
+//! Helper function to print the statistics of the finite values
+void printStatistics(QTextStream& stream, QString const& title, VectorXd const& values)
+{
+    // Slice the finite values
+    QList<double> data;
+    for (double value : values)
+    {
+        if (std::isfinite(value))
+            data.push_back(value);
+    }
+    int numData = data.size();
+    if (numData == 0)
+        return;
+    std::sort(data.begin(), data.end());
+
+    // Estimate the moments
+    VectorXd vector = Map<VectorXd>(data.data(), numData);
+    double mean = vector.mean();
+    double deviation = numData > 1 ? std::sqrt((vector.array() - mean).square().sum() / (numData - 1)) : 0.0;
+    auto percentile = [&data, numData](double ratio) { return data[std::clamp((int) std::round(ratio * (numData - 1)), 0, numData - 1)]; };
+
+    // Print the results
+    stream << Qt::endl << title << Qt::endl;
+    stream << QObject::tr("-> Mean:         %1").arg(QString::number(mean, 'g', 6)) << Qt::endl;
+    stream << QObject::tr("-> Deviation:    %1").arg(QString::number(deviation, 'g', 6)) << Qt::endl;
+    stream << QObject::tr("-> Minimum:      %1").arg(QString::number(data.first(), 'g', 6)) << Qt::endl;
+    stream << QObject::tr("-> P5:           %1").arg(QString::number(percentile(0.05), 'g', 6)) << Qt::endl;
+    stream << QObject::tr("-> P50:          %1").arg(QString::number(percentile(0.50), 'g', 6)) << Qt::endl;
+    stream << QObject::tr("-> P95:          %1").arg(QString::number(percentile(0.95), 'g', 6)) << Qt::endl;
+    stream << QObject::tr("-> Maximum:      %1").arg(QString::number(data.last(), 'g', 6)) << Qt::endl;
+}
+
+//! Helper function to print the running mean and its standard error while the number of samples is doubled
+void printConvergence(QTextStream& stream, VectorXd const& values)
+{
+    int numValues = values.size();
+    if (numValues == 0)
+        return;
+    stream << Qt::endl << QObject::tr("Convergence") << Qt::endl;
+    stream << QString("%1 %2 %3").arg(QObject::tr("Samples"), 10).arg(QObject::tr("Mean"), 14).arg(QObject::tr("Error"), 14) << Qt::endl;
+    int numFinite = 0;
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    int iCheck = 1;
+    for (int i = 0; i != numValues; ++i)
+    {
+        // Accumulate the sums
+        if (std::isfinite(values[i]))
+        {
+            ++numFinite;
+            sum += values[i];
+            sumSquares += values[i] * values[i];
+        }
+
+        // Print the statistics at the checkpoints
+        int numCurrent = i + 1;
+        if (numCurrent != iCheck && numCurrent != numValues)
+            continue;
+        iCheck *= 2;
+        if (numFinite == 0)
+            continue;
+        double mean = sum / numFinite;
+        double variance = numFinite > 1 ? std::max(0.0, (sumSquares - numFinite * mean * mean) / (numFinite - 1)) : 0.0;
+        double error = std::sqrt(variance / numFinite);
+        stream << QString("%1 %2 %3").arg(numCurrent, 10).arg(QString::number(mean, 'g', 6), 14).arg(QString::number(error, 'g', 6), 14)
+               << Qt::endl;
+    }
+}
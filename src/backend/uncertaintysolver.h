@@ -0,0 +1,138 @@
+#ifndef UNCERTAINTYSOLVER_H
+#define UNCERTAINTYSOLVER_H
+
+#include <kcl/model.h>
+
+#include "fluttersolver.h"
+#include "isolver.h"
+#include "optimconstraints.h"
+#include "optimselector.h"
+#include "profiler.h"
+#include "solverlog.h"
+#include "solvermetrics.h"
+
+namespace Backend::Core
+{
+
+struct UncertaintyOptions : public ISerializable
+{
+    Q_GADGET
+    Q_PROPERTY(int numSamples MEMBER numSamples)
+    Q_PROPERTY(int seed MEMBER seed)
+    Q_PROPERTY(double deviation MEMBER deviation)
+    Q_PROPERTY(int numThreads MEMBER numThreads)
+
+public:
+    UncertaintyOptions();
+    ~UncertaintyOptions() = default;
+
+    bool operator==(UncertaintyOptions const& another) const;
+    bool operator!=(UncertaintyOptions const& another) const;
+
+    void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
+    void deserialize(QXmlStreamReader& stream) override;
+
+    //! Number of perturbed models to solve
+    int numSamples;
+
+    //! Seed of the random generator, so that the samples are reproducible
+    int seed;
+
+    //! Half-width of the uniform sampling interval of the parameters relative to their nominal values
+    double deviation;
+
+    //! Number of flutter solutions computed concurrently
+    int numThreads;
+};
+
+struct UncertaintySolution : public ISerializable
+{
+    Q_GADGET
+    Q_PROPERTY(double nominalFlow MEMBER nominalFlow)
+    Q_PROPERTY(double nominalSpeed MEMBER nominalSpeed)
+    Q_PROPERTY(double nominalFrequency MEMBER nominalFrequency)
+    Q_PROPERTY(Eigen::VectorXd critFlow MEMBER critFlow)
+    Q_PROPERTY(Eigen::VectorXd critSpeed MEMBER critSpeed)
+    Q_PROPERTY(Eigen::VectorXd critFrequency MEMBER critFrequency)
+
+public:
+    UncertaintySolution();
+    ~UncertaintySolution() = default;
+
+    bool isEmpty() const;
+    int numSamples() const;
+    int numFlutter() const;
+
+    bool operator==(UncertaintySolution const& another) const;
+    bool operator!=(UncertaintySolution const& another) const;
+
+    void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
+    void deserialize(QXmlStreamReader& stream) override;
+
+    // Critical values of the nominal model
+    double nominalFlow;
+    double nominalSpeed;
+    double nominalFrequency;
+
+    //! Lowest critical values of every sample (NaN if there is no flutter within the flow range)
+    Eigen::VectorXd critFlow;
+    Eigen::VectorXd critSpeed;
+    Eigen::VectorXd critFrequency;
+};
+
+class UncertaintySolver : public QObject, public ISolver
+{
+    Q_OBJECT
+    Q_PROPERTY(KCL::Model model MEMBER model)
+    Q_PROPERTY(OptimSelector selector MEMBER selector)
+    Q_PROPERTY(OptimConstraints constraints MEMBER constraints)
+    Q_PROPERTY(FlutterOptions flutterOptions MEMBER flutterOptions)
+    Q_PROPERTY(UncertaintyOptions options MEMBER options)
+    Q_PROPERTY(UncertaintySolution solution MEMBER solution)
+    Q_PROPERTY(Backend::Core::SolverLog log MEMBER log)
+
+public:
+    UncertaintySolver();
+    ~UncertaintySolver() = default;
+    UncertaintySolver(UncertaintySolver const& another);
+    UncertaintySolver(UncertaintySolver&& another);
+    UncertaintySolver& operator=(UncertaintySolver const& another);
+
+    ISolver::Type type() const override;
+    ISolver* clone() const override;
+
+    void clear() override;
+    void solve() override;
+    MemoryUsage memoryUsage() const override;
+
+    void serialize(QXmlStreamWriter& stream, QString const& elementName) const override;
+    void deserialize(QXmlStreamReader& stream) override;
+
+    bool operator==(ISolver const* pBaseSolver) const override;
+    bool operator!=(ISolver const* pBaseSolver) const override;
+
+    Profiler& profiler();
+
+signals:
+    void solverFinished();
+    void logAppended(QString message);
+
+private:
+    void appendLog(QString const& message, QtMsgType type = QtMsgType::QtInfoMsg, QString const& category = QString());
+
+public:
+    QString name;
+    KCL::Model model;
+    OptimSelector selector;
+    OptimConstraints constraints;
+    FlutterOptions flutterOptions;
+    UncertaintyOptions options;
+    UncertaintySolution solution;
+    SolverLog log;
+
+private:
+    Profiler mProfiler;
+};
+}
+
+#endif // UNCERTAINTYSOLVER_H
@@ -0,0 +1,259 @@
+#include <QDir>
+#include <QJsonDocument>
+#include <QThreadPool>
+
+#include <iostream>
+
+#include "batchrunner.h"
+#include "envelopesolver.h"
+#include "fluttersolver.h"
+#include "modalsolver.h"
+#include "optimsolver.h"
+#include "sensitivitysolver.h"
+#include "uncertaintysolver.h"
+
+using namespace Batch;
+using namespace Backend::Core;
+
+BatchRunner::BatchRunner(Project& project)
+    : mProject(project)
+    , mIsProfile(false)
+{
+    mTimer.start();
+}
+
+QList<BatchJob> const& BatchRunner::jobs() const
+{
+    return mJobs;
+}
+
+//! Select the solvers by names of subprojects and solvers (empty lists select everything)
+void BatchRunner::select(QStringList const& subprojectNames, QStringList const& solverNames)
+{
+    mJobs.clear();
+    for (Subproject& subproject : mProject.subprojects())
+    {
+        if (!subprojectNames.isEmpty() && !subprojectNames.contains(subproject.name()))
+            continue;
+        for (ISolver* pSolver : subproject.solvers())
+        {
+            QString name = solverName(pSolver);
+            if (!solverNames.isEmpty() && !solverNames.contains(name))
+                continue;
+            mJobs.push_back({subproject.name(), name, pSolver});
+        }
+    }
+}
+
+//! Set the directory to write the recordings of optimization runs to (empty to disable recording)
+void BatchRunner::setRecordDirectory(QString const& pathDirectory)
+{
+    mRecordDirectory = pathDirectory;
+}
+
+//! Append the breakdown of the solver phases to the logs and optimization solutions
+void BatchRunner::setProfile(bool isProfile)
+{
+    mIsProfile = isProfile;
+}
+
+//! Run the selected solvers using the thread budget. Returns the number of failed solvers
+int BatchRunner::run(int numThreads)
+{
+    int numJobs = mJobs.size();
+    report("selected", {{"numSolvers", numJobs}, {"numThreads", numThreads}});
+
+    // Distribute the solvers among the threads
+    QThreadPool pool;
+    pool.setMaxThreadCount(std::max(1, numThreads));
+    QList<bool> statuses(numJobs, false);
+    SolverMetrics& metrics = SolverMetrics::instance();
+    metrics.changeQueueDepth(numJobs);
+    for (int i = 0; i != numJobs; ++i)
+    {
+        pool.start(
+            [this, &statuses, &metrics, i]()
+            {
+                metrics.changeQueueDepth(-1);
+                statuses[i] = runJob(mJobs[i]);
+            });
+    }
+    pool.waitForDone();
+
+    // Count the failures
+    int numFailed = statuses.count(false);
+    report("completed", {{"numSolvers", numJobs}, {"numFailed", numFailed}});
+
+    // Summarize the throughput
+    SolverMetricsSnapshot snapshot = metrics.snapshot();
+    report("metrics",
+           {{"numEvaluations", snapshot.numEvaluations},
+            {"numIterations", snapshot.numIterations},
+            {"numEigenSolves", snapshot.numEigenSolves},
+            {"eigenDuration", snapshot.eigenDuration},
+            {"eigenDedupHitRatio", snapshot.eigenDedupHitRatio},
+            {"replayHitRatio", snapshot.replayHitRatio}});
+    return numFailed;
+}
+
+//! Print the event as a single JSON line (thread-safe)
+void BatchRunner::report(QString const& event, QJsonObject object)
+{
+    object["event"] = event;
+    object["time"] = mTimer.elapsed() * 1e-3;
+    QByteArray line = QJsonDocument(object).toJson(QJsonDocument::Compact);
+    QMutexLocker locker(&mMutex);
+    std::cout << line.constData() << std::endl;
+}
+
+//! Solve the problem and report the progress
+bool BatchRunner::runJob(BatchJob const& job)
+{
+    ISolver* pSolver = job.pSolver;
+    QJsonObject info = jobInfo(job);
+    report("started", info);
+    if (Profiler* pProfiler = profiler(pSolver))
+        pProfiler->setEnabled(mIsProfile);
+
+    // Subscribe to the iterations
+    QMetaObject::Connection connection;
+    bool isRecord = false;
+    if (pSolver->type() == ISolver::kOptim)
+    {
+        OptimSolver* pOptimSolver = (OptimSolver*) pSolver;
+        isRecord = !mRecordDirectory.isEmpty();
+        if (isRecord)
+            pOptimSolver->recorder().setEnabled(true);
+        auto fun = [this, info](OptimSolution solution)
+        {
+            QJsonObject object = info;
+            object["iteration"] = solution.iteration;
+            object["cost"] = solution.cost;
+            report("iteration", object);
+        };
+        connection = QObject::connect(pOptimSolver, &OptimSolver::iterationFinished, pOptimSolver, fun, Qt::DirectConnection);
+    }
+
+    // Run the solver
+    QElapsedTimer timer;
+    timer.start();
+    pSolver->solve();
+    QObject::disconnect(connection);
+
+    // Write the recording
+    if (isRecord)
+    {
+        QString fileName = QString("%1_%2.%3").arg(job.subprojectName, job.solverName, OptimRecording::fileSuffix());
+        QString pathFile = QDir(mRecordDirectory).filePath(fileName);
+        QJsonObject object = jobInfo(job);
+        object["pathFile"] = pathFile;
+        if (((OptimSolver*) pSolver)->recorder().recording().write(pathFile))
+            report("recorded", object);
+        else
+            report("error", {{"message", QString("Could not write the recording: %1").arg(pathFile)}});
+    }
+
+    // Report the status
+    bool status = isSuccess(pSolver);
+    info["duration"] = timer.elapsed() * 1e-3;
+    info["isSuccess"] = status;
+    report("finished", info);
+    return status;
+}
+
+//! Describe the job
+QJsonObject BatchRunner::jobInfo(BatchJob const& job) const
+{
+    QJsonObject result;
+    result["subproject"] = job.subprojectName;
+    result["solver"] = job.solverName;
+    result["type"] = typeName(job.pSolver->type());
+    return result;
+}
+
+//! Retrieve the name of the solver
+QString BatchRunner::solverName(ISolver* pSolver)
+{
+    switch (pSolver->type())
+    {
+    case ISolver::kModal:
+        return ((ModalSolver*) pSolver)->name;
+    case ISolver::kOptim:
+        return ((OptimSolver*) pSolver)->name;
+    case ISolver::kFlutter:
+        return ((FlutterSolver*) pSolver)->name;
+    case ISolver::kSensitivity:
+        return ((SensitivitySolver*) pSolver)->name;
+    case ISolver::kUncertainty:
+        return ((UncertaintySolver*) pSolver)->name;
+    case ISolver::kEnvelope:
+        return ((EnvelopeSolver*) pSolver)->name;
+    }
+    return QString();
+}
+
+//! Retrieve the name of the solver type
+QString BatchRunner::typeName(ISolver::Type type)
+{
+    switch (type)
+    {
+    case ISolver::kModal:
+        return "modal";
+    case ISolver::kOptim:
+        return "optim";
+    case ISolver::kFlutter:
+        return "flutter";
+    case ISolver::kSensitivity:
+        return "sensitivity";
+    case ISolver::kUncertainty:
+        return "uncertainty";
+    case ISolver::kEnvelope:
+        return "envelope";
+    }
+    return QString();
+}
+
+//! Check whether the solver obtained a usable solution
+bool BatchRunner::isSuccess(ISolver* pSolver)
+{
+    switch (pSolver->type())
+    {
+    case ISolver::kModal:
+        return !((ModalSolver*) pSolver)->solution.isEmpty();
+    case ISolver::kOptim:
+    {
+        OptimSolver* pOptimSolver = (OptimSolver*) pSolver;
+        return !pOptimSolver->solutions.isEmpty() && pOptimSolver->solutions.last().isSuccess;
+    }
+    case ISolver::kFlutter:
+        return !((FlutterSolver*) pSolver)->solution.isEmpty();
+    case ISolver::kSensitivity:
+        return !((SensitivitySolver*) pSolver)->solution.isEmpty();
+    case ISolver::kUncertainty:
+        return !((UncertaintySolver*) pSolver)->solution.isEmpty();
+    case ISolver::kEnvelope:
+        return !((EnvelopeSolver*) pSolver)->solution.isEmpty();
+    }
+    return false;
+}
+
+//! Retrieve the profiler of the solver
+Profiler* BatchRunner::profiler(ISolver* pSolver)
+{
+    switch (pSolver->type())
+    {
+    case ISolver::kModal:
+        return &((ModalSolver*) pSolver)->profiler();
+    case ISolver::kOptim:
+        return &((OptimSolver*) pSolver)->profiler();
+    case ISolver::kFlutter:
+        return &((FlutterSolver*) pSolver)->profiler();
+    case ISolver::kSensitivity:
+        return &((SensitivitySolver*) pSolver)->profiler();
+    case ISolver::kUncertainty:
+        return &((UncertaintySolver*) pSolver)->profiler();
+    case ISolver::kEnvelope:
+        return &((EnvelopeSolver*) pSolver)->profiler();
+    }
+    return nullptr;
+}
@@ -0,0 +1,60 @@
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QMutex>
+
+#include "project.h"
+
+namespace Backend::Core
+{
+class Profiler;
+}
+
+namespace Batch
+{
+
+//! Solver selected to be run
+struct BatchJob
+{
+    QString subprojectName;
+    QString solverName;
+    Backend::Core::ISolver* pSolver;
+};
+
+//! Class to run the project solvers in parallel without GUI
+class BatchRunner
+{
+public:
+    BatchRunner(Backend::Core::Project& project);
+    ~BatchRunner() = default;
+
+    QList<BatchJob> const& jobs() const;
+    void select(QStringList const& subprojectNames, QStringList const& solverNames);
+    void setRecordDirectory(QString const& pathDirectory);
+    void setProfile(bool isProfile);
+    int run(int numThreads);
+
+    void report(QString const& event, QJsonObject object = QJsonObject());
+
+private:
+    bool runJob(BatchJob const& job);
+    QJsonObject jobInfo(BatchJob const& job) const;
+
+    static QString solverName(Backend::Core::ISolver* pSolver);
+    static QString typeName(Backend::Core::ISolver::Type type);
+    static bool isSuccess(Backend::Core::ISolver* pSolver);
+    static Backend::Core::Profiler* profiler(Backend::Core::ISolver* pSolver);
+
+private:
+    Backend::Core::Project& mProject;
+    QList<BatchJob> mJobs;
+    QString mRecordDirectory;
+    bool mIsProfile;
+    QMutex mMutex;
+    QElapsedTimer mTimer;
+};
+}
+
+#endif // BATCHRUNNER_H
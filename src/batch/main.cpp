@@ -0,0 +1,113 @@
+
+#include <config.h>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QThread>
+
+#include "batchrunner.h"
+#include "optimrecorder.h"
+#include "tracer.h"
+
+using namespace Backend::Core;
+
+int main(int argc, char* argv[])
+{
+    // Create the application
+    QCoreApplication application(argc, argv);
+    QCoreApplication::setApplicationName(QString("%1-batch").arg(APP_NAME));
+    QCoreApplication::setApplicationVersion(VERSION_FULL);
+
+    // Set up the arguments
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Run the solvers of a project without GUI. Progress is printed as JSON lines");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("project", "Project file to solve");
+    QCommandLineOption outputOption({"o", "output"}, "Write the results to the file instead of the input one", "file");
+    QCommandLineOption subprojectOption({"s", "subproject"}, "Name of the subproject to solve (repeatable, all by default)", "name");
+    QCommandLineOption solverOption({"n", "solver"}, "Name of the solver to run (repeatable, all by default)", "name");
+    QCommandLineOption threadsOption({"j", "threads"}, "Number of solvers to run in parallel", "number",
+                                     QString::number(QThread::idealThreadCount()));
+    QCommandLineOption recordOption({"r", "record"}, "Write recordings of optimization runs to the directory", "directory");
+    QCommandLineOption replayOption("replay", "Rerun the optimizer against the recorded evaluations instead of the project", "file");
+    QCommandLineOption radiusOption("radius", "Relative distance to substitute unrecorded points by the nearest ones", "number", "0");
+    QCommandLineOption profileOption({"p", "profile"}, "Append the breakdown of the solver phases to the solver logs");
+    QCommandLineOption traceOption({"t", "trace"}, "Write the execution timeline of the solvers next to the output project");
+    parser.addOptions({outputOption, subprojectOption, solverOption, threadsOption, recordOption, replayOption, radiusOption, profileOption,
+                       traceOption});
+    parser.process(application);
+    Project project;
+    Batch::BatchRunner runner(project);
+
+    // Replay the recording
+    if (parser.isSet(replayOption))
+    {
+        QString pathFile = parser.value(replayOption);
+        OptimRecording recording;
+        if (!recording.read(pathFile))
+        {
+            runner.report("error", {{"message", QString("Could not read the recording: %1").arg(pathFile)}});
+            return 1;
+        }
+        OptimReplayer replayer(recording, parser.value(radiusOption).toDouble());
+        ReplayStatistics statistics = replayer.replay();
+        runner.report("replayed", {{"pathFile", pathFile},
+                                   {"numEvaluations", statistics.numEvaluations},
+                                   {"numHits", statistics.numHits},
+                                   {"numNearest", statistics.numNearest},
+                                   {"numMisses", statistics.numMisses},
+                                   {"numIterations", statistics.numIterations},
+                                   {"initCost", statistics.initCost},
+                                   {"finalCost", statistics.finalCost},
+                                   {"duration", statistics.duration},
+                                   {"isSuccess", statistics.isSuccess},
+                                   {"message", statistics.message}});
+        return statistics.isSuccess ? 0 : 2;
+    }
+
+    // Read the project
+    QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 1)
+        parser.showHelp(1);
+    QString inputPathFile = arguments.first();
+    if (!project.read(inputPathFile))
+    {
+        runner.report("error", {{"message", QString("Could not read the project: %1").arg(inputPathFile)}});
+        return 1;
+    }
+
+    // Run the solvers
+    runner.select(parser.values(subprojectOption), parser.values(solverOption));
+    runner.setRecordDirectory(parser.value(recordOption));
+    runner.setProfile(parser.isSet(profileOption));
+    if (runner.jobs().isEmpty())
+    {
+        runner.report("error", {{"message", "No solvers match the selection"}});
+        return 1;
+    }
+    Tracer& tracer = Tracer::instance();
+    tracer.setEnabled(parser.isSet(traceOption));
+    int numFailed = runner.run(parser.value(threadsOption).toInt());
+
+    // Write the results
+    QString outputPathFile = parser.isSet(outputOption) ? parser.value(outputOption) : inputPathFile;
+    if (!project.write(outputPathFile))
+    {
+        runner.report("error", {{"message", QString("Could not write the project: %1").arg(outputPathFile)}});
+        return 1;
+    }
+    runner.report("written", {{"pathFile", outputPathFile}});
+
+    // Write the execution timeline
+    if (tracer.isEnabled())
+    {
+        QString tracePathFile = Tracer::pathFile(outputPathFile);
+        tracer.setEnabled(false);
+        if (tracer.write(tracePathFile))
+            runner.report("traced", {{"pathFile", tracePathFile}});
+        else
+            runner.report("error", {{"message", QString("Could not write the trace: %1").arg(tracePathFile)}});
+    }
+
+    return numFailed == 0 ? 0 : 2;
+}
@@ -0,0 +1,135 @@
+#include <QSplitter>
+#include <QVBoxLayout>
+
+#include "convergenceview.h"
+#include "customplot.h"
+#include "optimsolver.h"
+#include "solverprogress.h"
+#include "tableview.h"
+
+using namespace Backend;
+using namespace Frontend;
+
+ConvergenceView::ConvergenceView(Core::OptimSolver& solver)
+    : mSolver(solver)
+    , mpCostGraph(nullptr)
+    , mpErrorGraph(nullptr)
+{
+    createContent();
+    createConnections();
+}
+
+//! Clear all the items from the scene
+void ConvergenceView::clear()
+{
+    mpPlot->clearPlottables();
+    mpCostGraph = nullptr;
+    mpErrorGraph = nullptr;
+    mpTable->setProgress({});
+}
+
+//! Draw the iterations which have been already computed
+void ConvergenceView::plot()
+{
+    // Constants
+    double const kLineWidth = 1.5;
+    int const kMarkerSize = 6;
+
+    // Remove the previous data
+    clear();
+
+    // Create the graphs
+    mpCostGraph = mpPlot->addGraph(mpPlot->xAxis, mpPlot->yAxis);
+    mpCostGraph->setName(tr("Cost"));
+    mpCostGraph->setPen(QPen(Qt::blue, kLineWidth));
+    mpCostGraph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssCircle, kMarkerSize));
+    mpErrorGraph = mpPlot->addGraph(mpPlot->xAxis, mpPlot->yAxis2);
+    mpErrorGraph->setName(tr("Max error"));
+    mpErrorGraph->setPen(QPen(Qt::red, kLineWidth));
+    mpErrorGraph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssSquare, kMarkerSize));
+
+    // Set the axes
+    mpPlot->xAxis->setLabel(tr("Iteration"));
+    mpPlot->yAxis->setLabel(tr("Cost"));
+    mpPlot->yAxis->setScaleType(QCPAxis::stLogarithmic);
+    mpPlot->yAxis->setTicker(QSharedPointer<QCPAxisTickerLog>(new QCPAxisTickerLog));
+    mpPlot->yAxis2->setVisible(true);
+    mpPlot->yAxis2->setLabel(tr("Max error, %"));
+    mpPlot->legend->setVisible(true);
+
+    // Draw the iterations delivered so far, since the solutions could be appended concurrently
+    QList<Core::SolverProgress> progresses = mSolver.progressChannel().history();
+    appendProgress(progresses);
+    mpTable->setProgress(progresses);
+}
+
+//! Update the scene
+void ConvergenceView::refresh()
+{
+    plot();
+}
+
+//! Get the view type
+IView::Type ConvergenceView::type() const
+{
+    return IView::kConvergence;
+}
+
+//! Get the solver which progress is displayed
+Core::OptimSolver const& ConvergenceView::solver() const
+{
+    return mSolver;
+}
+
+//! Create all the widgets
+void ConvergenceView::createContent()
+{
+    // Constants
+    int const kHandleWidth = 10;
+
+    // Create the widgets
+    mpPlot = new CustomPlot;
+    mpTable = new TableView;
+
+    // Combine the plot and table
+    QSplitter* pSplitter = new QSplitter(Qt::Horizontal);
+    pSplitter->setHandleWidth(kHandleWidth);
+    pSplitter->addWidget(mpPlot);
+    pSplitter->addWidget(mpTable);
+    pSplitter->setStretchFactor(0, 2);
+    pSplitter->setStretchFactor(1, 1);
+
+    // Set the layout
+    QVBoxLayout* pMainLayout = new QVBoxLayout;
+    pMainLayout->addWidget(pSplitter);
+    setLayout(pMainLayout);
+}
+
+//! Subscribe to the solver progress
+void ConvergenceView::createConnections()
+{
+    connect(&mSolver.progressChannel(), &Core::SolverProgressChannel::progressed, this, &ConvergenceView::appendProgress);
+    mpTable->subscribe(mSolver.progressChannel());
+}
+
+//! Append the iterations to the graphs
+void ConvergenceView::appendProgress(QList<Core::SolverProgress> const& progresses)
+{
+    if (!mpCostGraph || !mpErrorGraph)
+        return;
+
+    // Add the data points
+    for (Core::SolverProgress const& progress : progresses)
+    {
+        double maxError = 0.0;
+        if (progress.errorFrequencies.size() > 0)
+            maxError = progress.errorFrequencies.cwiseAbs().maxCoeff() * 100;
+        mpCostGraph->addData(progress.iteration, progress.cost);
+        mpErrorGraph->addData(progress.iteration, maxError);
+    }
+
+    // Fit the data
+    mpCostGraph->rescaleAxes();
+    mpErrorGraph->rescaleValueAxis();
+    mpPlot->replot(QCustomPlot::rpQueuedReplot);
+}
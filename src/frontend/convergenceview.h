@@ -0,0 +1,51 @@
+#ifndef CONVERGENCEVIEW_H
+#define CONVERGENCEVIEW_H
+
+#include "iview.h"
+
+class QCPGraph;
+
+namespace Backend::Core
+{
+class OptimSolver;
+struct SolverProgress;
+}
+
+namespace Frontend
+{
+
+class CustomPlot;
+class TableView;
+
+//! Class to display convergence of the optimization process while it is running
+class ConvergenceView : public IView
+{
+    Q_OBJECT
+
+public:
+    ConvergenceView(Backend::Core::OptimSolver& solver);
+    virtual ~ConvergenceView() = default;
+
+    void clear() override;
+    void plot() override;
+    void refresh() override;
+    IView::Type type() const override;
+
+    Backend::Core::OptimSolver const& solver() const;
+
+private:
+    void createContent();
+    void createConnections();
+    void appendProgress(QList<Backend::Core::SolverProgress> const& progresses);
+
+private:
+    Backend::Core::OptimSolver& mSolver;
+    CustomPlot* mpPlot;
+    TableView* mpTable;
+    QCPGraph* mpCostGraph;
+    QCPGraph* mpErrorGraph;
+};
+
+}
+
+#endif // CONVERGENCEVIEW_H
@@ -2,16 +2,16 @@
 #include <set>
 
 #include "customplot.h"
+#include "matrixtable.h"
 #include "uiconstants.h"
 #include "uiutility.h"
-#include "customtable.h"
 
 using namespace Frontend;
 
 static const char* skLineStyle = "lineStyle";
 static const char* skScatterStyle = "scatterStyle";
 
-QPair<QList<double>, QList<double>> getPlottableData(QCPAbstractPlottable* pPlottable);
+void setPlottableData(QCPAbstractPlottable* pPlottable, Eigen::MatrixXd& data, int iColumn);
 
 CustomPlot::CustomPlot(QWidget* pParent)
     : QCustomPlot(pParent)
@@ -519,9 +519,8 @@ void CustomPlot::savePixmap()
 void CustomPlot::viewPlotData()
 {
     const QSize kDefaultSize(1024, 800);
-    const uint kNumHeader = 2;
     const uint kNumSubColumns = 2;
-    auto const kFormatter = [](double value) { return QString::number(value, 'g', 6); };
+    const int kPrecision = 6;
 
     uint numPlottables = plottableCount();
     int maxNumData = 0;
@@ -538,53 +537,32 @@ void CustomPlot::viewPlotData()
         maxNumData = std::max(maxNumData, numData);
     }
 
-    // Create the table to view
-    CustomTable* pTable = new CustomTable(this);
-    pTable->setWindowTitle(tr("Plot data"));
-    pTable->setWindowFlag(Qt::Window, true);
-    pTable->setAttribute(Qt::WA_DeleteOnClose, true);
-    pTable->horizontalHeader()->hide();
-    pTable->verticalHeader()->hide();
-    pTable->resize(kDefaultSize);
-
-    // Change the number of rows and columns
-    pTable->setRowCount(kNumHeader + maxNumData);
-    pTable->setColumnCount(kNumSubColumns * numPlottables);
-
-    // Add all the plottables
+    // Gather the data of all the plottables, so that the missing values are marked as NaNs
+    Eigen::MatrixXd data(maxNumData, kNumSubColumns * numPlottables);
+    data.setConstant(std::numeric_limits<double>::quiet_NaN());
+    QStringList labels(data.cols());
     for (uint iPlottable = 0; iPlottable != numPlottables; ++iPlottable)
     {
-        // Retrieve the plottable data
         QCPAbstractPlottable* pPlottable = plottable(iPlottable);
-        auto data = getPlottableData(pPlottable);
-        QList<double> const& xData = data.first;
-        QList<double> const& yData = data.second;
-
-        // Assign the header
         uint iInsert = iPlottable * kNumSubColumns;
-        pTable->setItem(0, iInsert, new QTableWidgetItem(pPlottable->name()));
-        pTable->setSpan(0, iInsert, 1, kNumSubColumns);
-        pTable->setItem(1, iInsert, new QTableWidgetItem("X"));
-        pTable->setItem(1, iInsert + 1, new QTableWidgetItem("Y"));
-
-        // Assign the data
-        uint numData = xData.size();
-        QString xText, yText;
-        for (uint iData = 0; iData != numData; ++iData)
-        {
-            xText = kFormatter(xData[iData]);
-            yText = kFormatter(yData[iData]);
-            pTable->setItem(kNumHeader + iData, iInsert, new QTableWidgetItem(xText));
-            pTable->setItem(kNumHeader + iData, iInsert + 1, new QTableWidgetItem(yText));
-        }
+        labels[iInsert] = QString("%1: X").arg(pPlottable->name());
+        labels[iInsert + 1] = QString("%1: Y").arg(pPlottable->name());
+        setPlottableData(pPlottable, data, iInsert);
     }
 
+    // Create the table to view, which formats the values on demand
+    MatrixTable* pTable = new MatrixTable(this);
+    pTable->setWindowTitle(tr("Plot data"));
+    pTable->setWindowFlag(Qt::Window, true);
+    pTable->setAttribute(Qt::WA_DeleteOnClose, true);
+    pTable->verticalHeader()->hide();
+    pTable->resize(kDefaultSize);
+    pTable->matrixModel()->setFormat('g', kPrecision);
+    pTable->matrixModel()->setMatrix(std::move(data), labels);
+
     // Resize the table
     pTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeMode::Stretch);
 
-    // Align the data
-    pTable->setDataAlignment(Qt::AlignCenter);
-
     // Show the table
     pTable->show();
 }
@@ -801,35 +779,26 @@ void PlottablePropertyEditor::setDoubleValue(QtProperty* pProperty, double value
     mpPlottable->setProperty(skScatterStyle, QVariant::fromValue(scatterStyle));
 }
 
-//! Helper function to retrieve plottable data
-QPair<QList<double>, QList<double>> getPlottableData(QCPAbstractPlottable* pPlottable)
+//! Helper function to write plottable data to the columns of the matrix
+void setPlottableData(QCPAbstractPlottable* pPlottable, Eigen::MatrixXd& data, int iColumn)
 {
-    uint numData = 0;
-    uint iData = 0;
-    QList<double> xData, yData;
+    int iData = 0;
     if (QCPGraph* pGraph = qobject_cast<QCPGraph*>(pPlottable))
     {
-        numData = pGraph->dataCount();
-        xData.resize(numData);
-        yData.resize(numData);
         QCPGraphDataContainer* pData = pGraph->data().data();
-        for (auto iter = pData->begin(); iter != pData->end(); ++iter, ++iData)
+        for (auto iter = pData->constBegin(); iter != pData->constEnd(); ++iter, ++iData)
         {
-            xData[iData] = iter->key;
-            yData[iData] = iter->value;
+            data(iData, iColumn) = iter->key;
+            data(iData, iColumn + 1) = iter->value;
         }
     }
     else if (QCPCurve* pCurve = qobject_cast<QCPCurve*>(pPlottable))
     {
-        numData = pCurve->dataCount();
-        xData.resize(numData);
-        yData.resize(numData);
         QCPCurveDataContainer* pData = pCurve->data().data();
-        for (auto iter = pData->begin(); iter != pData->end(); ++iter, ++iData)
+        for (auto iter = pData->constBegin(); iter != pData->constEnd(); ++iter, ++iData)
         {
-            xData[iData] = iter->key;
-            yData[iData] = iter->value;
+            data(iData, iColumn) = iter->key;
+            data(iData, iColumn + 1) = iter->value;
         }
     }
-    return QPair<QList<double>, QList<double>>(xData, yData);
 }
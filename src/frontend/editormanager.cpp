@@ -11,6 +11,7 @@
 #include "constantseditor.h"
 #include "constraintseditor.h"
 #include "editormanager.h"
+#include "envelopesolver.h"
 #include "fluttersolver.h"
 #include "generaldataeditor.h"
 #include "masseditor.h"
@@ -21,10 +22,12 @@
 #include "polyexponentseditor.h"
 #include "rawdataeditor.h"
 #include "selectionset.h"
+#include "sensitivitysolver.h"
 #include "solveroptionseditor.h"
 #include "springdampereditor.h"
 #include "targeteditor.h"
 #include "uiutility.h"
+#include "uncertaintysolver.h"
 
 using namespace Backend;
 using namespace Frontend;
@@ -190,6 +193,33 @@ void EditorManager::createEditor(Core::OptimTarget& target)
     connectEditCommand(pEditor, setEdited);
 }
 
+//! Create editor of sensitivity options
+void EditorManager::createEditor(Backend::Core::SensitivityOptions& options)
+{
+    Editor* pEditor = new SensitivityOptionsEditor(options, tr("Sensitivity options"));
+    addEditor(pEditor);
+    auto setEdited = [this, &options]() { emit sensitivityOptionsEdited(options); };
+    connectEditCommand(pEditor, setEdited);
+}
+
+//! Create editor of uncertainty options
+void EditorManager::createEditor(Backend::Core::UncertaintyOptions& options)
+{
+    Editor* pEditor = new UncertaintyOptionsEditor(options, tr("Uniform sampling options"));
+    addEditor(pEditor);
+    auto setEdited = [this, &options]() { emit uncertaintyOptionsEdited(options); };
+    connectEditCommand(pEditor, setEdited);
+}
+
+//! Create editor of envelope options
+void EditorManager::createEditor(Backend::Core::EnvelopeOptions& options)
+{
+    Editor* pEditor = new EnvelopeOptionsEditor(options, tr("Envelope options"));
+    addEditor(pEditor);
+    auto setEdited = [this, &options]() { emit envelopeOptionsEdited(options); };
+    connectEditCommand(pEditor, setEdited);
+}
+
 //! Set the current editor to work with
 void EditorManager::setCurrentEditor(int index)
 {
@@ -449,6 +479,9 @@ void EditObject<T>::redo()
 template class Frontend::EditProperty<Backend::Core::ModalOptions>;
 template class Frontend::EditProperty<Backend::Core::FlutterOptions>;
 template class Frontend::EditProperty<Backend::Core::OptimOptions>;
+template class Frontend::EditProperty<Backend::Core::SensitivityOptions>;
+template class Frontend::EditProperty<Backend::Core::UncertaintyOptions>;
+template class Frontend::EditProperty<Backend::Core::EnvelopeOptions>;
 template class Frontend::EditObject<Backend::Core::OptimTarget>;
 template class Frontend::EditObject<Backend::Core::OptimConstraints>;
 template class Frontend::EditObject<Eigen::VectorXi>;
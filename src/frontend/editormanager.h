@@ -27,6 +27,9 @@ class OptimConstraints;
 struct ModalSolution;
 struct OptimProblem;
 struct OptimTarget;
+struct SensitivityOptions;
+struct UncertaintyOptions;
+struct EnvelopeOptions;
 }
 
 namespace Frontend
@@ -57,7 +60,10 @@ public:
         kFlutterOptions,
         kOptimOptions,
         kConstraints,
-        kOptimTarget
+        kOptimTarget,
+        kSensitivityOptions,
+        kUncertaintyOptions,
+        kEnvelopeOptions
     };
 
     Editor() = delete;
@@ -101,6 +107,9 @@ public:
     void createEditor(Backend::Core::OptimOptions& options);
     void createEditor(Backend::Core::OptimConstraints& constraints);
     void createEditor(Backend::Core::OptimTarget& target);
+    void createEditor(Backend::Core::SensitivityOptions& options);
+    void createEditor(Backend::Core::UncertaintyOptions& options);
+    void createEditor(Backend::Core::EnvelopeOptions& options);
     void setCurrentEditor(int index);
     void refreshCurrentEditor();
 
@@ -111,6 +120,9 @@ signals:
     void optimOptionsEdited(Backend::Core::OptimOptions& options);
     void constraintsEdited(Backend::Core::OptimConstraints& constraints);
     void optimTargetEdited(Backend::Core::OptimTarget& target);
+    void sensitivityOptionsEdited(Backend::Core::SensitivityOptions& options);
+    void uncertaintyOptionsEdited(Backend::Core::UncertaintyOptions& options);
+    void envelopeOptionsEdited(Backend::Core::EnvelopeOptions& options);
 
 private:
     void createContent();
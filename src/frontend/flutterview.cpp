@@ -14,6 +14,8 @@ using namespace Frontend;
 
 QIcon getIcon(QCPScatterStyle const& style, QSize const& size, bool isLine, bool isMarker);
 void updateLimits(Edit1d* pMinEdit, Edit1d* pMaxEdit);
+QVector<QCPCurveData> decimate(QVector<QCPGraphData> const& xData, QVector<QCPGraphData> const& yData, QPair<double, double> const& limits,
+                               int numColumns);
 
 FlutterViewOptions::FlutterViewOptions()
     : indicesModes(128)
@@ -435,9 +437,18 @@ void FlutterViewEditor::setOptions()
     emit edited();
 }
 
+FlutterModeData::FlutterModeData()
+    : isMapped(false)
+    , pFrequencies(new QCPGraphDataContainer)
+    , pDecrements(new QCPGraphDataContainer)
+    , pHodograph(new QCPCurveDataContainer)
+{
+}
+
 FlutterView::FlutterView(Core::FlutterSolution const& solution, FlutterViewOptions const& options)
     : mSolution(solution)
     , mOptions(options)
+    , mIsFlowSorted(true)
 {
     createContent();
     createConnections();
@@ -459,8 +470,7 @@ void FlutterView::clear()
     mpDecrementPlot->clearPlottables();
     mpHodographPlot->clearPlottables();
     mMaskModes.clear();
-    mDecrements = Eigen::MatrixXd();
-    mFrequencies = Eigen::MatrixXd();
+    mModeData.clear();
 }
 
 //! Draw the scene
@@ -530,59 +540,116 @@ void FlutterView::createContent()
 //! Specify connections between widgets
 void FlutterView::createConnections()
 {
-    connect(mpEditor, &FlutterViewEditor::edited, this, &FlutterView::plot);
+    connect(mpEditor, &FlutterViewEditor::edited, this, &FlutterView::processEdit);
 }
 
-//! Compute the data for plotting
+//! Allocate the plotting data without mapping the roots
 void FlutterView::setData()
+{
+    // Slice dimensions
+    int numSteps = mSolution.flow.size();
+    int numModes = mSolution.roots.rows();
+
+    // Check if the graph data can be inserted without sorting
+    double const* pFlow = mSolution.flow.data();
+    mIsFlowSorted = std::is_sorted(pFlow, pFlow + numSteps);
+
+    // Create the containers, which are filled on demand
+    mModeData.resize(numModes);
+    mMappedOptions = mOptions;
+
+    // Set the mask of modes for plotting
+    setMask();
+}
+
+//! Set the mask of modes for plotting
+void FlutterView::setMask()
+{
+    int numModes = mModeData.size();
+    mMaskModes.fill(false, numModes);
+    int numRequestedModes = mOptions.indicesModes.size();
+    for (int i = 0; i != numRequestedModes; ++i)
+    {
+        int iMode = mOptions.indicesModes[i];
+        if (iMode >= 0 && iMode < numModes)
+            mMaskModes[iMode] = true;
+    }
+}
+
+//! Convert the roots of the mode to the plotting data
+void FlutterView::mapData(int iMode)
 {
     // Constants
     double const kTwoPi = 2.0 * M_PI;
     double const kThreshold = 1e-6;
+    int const kDecimationFactor = 4;
+    int const kMinNumColumns = 2048;
+
+    // Check if the data is up to date
+    FlutterModeData& data = mModeData[iMode];
+    if (data.isMapped)
+        return;
 
     // Slice dimensions
     int numSteps = mSolution.flow.size();
-    int numModes = mSolution.roots.rows();
 
-    // Set the matrices of frequencies and decrements
-    mFrequencies.resize(numModes, numSteps);
-    mDecrements.resize(numModes, numSteps);
-    for (int iMode = 0; iMode != numModes; ++iMode)
+    // Compute the frequencies and decrements
+    QVector<QCPGraphData> frequencies(numSteps);
+    QVector<QCPGraphData> decrements(numSteps);
+    for (int iStep = 0; iStep != numSteps; ++iStep)
     {
-        for (int iStep = 0; iStep != numSteps; ++iStep)
+        double realValue = mSolution.roots(iMode, iStep).real();
+        double imagValue = mSolution.roots(iMode, iStep).imag();
+        double frequency, decrement;
+        if (mOptions.showCircular)
         {
-            double realValue = mSolution.roots(iMode, iStep).real();
-            double imagValue = mSolution.roots(iMode, iStep).imag();
-            double frequency, decrement;
-            if (mOptions.showCircular)
-            {
-                frequency = imagValue;
-                decrement = realValue;
-            }
+            frequency = imagValue;
+            decrement = realValue;
+        }
+        else
+        {
+            frequency = imagValue / kTwoPi;
+            if (std::abs(imagValue) > kThreshold)
+                decrement = kTwoPi * realValue / imagValue;
             else
-            {
-                frequency = imagValue / kTwoPi;
-                if (std::abs(imagValue) > kThreshold)
-                    decrement = kTwoPi * realValue / imagValue;
-                else
-                    decrement = std::copysign(std::numeric_limits<double>::infinity(), realValue);
-            }
-            frequency = std::clamp(frequency, mOptions.limitsFrequencies.first, mOptions.limitsFrequencies.second);
-            decrement = std::clamp(decrement, mOptions.limitsDecrements.first, mOptions.limitsDecrements.second);
-            mFrequencies(iMode, iStep) = frequency;
-            mDecrements(iMode, iStep) = decrement;
+                decrement = std::copysign(std::numeric_limits<double>::infinity(), realValue);
         }
+        frequency = std::clamp(frequency, mOptions.limitsFrequencies.first, mOptions.limitsFrequencies.second);
+        decrement = std::clamp(decrement, mOptions.limitsDecrements.first, mOptions.limitsDecrements.second);
+        frequencies[iStep] = QCPGraphData(mSolution.flow[iStep], frequency);
+        decrements[iStep] = QCPGraphData(mSolution.flow[iStep], decrement);
     }
 
-    // Set the mask of modes for plotting
-    mMaskModes.resize(numModes);
-    int numRequestedModes = mOptions.indicesModes.size();
-    for (int i = 0; i != numRequestedModes; ++i)
+    // Set the graph data, which is decimated by graphs while drawing
+    data.pFrequencies->set(frequencies, mIsFlowSorted);
+    data.pDecrements->set(decrements, mIsFlowSorted);
+
+    // Set the curve data decimated by pixel columns
+    int numColumns = std::max(kMinNumColumns, kDecimationFactor * mpHodographPlot->axisRect()->width());
+    data.pHodograph->set(decimate(decrements, frequencies, mOptions.limitsDecrements, numColumns), true);
+    data.isMapped = true;
+}
+
+//! Update the plots affected by editing of the options
+void FlutterView::processEdit()
+{
+    // Invalidate the data, if the mapping of roots has been changed
+    bool isMappingChanged = mOptions.showCircular != mMappedOptions.showCircular
+                            || mOptions.limitsFrequencies != mMappedOptions.limitsFrequencies
+                            || mOptions.limitsDecrements != mMappedOptions.limitsDecrements;
+    if (isMappingChanged)
     {
-        int iMode = mOptions.indicesModes[i];
-        if (iMode >= 0 && iMode < numModes)
-            mMaskModes[iMode] = true;
+        int numModes = mModeData.size();
+        for (int i = 0; i != numModes; ++i)
+            mModeData[i].isMapped = false;
     }
+    mMappedOptions = mOptions;
+
+    // Remap the modes which are displayed
+    setMask();
+    plotVgDiagram();
+    plotHodograph();
+    mpEditor->refresh(mMaskModes, mSolution.frequencies);
 }
 
 //! Display aerodynamic Vg diagram
@@ -592,25 +659,23 @@ void FlutterView::plotVgDiagram()
     int numSteps = mSolution.flow.size();
     int numModes = mMaskModes.size();
 
-    // Get the flow values
-    QList<double> flow(numSteps);
-    for (int i = 0; i != numSteps; ++i)
-        flow[i] = mSolution.flow[i];
-
     // Process all the modes
     for (int iMode = 0; iMode != numModes; ++iMode)
     {
+        FlutterModeData& data = mModeData[iMode];
+
+        // Remove the graphs of hidden modes, but keep their data
         if (!mMaskModes[iMode])
+        {
+            if (data.pFrequencyGraph)
+                mpFrequencyPlot->removePlottable(data.pFrequencyGraph);
+            if (data.pDecrementGraph)
+                mpDecrementPlot->removePlottable(data.pDecrementGraph);
             continue;
+        }
 
         // Set the data
-        QList<double> frequency(numSteps);
-        QList<double> decrement(numSteps);
-        for (int iStep = 0; iStep != numSteps; ++iStep)
-        {
-            frequency[iStep] = mFrequencies(iMode, iStep);
-            decrement[iStep] = mDecrements(iMode, iStep);
-        }
+        mapData(iMode);
 
         // Get rendering properties
         int iColor = Utility::getRepeatedIndex(iMode, mOptions.modeColors.size());
@@ -618,13 +683,26 @@ void FlutterView::plotVgDiagram()
         QColor color = mOptions.modeColors[iColor];
         auto marker = mOptions.modeMarkers[iMarker];
 
-        // Add the graphs
+        // Add the graphs sharing the data
         QString name = Utility::getModeName(iMode, mSolution.frequencies[iMode]);
-        addGraph(mpFrequencyPlot, flow, frequency, color, marker, name);
-        addGraph(mpDecrementPlot, flow, decrement, color, marker, name);
+        if (!data.pFrequencyGraph)
+            data.pFrequencyGraph = addGraph(mpFrequencyPlot, data.pFrequencies, name);
+        if (!data.pDecrementGraph)
+            data.pDecrementGraph = addGraph(mpDecrementPlot, data.pDecrements, name);
+
+        // Set the style
+        setStyle(data.pFrequencyGraph, color, marker);
+        setStyle(data.pDecrementGraph, color, marker);
     }
 
     // Set the ranges
+    if (numSteps > 0)
+    {
+        double minFlow = mSolution.flow.minCoeff();
+        double maxFlow = mSolution.flow.maxCoeff();
+        mpFrequencyPlot->xAxis->setRange(minFlow, maxFlow);
+        mpDecrementPlot->xAxis->setRange(minFlow, maxFlow);
+    }
     mpFrequencyPlot->yAxis->setRange(mOptions.limitsFrequencies.first, mOptions.limitsFrequencies.second);
     mpDecrementPlot->yAxis->setRange(mOptions.limitsDecrements.first, mOptions.limitsDecrements.second);
 
@@ -650,23 +728,23 @@ void FlutterView::plotVgDiagram()
 void FlutterView::plotHodograph()
 {
     // Slice dimensions
-    int numSteps = mSolution.flow.size();
     int numModes = mMaskModes.size();
 
     // Process all the modes
     for (int iMode = 0; iMode != numModes; ++iMode)
     {
+        FlutterModeData& data = mModeData[iMode];
+
+        // Remove the curves of hidden modes, but keep their data
         if (!mMaskModes[iMode])
+        {
+            if (data.pHodographCurve)
+                mpHodographPlot->removePlottable(data.pHodographCurve);
             continue;
+        }
 
         // Set the data
-        QList<double> frequency(numSteps);
-        QList<double> decrement(numSteps);
-        for (int iStep = 0; iStep != numSteps; ++iStep)
-        {
-            frequency[iStep] = mFrequencies(iMode, iStep);
-            decrement[iStep] = mDecrements(iMode, iStep);
-        }
+        mapData(iMode);
 
         // Get rendering properties
         int iColor = Utility::getRepeatedIndex(iMode, mOptions.modeColors.size());
@@ -674,9 +752,13 @@ void FlutterView::plotHodograph()
         QColor color = mOptions.modeColors[iColor];
         auto marker = mOptions.modeMarkers[iMarker];
 
-        // Add the curves
+        // Add the curve sharing the data
         QString name = Utility::getModeName(iMode, mSolution.frequencies[iMode]);
-        addCurve(mpHodographPlot, decrement, frequency, color, marker, name);
+        if (!data.pHodographCurve)
+            data.pHodographCurve = addCurve(mpHodographPlot, data.pHodograph, name);
+
+        // Set the style
+        setStyle(data.pHodographCurve, color, marker);
     }
 
     // Set the ranges
@@ -696,18 +778,30 @@ void FlutterView::plotHodograph()
     mpHodographPlot->replot();
 }
 
-//! Add the graph to the specified plot
-void FlutterView::addGraph(CustomPlot* pPlot, QList<double> const& xData, QList<double> const& yData, QColor const& color, Marker marker,
-                           QString const& name)
+//! Add the graph which shares the data container
+QCPGraph* FlutterView::addGraph(CustomPlot* pPlot, QSharedPointer<QCPGraphDataContainer> pData, QString const& name)
 {
-    // Create a new graph
     QCPGraph* pGraph = pPlot->addGraph();
-    pGraph->setData(xData, yData, false);
+    pGraph->setData(pData);
     pGraph->setSelectable(QCP::SelectionType::stSingleData);
     pGraph->setAdaptiveSampling(true);
     pGraph->setName(name);
+    return pGraph;
+}
+
+//! Add the curve which shares the data container
+QCPCurve* FlutterView::addCurve(CustomPlot* pPlot, QSharedPointer<QCPCurveDataContainer> pData, QString const& name)
+{
+    QCPCurve* pCurve = new QCPCurve(pPlot->xAxis, pPlot->yAxis);
+    pCurve->setData(pData);
+    pCurve->setSelectable(QCP::SelectionType::stSingleData);
+    pCurve->setName(name);
+    return pCurve;
+}
 
-    // Set the graph style
+//! Set the graph style
+void FlutterView::setStyle(QCPGraph* pGraph, QColor const& color, Marker marker)
+{
     if (!mOptions.showMarkers)
         marker = QCPScatterStyle::ssNone;
     pGraph->setScatterStyle(QCPScatterStyle(marker, mOptions.markerSize));
@@ -716,23 +810,11 @@ void FlutterView::addGraph(CustomPlot* pPlot, QList<double> const& xData, QList<
     else
         pGraph->setLineStyle(QCPGraph::lsNone);
     pGraph->setPen(QPen(color, mOptions.lineWidth));
-
-    // Rescale the axes, so that all the graphs fit
-    bool isEnlarge = pPlot->graphCount() > 1;
-    pGraph->rescaleAxes(isEnlarge);
 }
 
-//! Add the curve to the specified plot
-void FlutterView::addCurve(CustomPlot* pPlot, QList<double> const& xData, QList<double> const& yData, QColor const& color, Marker marker,
-                           QString const& name)
+//! Set the curve style
+void FlutterView::setStyle(QCPCurve* pCurve, QColor const& color, Marker marker)
 {
-    // Create a new curve
-    QCPCurve* pCurve = new QCPCurve(pPlot->xAxis, pPlot->yAxis);
-    pCurve->setData(xData, yData);
-    pCurve->setSelectable(QCP::SelectionType::stSingleData);
-    pCurve->setName(name);
-
-    // Set the curve style
     if (!mOptions.showMarkers)
         marker = QCPScatterStyle::ssNone;
     pCurve->setScatterStyle(QCPScatterStyle(marker, mOptions.markerSize));
@@ -741,10 +823,59 @@ void FlutterView::addCurve(CustomPlot* pPlot, QList<double> const& xData, QList<
     else
         pCurve->setLineStyle(QCPCurve::lsNone);
     pCurve->setPen(QPen(color, mOptions.lineWidth));
+}
 
-    // Rescale the axes, so that all the graphs fit
-    bool isEnlarge = pPlot->graphCount() > 1;
-    pCurve->rescaleAxes(isEnlarge);
+//! Helper function to decimate the curve by keeping the first, last and extreme points of each pixel column
+QVector<QCPCurveData> decimate(QVector<QCPGraphData> const& xData, QVector<QCPGraphData> const& yData, QPair<double, double> const& limits,
+                               int numColumns)
+{
+    QVector<QCPCurveData> result;
+
+    // Slice dimensions
+    int numData = xData.size();
+    if (numData == 0)
+        return result;
+    result.reserve(std::min(numData, 4 * numColumns));
+
+    // Specify the auxiliary functions
+    double width = limits.second - limits.first;
+    auto getColumn = [&](int i)
+    {
+        if (width <= 0.0)
+            return 0;
+        return (int) std::floor((xData[i].value - limits.first) / width * numColumns);
+    };
+    auto append = [&](int i) { result.push_back(QCPCurveData(i, xData[i].value, yData[i].value)); };
+
+    // Loop through the runs of points which belong to the same column
+    int iStart = 0;
+    while (iStart != numData)
+    {
+        // Find the run
+        int iColumn = getColumn(iStart);
+        int iMin = iStart;
+        int iMax = iStart;
+        int iEnd = iStart + 1;
+        while (iEnd != numData && getColumn(iEnd) == iColumn)
+        {
+            if (yData[iEnd].value < yData[iMin].value)
+                iMin = iEnd;
+            if (yData[iEnd].value > yData[iMax].value)
+                iMax = iEnd;
+            ++iEnd;
+        }
+        int iLast = iEnd - 1;
+
+        // Keep the points in the original order
+        QList<int> indices = {iStart, std::min(iMin, iMax), std::max(iMin, iMax), iLast};
+        for (int k = 0; k != indices.size(); ++k)
+        {
+            if (k == 0 || indices[k] != indices[k - 1])
+                append(indices[k]);
+        }
+        iStart = iEnd;
+    }
+    return result;
 }
 
 //! Helper function to get icons for legend
@@ -108,6 +108,24 @@ private:
     Edit1d* mpLineWidthEdit;
 };
 
+//! Plotting data of a flutter mode shared between plottables
+struct FlutterModeData
+{
+    FlutterModeData();
+    ~FlutterModeData() = default;
+
+    // Data
+    bool isMapped;
+    QSharedPointer<QCPGraphDataContainer> pFrequencies;
+    QSharedPointer<QCPGraphDataContainer> pDecrements;
+    QSharedPointer<QCPCurveDataContainer> pHodograph;
+
+    // Plottables
+    QPointer<QCPGraph> pFrequencyGraph;
+    QPointer<QCPGraph> pDecrementGraph;
+    QPointer<QCPCurve> pHodographCurve;
+};
+
 //! Class to display flutter solution
 class FlutterView : public IView
 {
@@ -131,14 +149,17 @@ private:
 
     // Process
     void setData();
+    void setMask();
+    void mapData(int iMode);
+    void processEdit();
 
     // Plot
     void plotVgDiagram();
     void plotHodograph();
-    void addGraph(CustomPlot* pPlot, QList<double> const& xData, QList<double> const& yData, QColor const& color, Marker marker,
-                  QString const& name);
-    void addCurve(CustomPlot* pPlot, QList<double> const& xData, QList<double> const& yData, QColor const& color, Marker marker,
-                  QString const& name);
+    QCPGraph* addGraph(CustomPlot* pPlot, QSharedPointer<QCPGraphDataContainer> pData, QString const& name);
+    QCPCurve* addCurve(CustomPlot* pPlot, QSharedPointer<QCPCurveDataContainer> pData, QString const& name);
+    void setStyle(QCPGraph* pGraph, QColor const& color, Marker marker);
+    void setStyle(QCPCurve* pCurve, QColor const& color, Marker marker);
 
 private:
     Backend::Core::FlutterSolution const& mSolution;
@@ -153,9 +174,10 @@ private:
     FlutterViewEditor* mpEditor;
 
     // Data
+    bool mIsFlowSorted;
     QList<bool> mMaskModes;
-    Eigen::MatrixXd mFrequencies;
-    Eigen::MatrixXd mDecrements;
+    QList<FlutterModeData> mModeData;
+    FlutterViewOptions mMappedOptions;
 };
 
 }
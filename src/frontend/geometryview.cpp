@@ -31,6 +31,7 @@
 #include "geometryview.h"
 #include "lineedit.h"
 #include "modalsolver.h"
+#include "solverprogress.h"
 #include "uialiasdata.h"
 #include "uiconstants.h"
 #include "uiutility.h"
@@ -205,6 +206,7 @@ void GeometryView::clear()
     auto props = mRenderer->GetViewProps();
     while (props->GetLastProp())
         mRenderer->RemoveViewProp(props->GetLastProp());
+    mLegend = nullptr;
 }
 
 //! Draw the scene
@@ -674,6 +676,50 @@ void GeometryView::drawElements(vtkSmartPointer<vtkPoints> points, MatrixXi cons
     mRenderer->AddActor(actor);
 }
 
+//! Deliver the solver progress to the view
+void GeometryView::subscribe(Core::SolverProgressChannel& channel)
+{
+    connect(&channel, &Core::SolverProgressChannel::progressed, this, &GeometryView::updateProgress, Qt::UniqueConnection);
+}
+
+//! Update frequencies of the fields using the latest solver progress without redrawing the scene
+void GeometryView::updateProgress(QList<Core::SolverProgress> const& progresses)
+{
+    if (progresses.empty())
+        return;
+    Core::SolverProgress const& progress = progresses.last();
+
+    // Loop through all the fields
+    int count = numFields();
+    int numPairs = progress.indices.size();
+    bool isModified = false;
+    for (int iField = 0; iField != count; ++iField)
+    {
+        VertexField& field = mFields[iField];
+        for (int i = 0; i != numPairs; ++i)
+        {
+            if (progress.indices[i] != field.index || std::isnan(progress.frequencies[i]))
+                continue;
+
+            // Keep the names set by user
+            bool isDefaultName = field.name == Utility::getModeName(field.index, field.frequency);
+            field.frequency = progress.frequencies[i];
+            if (isDefaultName)
+                field.name = Utility::getModeName(field.index, field.frequency);
+
+            // Modify the legend entry
+            if (mLegend && iField < mLegend->GetNumberOfEntries())
+                mLegend->SetEntryString(iField, field.name.toStdString().c_str());
+            isModified = true;
+            break;
+        }
+    }
+
+    // Render the modified legend
+    if (isModified)
+        mRenderWindow->Render();
+}
+
 //! Display field names which are plotted
 void GeometryView::drawLegend()
 {
@@ -683,6 +729,7 @@ void GeometryView::drawLegend()
     double const kStep = 0.2;
 
     // Check if there are any fields
+    mLegend = nullptr;
     if (mFields.empty())
         return;
     int count = numFields();
@@ -725,6 +772,7 @@ void GeometryView::drawLegend()
 
     // Add the legend to the scene
     mRenderer->AddActor(legend);
+    mLegend = legend;
 }
 
 //! Show dialog to modify view settings
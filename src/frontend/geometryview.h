@@ -14,11 +14,14 @@ class vtkPoints;
 class vtkCellArray;
 class vtkLookupTable;
 class vtkDoubleArray;
+class vtkLegendBoxActor;
 
 namespace Backend::Core
 {
 struct Geometry;
 struct ModalSolution;
+struct SolverProgress;
+class SolverProgressChannel;
 }
 
 namespace Frontend
@@ -104,6 +107,9 @@ public:
 
     void setIsometricView();
 
+    void subscribe(Backend::Core::SolverProgressChannel& channel);
+    void updateProgress(QList<Backend::Core::SolverProgress> const& progresses);
+
 private:
     void initialize();
 
@@ -136,6 +142,7 @@ private:
     vtkSmartPointer<vtkRenderer> mRenderer;
     vtkSmartPointer<vtkCameraOrientationWidget> mOrientationWidget;
     vtkSmartPointer<vtkPoints> mUndeformedPoints;
+    vtkSmartPointer<vtkLegendBoxActor> mLegend;
     QList<unsigned long> mObserverTags;
     int mTimerId;
 };
@@ -4,22 +4,28 @@
 #include <kcl/model.h>
 #include <magicenum/magic_enum.hpp>
 
+#include "envelopesolver.h"
 #include "fluttersolver.h"
 #include "hierarchyitem.h"
 #include "modalsolver.h"
 #include "optimsolver.h"
+#include "selectionset.h"
+#include "sensitivitysolver.h"
 #include "subproject.h"
 #include "uiutility.h"
+#include "uncertaintysolver.h"
 
 using namespace Backend;
 using namespace Frontend;
 
 // Helper functions
 Core::Subproject* getSubproject(HierarchyItem* pItem);
+KCL::Model* getSelectorModel(HierarchyItem* pItem);
 KCL::Model* getModel(HierarchyItem* pItem);
 
 HierarchyItem::HierarchyItem(Type itemType)
     : mkType(itemType)
+    , mIsFetched(true)
 {
     setEditable(false);
 }
@@ -71,7 +77,7 @@ void HierarchyItem::evaluate()
     }
 
     // Retrieve the object data
-    QString objectID = QString::number(row());
+    QString objectID = key();
     QString objectPath = data(Qt::DisplayRole).toString();
 
     // Build up the identifier
@@ -87,6 +93,63 @@ void HierarchyItem::evaluate()
         mPath = QString("%1%3%2").arg(parentPath, objectPath, separator());
 }
 
+//! Retrieve the key which identifies the item among its siblings by its type and text
+QString HierarchyItem::key()
+{
+    // Count only the preceding siblings with the same text, so that inserting or removing other items does not shift the key
+    QString text = data(Qt::DisplayRole).toString();
+    QStandardItem* pParent = parent();
+    if (!pParent && model())
+        pParent = model()->invisibleRootItem();
+    int iKey = 0;
+    if (pParent)
+    {
+        int iRow = row();
+        for (int i = 0; i != iRow; ++i)
+        {
+            QStandardItem* pSibling = pParent->child(i);
+            if (pSibling->type() == mkType && pSibling->text() == text)
+                ++iKey;
+        }
+    }
+    text.replace(separator(), "|");
+    return QString("%1:%2:%3").arg(mkType).arg(text).arg(iKey);
+}
+
+//! Check if the children of the item have not been created yet
+bool HierarchyItem::canFetchMore() const
+{
+    return !mIsFetched;
+}
+
+//! Create the children of the item, if necessary
+void HierarchyItem::fetchMore()
+{
+    if (mIsFetched)
+        return;
+    mIsFetched = true;
+    appendChildren();
+}
+
+//! Remove the children of the item, so that they are recreated on the next request
+void HierarchyItem::invalidate()
+{
+    if (rowCount() > 0)
+        removeRows(0, rowCount());
+    mIsFetched = false;
+}
+
+//! Create the children of the item
+void HierarchyItem::appendChildren()
+{
+}
+
+//! Postpone creation of the children until they are requested
+void HierarchyItem::deferChildren()
+{
+    mIsFetched = false;
+}
+
 //! Set the expanded state of the hierarchy item
 void HierarchyItem::setExpanded(bool flag)
 {
@@ -147,7 +210,7 @@ SubprojectHierarchyItem::SubprojectHierarchyItem(Backend::Core::Subproject& subp
     , mSubproject(subproject)
 {
     setEditable(true);
-    appendChildren();
+    deferChildren();
 }
 
 //! Represent the subproject content
@@ -177,39 +240,89 @@ void SubprojectHierarchyItem::appendChildren()
         case Core::ISolver::kOptim:
             appendRow(new OptimSolverHierarchyItem((Core::OptimSolver*) pSolver, QObject::tr("Optim Solver %1").arg(1 + k)));
             break;
+        case Core::ISolver::kSensitivity:
+            appendRow(new SensitivitySolverHierarchyItem((Core::SensitivitySolver*) pSolver, QObject::tr("Sensitivity Solver %1").arg(1 + k)));
+            break;
+        case Core::ISolver::kUncertainty:
+            appendRow(new UncertaintySolverHierarchyItem((Core::UncertaintySolver*) pSolver, QObject::tr("Uniform Sampling Solver %1").arg(1 + k)));
+            break;
+        case Core::ISolver::kEnvelope:
+            appendRow(new EnvelopeSolverHierarchyItem((Core::EnvelopeSolver*) pSolver, QObject::tr("Envelope Solver %1").arg(1 + k)));
+            break;
         default:
             break;
         }
     }
 }
 
+QString SubprojectHierarchyItem::key()
+{
+    return mSubproject.id().toString(QUuid::WithoutBraces);
+}
+
 Core::Subproject& SubprojectHierarchyItem::subproject()
 {
     return mSubproject;
 }
 
+//! Show the memory held by the subproject as a tooltip
+QVariant SubprojectHierarchyItem::data(int role) const
+{
+    if (role == Qt::ToolTipRole)
+        return mSubproject.memoryUsage().toString();
+    return HierarchyItem::data(role);
+}
+
 //! Select items associated with the model
 void SubprojectHierarchyItem::selectItems(KCL::Model const& kclModel, QList<Core::Selection> const& selections)
 {
-    QList<HierarchyItem*> foundItems;
-    Utility::findItems(this, HierarchyItem::kModel, foundItems);
-    if (!foundItems.empty())
+    // Models are located either at the top level or inside optimization iterations, so that other branches are left unpopulated
+    fetchMore();
+    QList<ModelHierarchyItem*> modelItems;
+    int numChildren = rowCount();
+    for (int i = 0; i != numChildren; ++i)
     {
-        int numFound = foundItems.size();
-        for (int i = 0; i != numFound; ++i)
+        HierarchyItem* pBaseItem = (HierarchyItem*) child(i);
+        if (pBaseItem->type() == HierarchyItem::kModel)
+        {
+            modelItems.push_back((ModelHierarchyItem*) pBaseItem);
+        }
+        else if (pBaseItem->type() == HierarchyItem::kOptimSolver)
         {
-            ModelHierarchyItem* pModelItem = (ModelHierarchyItem*) foundItems[i];
-            if (&pModelItem->kclModel() == &kclModel)
-                pModelItem->selectItems(selections);
+            QList<HierarchyItem*> solverItems = Utility::childItems(pBaseItem);
+            for (HierarchyItem* pGroupItem : solverItems)
+            {
+                if (pGroupItem->type() != HierarchyItem::kGroupOptimSolutions)
+                    continue;
+                QList<HierarchyItem*> solutionItems = Utility::childItems(pGroupItem);
+                for (HierarchyItem* pSolutionItem : solutionItems)
+                {
+                    QList<HierarchyItem*> items = Utility::childItems(pSolutionItem);
+                    for (HierarchyItem* pItem : items)
+                    {
+                        if (pItem->type() == HierarchyItem::kModel)
+                            modelItems.push_back((ModelHierarchyItem*) pItem);
+                    }
+                }
+            }
         }
     }
+
+    // Select the elements of the matched model
+    int numModels = modelItems.size();
+    for (int i = 0; i != numModels; ++i)
+    {
+        ModelHierarchyItem* pModelItem = modelItems[i];
+        if (&pModelItem->kclModel() == &kclModel)
+            pModelItem->selectItems(selections);
+    }
 }
 
 ModelHierarchyItem::ModelHierarchyItem(KCL::Model& model)
     : HierarchyItem(kModel, QIcon(":/icons/model.svg"), QObject::tr("Model"))
     , mModel(model)
 {
-    appendChildren();
+    deferChildren();
 }
 
 void ModelHierarchyItem::appendChildren()
@@ -243,6 +356,12 @@ KCL::Model& ModelHierarchyItem::kclModel()
 //! Select model elements associated with surfaces
 void ModelHierarchyItem::selectItems(QList<Core::Selection> const& selections)
 {
+    // Pack the selections, so that each element is looked up in constant time
+    Core::SelectionSet set(mModel);
+    set.setSelected(selections, true);
+
+    // Loop through all the surfaces
+    fetchMore();
     int numChildren = rowCount();
     for (int i = 0; i != numChildren; ++i)
     {
@@ -250,7 +369,7 @@ void ModelHierarchyItem::selectItems(QList<Core::Selection> const& selections)
         if (pBaseItem->type() == HierarchyItem::kSurface)
         {
             SurfaceHierarchyItem* pItem = (SurfaceHierarchyItem*) pBaseItem;
-            pItem->selectItems(selections);
+            pItem->selectItems(set);
         }
     }
 }
@@ -261,7 +380,7 @@ SurfaceHierarchyItem::SurfaceHierarchyItem(int iSurface, KCL::ElasticSurface& su
     , mSurface(surface)
 {
     setEditable(true);
-    appendChildren();
+    deferChildren();
 }
 
 void SurfaceHierarchyItem::appendChildren()
@@ -323,28 +442,22 @@ KCL::Model* SurfaceHierarchyItem::kclModel()
 }
 
 //! Select items excluding duplicate entities
-void SurfaceHierarchyItem::selectItems(QList<Core::Selection> const& selections)
+void SurfaceHierarchyItem::selectItems(Core::SelectionSet const& selectionSet)
 {
-    // Create the mask of the selected elements
-    int numSelections = selections.size();
-    QSet<Core::Selection> selectionSet;
-    for (int i = 0; i != numSelections; ++i)
-        selectionSet.insert(selections[i]);
-
-    // Loop through all the elements associated with the surface
+    fetchMore();
     int numChildren = rowCount();
     for (int i = 0; i != numChildren; ++i)
         selectItem((HierarchyItem*) child(i), selectionSet);
 }
 
 //! Select model elements associated with the given item using the selection set
-void SurfaceHierarchyItem::selectItem(HierarchyItem* pBaseItem, QSet<Core::Selection> const& selectionSet)
+void SurfaceHierarchyItem::selectItem(HierarchyItem* pBaseItem, Core::SelectionSet const& selectionSet)
 {
     if (pBaseItem->type() == HierarchyItem::kElement)
     {
         ElementHierarchyItem* pItem = (ElementHierarchyItem*) pBaseItem;
         Core::Selection key(mkISurface, pItem->element()->type(), pItem->iElement());
-        if (selectionSet.contains(key))
+        if (selectionSet.isSelected(key))
             pItem->setSelected();
     }
     else if (pBaseItem->type() == HierarchyItem::kGroupElements)
@@ -363,6 +476,12 @@ ElementHierarchyItem::ElementHierarchyItem(int iElement, KCL::AbstractElement* p
     setIcon(Utility::getIcon(mpElement));
 }
 
+//! Identify the item by the element itself, since the element names are generated from their positions
+QString ElementHierarchyItem::key()
+{
+    return QString("%1:%2").arg(mkType).arg((quintptr) mpElement, 0, 16);
+}
+
 int ElementHierarchyItem::iSurface()
 {
     HierarchyItem* pItem = Utility::findParentByType(this, HierarchyItem::kSurface);
@@ -398,7 +517,12 @@ ModalSolverHierarchyItem::ModalSolverHierarchyItem(Core::ModalSolver* pSolver, Q
     setEditable(true);
     setText(mpSolver->name.isEmpty() ? defaultName : mpSolver->name);
     setIcon(Utility::getIcon(mpSolver));
-    appendChildren();
+    deferChildren();
+}
+
+QString ModalSolverHierarchyItem::key()
+{
+    return mpSolver->id().toString(QUuid::WithoutBraces);
 }
 
 Core::ModalSolver* ModalSolverHierarchyItem::solver()
@@ -406,6 +530,14 @@ Core::ModalSolver* ModalSolverHierarchyItem::solver()
     return mpSolver;
 }
 
+//! Show the memory held by the solver as a tooltip
+QVariant ModalSolverHierarchyItem::data(int role) const
+{
+    if (role == Qt::ToolTipRole)
+        return mpSolver->memoryUsage().toString();
+    return HierarchyItem::data(role);
+}
+
 void ModalSolverHierarchyItem::appendChildren()
 {
     appendRow(new ModalOptionsHierarchyItem(mpSolver->options));
@@ -434,7 +566,7 @@ ModalSolutionHierarchyItem::ModalSolutionHierarchyItem(Core::ModalSolution const
     : HierarchyItem(kModalSolution, QIcon(":/icons/solution.png"), name)
     , mSolution(solution)
 {
-    appendChildren();
+    deferChildren();
 }
 
 Core::ModalSolution const& ModalSolutionHierarchyItem::solution() const
@@ -517,7 +649,12 @@ FlutterSolverHierarchyItem::FlutterSolverHierarchyItem(Core::FlutterSolver* pSol
     setEditable(true);
     setText(mpSolver->name.isEmpty() ? defaultName : mpSolver->name);
     setIcon(Utility::getIcon(mpSolver));
-    appendChildren();
+    deferChildren();
+}
+
+QString FlutterSolverHierarchyItem::key()
+{
+    return mpSolver->id().toString(QUuid::WithoutBraces);
 }
 
 Core::FlutterSolver* FlutterSolverHierarchyItem::solver()
@@ -525,6 +662,14 @@ Core::FlutterSolver* FlutterSolverHierarchyItem::solver()
     return mpSolver;
 }
 
+//! Show the memory held by the solver as a tooltip
+QVariant FlutterSolverHierarchyItem::data(int role) const
+{
+    if (role == Qt::ToolTipRole)
+        return mpSolver->memoryUsage().toString();
+    return HierarchyItem::data(role);
+}
+
 void FlutterSolverHierarchyItem::appendChildren()
 {
     appendRow(new FlutterOptionsHierarchyItem(mpSolver->options));
@@ -548,7 +693,7 @@ FlutterSolutionHierarchyItem::FlutterSolutionHierarchyItem(Core::FlutterSolution
     : HierarchyItem(kFlutterSolution, QIcon(":/icons/solution.png"), QObject::tr("Flutter Solution"))
     , mSolution(solution)
 {
-    appendChildren();
+    deferChildren();
 }
 
 Core::FlutterSolution const& FlutterSolutionHierarchyItem::solution() const
@@ -642,7 +787,12 @@ OptimSolverHierarchyItem::OptimSolverHierarchyItem(Core::OptimSolver* pSolver, Q
     setEditable(true);
     setText(mpSolver->name.isEmpty() ? defaultName : mpSolver->name);
     setIcon(Utility::getIcon(mpSolver));
-    appendChildren();
+    deferChildren();
+}
+
+QString OptimSolverHierarchyItem::key()
+{
+    return mpSolver->id().toString(QUuid::WithoutBraces);
 }
 
 Core::OptimSolver* OptimSolverHierarchyItem::solver()
@@ -650,6 +800,14 @@ Core::OptimSolver* OptimSolverHierarchyItem::solver()
     return mpSolver;
 }
 
+//! Show the memory held by the solver as a tooltip
+QVariant OptimSolverHierarchyItem::data(int role) const
+{
+    if (role == Qt::ToolTipRole)
+        return mpSolver->memoryUsage().toString();
+    return HierarchyItem::data(role);
+}
+
 void OptimSolverHierarchyItem::appendChildren()
 {
     Core::OptimProblem& problem = mpSolver->problem;
@@ -695,7 +853,7 @@ OptimSelectorHierarchyItem::OptimSelectorHierarchyItem(Core::OptimSelector& sele
     : HierarchyItem(kOptimSelector, QIcon(":/icons/selector.svg"), QObject::tr("OptimSelector"))
     , mSelector(selector)
 {
-    appendChildren();
+    deferChildren();
 }
 
 Core::OptimSelector& OptimSelectorHierarchyItem::selector()
@@ -705,10 +863,7 @@ Core::OptimSelector& OptimSelectorHierarchyItem::selector()
 
 KCL::Model* OptimSelectorHierarchyItem::kclModel()
 {
-    HierarchyItem* pFoundItem = Utility::findParentByType(this, HierarchyItem::kOptimSolver);
-    if (pFoundItem)
-        return &static_cast<OptimSolverHierarchyItem*>(pFoundItem)->solver()->problem.model;
-    return nullptr;
+    return getSelectorModel(this);
 }
 
 void OptimSelectorHierarchyItem::appendChildren()
@@ -749,10 +904,7 @@ int OptimSelectionSetHierarchyItem::iSelectionSet()
 
 KCL::Model* OptimSelectionSetHierarchyItem::kclModel()
 {
-    HierarchyItem* pBaseItem = Utility::findParentByType(this, HierarchyItem::kOptimSolver);
-    if (pBaseItem)
-        return &static_cast<OptimSolverHierarchyItem*>(pBaseItem)->solver()->problem.model;
-    return nullptr;
+    return getSelectorModel(this);
 }
 
 OptimConstraintsHierarchyItem::OptimConstraintsHierarchyItem(Core::OptimConstraints& constraints)
@@ -778,7 +930,7 @@ OptimSolutionHierarchyItem::OptimSolutionHierarchyItem(int iSolution, Core::Opti
     QIcon icon(QString(":/icons/flag-%1.svg").arg(Utility::errorColorName(error, kAcceptThreshold, kCritialThreshold)));
     setText(name);
     setIcon(icon);
-    appendChildren();
+    deferChildren();
 }
 
 int OptimSolutionHierarchyItem::iSolution() const
@@ -797,13 +949,209 @@ void OptimSolutionHierarchyItem::appendChildren()
     appendRow(new ModalSolutionHierarchyItem(mSolution.modalSolution));
 }
 
-LogHierarchyItem::LogHierarchyItem(QString& log)
+SensitivitySolverHierarchyItem::SensitivitySolverHierarchyItem(Core::SensitivitySolver* pSolver, QString const& defaultName)
+    : HierarchyItem(kSensitivitySolver)
+    , mpSolver(pSolver)
+{
+    setEditable(true);
+    setText(mpSolver->name.isEmpty() ? defaultName : mpSolver->name);
+    setIcon(Utility::getIcon(mpSolver));
+    deferChildren();
+}
+
+QString SensitivitySolverHierarchyItem::key()
+{
+    return mpSolver->id().toString(QUuid::WithoutBraces);
+}
+
+Core::SensitivitySolver* SensitivitySolverHierarchyItem::solver()
+{
+    return mpSolver;
+}
+
+//! Show the memory held by the solver as a tooltip
+QVariant SensitivitySolverHierarchyItem::data(int role) const
+{
+    if (role == Qt::ToolTipRole)
+        return mpSolver->memoryUsage().toString();
+    return HierarchyItem::data(role);
+}
+
+void SensitivitySolverHierarchyItem::appendChildren()
+{
+    appendRow(new SensitivityOptionsHierarchyItem(mpSolver->options));
+    appendRow(new OptimSelectorHierarchyItem(mpSolver->selector));
+    appendRow(new OptimConstraintsHierarchyItem(mpSolver->constraints));
+    if (!mpSolver->solution.isEmpty())
+        appendRow(new SensitivitySolutionHierarchyItem(mpSolver->solution));
+    appendRow(new LogHierarchyItem(mpSolver->log));
+}
+
+SensitivityOptionsHierarchyItem::SensitivityOptionsHierarchyItem(Core::SensitivityOptions& options)
+    : HierarchyItem(kSensitivityOptions, QIcon(":/icons/options.png"), QObject::tr("Options"))
+    , mOptions(options)
+{
+}
+
+Core::SensitivityOptions& SensitivityOptionsHierarchyItem::options()
+{
+    return mOptions;
+}
+
+SensitivitySolutionHierarchyItem::SensitivitySolutionHierarchyItem(Core::SensitivitySolution const& solution)
+    : HierarchyItem(kSensitivitySolution, QIcon(":/icons/solution.png"), QObject::tr("Sensitivity Solution"))
+    , mSolution(solution)
+{
+}
+
+Core::SensitivitySolution const& SensitivitySolutionHierarchyItem::solution() const
+{
+    return mSolution;
+}
+
+UncertaintySolverHierarchyItem::UncertaintySolverHierarchyItem(Core::UncertaintySolver* pSolver, QString const& defaultName)
+    : HierarchyItem(kUncertaintySolver)
+    , mpSolver(pSolver)
+{
+    setEditable(true);
+    setText(mpSolver->name.isEmpty() ? defaultName : mpSolver->name);
+    setIcon(Utility::getIcon(mpSolver));
+    deferChildren();
+}
+
+QString UncertaintySolverHierarchyItem::key()
+{
+    return mpSolver->id().toString(QUuid::WithoutBraces);
+}
+
+Core::UncertaintySolver* UncertaintySolverHierarchyItem::solver()
+{
+    return mpSolver;
+}
+
+//! Show the memory held by the solver as a tooltip
+QVariant UncertaintySolverHierarchyItem::data(int role) const
+{
+    if (role == Qt::ToolTipRole)
+        return mpSolver->memoryUsage().toString();
+    return HierarchyItem::data(role);
+}
+
+void UncertaintySolverHierarchyItem::appendChildren()
+{
+    appendRow(new FlutterOptionsHierarchyItem(mpSolver->flutterOptions));
+    appendRow(new UncertaintyOptionsHierarchyItem(mpSolver->options));
+    appendRow(new OptimSelectorHierarchyItem(mpSolver->selector));
+    appendRow(new OptimConstraintsHierarchyItem(mpSolver->constraints));
+    if (!mpSolver->solution.isEmpty())
+        appendRow(new UncertaintySolutionHierarchyItem(mpSolver->solution));
+    appendRow(new LogHierarchyItem(mpSolver->log));
+}
+
+UncertaintyOptionsHierarchyItem::UncertaintyOptionsHierarchyItem(Core::UncertaintyOptions& options)
+    : HierarchyItem(kUncertaintyOptions, QIcon(":/icons/options.png"), QObject::tr("Uniform Sampling Options"))
+    , mOptions(options)
+{
+}
+
+Core::UncertaintyOptions& UncertaintyOptionsHierarchyItem::options()
+{
+    return mOptions;
+}
+
+UncertaintySolutionHierarchyItem::UncertaintySolutionHierarchyItem(Core::UncertaintySolution const& solution)
+    : HierarchyItem(kUncertaintySolution, QIcon(":/icons/crit.png"), QObject::tr("Uniform Sampling Solution"))
+    , mSolution(solution)
+{
+}
+
+Core::UncertaintySolution const& UncertaintySolutionHierarchyItem::solution() const
+{
+    return mSolution;
+}
+
+EnvelopeSolverHierarchyItem::EnvelopeSolverHierarchyItem(Core::EnvelopeSolver* pSolver, QString const& defaultName)
+    : HierarchyItem(kEnvelopeSolver)
+    , mpSolver(pSolver)
+{
+    setEditable(true);
+    setText(mpSolver->name.isEmpty() ? defaultName : mpSolver->name);
+    setIcon(Utility::getIcon(mpSolver));
+    deferChildren();
+}
+
+QString EnvelopeSolverHierarchyItem::key()
+{
+    return mpSolver->id().toString(QUuid::WithoutBraces);
+}
+
+Core::EnvelopeSolver* EnvelopeSolverHierarchyItem::solver()
+{
+    return mpSolver;
+}
+
+//! Show the memory held by the solver as a tooltip
+QVariant EnvelopeSolverHierarchyItem::data(int role) const
+{
+    if (role == Qt::ToolTipRole)
+        return mpSolver->memoryUsage().toString();
+    return HierarchyItem::data(role);
+}
+
+void EnvelopeSolverHierarchyItem::appendChildren()
+{
+    appendRow(new FlutterOptionsHierarchyItem(mpSolver->flutterOptions));
+    appendRow(new EnvelopeOptionsHierarchyItem(mpSolver->options));
+    if (!mpSolver->solution.isEmpty())
+        appendRow(new EnvelopeSolutionHierarchyItem(mpSolver->solution));
+    appendRow(new LogHierarchyItem(mpSolver->log));
+}
+
+EnvelopeOptionsHierarchyItem::EnvelopeOptionsHierarchyItem(Core::EnvelopeOptions& options)
+    : HierarchyItem(kEnvelopeOptions, QIcon(":/icons/options.png"), QObject::tr("Envelope Options"))
+    , mOptions(options)
+{
+}
+
+Core::EnvelopeOptions& EnvelopeOptionsHierarchyItem::options()
+{
+    return mOptions;
+}
+
+EnvelopeSolutionHierarchyItem::EnvelopeSolutionHierarchyItem(Core::EnvelopeSolution const& solution)
+    : HierarchyItem(kEnvelopeSolution, QIcon(":/icons/crit.png"), QObject::tr("Envelope Solution"))
+    , mSolution(solution)
+{
+    deferChildren();
+}
+
+Core::EnvelopeSolution const& EnvelopeSolutionHierarchyItem::solution() const
+{
+    return mSolution;
+}
+
+//! Append the full solutions of the cases, if they have been retained
+void EnvelopeSolutionHierarchyItem::appendChildren()
+{
+    int numSolutions = mSolution.solutions.size();
+    for (int i = 0; i != numSolutions; ++i)
+    {
+        if (mSolution.solutions[i].isEmpty())
+            continue;
+        FlutterSolutionHierarchyItem* pItem = new FlutterSolutionHierarchyItem(mSolution.solutions[i]);
+        if (i < mSolution.names.size())
+            pItem->setText(mSolution.names[i]);
+        appendRow(pItem);
+    }
+}
+
+LogHierarchyItem::LogHierarchyItem(Core::SolverLog& log)
     : HierarchyItem(kLog, QIcon(":/icons/log.png"), QObject::tr("Log"))
     , mLog(log)
 {
 }
 
-QString const& LogHierarchyItem::log() const
+Core::SolverLog const& LogHierarchyItem::log() const
 {
     return mLog;
 }
@@ -825,3 +1173,18 @@ KCL::Model* getModel(HierarchyItem* pItem)
         return &static_cast<ModelHierarchyItem*>(pFoundItem)->kclModel();
     return nullptr;
 }
+
+//! Helper function to find model which the selection sets of the current item refer to
+KCL::Model* getSelectorModel(HierarchyItem* pItem)
+{
+    HierarchyItem* pFoundItem = Utility::findParentByType(pItem, HierarchyItem::kOptimSolver);
+    if (pFoundItem)
+        return &static_cast<OptimSolverHierarchyItem*>(pFoundItem)->solver()->problem.model;
+    pFoundItem = Utility::findParentByType(pItem, HierarchyItem::kSensitivitySolver);
+    if (pFoundItem)
+        return &static_cast<SensitivitySolverHierarchyItem*>(pFoundItem)->solver()->model;
+    pFoundItem = Utility::findParentByType(pItem, HierarchyItem::kUncertaintySolver);
+    if (pFoundItem)
+        return &static_cast<UncertaintySolverHierarchyItem*>(pFoundItem)->solver()->model;
+    return nullptr;
+}
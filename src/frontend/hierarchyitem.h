@@ -36,7 +36,21 @@ struct OptimTarget;
 class OptimSelector;
 class SelectionSet;
 class OptimConstraints;
+
+class SensitivitySolver;
+struct SensitivityOptions;
+struct SensitivitySolution;
+
+class UncertaintySolver;
+struct UncertaintyOptions;
+struct UncertaintySolution;
+
+class EnvelopeSolver;
+struct EnvelopeOptions;
+struct EnvelopeSolution;
 struct Selection;
+
+class SolverLog;
 }
 
 namespace Frontend
@@ -70,6 +84,15 @@ public:
         kOptimConstraints,
         kGroupOptimSolutions,
         kOptimSolution,
+        kSensitivitySolver,
+        kSensitivityOptions,
+        kSensitivitySolution,
+        kUncertaintySolver,
+        kUncertaintyOptions,
+        kUncertaintySolution,
+        kEnvelopeSolver,
+        kEnvelopeOptions,
+        kEnvelopeSolution,
         kLog
     };
 
@@ -85,9 +108,19 @@ public:
     void setExpanded(bool flag = true);
     void setSelected(bool flag = true);
 
+    // Lazy population
+    bool canFetchMore() const;
+    void fetchMore();
+    void invalidate();
+
     static bool isValid(int iType);
     static QString separator();
 
+protected:
+    virtual QString key();
+    virtual void appendChildren();
+    void deferChildren();
+
 private:
     void evaluate();
 
@@ -95,6 +128,7 @@ protected:
     Type const mkType;
     QString mID;
     QString mPath;
+    bool mIsFetched;
 };
 
 class SubprojectHierarchyItem : public HierarchyItem
@@ -104,11 +138,13 @@ public:
     virtual ~SubprojectHierarchyItem() = default;
 
     Backend::Core::Subproject& subproject();
+    QVariant data(int role = Qt::UserRole + 1) const override;
 
     void selectItems(KCL::Model const& kclModel, QList<Backend::Core::Selection> const& selections);
 
 private:
-    void appendChildren();
+    QString key() override;
+    void appendChildren() override;
 
     Backend::Core::Subproject& mSubproject;
 };
@@ -125,7 +161,7 @@ public:
     void selectItems(QList<Backend::Core::Selection> const& selections);
 
 private:
-    void appendChildren();
+    void appendChildren() override;
 
     KCL::Model& mModel;
 };
@@ -140,11 +176,11 @@ public:
     KCL::ElasticSurface& surface();
     KCL::Model* kclModel();
 
-    void selectItems(QList<Backend::Core::Selection> const& selections);
-    void selectItem(HierarchyItem* pBaseItem, QSet<Backend::Core::Selection> const& selectionSet);
+    void selectItems(Backend::Core::SelectionSet const& selectionSet);
+    void selectItem(HierarchyItem* pBaseItem, Backend::Core::SelectionSet const& selectionSet);
 
 private:
-    void appendChildren();
+    void appendChildren() override;
     bool isInsertable(KCL::AbstractElement* pElement);
 
     int const mkISurface;
@@ -164,6 +200,8 @@ public:
     Backend::Core::Subproject* subproject();
 
 private:
+    QString key() override;
+
     int const mkIElement;
     KCL::AbstractElement* mpElement;
 };
@@ -175,9 +213,11 @@ public:
     virtual ~ModalSolverHierarchyItem() = default;
 
     Backend::Core::ModalSolver* solver();
+    QVariant data(int role = Qt::UserRole + 1) const override;
 
 private:
-    void appendChildren();
+    QString key() override;
+    void appendChildren() override;
 
     Backend::Core::ModalSolver* mpSolver;
 };
@@ -204,7 +244,7 @@ public:
     Backend::Core::ModalSolution const& solution() const;
 
 private:
-    void appendChildren();
+    void appendChildren() override;
 
     Backend::Core::ModalSolution const& mSolution;
 };
@@ -251,9 +291,11 @@ public:
     virtual ~FlutterSolverHierarchyItem() = default;
 
     Backend::Core::FlutterSolver* solver();
+    QVariant data(int role = Qt::UserRole + 1) const override;
 
 private:
-    void appendChildren();
+    QString key() override;
+    void appendChildren() override;
 
     Backend::Core::FlutterSolver* mpSolver;
 };
@@ -279,7 +321,7 @@ public:
     Backend::Core::FlutterSolution const& solution() const;
 
 private:
-    void appendChildren();
+    void appendChildren() override;
 
     Backend::Core::FlutterSolution const& mSolution;
 };
@@ -323,9 +365,11 @@ public:
     virtual ~OptimSolverHierarchyItem() = default;
 
     Backend::Core::OptimSolver* solver();
+    QVariant data(int role = Qt::UserRole + 1) const override;
 
 private:
-    void appendChildren();
+    QString key() override;
+    void appendChildren() override;
 
     Backend::Core::OptimSolver* mpSolver;
 };
@@ -364,7 +408,7 @@ public:
     KCL::Model* kclModel();
 
 private:
-    void appendChildren();
+    void appendChildren() override;
 
     Backend::Core::OptimSelector& mSelector;
 };
@@ -407,22 +451,144 @@ public:
     Backend::Core::OptimSolution const& solution() const;
 
 private:
-    void appendChildren();
+    void appendChildren() override;
 
     int const mkISolution;
     Backend::Core::OptimSolution& mSolution;
 };
 
+class SensitivitySolverHierarchyItem : public HierarchyItem
+{
+public:
+    SensitivitySolverHierarchyItem(Backend::Core::SensitivitySolver* pSolver, QString const& defaultName);
+    virtual ~SensitivitySolverHierarchyItem() = default;
+
+    Backend::Core::SensitivitySolver* solver();
+    QVariant data(int role = Qt::UserRole + 1) const override;
+
+private:
+    QString key() override;
+    void appendChildren() override;
+
+    Backend::Core::SensitivitySolver* mpSolver;
+};
+
+class SensitivityOptionsHierarchyItem : public HierarchyItem
+{
+public:
+    SensitivityOptionsHierarchyItem(Backend::Core::SensitivityOptions& options);
+    virtual ~SensitivityOptionsHierarchyItem() = default;
+
+    Backend::Core::SensitivityOptions& options();
+
+private:
+    Backend::Core::SensitivityOptions& mOptions;
+};
+
+class SensitivitySolutionHierarchyItem : public HierarchyItem
+{
+public:
+    SensitivitySolutionHierarchyItem(Backend::Core::SensitivitySolution const& solution);
+    virtual ~SensitivitySolutionHierarchyItem() = default;
+
+    Backend::Core::SensitivitySolution const& solution() const;
+
+private:
+    Backend::Core::SensitivitySolution const& mSolution;
+};
+
+class UncertaintySolverHierarchyItem : public HierarchyItem
+{
+public:
+    UncertaintySolverHierarchyItem(Backend::Core::UncertaintySolver* pSolver, QString const& defaultName);
+    virtual ~UncertaintySolverHierarchyItem() = default;
+
+    Backend::Core::UncertaintySolver* solver();
+    QVariant data(int role = Qt::UserRole + 1) const override;
+
+private:
+    QString key() override;
+    void appendChildren() override;
+
+    Backend::Core::UncertaintySolver* mpSolver;
+};
+
+class UncertaintyOptionsHierarchyItem : public HierarchyItem
+{
+public:
+    UncertaintyOptionsHierarchyItem(Backend::Core::UncertaintyOptions& options);
+    virtual ~UncertaintyOptionsHierarchyItem() = default;
+
+    Backend::Core::UncertaintyOptions& options();
+
+private:
+    Backend::Core::UncertaintyOptions& mOptions;
+};
+
+class UncertaintySolutionHierarchyItem : public HierarchyItem
+{
+public:
+    UncertaintySolutionHierarchyItem(Backend::Core::UncertaintySolution const& solution);
+    virtual ~UncertaintySolutionHierarchyItem() = default;
+
+    Backend::Core::UncertaintySolution const& solution() const;
+
+private:
+    Backend::Core::UncertaintySolution const& mSolution;
+};
+
+class EnvelopeSolverHierarchyItem : public HierarchyItem
+{
+public:
+    EnvelopeSolverHierarchyItem(Backend::Core::EnvelopeSolver* pSolver, QString const& defaultName);
+    virtual ~EnvelopeSolverHierarchyItem() = default;
+
+    Backend::Core::EnvelopeSolver* solver();
+    QVariant data(int role = Qt::UserRole + 1) const override;
+
+private:
+    QString key() override;
+    void appendChildren() override;
+
+    Backend::Core::EnvelopeSolver* mpSolver;
+};
+
+class EnvelopeOptionsHierarchyItem : public HierarchyItem
+{
+public:
+    EnvelopeOptionsHierarchyItem(Backend::Core::EnvelopeOptions& options);
+    virtual ~EnvelopeOptionsHierarchyItem() = default;
+
+    Backend::Core::EnvelopeOptions& options();
+
+private:
+    Backend::Core::EnvelopeOptions& mOptions;
+};
+
+class EnvelopeSolutionHierarchyItem : public HierarchyItem
+{
+public:
+    EnvelopeSolutionHierarchyItem(Backend::Core::EnvelopeSolution const& solution);
+    virtual ~EnvelopeSolutionHierarchyItem() = default;
+
+    Backend::Core::EnvelopeSolution const& solution() const;
+
+private:
+    void appendChildren() override;
+
+    Backend::Core::EnvelopeSolution const& mSolution;
+};
+
 class LogHierarchyItem : public QObject, public HierarchyItem
 {
 public:
-    LogHierarchyItem(QString& log);
+    LogHierarchyItem(Backend::Core::SolverLog& log);
     virtual ~LogHierarchyItem() = default;
 
-    QString const& log() const;
+    Backend::Core::SolverLog const& log() const;
 
 private:
-    QString& mLog;
+    Backend::Core::SolverLog& mLog;
 };
 }
 
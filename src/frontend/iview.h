@@ -12,7 +12,9 @@ public:
         kGeometry,
         kLog,
         kFlutter,
-        kTable
+        kTable,
+        kConvergence,
+        kSensitivity
     };
     virtual ~IView() = default;
     virtual void clear() = 0;
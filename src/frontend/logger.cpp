@@ -1,16 +1,45 @@
 #include <QApplication>
+#include <QThread>
 #include <QTime>
+#include <QTimer>
 
 #include "logger.h"
 #include "uiutility.h"
 
 using namespace Frontend;
 
+//! Interval between insertions of queued messages, ms
+static int const skFlushInterval = 100;
+
+//! Maximum number of queued messages
+static int const skMaxNumPending = 1000;
+
+//! Maximum number of messages of a category accepted per period
+static int const skMaxRate = 50;
+
+//! Duration of the rate limiting period, ms
+static qint64 const skRatePeriod = 1000;
+
+//! Maximum number of text blocks kept in the widget
+static int const skMaxNumBlocks = 20000;
+
 Logger::Logger(QWidget* pParent)
     : QTextEdit(pParent)
+    , mPendingOffset(0)
+    , mNumEvicted(0)
+    , mIsScheduled(false)
 {
     setReadOnly(false);
+    setUndoRedoEnabled(false);
     setFont(Utility::getMonospaceFont());
+    document()->setMaximumBlockCount(skMaxNumBlocks);
+
+    // Set the timer to insert messages in batches
+    mpFlushTimer = new QTimer(this);
+    mpFlushTimer->setSingleShot(true);
+    mpFlushTimer->setInterval(skFlushInterval);
+    connect(mpFlushTimer, &QTimer::timeout, this, &Logger::flush);
+    mClock.start();
 }
 
 Logger::~Logger()
@@ -22,24 +51,172 @@ QSize Logger::sizeHint() const
     return QSize(800, 100);
 }
 
-//! Represent a message sent
-void Logger::log(QtMsgType messageType, QString const& message)
+//! Queue a message to be shown (thread-safe). Duplicates are coalesced and frequent categories are rate limited
+void Logger::log(QtMsgType messageType, QString const& message, QString const& category)
 {
     // Constants
-    QChar kNewLine = '\n';
     QChar kComma = '\"';
 
     // Set the data to output
-    QString time = QTime::currentTime().toString();
     QString filterMessage = message;
     if (filterMessage.endsWith(kComma))
         filterMessage.removeAt(filterMessage.size() - 1);
     if (filterMessage.startsWith(kComma))
         filterMessage.removeAt(0);
+    QString key = messageKey(messageType, filterMessage);
+
+    {
+        QMutexLocker locker(&mMutex);
+
+        // Coalesce the duplicate
+        auto iter = mPendingIndices.find(key);
+        if (iter != mPendingIndices.end())
+        {
+            ++mPending[iter.value() - mPendingOffset].count;
+        }
+        else
+        {
+            // Check the rate of messages
+            if (messageType != QtFatalMsg && !acceptRate(category.isEmpty() ? "default" : category))
+                return;
+
+            // Evict the oldest message. The indices are shifted by the offset, so that they remain valid
+            if (mPending.size() >= skMaxNumPending)
+            {
+                Message const& oldest = mPending.first();
+                mPendingIndices.remove(messageKey(oldest.type, oldest.text));
+                mPending.removeFirst();
+                ++mPendingOffset;
+                ++mNumEvicted;
+            }
+
+            // Queue the message
+            mPendingIndices[key] = mPendingOffset + mPending.size();
+            mPending.push_back({messageType, filterMessage, QTime::currentTime(), 1});
+            schedule();
+        }
+    }
+
+    // Show the fatal message before the application is aborted
+    if (messageType == QtFatalMsg)
+        flushFatal();
+}
+
+//! Insert all the queued messages at once
+void Logger::flush()
+{
+    // Retrieve the messages
+    QList<Message> messages;
+    int numEvicted;
+    QList<QPair<QString, int>> suppressed;
+    {
+        QMutexLocker locker(&mMutex);
+        messages.swap(mPending);
+        mPendingIndices.clear();
+        mPendingOffset = 0;
+        numEvicted = mNumEvicted;
+        mNumEvicted = 0;
+        for (auto iter = mRates.begin(); iter != mRates.end(); ++iter)
+        {
+            if (iter->numSuppressed > 0)
+            {
+                suppressed.push_back({iter.key(), iter->numSuppressed});
+                iter->numSuppressed = 0;
+            }
+        }
+        mIsScheduled = false;
+    }
+
+    // Report the dropped messages
+    QTime time = QTime::currentTime();
+    if (numEvicted > 0)
+        messages.push_back({QtWarningMsg, tr("%1 messages were dropped due to the queue overflow").arg(numEvicted), time, 1});
+    for (auto const& [category, number] : suppressed)
+        messages.push_back({QtWarningMsg, tr("%1 messages of the category \"%2\" were suppressed").arg(number).arg(category), time, 1});
+    if (messages.isEmpty())
+        return;
+
+    // Insert the messages as a single edit
+    QTextCursor cursor(document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.beginEditBlock();
+    for (Message const& message : messages)
+        insertMessage(cursor, message);
+    cursor.endEditBlock();
+
+    // Scroll to bottom
+    moveCursor(QTextCursor::End);
+}
+
+//! Check whether a message of the category can be accepted within the current period
+bool Logger::acceptRate(QString const& category)
+{
+    qint64 now = mClock.elapsed();
+    Rate& rate = mRates[category];
+    if (rate.numAccepted == 0 || now - rate.start >= skRatePeriod)
+    {
+        rate.start = now;
+        rate.numAccepted = 0;
+    }
+    if (rate.numAccepted >= skMaxRate)
+    {
+        ++rate.numSuppressed;
+        schedule();
+        return false;
+    }
+    ++rate.numAccepted;
+    return true;
+}
+
+//! Request the insertion of the queued messages (the mutex must be locked)
+void Logger::schedule()
+{
+    if (mIsScheduled)
+        return;
+    mIsScheduled = true;
+    QMetaObject::invokeMethod(
+        this,
+        [this]()
+        {
+            if (!mpFlushTimer->isActive())
+                mpFlushTimer->start();
+        },
+        Qt::QueuedConnection);
+}
+
+//! Insert the queued messages and repaint the widget immediately, since the event loop will not run again
+void Logger::flushFatal()
+{
+    auto fun = [this]()
+    {
+        flush();
+        viewport()->repaint();
+    };
+    if (QThread::currentThread() == thread())
+        fun();
+    else
+        QMetaObject::invokeMethod(this, fun, Qt::BlockingQueuedConnection);
+}
+
+//! Insert the message at the cursor position
+void Logger::insertMessage(QTextCursor& cursor, Message const& message)
+{
+    // Constants
+    QChar kNewLine = '\n';
+
+    // Set the data to output
+    QString time = message.time.toString();
+    QString text = message.text;
+    if (message.count > 1)
+    {
+        if (text.endsWith(kNewLine))
+            text.chop(1);
+        text.append(tr(" (repeated %1 times)").arg(message.count));
+    }
 
     // Determine the message color
     QColor color;
-    switch (messageType)
+    switch (message.type)
     {
     case QtDebugMsg:
         color = Qt::gray;
@@ -66,17 +243,19 @@ void Logger::log(QtMsgType messageType, QString const& message)
     messageFormat.setForeground(QBrush(color));
 
     // Insert the text
-    QTextCursor cursor = textCursor();
     if (document()->characterCount() > 0)
         cursor.insertText(kNewLine);
     cursor.insertText(time, timeFormat);
     cursor.insertText(kNewLine);
-    cursor.insertText(filterMessage, messageFormat);
+    cursor.insertText(text, messageFormat);
 
     // Insert a new line, if necessary
-    if (message.back() != kNewLine)
+    if (!text.endsWith(kNewLine))
         cursor.insertText(kNewLine);
+}
 
-    // Scroll to bottom
-    moveCursor(QTextCursor::End);
+//! Build the key to find duplicates of the message
+QString Logger::messageKey(QtMsgType type, QString const& text)
+{
+    return QString("%1:%2").arg((int) type).arg(text);
 }
@@ -2,12 +2,18 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
 #include <QTextEdit>
+#include <QTime>
+
+QT_FORWARD_DECLARE_CLASS(QTimer)
 
 namespace Frontend
 {
 
-//! Log all the messages sent
+//! Log all the messages sent. Messages are queued from any thread and inserted in batches
 class Logger : public QTextEdit
 {
     Q_OBJECT
@@ -19,7 +25,43 @@ public:
     virtual ~Logger();
 
     QSize sizeHint() const override;
-    void log(QtMsgType messageType, QString const& message);
+    void log(QtMsgType messageType, QString const& message, QString const& category = QString());
+    void flush();
+
+private:
+    //! Queued message with the number of its repetitions
+    struct Message
+    {
+        QtMsgType type;
+        QString text;
+        QTime time;
+        int count;
+    };
+
+    //! Number of messages accepted and suppressed within the current period
+    struct Rate
+    {
+        qint64 start;
+        int numAccepted;
+        int numSuppressed;
+    };
+
+    bool acceptRate(QString const& category);
+    void schedule();
+    void flushFatal();
+    void insertMessage(QTextCursor& cursor, Message const& message);
+    static QString messageKey(QtMsgType type, QString const& text);
+
+private:
+    QMutex mMutex;
+    QList<Message> mPending;
+    QHash<QString, qint64> mPendingIndices;
+    qint64 mPendingOffset;
+    QHash<QString, Rate> mRates;
+    int mNumEvicted;
+    bool mIsScheduled;
+    QElapsedTimer mClock;
+    QTimer* mpFlushTimer;
 };
 
 }
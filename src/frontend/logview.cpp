@@ -1,11 +1,16 @@
-#include <QTextEdit>
+#include <QPlainTextEdit>
+#include <QScrollBar>
 #include <QVBoxLayout>
 
 #include "logview.h"
 #include "uiutility.h"
 
+using namespace Backend::Core;
 using namespace Frontend;
 
+//! Maximum number of text blocks kept in the view
+static int const skMaxNumBlocks = 100000;
+
 LogHighlighter::LogHighlighter(QTextDocument* pParent)
     : QSyntaxHighlighter(pParent)
 {
@@ -69,8 +74,11 @@ void LogHighlighter::highlightBlock(QString const& text)
     }
 }
 
-LogView::LogView(QString const& log)
+LogView::LogView(SolverLog const& log)
     : mLog(log)
+    , mNumRendered(0)
+    , mGeneration(log.generation())
+    , mIsPending(false)
 {
     createContent();
 }
@@ -83,19 +91,32 @@ LogView::~LogView()
 void LogView::clear()
 {
     mpEdit->clear();
+    mNumRendered = 0;
 }
 
-//! Display the log text
+//! Display all the log records
 void LogView::plot()
 {
     clear();
-    mpEdit->setText(mLog);
+    refresh();
 }
 
-//! Update the log text
+//! Display the records appended since the last update
 void LogView::refresh()
 {
-    plot();
+    if (!isVisible())
+    {
+        mIsPending = true;
+        return;
+    }
+    mIsPending = false;
+    qint64 generation = mLog.generation();
+    if (generation != mGeneration)
+    {
+        clear();
+        mGeneration = generation;
+    }
+    appendRecords();
 }
 
 //! Get the view type
@@ -105,17 +126,27 @@ IView::Type LogView::type() const
 }
 
 //! Retrieve the current log
-QString const& LogView::log() const
+SolverLog const& LogView::log() const
 {
     return mLog;
 }
 
+//! Render the records which were requested while the view was hidden
+void LogView::showEvent(QShowEvent* pEvent)
+{
+    IView::showEvent(pEvent);
+    if (mIsPending)
+        refresh();
+}
+
 //! Create all the widgets
 void LogView::createContent()
 {
     // Create the text widget
-    mpEdit = new QTextEdit;
+    mpEdit = new QPlainTextEdit;
     mpEdit->setReadOnly(true);
+    mpEdit->setUndoRedoEnabled(false);
+    mpEdit->setMaximumBlockCount(skMaxNumBlocks);
     mpEdit->setFont(Utility::getMonospaceFont());
 
     // Create the text highlighter
@@ -126,3 +157,25 @@ void LogView::createContent()
     pLayout->addWidget(mpEdit);
     setLayout(pLayout);
 }
+
+//! Insert the records which have not been rendered yet at the end of the text
+void LogView::appendRecords()
+{
+    QList<LogRecord> records = mLog.records(mNumRendered, &mNumRendered);
+    if (records.isEmpty())
+        return;
+
+    // Format the records
+    QString text;
+    for (LogRecord const& record : records)
+        text.append(SolverLog::format(record));
+
+    // Insert the text keeping the scroll position, unless it is at the end
+    QScrollBar* pScrollBar = mpEdit->verticalScrollBar();
+    bool isEnd = pScrollBar->value() == pScrollBar->maximum();
+    QTextCursor cursor(mpEdit->document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.insertText(text);
+    if (isEnd)
+        pScrollBar->setValue(pScrollBar->maximum());
+}
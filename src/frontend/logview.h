@@ -5,8 +5,9 @@
 #include <QSyntaxHighlighter>
 
 #include "iview.h"
+#include "solverlog.h"
 
-QT_FORWARD_DECLARE_CLASS(QTextEdit)
+QT_FORWARD_DECLARE_CLASS(QPlainTextEdit)
 
 namespace Frontend
 {
@@ -34,13 +35,13 @@ private:
     QVector<HighlightingRule> mRules;
 };
 
-//! Class to display solver log
+//! Class to display solver log. Records are rendered when the view is shown and appended incrementally
 class LogView : public IView
 {
     Q_OBJECT
 
 public:
-    LogView(QString const& log);
+    LogView(Backend::Core::SolverLog const& log);
     virtual ~LogView();
 
     void clear() override;
@@ -48,15 +49,22 @@ public:
     void refresh() override;
     IView::Type type() const override;
 
-    QString const& log() const;
+    Backend::Core::SolverLog const& log() const;
+
+protected:
+    void showEvent(QShowEvent* pEvent) override;
 
 private:
     void createContent();
+    void appendRecords();
 
 private:
-    QString const& mLog;
-    QTextEdit* mpEdit;
+    Backend::Core::SolverLog const& mLog;
+    QPlainTextEdit* mpEdit;
     LogHighlighter* mpHighlighter;
+    qint64 mNumRendered;
+    qint64 mGeneration;
+    bool mIsPending;
 };
 
 }
@@ -3,19 +3,26 @@
 #include <QCloseEvent>
 #include <QFileDialog>
 #include <QFontDatabase>
+#include <QLabel>
 #include <QMenuBar>
 #include <QMessageBox>
+#include <QStatusBar>
+#include <QTimer>
 #include <QToolBar>
 
 #include "config.h"
+#include "envelopesolver.h"
 #include "fluttersolver.h"
 #include "logger.h"
 #include "mainwindow.h"
 #include "modalsolver.h"
 #include "optimsolver.h"
 #include "projectbrowser.h"
+#include "sensitivitysolver.h"
+#include "solvermetrics.h"
 #include "uiconstants.h"
 #include "uiutility.h"
+#include "uncertaintysolver.h"
 #include "viewmanager.h"
 
 using namespace ads;
@@ -174,6 +181,9 @@ void MainWindow::createContent()
     // Create logger
     pWidget = createLogger();
     mpDockManager->addDockWidget(ads::BottomDockWidgetArea, pWidget, pArea);
+
+    // Show the solver throughput
+    createStatusBar();
 }
 
 //! Create the dock manager and specify its configuration
@@ -224,6 +234,21 @@ ads::CDockWidget* MainWindow::createLogger()
     return pDockWidget;
 }
 
+//! Create the status bar which displays the solver metrics
+void MainWindow::createStatusBar()
+{
+    mpMetricsLabel = new QLabel;
+    mpMetricsLabel->setToolTip(tr("Throughput of the running solvers. The deduplicated eigen solves count only the solutions reused at "
+                                  "the points which an optimization evaluates again"));
+    statusBar()->addPermanentWidget(mpMetricsLabel);
+
+    // Poll the metrics registry
+    mpMetricsTimer = new QTimer(this);
+    mpMetricsTimer->setInterval(Constants::Metrics::skPollInterval);
+    connect(mpMetricsTimer, &QTimer::timeout, this, &MainWindow::updateMetrics);
+    mpMetricsTimer->start();
+}
+
 //! Connect the widgets between each other
 void MainWindow::createConnections()
 {
@@ -257,7 +282,6 @@ void MainWindow::createConnections()
             {
                 setModified(true);
                 mpViewManager->setSelectionByView(model, selectionSet);
-                mpProjectBrowser->refresh();
             });
 
     // View manager
@@ -606,13 +630,40 @@ void MainWindow::updateSolvers(KCL::Model const& model)
             pSolver->problem.selector.update(model);
             break;
         }
+        case Core::ISolver::kSensitivity:
+        {
+            Core::SensitivitySolver* pSolver = (Core::SensitivitySolver*) pBaseSolver;
+            pSolver->model = model;
+            pSolver->selector.update(model);
+            break;
+        }
+        case Core::ISolver::kUncertainty:
+        {
+            Core::UncertaintySolver* pSolver = (Core::UncertaintySolver*) pBaseSolver;
+            pSolver->model = model;
+            pSolver->selector.update(model);
+            break;
+        }
+        case Core::ISolver::kEnvelope:
+            static_cast<Core::EnvelopeSolver*>(pBaseSolver)->model = model;
+            break;
         }
     }
 }
 
+//! Display the latest solver metrics
+void MainWindow::updateMetrics()
+{
+    Core::SolverMetricsSnapshot snapshot = Core::SolverMetrics::instance().snapshot();
+    if (snapshot.isIdle())
+        mpMetricsLabel->clear();
+    else
+        mpMetricsLabel->setText(snapshot.toString());
+}
+
 //! Helper function to log all the messages
-void Frontend::logMessage(QtMsgType type, QMessageLogContext const& /*context*/, QString const& message)
+void Frontend::logMessage(QtMsgType type, QMessageLogContext const& context, QString const& message)
 {
     if (Frontend::MainWindow::pLogger)
-        Frontend::MainWindow::pLogger->log(type, message);
+        Frontend::MainWindow::pLogger->log(type, message, context.category);
 }
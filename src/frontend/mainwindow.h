@@ -5,6 +5,9 @@
 #include <QMainWindow>
 #include <QSettings>
 
+QT_FORWARD_DECLARE_CLASS(QLabel);
+QT_FORWARD_DECLARE_CLASS(QTimer);
+
 #include "project.h"
 
 namespace ads
@@ -59,6 +62,7 @@ private:
     ads::CDockWidget* createProjectBrowser();
     ads::CDockWidget* createViewManager();
     ads::CDockWidget* createLogger();
+    void createStatusBar();
     void createConnections();
 
     // State
@@ -85,6 +89,7 @@ private:
 
     // Solver
     void updateSolvers(KCL::Model const& model);
+    void updateMetrics();
 
 private:
     QSettings mSettings;
@@ -96,12 +101,14 @@ private:
     QMenu* mpWindowMenu;
     ProjectBrowser* mpProjectBrowser;
     ViewManager* mpViewManager;
+    QLabel* mpMetricsLabel;
+    QTimer* mpMetricsTimer;
 
     // Project
     Backend::Core::Project mProject;
 };
 
-void logMessage(QtMsgType type, QMessageLogContext const& /*context*/, QString const& message);
+void logMessage(QtMsgType type, QMessageLogContext const& context, QString const& message);
 }
 
 #endif // MAINWINDOW_H
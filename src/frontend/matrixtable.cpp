@@ -0,0 +1,238 @@
+#include <QApplication>
+#include <QClipboard>
+#include <QHeaderView>
+#include <QMenu>
+
+#include "matrixtable.h"
+
+using namespace Frontend;
+
+MatrixTableModel::MatrixTableModel(QObject* pParent)
+    : QAbstractTableModel(pParent)
+    , mFormat('f')
+    , mPrecision(3)
+{
+}
+
+int MatrixTableModel::rowCount(QModelIndex const& parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return mMatrix.rows();
+}
+
+int MatrixTableModel::columnCount(QModelIndex const& parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return mMatrix.cols();
+}
+
+//! Format the value only when it is requested by the view
+QVariant MatrixTableModel::data(QModelIndex const& index, int role) const
+{
+    if (!index.isValid())
+        return QVariant();
+    switch (role)
+    {
+    case Qt::DisplayRole:
+        return text(index.row(), index.column());
+    case Qt::EditRole:
+        return value(index.row(), index.column());
+    case Qt::TextAlignmentRole:
+        return Qt::AlignCenter;
+    default:
+        return QVariant();
+    }
+}
+
+//! Get the header labels, so that the missing ones are replaced by the indices
+QVariant MatrixTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole)
+        return QVariant();
+    QStringList const& labels = orientation == Qt::Horizontal ? mHorizontalLabels : mVerticalLabels;
+    if (section >= 0 && section < labels.size())
+        return labels[section];
+    return QString::number(1 + section);
+}
+
+Eigen::MatrixXd const& MatrixTableModel::matrix() const
+{
+    return mMatrix;
+}
+
+QStringList const& MatrixTableModel::horizontalLabels() const
+{
+    return mHorizontalLabels;
+}
+
+double MatrixTableModel::value(int iRow, int iColumn) const
+{
+    return mMatrix(iRow, iColumn);
+}
+
+//! Convert the value to string (NaNs are considered as missing values)
+QString MatrixTableModel::text(int iRow, int iColumn) const
+{
+    double value = mMatrix(iRow, iColumn);
+    if (std::isnan(value))
+        return QString();
+    return QString::number(value, mFormat, mPrecision);
+}
+
+//! Substitute the matrix to be viewed
+void MatrixTableModel::setMatrix(Eigen::MatrixXd matrix, QStringList const& horizontalLabels, QStringList const& verticalLabels)
+{
+    beginResetModel();
+    mMatrix = std::move(matrix);
+    mHorizontalLabels = horizontalLabels;
+    mVerticalLabels = verticalLabels;
+    endResetModel();
+}
+
+//! Append rows to the end of the matrix
+void MatrixTableModel::appendRows(Eigen::MatrixXd const& rows, QStringList const& verticalLabels)
+{
+    int numRows = rows.rows();
+    if (numRows == 0 || rows.cols() != mMatrix.cols())
+        return;
+    int iStartRow = mMatrix.rows();
+    beginInsertRows(QModelIndex(), iStartRow, iStartRow + numRows - 1);
+    mMatrix.conservativeResize(iStartRow + numRows, Eigen::NoChange);
+    mMatrix.bottomRows(numRows) = rows;
+    if (mVerticalLabels.size() == iStartRow)
+        mVerticalLabels.append(verticalLabels);
+    endInsertRows();
+}
+
+//! Set the format of values according to QString::number
+void MatrixTableModel::setFormat(char format, int precision)
+{
+    mFormat = format;
+    mPrecision = precision;
+    if (mMatrix.size() > 0)
+        emit dataChanged(index(0, 0), index(mMatrix.rows() - 1, mMatrix.cols() - 1), {Qt::DisplayRole});
+}
+
+//! Remove all the data
+void MatrixTableModel::clear()
+{
+    setMatrix(Eigen::MatrixXd());
+}
+
+MatrixTable::MatrixTable(QWidget* pParent)
+    : QTableView(pParent)
+    , mpModel(new MatrixTableModel(this))
+{
+    setModel(mpModel);
+    verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    createActions();
+    setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(this, &QTableView::customContextMenuRequested, this, &MatrixTable::processContextMenuRequested);
+}
+
+MatrixTableModel* MatrixTable::matrixModel()
+{
+    return mpModel;
+}
+
+//! Create actions to handle table content
+void MatrixTable::createActions()
+{
+    addAction(QIcon(":/icons/edit-copy.svg"), tr("&Copy data"), QKeySequence::Copy, this, &MatrixTable::copySelection);
+}
+
+//! Copy selected data to the clipboard by chunks of rows
+void MatrixTable::copySelection()
+{
+    // Constants
+    int const kChunkSize = 4096;
+    int const kNumCharsPerValue = 12;
+
+    // Retrieve the selection
+    QItemSelection selection = selectionModel()->selection();
+    if (selection.isEmpty())
+        return;
+
+    // Find the bounding range of the selection
+    int iStartRow = std::numeric_limits<int>::max();
+    int iStartColumn = std::numeric_limits<int>::max();
+    int iEndRow = -1;
+    int iEndColumn = -1;
+    qsizetype numSelected = 0;
+    for (QItemSelectionRange const& range : selection)
+    {
+        iStartRow = std::min(iStartRow, range.top());
+        iStartColumn = std::min(iStartColumn, range.left());
+        iEndRow = std::max(iEndRow, range.bottom());
+        iEndColumn = std::max(iEndColumn, range.right());
+        numSelected += (qsizetype) range.height() * range.width();
+    }
+    int numRows = 1 + iEndRow - iStartRow;
+    int numColumns = 1 + iEndColumn - iStartColumn;
+    qsizetype numBounded = (qsizetype) numRows * numColumns;
+    bool isRectangle = selection.size() == 1 || numSelected == numBounded;
+
+    // Collect the selected spans of columns for every row, so that the selection is not queried per cell
+    QList<QList<std::pair<int, int>>> rowSpans(isRectangle ? 1 : numRows);
+    if (isRectangle)
+    {
+        rowSpans[0].push_back({iStartColumn, iEndColumn});
+    }
+    else
+    {
+        for (QItemSelectionRange const& range : selection)
+        {
+            for (int i = range.top(); i <= range.bottom(); ++i)
+                rowSpans[i - iStartRow].push_back({range.left(), range.right()});
+        }
+        for (QList<std::pair<int, int>>& spans : rowSpans)
+            std::sort(spans.begin(), spans.end());
+    }
+
+    // Process the rows by chunks, so that the memory is allocated once per chunk
+    QString selectionText;
+    selectionText.reserve(std::min(numSelected, (qsizetype) kChunkSize * numColumns) * kNumCharsPerValue);
+    QString chunkText;
+    for (int iChunk = iStartRow; iChunk <= iEndRow; iChunk += kChunkSize)
+    {
+        int iLastRow = std::min(iEndRow, iChunk + kChunkSize - 1);
+        chunkText.clear();
+        for (int i = iChunk; i <= iLastRow; ++i)
+        {
+            QList<std::pair<int, int>> const& spans = rowSpans[isRectangle ? 0 : i - iStartRow];
+            if (spans.empty())
+                continue;
+            QString rowText;
+            int iLastColumn = iStartColumn - 1;
+            for (auto const& span : spans)
+            {
+                for (int j = std::max(span.first, iLastColumn + 1); j <= span.second; ++j)
+                {
+                    if (iLastColumn >= iStartColumn)
+                        rowText.append('\t');
+                    rowText.append(mpModel->text(i, j));
+                    iLastColumn = j;
+                }
+            }
+            chunkText.append(rowText);
+            chunkText.append('\n');
+        }
+        selectionText.append(chunkText);
+    }
+    if (selectionText.endsWith('\n'))
+        selectionText.chop(1);
+
+    // Assign the data to the clipboard
+    QApplication::clipboard()->setText(selectionText);
+}
+
+//! Show the context menu at the specified location
+void MatrixTable::processContextMenuRequested(QPoint const& /*position*/)
+{
+    QMenu* pMenu = new QMenu(this);
+    pMenu->setAttribute(Qt::WA_DeleteOnClose);
+    pMenu->addActions(actions());
+    pMenu->exec(QCursor::pos());
+}
@@ -0,0 +1,66 @@
+#ifndef MATRIXTABLE_H
+#define MATRIXTABLE_H
+
+#include <Eigen/Core>
+#include <QAbstractTableModel>
+#include <QTableView>
+
+namespace Frontend
+{
+
+//! Model which formats matrix values on demand
+class MatrixTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    MatrixTableModel(QObject* pParent = nullptr);
+    virtual ~MatrixTableModel() = default;
+
+    int rowCount(QModelIndex const& parent = QModelIndex()) const override;
+    int columnCount(QModelIndex const& parent = QModelIndex()) const override;
+    QVariant data(QModelIndex const& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    Eigen::MatrixXd const& matrix() const;
+    QStringList const& horizontalLabels() const;
+    double value(int iRow, int iColumn) const;
+    QString text(int iRow, int iColumn) const;
+
+    void setMatrix(Eigen::MatrixXd matrix, QStringList const& horizontalLabels = QStringList(),
+                   QStringList const& verticalLabels = QStringList());
+    void appendRows(Eigen::MatrixXd const& rows, QStringList const& verticalLabels = QStringList());
+    void setFormat(char format, int precision);
+    void clear();
+
+private:
+    Eigen::MatrixXd mMatrix;
+    QStringList mHorizontalLabels;
+    QStringList mVerticalLabels;
+    char mFormat;
+    int mPrecision;
+};
+
+//! Table to view large matrices without creating items
+class MatrixTable : public QTableView
+{
+    Q_OBJECT
+
+public:
+    MatrixTable(QWidget* pParent = nullptr);
+    virtual ~MatrixTable() = default;
+
+    MatrixTableModel* matrixModel();
+
+private:
+    void createActions();
+    void copySelection();
+    void processContextMenuRequested(QPoint const& position);
+
+private:
+    MatrixTableModel* mpModel;
+};
+
+}
+
+#endif // MATRIXTABLE_H
@@ -3,8 +3,11 @@
 #include <QFile>
 #include <QListWidget>
 #include <QMenu>
+#include <QProgressBar>
+#include <QSet>
 #include <QToolBar>
 #include <QVBoxLayout>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include <vtkAxesActor.h>
 #include <vtkCamera.h>
@@ -17,22 +20,20 @@
 #include <vtkOrientationMarkerWidget.h>
 #include <vtkPNGReader.h>
 #include <vtkPlaneSource.h>
-#include <vtkPoints.h>
 #include <vtkPolyData.h>
 #include <vtkPolyDataSilhouette.h>
-#include <vtkPolygon.h>
 #include <vtkProperty.h>
 #include <vtkRenderWindowInteractor.h>
 #include <vtkRenderer.h>
 #include <vtkTexture.h>
 #include <vtkTransform.h>
-#include <vtkUnstructuredGrid.h>
 #include <QVTKOpenGLNativeWidget.h>
 
 #include <kcl/model.h>
 #include <magicenum/magic_enum.hpp>
 
 #include "modelview.h"
+#include "modelviewbuilder.h"
 #include "selectionset.h"
 #include "uiconstants.h"
 #include "uiutility.h"
@@ -51,7 +52,6 @@ constexpr auto skAllTypes = magic_enum::enum_values<KCL::ElementType>();
 auto const skBeamTypes = Utility::beamTypes();
 auto const skPanelTypes = Utility::panelTypes();
 auto const skAeroTrapeziumTypes = Utility::aeroTrapeziumTypes();
-auto const skMassTypes = Utility::massTypes();
 auto const skSpringTypes = Utility::springTypes();
 
 // Helper functions
@@ -109,6 +109,7 @@ ModelView::ModelView(KCL::Model const& model, ModelViewOptions const& options)
 
 ModelView::~ModelView()
 {
+    mpBuildWatcher->cancel();
     ModelView::clear();
 }
 
@@ -141,24 +142,16 @@ void ModelView::clear()
 //! Draw the scene
 void ModelView::plot()
 {
-    // Add the model to the scene to compute visible boundaries, if neceassary
-    bool isEmptyScene = mRenderer->GetActors()->GetNumberOfItems() == 0;
-    if (isEmptyScene)
-        drawModel();
-
-    // Compute the model maximum dimension
-    mMaximumDimension = Utility::getMaximumDimension(mRenderer);
-    if (mMaximumDimension < std::numeric_limits<double>::epsilon())
-        mMaximumDimension = 1.0;
-
-    // Clear the scene
-    clear();
-
-    // Add the model to the scene
-    drawModel();
-
-    // Render the model
-    mRenderWindow->Render();
+    // Discard the result of the previous build
+    if (mpBuildWatcher->isRunning())
+        mpBuildWatcher->cancel();
+
+    // Build the geometry of the model snapshot on a worker thread, so that only actors are created here
+    auto pBuilder = std::make_shared<ModelViewBuilder>(mModel, mOptions);
+    mSelector.setDeferred(true);
+    mpProgressBar->setRange(0, 0);
+    mpProgressBar->show();
+    mpBuildWatcher->setFuture(QtConcurrent::run([pBuilder](QPromise<ModelViewScene>& promise) { pBuilder->build(promise); }));
 }
 
 //! Update the scene
@@ -228,6 +221,9 @@ void ModelView::initialize()
 
     // Set the maximum dimension
     mMaximumDimension = 0.0;
+
+    // Set the building state
+    mIsIsometricPending = false;
 }
 
 //! Load the textures from the resource file
@@ -244,6 +240,15 @@ void ModelView::createContent()
     // Create the VTK widget
     mRenderWidget = new QVTKOpenGLNativeWidget;
 
+    // Create the indicator of geometry building
+    mpProgressBar = new QProgressBar;
+    mpProgressBar->setTextVisible(false);
+    mpProgressBar->setMaximumHeight(mpProgressBar->fontMetrics().height() / 2);
+    mpProgressBar->hide();
+
+    // Create the watcher of geometry building
+    mpBuildWatcher = new QFutureWatcher<ModelViewScene>(this);
+
     // Create auxiliary function
     auto createShowAction = [this](QIcon const& icon, QString const& name, bool& option)
     {
@@ -282,671 +287,216 @@ void ModelView::createContent()
     // Combine the widgets
     pLayout->addWidget(pToolBar);
     pLayout->addWidget(mRenderWidget);
+    pLayout->addWidget(mpProgressBar);
     setLayout(pLayout);
 }
 
 //! Set the signals & slots
 void ModelView::createConnections()
 {
+    connect(mpBuildWatcher, &QFutureWatcher<ModelViewScene>::progressRangeChanged, mpProgressBar, &QProgressBar::setRange);
+    connect(mpBuildWatcher, &QFutureWatcher<ModelViewScene>::progressValueChanged, mpProgressBar, &QProgressBar::setValue);
+    connect(mpBuildWatcher, &QFutureWatcher<ModelViewScene>::finished, this, &ModelView::processBuild);
     connect(mStyle->handler, &InteractorHandler::selectItemsRequested, this, &ModelView::selectItemsRequested);
     connect(mStyle->handler, &InteractorHandler::editItemsRequested, this, &ModelView::editItemsRequested);
 }
 
-//! Represent the model entities
-void ModelView::drawModel()
+//! Process the geometry built on the worker thread
+void ModelView::processBuild()
 {
-    // Check if the model is suitable for drawing
-    if (mModel.isEmpty())
+    mpProgressBar->hide();
+    if (mpBuildWatcher->isCanceled() || mpBuildWatcher->future().resultCount() == 0)
         return;
 
-    // Loop through all the elastic surfaces
-    int numSurfaces = mModel.surfaces.size();
-    for (int iSurface = 0; iSurface != numSurfaces; ++iSurface)
-    {
-        KCL::ElasticSurface const& surface = mModel.surfaces[iSurface];
-
-        // Retrieve the surface data
-        if (!surface.containsElement(KCL::OD))
-            continue;
-        auto pData = (KCL::GeneralData*) surface.element(KCL::OD);
-        bool isSymmetry = pData->iSymmetry == 0;
-
-        // Build up the transformation
-        auto transform = Utility::computeTransformation(pData->coords, pData->dihedralAngle, pData->sweepAngle, pData->zAngle);
-        auto aeroTransform = Utility::computeTransformation(pData->coords, pData->dihedralAngle, 0.0, pData->zAngle);
-
-        // Reflect the transformation about the XOY plane
-        auto reflectTransform = Utility::reflectTransformation(transform);
-        auto reflectAeroTransform = Utility::reflectTransformation(aeroTransform);
+    // Keep the selection, so that it survives the actors substitution
+    QList<Core::Selection> selections = mSelector.selected();
 
-        // Draw the aero trapeziums
-        for (auto type : skAeroTrapeziumTypes)
-        {
-            drawAeroTrapeziums(aeroTransform, iSurface, type);
-            if (isSymmetry && mOptions.showSymmetry)
-                drawAeroTrapeziums(reflectAeroTransform, iSurface, type);
-        }
-
-        // Draw the panels
-        for (auto type : skPanelTypes)
-        {
-            if (mOptions.showThickness)
-            {
-                drawPanels3D(transform, iSurface, type);
-                if (isSymmetry && mOptions.showSymmetry)
-                    drawPanels3D(reflectTransform, iSurface, type);
-            }
-            else
-            {
-                drawPanels2D(transform, iSurface, type);
-                if (isSymmetry && mOptions.showSymmetry)
-                    drawPanels2D(reflectTransform, iSurface, type);
-            }
-        }
+    // Substitute the scene content
+    clear();
+    drawScene(mpBuildWatcher->result());
+    mSelector.setDeferred(false);
+    mSelector.select(selections);
 
-        // Draw the beams
-        for (auto type : skBeamTypes)
-        {
-            if (mOptions.showThickness)
-            {
-                drawBeams3D(transform, iSurface, type);
-                if (isSymmetry && mOptions.showSymmetry)
-                    drawBeams3D(reflectTransform, iSurface, type);
-            }
-            else
-            {
-                drawBeams2D(transform, iSurface, type);
-                if (isSymmetry && mOptions.showSymmetry)
-                    drawBeams2D(reflectTransform, iSurface, type);
-            }
-        }
+    // Render the model
+    if (mIsIsometricPending)
+        setIsometricView();
+    else
+        mRenderWindow->Render();
+}
 
-        // Draw the masses
-        for (auto type : skMassTypes)
-        {
-            drawMasses(transform, iSurface, type);
-            if (isSymmetry && mOptions.showSymmetry)
-                drawMasses(reflectTransform, iSurface, type);
-        }
+//! Create actors for the prepared model entities
+void ModelView::drawScene(ModelViewScene const& scene)
+{
+    mMaximumDimension = scene.maximumDimension;
 
-        // Draw the local coordinate axes
-        if (mOptions.showLocalAxes)
+    // Loop through all the entities
+    QList<vtkPlaneSource*> sources;
+    for (ModelViewEntity const& entity : scene.entities)
+    {
+        switch (entity.kind)
         {
-            drawLocalAxes(transform);
-            if (isSymmetry && mOptions.showSymmetry)
-                drawLocalAxes(reflectTransform);
+        case ModelViewEntity::kMass:
+            sources.push_back(drawMass(entity));
+            break;
+        case ModelViewEntity::kSpring:
+            drawSpring(entity);
+            break;
+        case ModelViewEntity::kLocalAxes:
+            drawLocalAxes(entity.transform);
+            break;
+        default:
+            drawElement(entity);
+            break;
         }
     }
 
-    // Process the special surface
-    for (auto type : skSpringTypes)
-    {
-        drawSprings(false, type);
-        if (mOptions.showSymmetry)
-            drawSprings(true, type);
-    }
-}
-
-//! Render beam elements as lines
-void ModelView::drawBeams2D(Transformation const& transform, int iSurface, KCL::ElementType type)
-{
-    int const kNumCellPoints = 2;
-
-    // Slice the elements for rendering
-    std::vector<KCL::AbstractElement const*> elements = mModel.surfaces[iSurface].elements(type);
-    if (elements.empty() || !mOptions.maskElements[type])
-        return;
-    vtkColor3d color = mOptions.elementColors[type];
-
-    // Process all the elements
-    int numElements = elements.size();
-    for (int iElement = 0; iElement != numElements; ++iElement)
+    // Set the callback functions
+    if (!sources.empty())
     {
-        KCL::AbstractElement const* pElement = elements[iElement];
-
-        // Slice element coordinates
-        KCL::VecN elementData = pElement->get();
-        KCL::Vec2 startCoords = {elementData[0], elementData[1]};
-        KCL::Vec2 endCoords = {elementData[2], elementData[3]};
-
-        // Transform the coordinates to global coordinate system
-        auto startPosition = transform * Vector3d(startCoords[0], 0.0, startCoords[1]);
-        auto endPosition = transform * Vector3d(endCoords[0], 0.0, endCoords[1]);
-
-        // Set the points
-        vtkNew<vtkPoints> points;
-        points->InsertNextPoint(startPosition[0], startPosition[1], startPosition[2]);
-        points->InsertNextPoint(endPosition[0], endPosition[1], endPosition[2]);
-
-        // Set the connectivity indices
-        vtkNew<vtkCellArray> indices;
-        indices->InsertNextCell(kNumCellPoints);
-        indices->InsertCellPoint(0);
-        indices->InsertCellPoint(1);
-
-        // Create the polygons
-        vtkNew<vtkPolyData> polyData;
-        polyData->SetPoints(points);
-        polyData->SetLines(indices);
-
-        // Build the mapper
-        vtkNew<vtkPolyDataMapper> mapper;
-        mapper->SetInputData(polyData);
-
-        // Create the actor and add to the scene
-        vtkNew<vtkActor> actor;
-        actor->SetMapper(mapper);
-        actor->GetProperty()->SetColor(color.GetData());
-        actor->GetProperty()->SetLineWidth(mOptions.beamLineWidth);
-
-        // Register the actor
-        mSelector.registerActor(Core::Selection(iSurface, type, iElement), actor);
+        // Create the plane follower event
+        vtkNew<PlaneFollowerCallback> callback;
+        callback->scale = 2.0 * mOptions.massScale * mMaximumDimension;
+        callback->sources = sources;
+        callback->camera = mRenderer->GetActiveCamera();
 
-        // Add the actor to the scene
-        mRenderer->AddActor(actor);
+        // Attach the follower event to the interactor
+        auto interactor = mRenderWindow->GetInteractor();
+        unsigned long tag = interactor->AddObserver(vtkCommand::EndInteractionEvent, callback);
+        mObserverTags.push_back(tag);
     }
 }
 
-//! Draw beams as cylinders
-void ModelView::drawBeams3D(Transformation const& transform, int iSurface, KCL::ElementType type)
+//! Render beams, panels, aerodynamic trapeziums and mass rods
+void ModelView::drawElement(ModelViewEntity const& entity)
 {
-    // Constants
-    int kResolution = 8;
-
-    // Slice the elements for rendering
-    std::vector<KCL::AbstractElement const*> elements = mModel.surfaces[iSurface].elements(type);
-    if (elements.empty() || !mOptions.maskElements[type])
-        return;
-    vtkColor3d color = mOptions.elementColors[type];
-
-    // Compute the cyliner radius
-    double radius = mOptions.beamScale * mMaximumDimension;
+    double const kAeroOpacity = 0.5;
+    double const kAeroPolyOffset = 0.01;
+    double const kAeroPolyUnits = 10;
+    vtkColor3d kRodColor = vtkColors->GetColor3d("red");
 
-    // Process all the elements
-    int numElements = elements.size();
-    for (int iElement = 0; iElement != numElements; ++iElement)
+    // Build the mapper
+    vtkSmartPointer<vtkMapper> mapper;
+    if (entity.kind == ModelViewEntity::kShell)
     {
-        KCL::AbstractElement const* pElement = elements[iElement];
-
-        // Slice element coordinates
-        KCL::VecN elementData = pElement->get();
-        KCL::Vec2 startCoords = {elementData[0], elementData[1]};
-        KCL::Vec2 endCoords = {elementData[2], elementData[3]};
-
-        // Transform the coordinates to global coordinate system
-        Vector3d startPosition = transform * Vector3d(startCoords[0], 0.0, startCoords[1]);
-        Vector3d endPosition = transform * Vector3d(endCoords[0], 0.0, endCoords[1]);
-
-        // Create the cylinder actor
-        auto actor = Utility::createCylinderActor(startPosition, endPosition, radius, kResolution);
-        actor->GetProperty()->SetColor(color.GetData());
-        if (mOptions.showWireframe)
-            actor->GetProperty()->SetRepresentationToWireframe();
-
-        // Register the actor
-        mSelector.registerActor(Core::Selection(iSurface, type, iElement), actor);
-
-        // Add the actor to the scene
-        mRenderer->AddActor(actor);
+        vtkNew<vtkDataSetMapper> dataSetMapper;
+        dataSetMapper->SetInputData(entity.data);
+        mapper = dataSetMapper;
     }
-}
-
-//! Render panel elements as planes
-void ModelView::drawPanels2D(Transformation const& transform, int iSurface, KCL::ElementType type)
-{
-    int const kNumCellPoints = 4;
-
-    // Slice the elements for rendering
-    std::vector<KCL::AbstractElement const*> elements = mModel.surfaces[iSurface].elements(type);
-    if (elements.empty() || !mOptions.maskElements[type])
-        return;
-    vtkColor3d color = mOptions.elementColors[type];
-
-    // Process all the elements
-    int numElements = elements.size();
-    for (int iElement = 0; iElement != numElements; ++iElement)
+    else
     {
-        KCL::AbstractElement const* pElement = elements[iElement];
-
-        // Slice element coordinates
-        KCL::VecN elementData = pElement->get();
-
-        // Set points and connections between them
-        int iData = 1;
-        vtkNew<vtkPoints> points;
-        vtkNew<vtkPolygon> polygon;
-        vtkNew<vtkCellArray> polygons;
-        for (int iPosition = 0; iPosition != kNumCellPoints; ++iPosition)
-        {
-            auto position = transform * Vector3d(elementData[iData], 0.0, elementData[iData + 1]);
-            points->InsertNextPoint(position[0], position[1], position[2]);
-            polygon->GetPointIds()->InsertNextId(iPosition);
-            iData += 2;
-        }
-        polygons->InsertNextCell(polygon);
-
-        // Create the polygon objects
-        vtkNew<vtkPolyData> polyData;
-        polyData->SetPoints(points);
-        polyData->SetPolys(polygons);
-
-        // Build the mapper
-        vtkNew<vtkPolyDataMapper> mapper;
-        mapper->SetInputData(polyData);
-
-        // Create the actor and add to the scene
-        vtkNew<vtkActor> actor;
-        actor->SetMapper(mapper);
-        actor->GetProperty()->SetColor(color.GetData());
-        actor->GetProperty()->SetEdgeColor(mOptions.edgeColor.GetData());
-        actor->GetProperty()->SetEdgeOpacity(mOptions.edgeOpacity);
-        actor->GetProperty()->EdgeVisibilityOn();
-        if (mOptions.showWireframe)
-            actor->GetProperty()->SetRepresentationToWireframe();
-
-        // Register the actor
-        mSelector.registerActor(Core::Selection(iSurface, type, iElement), actor);
-
-        // Add the actor to the scene
-        mRenderer->AddActor(actor);
+        vtkNew<vtkPolyDataMapper> polyDataMapper;
+        polyDataMapper->SetInputData(vtkPolyData::SafeDownCast(entity.data));
+        mapper = polyDataMapper;
     }
-}
-
-//! Render panel elements as hexahedrons
-void ModelView::drawPanels3D(Transformation const& transform, int iSurface, KCL::ElementType type)
-{
-    int const kNumVertices = 4;
-
-    // Slice the elements for rendering
-    std::vector<KCL::AbstractElement const*> elements = mModel.surfaces[iSurface].elements(type);
-    if (elements.empty() || !mOptions.maskElements[type])
-        return;
-    vtkColor3d color = mOptions.elementColors[type];
-
-    // Process all the elements
-    int numElements = elements.size();
-    for (int iElement = 0; iElement != numElements; ++iElement)
+    if (entity.kind == ModelViewEntity::kAeroTrapezium)
     {
-        KCL::AbstractElement const* pElement = elements[iElement];
-
-        // Get element data
-        KCL::VecN elementData = pElement->get();
-
-        // Get the plane coordinates
-        int iData = 0;
-        double thickness = elementData[iData++];
-        Matrix42d coords;
-        for (int iVertex = 0; iVertex != kNumVertices; ++iVertex)
-        {
-            coords(iVertex, 0) = elementData[iData];
-            coords(iVertex, 1) = elementData[iData + 1];
-            iData += 2;
-        }
-
-        // Get the depths
-        Vector4d depths;
-        int numDepths = depths.size();
-        for (int iDepth = 0; iDepth != numDepths; ++iDepth)
-        {
-            depths[iDepth] = elementData[iData];
-            ++iData;
-        }
-
-        // Evaluate the depth at the last point
-        if (type != KCL::P4)
-            Utility::setLastDepth(coords, depths);
-
-        // Create the shell actor
-        auto actor = Utility::createShellActor(transform, coords, depths, thickness);
-        actor->GetProperty()->SetColor(color.GetData());
-        actor->GetProperty()->SetEdgeColor(mOptions.edgeColor.GetData());
-        actor->GetProperty()->SetEdgeOpacity(mOptions.edgeOpacity);
-        actor->GetProperty()->EdgeVisibilityOn();
-        if (mOptions.showWireframe)
-            actor->GetProperty()->SetRepresentationToWireframe();
-
-        // Register the actor
-        mSelector.registerActor(Core::Selection(iSurface, type, iElement), actor);
-
-        // Add the actor to the scene
-        mRenderer->AddActor(actor);
+        mapper->SetRelativeCoincidentTopologyPolygonOffsetParameters(kAeroPolyOffset, kAeroPolyUnits);
+        mapper->SetResolveCoincidentTopologyToPolygonOffset();
     }
-}
 
-//! Render aerodynamic trapezium elements
-void ModelView::drawAeroTrapeziums(Transformation const& transform, int iSurface, KCL::ElementType type)
-{
-    double const kOpacity = 0.5;
-    double const kPolyOffset = 0.01;
-    double const kPolyUnits = 10;
+    // Create the actor
+    vtkNew<vtkActor> actor;
+    actor->SetMapper(mapper);
+    vtkProperty* pProperty = actor->GetProperty();
+    pProperty->SetColor(mOptions.elementColors.value(entity.selection.type).GetData());
 
-    // Slice the elements for rendering
-    std::vector<KCL::AbstractElement const*> elements = mModel.surfaces[iSurface].elements(type);
-    if (elements.empty() || !mOptions.maskElements[type])
-        return;
-    vtkColor3d color = mOptions.elementColors[type];
-
-    // Process all the elements
-    int numElements = elements.size();
-    bool isVertical = Utility::isAeroVertical(type);
-    bool isAileron = Utility::isAeroAileron(type);
-    bool isMeshable = Utility::isAeroMeshable(type);
-    for (int iElement = 0; iElement != numElements; ++iElement)
+    // Set the style
+    switch (entity.kind)
     {
-        KCL::AbstractElement const* pElement = elements[iElement];
-        if (pElement->subType() == KCL::ElementSubType::AE1)
-            continue;
-
-        // Slice element parameters
-        KCL::VecN data = pElement->get();
-        int iShift = isAileron ? 1 : 0;
-        KCL::Vec2 coords0 = {data[iShift + 0], data[iShift + 1]};
-        KCL::Vec2 coords1 = {data[iShift + 2], data[iShift + 3]};
-        KCL::Vec2 coords2 = {data[iShift + 4], data[iShift + 5]};
-        int numStrips = 1;
-        int numPanels = 1;
-        if (isMeshable)
-        {
-            numStrips = data[iShift + 6];
-            numPanels = data[iShift + 7];
-        }
-
-        // Combine the vertex coordinates
-        Vector2d A = {coords0[0], coords0[1]}; // Bottom left
-        Vector2d B = {coords2[0], coords0[1]}; // Bottom right
-        Vector2d C = {coords2[1], coords1[1]}; // Top right
-        Vector2d D = {coords1[0], coords1[1]}; // Top left
-
-        // Allocate the points and their connectivity list
-        vtkNew<vtkPoints> points;
-        vtkNew<vtkCellArray> polygons;
-
-        // Create the grid of points
-        for (int s = 0; s <= numPanels; ++s)
-        {
-            double u = (double) s / numPanels;
-            for (int r = 0; r <= numStrips; ++r)
-            {
-                double v = (double) r / numStrips;
-                double x = (1.0 - v) * ((1.0 - u) * A[0] + u * B[0]) + v * ((1.0 - u) * D[0] + u * C[0]);
-                double z = (1.0 - v) * ((1.0 - u) * A[1] + u * B[1]) + v * ((1.0 - u) * D[1] + u * C[1]);
-                auto position = isVertical ? Vector3d(x, z, 0) : Vector3d(x, 0, z);
-                position = transform * position;
-                points->InsertNextPoint(position[0], position[1], position[2]);
-            }
-        }
-
-        // Set the polygon data
-        for (int s = 0; s != numPanels; ++s)
-        {
-            for (int r = 0; r != numStrips; ++r)
-            {
-                vtkNew<vtkPolygon> polygon;
-                polygon->GetPointIds()->InsertNextId(s * (numStrips + 1) + r);
-                polygon->GetPointIds()->InsertNextId(s * (numStrips + 1) + r + 1);
-                polygon->GetPointIds()->InsertNextId((s + 1) * (numStrips + 1) + r + 1);
-                polygon->GetPointIds()->InsertNextId((s + 1) * (numStrips + 1) + r);
-                polygons->InsertNextCell(polygon);
-            }
-        }
-
-        // Create the polygon objects
-        vtkNew<vtkPolyData> polyData;
-        polyData->SetPoints(points);
-        polyData->SetPolys(polygons);
-
-        // Build the mapper
-        vtkNew<vtkPolyDataMapper> mapper;
-        mapper->SetInputData(polyData);
-        mapper->SetRelativeCoincidentTopologyPolygonOffsetParameters(kPolyOffset, kPolyUnits);
-        mapper->SetResolveCoincidentTopologyToPolygonOffset();
-
-        // Create the actor and add to the scene
-        vtkNew<vtkActor> actor;
-        actor->SetMapper(mapper);
-        actor->GetProperty()->SetColor(color.GetData());
-        actor->GetProperty()->SetOpacity(kOpacity);
-        actor->GetProperty()->SetEdgeColor(mOptions.edgeColor.GetData());
-        actor->GetProperty()->SetEdgeOpacity(mOptions.edgeOpacity);
-        actor->GetProperty()->EdgeVisibilityOn();
+    case ModelViewEntity::kBeamLine:
+        pProperty->SetLineWidth(mOptions.beamLineWidth);
+        break;
+    case ModelViewEntity::kMassRod:
+        pProperty->SetColor(kRodColor.GetData());
+        break;
+    case ModelViewEntity::kAeroTrapezium:
+        pProperty->SetOpacity(kAeroOpacity);
+        [[fallthrough]];
+    case ModelViewEntity::kPanel:
+    case ModelViewEntity::kShell:
+        pProperty->SetEdgeColor(mOptions.edgeColor.GetData());
+        pProperty->SetEdgeOpacity(mOptions.edgeOpacity);
+        pProperty->EdgeVisibilityOn();
+        [[fallthrough]];
+    case ModelViewEntity::kBeamCylinder:
         if (mOptions.showWireframe)
-            actor->GetProperty()->SetRepresentationToWireframe();
+            pProperty->SetRepresentationToWireframe();
+        break;
+    default:
+        break;
+    }
 
-        // Register the actor
-        mSelector.registerActor(Core::Selection(iSurface, type, iElement), actor);
+    // Register the actor
+    if (entity.isSelectable())
+        mSelector.registerActor(entity.selection, actor);
 
-        // Add the actor to the scene
-        mRenderer->AddActor(actor);
-    }
+    // Add the actor to the scene
+    mRenderer->AddActor(actor);
 }
 
-//! Represent point masses
-void ModelView::drawMasses(Transformation const& transform, int iSurface, KCL::ElementType type)
+//! Represent a point mass by a textured plane
+vtkPlaneSource* ModelView::drawMass(ModelViewEntity const& entity)
 {
     double const kPolyOffset = -1;
     double const kPolyUnits = -66000;
-    vtkColor3d kRodColor = vtkColors->GetColor3d("red");
 
-    // Slice the elements for rendering
-    std::vector<KCL::AbstractElement const*> elements = mModel.surfaces[iSurface].elements(type);
-    if (elements.empty() || !mOptions.maskElements[type])
-        return;
-    vtkColor3d color = mOptions.elementColors[type];
-
-    // Get the visualization texture
-    vtkSmartPointer<vtkTexture> texture = mTextures["mass"];
+    // Create and position the source
     double w = mOptions.massScale * mMaximumDimension;
+    Vector3d const& position = entity.positions.first();
+    vtkNew<vtkPlaneSource> source;
+    double x = position[0];
+    double y = position[1];
+    double z = position[2];
+    source->SetOrigin(x - w, y - w, z);
+    source->SetPoint1(x + w, y - w, z);
+    source->SetPoint2(x - w, y + w, z);
+    source->SetResolution(1, 1);
+
+    // Map the resulting polygons
+    vtkNew<vtkPolyDataMapper> mapper;
+    mapper->SetInputConnection(source->GetOutputPort());
+    mapper->SetRelativeCoincidentTopologyPolygonOffsetParameters(kPolyOffset, kPolyUnits);
+    mapper->SetResolveCoincidentTopologyToPolygonOffset();
 
-    // Process all the elements
-    int numElements = elements.size();
-    QList<vtkPlaneSource*> sources;
-    for (int iElement = 0; iElement != numElements; ++iElement)
-    {
-        KCL::AbstractElement const* pBaseElement = elements[iElement];
-
-        // Slice element coordinates
-        Vector3d startPosition;
-        double lengthRod = 0.0;
-        double angleRodZ = 0.0;
-        switch (pBaseElement->type())
-        {
-        case KCL::SM:
-        {
-            auto pElement = (KCL::PointMass1 const*) pBaseElement;
-            startPosition = {pElement->coords[0], 0.0, pElement->coords[1]};
-            lengthRod = pElement->lengthRod;
-            angleRodZ = pElement->angleRodZ;
-            break;
-        }
-        case KCL::M3:
-        {
-            auto pElement = (KCL::PointMass3 const*) pBaseElement;
-            startPosition = {pElement->coords[0], pElement->coords[1], pElement->coords[2]};
-            lengthRod = pElement->lengthRod;
-            angleRodZ = pElement->angleRodZ;
-            break;
-        }
-        default:
-            continue;
-        }
-
-        // Build up the additional line which connects the mass to the elastic surface
-        Vector3d endPosition;
-        if (lengthRod > 0.0)
-        {
-            // Transform the coordiantes to the global coordinate system
-            auto addTransform = Transformation::Identity();
-            addTransform.rotate(AngleAxisd(qDegreesToRadians(angleRodZ), Vector3d::UnitY()));
-            addTransform.translate(Vector3d(0, 0, lengthRod));
-            endPosition = transform * addTransform * startPosition;
-            startPosition = transform * startPosition;
-
-            // Create the points and connectivity list
-            vtkNew<vtkPoints> points;
-            points->InsertNextPoint(startPosition[0], startPosition[1], startPosition[2]);
-            points->InsertNextPoint(endPosition[0], endPosition[1], endPosition[2]);
-            vtkNew<vtkCellArray> indices;
-            indices->InsertNextCell(2);
-            indices->InsertCellPoint(0);
-            indices->InsertCellPoint(1);
-
-            // Set the polygonal data
-            vtkNew<vtkPolyData> data;
-            data->SetPoints(points);
-            data->SetLines(indices);
-
-            // Build the mapper
-            vtkNew<vtkPolyDataMapper> mapper;
-            mapper->SetInputData(data);
-
-            // Create the actor and add to the scene
-            vtkNew<vtkActor> actor;
-            actor->SetMapper(mapper);
-            actor->GetProperty()->SetColor(kRodColor.GetData());
-
-            // Add the actor to the scene
-            mRenderer->AddActor(actor);
-        }
-        else
-        {
-            startPosition = transform * startPosition;
-            endPosition = startPosition;
-        }
-
-        // Create and position the source
-        vtkNew<vtkPlaneSource> source;
-        double x = endPosition[0];
-        double y = endPosition[1];
-        double z = endPosition[2];
-        source->SetOrigin(x - w, y - w, z);
-        source->SetPoint1(x + w, y - w, z);
-        source->SetPoint2(x - w, y + w, z);
-        source->SetResolution(1, 1);
-        sources.push_back(source);
-
-        // Map the resulting polygons
-        vtkNew<vtkPolyDataMapper> mapper;
-        mapper->SetInputConnection(source->GetOutputPort());
-        mapper->SetRelativeCoincidentTopologyPolygonOffsetParameters(kPolyOffset, kPolyUnits);
-        mapper->SetResolveCoincidentTopologyToPolygonOffset();
-
-        // Create the actor
-        vtkNew<vtkActor> actor;
-        actor->SetMapper(mapper);
-        actor->SetTexture(texture);
+    // Create the actor
+    vtkNew<vtkActor> actor;
+    actor->SetMapper(mapper);
+    actor->SetTexture(mTextures["mass"]);
 
-        // Register the actor
-        mSelector.registerActor(Core::Selection(iSurface, type, iElement), actor);
+    // Register the actor
+    mSelector.registerActor(entity.selection, actor);
 
-        // Add the actor to the scene
-        mRenderer->AddActor(actor);
-    }
-
-    // Set the callback functions
-    if (!sources.empty())
-    {
-        // Create the plane follower event
-        vtkNew<PlaneFollowerCallback> callback;
-        callback->scale = 2.0 * w;
-        callback->sources = sources;
-        callback->camera = mRenderer->GetActiveCamera();
+    // Add the actor to the scene
+    mRenderer->AddActor(actor);
 
-        // Attach the follower event to the interactor
-        auto interactor = mRenderWindow->GetInteractor();
-        unsigned long tag = interactor->AddObserver(vtkCommand::EndInteractionEvent, callback);
-        mObserverTags.push_back(tag);
-    }
+    return source;
 }
 
-//! Represent springs
-void ModelView::drawSprings(bool isReflect, KCL::ElementType type)
+//! Represent a spring by a helix with end points
+void ModelView::drawSpring(ModelViewEntity const& entity)
 {
-    int const kNumTurns = 6;
-    int const kResolution = 30;
-    KCL::Vec3 kZeroVec = {0.0, 0.0, 0.0};
-
-    // Slice the elements for rendering
-    std::vector<KCL::AbstractElement const*> elements = mModel.specialSurface.elements(type);
-    if (elements.empty() || !mOptions.maskElements[type])
-        return;
-    vtkColor3d color = mOptions.elementColors[type];
-
-    // Retrieve the scene parameters
-    double maxDimension = mMaximumDimension;
-
-    // Process all the elements
-    int numElements = elements.size();
-    int numSurfaces = mModel.surfaces.size();
-    for (int iElement = 0; iElement != numElements; ++iElement)
-    {
-        KCL::AbstractElement const* pBaseElement = elements[iElement];
-        if (!mOptions.maskElements[pBaseElement->type()])
-            continue;
-        if (pBaseElement->type() != KCL::PR)
-            continue;
-        auto pElement = (KCL::SpringDamper const*) pBaseElement;
-
-        // Process the first elastic surface
-        int iFirstSurface = pElement->iFirstSurface - 1;
-        if (iFirstSurface < 0 || iFirstSurface >= numSurfaces)
-            continue;
-        auto firstSurface = mModel.surfaces[iFirstSurface];
-        auto pFirstData = (KCL::GeneralData*) firstSurface.element(KCL::OD);
-        auto firstTransform = Utility::computeTransformation(pFirstData->coords, pFirstData->dihedralAngle, pFirstData->sweepAngle,
-                                                             pFirstData->zAngle);
-        auto addFirstTransform = Utility::computeTransformation(kZeroVec, 0.0, pElement->anglesFirstRod[0], pElement->anglesFirstRod[1]);
-        if (pFirstData->iSymmetry != 0 && isReflect)
-            continue;
-        if (isReflect)
-        {
-            firstTransform = Utility::reflectTransformation(firstTransform);
-            addFirstTransform = Utility::reflectTransformation(addFirstTransform);
-        }
-        Vector3d firstPosition = firstTransform * Vector3d(pElement->coordsFirstRod[0], 0.0, pElement->coordsFirstRod[1]);
-
-        // Process the second elastic surface
-        Vector3d secondPosition = {0.0, 0.0, 0.0};
-        if (pElement->iSecondSurface > 0)
-        {
-            int iSecondSurface = pElement->iSecondSurface - 1;
-            if (iSecondSurface < 0 || iSecondSurface >= numSurfaces)
-                continue;
-            auto secondSurface = mModel.surfaces[iSecondSurface];
-            auto pSecondData = (KCL::GeneralData*) secondSurface.element(KCL::OD);
-            auto secondTransform = Utility::computeTransformation(pSecondData->coords, pSecondData->dihedralAngle, pSecondData->sweepAngle,
-                                                                  pSecondData->zAngle);
-            if (pSecondData->iSymmetry != 0 && isReflect)
-                continue;
-            if (isReflect)
-                secondTransform = Utility::reflectTransformation(secondTransform);
-            secondPosition = secondTransform * Vector3d(pElement->coordsSecondRod[0], 0.0, pElement->coordsSecondRod[1]);
-        }
-        else
-        {
-            auto addFirstPosition = addFirstTransform * Vector3d({0.0, 0.0, pElement->lengthFirstRod});
-            secondPosition = firstPosition + addFirstPosition;
-        }
-
-        // Create the helix between two points
-        double lengthHelix = (secondPosition - firstPosition).norm();
-        double radiusHelix = mOptions.springScale * maxDimension * lengthHelix;
-        auto actorHelix = Utility::createHelixActor(firstPosition, secondPosition, radiusHelix, kNumTurns, kResolution);
-        actorHelix->GetProperty()->SetColor(color.GetData());
-        actorHelix->GetProperty()->SetLineWidth(mOptions.springLineWidth);
-
-        // Set the point renderer
-        double radiusPoints = mOptions.pointScale * maxDimension;
-        auto actorPoints = Utility::createPointsActor({firstPosition, secondPosition}, radiusPoints);
-        actorPoints->GetProperty()->SetColor(color.GetData());
-
-        // Register the actor
-        mSelector.registerActor(Core::Selection(type, iElement), actorHelix);
-        mSelector.registerActor(Core::Selection(type, iElement), actorPoints);
-
-        // Add the actors to the scene
-        mRenderer->AddActor(actorPoints);
-        mRenderer->AddActor(actorHelix);
-    }
+    vtkColor3d color = mOptions.elementColors.value(entity.selection.type);
+
+    // Create the helix actor
+    vtkNew<vtkPolyDataMapper> mapper;
+    mapper->SetInputData(vtkPolyData::SafeDownCast(entity.data));
+    vtkNew<vtkActor> actorHelix;
+    actorHelix->SetMapper(mapper);
+    actorHelix->GetProperty()->SetColor(color.GetData());
+    actorHelix->GetProperty()->SetLineWidth(mOptions.springLineWidth);
+
+    // Set the point renderer
+    double radiusPoints = mOptions.pointScale * mMaximumDimension;
+    auto actorPoints = Utility::createPointsActor(entity.positions, radiusPoints);
+    actorPoints->GetProperty()->SetColor(color.GetData());
+
+    // Register the actor
+    mSelector.registerActor(entity.selection, actorHelix);
+    mSelector.registerActor(entity.selection, actorPoints);
+
+    // Add the actors to the scene
+    mRenderer->AddActor(actorPoints);
+    mRenderer->AddActor(actorHelix);
 }
 
 //! Display local coordinate axes
@@ -994,6 +544,11 @@ void ModelView::drawLocalAxes(Transformation const& transform)
 //! Set the isometric view
 void ModelView::setIsometricView()
 {
+    // Defer until the geometry is built, since the camera is fitted to the scene
+    mIsIsometricPending = mpBuildWatcher->isRunning();
+    if (mIsIsometricPending)
+        return;
+
     vtkSmartPointer<vtkCamera> camera = mRenderer->GetActiveCamera();
     camera->SetPosition(-1, 1, 1);
     camera->SetFocalPoint(0, 0, 0);
@@ -1005,6 +560,7 @@ void ModelView::setIsometricView()
 
 ModelViewSelector::ModelViewSelector()
     : mIsVerbose(false)
+    , mIsDeferred(false)
 {
 }
 
@@ -1026,6 +582,7 @@ QList<Core::Selection> ModelViewSelector::selected() const
         if (selection.isValid())
             result.push_back(selection);
     }
+    result.append(mPending);
     return result;
 }
 
@@ -1035,6 +592,12 @@ void ModelViewSelector::setVerbose(bool value)
     mIsVerbose = value;
 }
 
+//! Queue selections of the entities which have not been drawn yet
+void ModelViewSelector::setDeferred(bool value)
+{
+    mIsDeferred = value;
+}
+
 //! Check if the verbosity is activated
 bool ModelViewSelector::isVerbose() const
 {
@@ -1107,9 +670,18 @@ void ModelViewSelector::select(vtkActor* actor, Flags flags)
 //! Select all the actors associated with a model entity
 void ModelViewSelector::select(Core::Selection key, Flags flags)
 {
-    // Check if there are any actors to select
+    // Check if there are any actors to select, otherwise queue the selection until they are drawn
     if (!mActors.contains(key))
+    {
+        if (mIsDeferred)
+        {
+            if (flags.testFlag(kSingleSelection))
+                mPending.clear();
+            if (!mPending.contains(key))
+                mPending.push_back(key);
+        }
         return;
+    }
 
     // Deselect all actors for the single selection mode
     if (flags.testFlag(kSingleSelection))
@@ -1125,9 +697,51 @@ void ModelViewSelector::select(Core::Selection key, Flags flags)
 //! Select all the actors associated with a set of model entities
 void ModelViewSelector::select(QList<Core::Selection> const& keys)
 {
-    int numKeys = keys.size();
-    for (int i = 0; i != numKeys; ++i)
-        select(keys[i], ModelViewSelector::kMultipleSelection);
+    QSet<Core::Selection> pending(mPending.begin(), mPending.end());
+    for (Core::Selection const& key : keys)
+    {
+        // Queue the selection until the actors are drawn
+        auto iter = mActors.constFind(key);
+        if (iter == mActors.cend())
+        {
+            if (mIsDeferred && !pending.contains(key))
+            {
+                pending.insert(key);
+                mPending.push_back(key);
+            }
+            continue;
+        }
+
+        // Select the actors, keeping the ones selected previously
+        for (vtkActor* actor : iter.value())
+        {
+            if (!isSelected(actor))
+                select(actor, ModelViewSelector::kMultipleSelection);
+        }
+    }
+}
+
+//! Select all the actors associated with the elements selected in the set
+void ModelViewSelector::select(Core::SelectionSet const& set)
+{
+    // Queue the selected elements until the actors are drawn
+    if (mIsDeferred)
+    {
+        select(set.selected());
+        return;
+    }
+
+    // Select the actors of the drawn elements, keeping the ones selected previously
+    for (auto const [key, values] : mActors.asKeyValueRange())
+    {
+        if (!set.isSelected(key))
+            continue;
+        for (vtkActor* actor : values)
+        {
+            if (!isSelected(actor))
+                select(actor, ModelViewSelector::kMultipleSelection);
+        }
+    }
 }
 
 //! Remove the actor from the selection set
@@ -1154,6 +768,7 @@ void ModelViewSelector::deselect(vtkActor* actor)
 //! Deselect all the actors associated with a model entity
 void ModelViewSelector::deselect(Core::Selection key)
 {
+    mPending.removeAll(key);
     if (!mActors.contains(key))
         return;
     QList<vtkActor*> values = mActors[key];
@@ -1165,6 +780,7 @@ void ModelViewSelector::deselect(Core::Selection key)
 //! Remove all the actors from the selection set
 void ModelViewSelector::deselectAll()
 {
+    mPending.clear();
     QList<Core::Selection> const keys = mActors.keys();
     int numKeys = keys.size();
     for (int iKey = 0; iKey != numKeys; ++iKey)
@@ -1208,6 +824,8 @@ QList<vtkActor*> ModelViewSelector::find(Core::Selection selection)
 void ModelViewSelector::clear()
 {
     mActors.clear();
+    mSelection.clear();
+    mPending.clear();
 }
 
 void PlaneFollowerCallback::Execute(vtkObject* caller, unsigned long evId, void*)
@@ -2,6 +2,7 @@
 #define MODELVIEW_H
 
 #include <QFlags>
+#include <QFutureWatcher>
 #include <QWidget>
 
 #include <vtkCallbackCommand.h>
@@ -22,8 +23,10 @@ struct Model;
 namespace Backend::Core
 {
 struct Selection;
+class SelectionSet;
 }
 
+class QProgressBar;
 class QVTKOpenGLNativeWidget;
 class vtkCameraOrientationWidget;
 class vtkTexture;
@@ -36,6 +39,9 @@ class vtkPolyDataSilhouette;
 namespace Frontend
 {
 
+struct ModelViewEntity;
+struct ModelViewScene;
+
 //! Class to select model entities on the scene
 class ModelViewSelector
 {
@@ -57,11 +63,13 @@ public:
     int numSelected() const;
     QList<Backend::Core::Selection> selected() const;
     void setVerbose(bool value);
+    void setDeferred(bool value);
 
     void selectAll();
     void select(vtkActor* actor, Flags flags);
     void select(Backend::Core::Selection key, Flags flags);
     void select(QList<Backend::Core::Selection> const& keys);
+    void select(Backend::Core::SelectionSet const& set);
     void deselect(vtkActor* actor);
     void deselect(Backend::Core::Selection key);
     void deselectAll();
@@ -73,8 +81,10 @@ public:
 
 private:
     bool mIsVerbose;
+    bool mIsDeferred;
     QMap<vtkActor*, vtkSmartPointer<vtkProperty>> mSelection;
     QMap<Backend::Core::Selection, QList<vtkActor*>> mActors;
+    QList<Backend::Core::Selection> mPending;
 };
 Q_DECLARE_OPERATORS_FOR_FLAGS(ModelViewSelector::Flags)
 
@@ -198,14 +208,11 @@ private:
     void createConnections();
 
     // Drawing
-    void drawModel();
-    void drawBeams2D(Transformation const& transform, int iSurface, KCL::ElementType type);
-    void drawBeams3D(Transformation const& transform, int iSurface, KCL::ElementType type);
-    void drawPanels2D(Transformation const& transform, int iSurface, KCL::ElementType type);
-    void drawPanels3D(Transformation const& transform, int iSurface, KCL::ElementType type);
-    void drawAeroTrapeziums(Transformation const& transform, int iSurface, KCL::ElementType type);
-    void drawMasses(Transformation const& transform, int iSurface, KCL::ElementType type);
-    void drawSprings(bool isReflect, KCL::ElementType type);
+    void processBuild();
+    void drawScene(ModelViewScene const& scene);
+    void drawElement(ModelViewEntity const& entity);
+    vtkPlaneSource* drawMass(ModelViewEntity const& entity);
+    void drawSpring(ModelViewEntity const& entity);
     void drawLocalAxes(Transformation const& transform);
 
     // Widgets
@@ -216,6 +223,7 @@ private:
     ModelViewOptions mOptions;
     ModelViewSelector mSelector;
     QVTKOpenGLNativeWidget* mRenderWidget;
+    QProgressBar* mpProgressBar;
     vtkSmartPointer<vtkRenderWindow> mRenderWindow;
     vtkSmartPointer<vtkRenderer> mRenderer;
     vtkSmartPointer<vtkCameraOrientationWidget> mOrientationWidget;
@@ -223,6 +231,10 @@ private:
     vtkSmartPointer<InteractorStyle> mStyle;
     QList<unsigned long> mObserverTags;
     double mMaximumDimension;
+
+    // Geometry building
+    QFutureWatcher<ModelViewScene>* mpBuildWatcher;
+    bool mIsIsometricPending;
 };
 }
 
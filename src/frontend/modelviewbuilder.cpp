@@ -0,0 +1,613 @@
+#include <vtkCellArray.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkPolygon.h>
+#include <vtkUnstructuredGrid.h>
+
+#include "modelviewbuilder.h"
+#include "uiutility.h"
+
+using namespace Frontend;
+using namespace Eigen;
+using namespace Backend;
+
+// Constants
+auto const skBeamTypes = Utility::beamTypes();
+auto const skPanelTypes = Utility::panelTypes();
+auto const skAeroTrapeziumTypes = Utility::aeroTrapeziumTypes();
+auto const skMassTypes = Utility::massTypes();
+auto const skSpringTypes = Utility::springTypes();
+
+ModelViewEntity::ModelViewEntity(Kind aKind, Core::Selection const& aSelection)
+    : kind(aKind)
+    , selection(aSelection)
+    , transform(Transformation::Identity())
+{
+}
+
+//! Check if the entity is associated with a model element
+bool ModelViewEntity::isSelectable() const
+{
+    return kind != kMassRod && kind != kLocalAxes;
+}
+
+ModelViewScene::ModelViewScene()
+    : maximumDimension(1.0)
+{
+}
+
+ModelViewBuilder::ModelViewBuilder(KCL::Model const& model, ModelViewOptions const& options)
+    : mModel(model)
+    , mOptions(options)
+{
+}
+
+//! Build the geometry of all the model entities
+void ModelViewBuilder::build(QPromise<ModelViewScene>& promise)
+{
+    mScene = ModelViewScene();
+    mBounds.setEmpty();
+
+    // Check if the model is suitable for drawing
+    if (mModel.isEmpty())
+    {
+        promise.addResult(mScene);
+        return;
+    }
+
+    // Loop through all the elastic surfaces
+    int numSurfaces = mModel.surfaces.size();
+    promise.setProgressRange(0, numSurfaces + 1);
+    for (int iSurface = 0; iSurface != numSurfaces; ++iSurface)
+    {
+        if (promise.isCanceled())
+            return;
+        buildSurface(iSurface);
+        promise.setProgressValue(1 + iSurface);
+    }
+
+    // Process the special surface
+    for (auto type : skSpringTypes)
+    {
+        buildSprings(false, type);
+        if (mOptions.showSymmetry)
+            buildSprings(true, type);
+    }
+
+    // Size the entities which depend on the scene dimensions
+    scaleEntities();
+    promise.setProgressValue(numSurfaces + 1);
+    promise.addResult(mScene);
+}
+
+//! Build the entities associated with an elastic surface
+void ModelViewBuilder::buildSurface(int iSurface)
+{
+    KCL::ElasticSurface const& surface = mModel.surfaces[iSurface];
+
+    // Retrieve the surface data
+    if (!surface.containsElement(KCL::OD))
+        return;
+    auto pData = (KCL::GeneralData*) surface.element(KCL::OD);
+    bool isSymmetry = pData->iSymmetry == 0 && mOptions.showSymmetry;
+
+    // Build up the transformation
+    auto transform = Utility::computeTransformation(pData->coords, pData->dihedralAngle, pData->sweepAngle, pData->zAngle);
+    auto aeroTransform = Utility::computeTransformation(pData->coords, pData->dihedralAngle, 0.0, pData->zAngle);
+
+    // Reflect the transformation about the XOY plane
+    auto reflectTransform = Utility::reflectTransformation(transform);
+    auto reflectAeroTransform = Utility::reflectTransformation(aeroTransform);
+
+    // Build the aero trapeziums
+    for (auto type : skAeroTrapeziumTypes)
+    {
+        buildAeroTrapeziums(aeroTransform, iSurface, type);
+        if (isSymmetry)
+            buildAeroTrapeziums(reflectAeroTransform, iSurface, type);
+    }
+
+    // Build the panels
+    for (auto type : skPanelTypes)
+    {
+        if (mOptions.showThickness)
+        {
+            buildPanels3D(transform, iSurface, type);
+            if (isSymmetry)
+                buildPanels3D(reflectTransform, iSurface, type);
+        }
+        else
+        {
+            buildPanels2D(transform, iSurface, type);
+            if (isSymmetry)
+                buildPanels2D(reflectTransform, iSurface, type);
+        }
+    }
+
+    // Build the beams
+    for (auto type : skBeamTypes)
+    {
+        buildBeams(transform, iSurface, type);
+        if (isSymmetry)
+            buildBeams(reflectTransform, iSurface, type);
+    }
+
+    // Build the masses
+    for (auto type : skMassTypes)
+    {
+        buildMasses(transform, iSurface, type);
+        if (isSymmetry)
+            buildMasses(reflectTransform, iSurface, type);
+    }
+
+    // Build the local coordinate axes
+    if (mOptions.showLocalAxes)
+    {
+        buildLocalAxes(transform);
+        if (isSymmetry)
+            buildLocalAxes(reflectTransform);
+    }
+}
+
+//! Build beam elements as lines or as cylinders, if the thickness is shown
+void ModelViewBuilder::buildBeams(Transformation const& transform, int iSurface, KCL::ElementType type)
+{
+    int const kNumCellPoints = 2;
+
+    // Slice the elements for rendering
+    std::vector<KCL::AbstractElement const*> elements = mModel.surfaces[iSurface].elements(type);
+    if (elements.empty() || !mOptions.maskElements[type])
+        return;
+
+    // Process all the elements
+    int numElements = elements.size();
+    for (int iElement = 0; iElement != numElements; ++iElement)
+    {
+        KCL::AbstractElement const* pElement = elements[iElement];
+
+        // Slice element coordinates
+        KCL::VecN elementData = pElement->get();
+        KCL::Vec2 startCoords = {elementData[0], elementData[1]};
+        KCL::Vec2 endCoords = {elementData[2], elementData[3]};
+
+        // Transform the coordinates to global coordinate system
+        Vector3d startPosition = transform * Vector3d(startCoords[0], 0.0, startCoords[1]);
+        Vector3d endPosition = transform * Vector3d(endCoords[0], 0.0, endCoords[1]);
+        expandBounds(startPosition);
+        expandBounds(endPosition);
+
+        // Cylinders are tessellated once the scene dimensions are known
+        Core::Selection selection(iSurface, type, iElement);
+        if (mOptions.showThickness)
+        {
+            ModelViewEntity entity(ModelViewEntity::kBeamCylinder, selection);
+            entity.positions = {startPosition, endPosition};
+            mScene.entities.push_back(entity);
+            continue;
+        }
+
+        // Set the points
+        vtkNew<vtkPoints> points;
+        points->InsertNextPoint(startPosition[0], startPosition[1], startPosition[2]);
+        points->InsertNextPoint(endPosition[0], endPosition[1], endPosition[2]);
+
+        // Set the connectivity indices
+        vtkNew<vtkCellArray> indices;
+        indices->InsertNextCell(kNumCellPoints);
+        indices->InsertCellPoint(0);
+        indices->InsertCellPoint(1);
+
+        // Create the polygons
+        vtkNew<vtkPolyData> polyData;
+        polyData->SetPoints(points);
+        polyData->SetLines(indices);
+
+        // Add the entity
+        ModelViewEntity entity(ModelViewEntity::kBeamLine, selection);
+        entity.data = polyData;
+        mScene.entities.push_back(entity);
+    }
+}
+
+//! Build panel elements as planes
+void ModelViewBuilder::buildPanels2D(Transformation const& transform, int iSurface, KCL::ElementType type)
+{
+    int const kNumCellPoints = 4;
+
+    // Slice the elements for rendering
+    std::vector<KCL::AbstractElement const*> elements = mModel.surfaces[iSurface].elements(type);
+    if (elements.empty() || !mOptions.maskElements[type])
+        return;
+
+    // Process all the elements
+    int numElements = elements.size();
+    for (int iElement = 0; iElement != numElements; ++iElement)
+    {
+        KCL::AbstractElement const* pElement = elements[iElement];
+
+        // Slice element coordinates
+        KCL::VecN elementData = pElement->get();
+
+        // Set points and connections between them
+        int iData = 1;
+        vtkNew<vtkPoints> points;
+        vtkNew<vtkPolygon> polygon;
+        vtkNew<vtkCellArray> polygons;
+        for (int iPosition = 0; iPosition != kNumCellPoints; ++iPosition)
+        {
+            Vector3d position = transform * Vector3d(elementData[iData], 0.0, elementData[iData + 1]);
+            points->InsertNextPoint(position[0], position[1], position[2]);
+            polygon->GetPointIds()->InsertNextId(iPosition);
+            expandBounds(position);
+            iData += 2;
+        }
+        polygons->InsertNextCell(polygon);
+
+        // Create the polygon objects
+        vtkNew<vtkPolyData> polyData;
+        polyData->SetPoints(points);
+        polyData->SetPolys(polygons);
+
+        // Add the entity
+        ModelViewEntity entity(ModelViewEntity::kPanel, Core::Selection(iSurface, type, iElement));
+        entity.data = polyData;
+        mScene.entities.push_back(entity);
+    }
+}
+
+//! Build panel elements as hexahedrons
+void ModelViewBuilder::buildPanels3D(Transformation const& transform, int iSurface, KCL::ElementType type)
+{
+    int const kNumVertices = 4;
+
+    // Slice the elements for rendering
+    std::vector<KCL::AbstractElement const*> elements = mModel.surfaces[iSurface].elements(type);
+    if (elements.empty() || !mOptions.maskElements[type])
+        return;
+
+    // Process all the elements
+    int numElements = elements.size();
+    for (int iElement = 0; iElement != numElements; ++iElement)
+    {
+        KCL::AbstractElement const* pElement = elements[iElement];
+
+        // Get element data
+        KCL::VecN elementData = pElement->get();
+
+        // Get the plane coordinates
+        int iData = 0;
+        double thickness = elementData[iData++];
+        Matrix42d coords;
+        for (int iVertex = 0; iVertex != kNumVertices; ++iVertex)
+        {
+            coords(iVertex, 0) = elementData[iData];
+            coords(iVertex, 1) = elementData[iData + 1];
+            iData += 2;
+        }
+
+        // Get the depths
+        Vector4d depths;
+        int numDepths = depths.size();
+        for (int iDepth = 0; iDepth != numDepths; ++iDepth)
+        {
+            depths[iDepth] = elementData[iData];
+            ++iData;
+        }
+
+        // Evaluate the depth at the last point
+        if (type != KCL::P4)
+            Utility::setLastDepth(coords, depths);
+
+        // Add the entity
+        ModelViewEntity entity(ModelViewEntity::kShell, Core::Selection(iSurface, type, iElement));
+        entity.data = Utility::createShellData(transform, coords, depths, thickness);
+        expandBounds(entity.data);
+        mScene.entities.push_back(entity);
+    }
+}
+
+//! Build aerodynamic trapezium elements
+void ModelViewBuilder::buildAeroTrapeziums(Transformation const& transform, int iSurface, KCL::ElementType type)
+{
+    // Slice the elements for rendering
+    std::vector<KCL::AbstractElement const*> elements = mModel.surfaces[iSurface].elements(type);
+    if (elements.empty() || !mOptions.maskElements[type])
+        return;
+
+    // Process all the elements
+    int numElements = elements.size();
+    bool isVertical = Utility::isAeroVertical(type);
+    bool isAileron = Utility::isAeroAileron(type);
+    bool isMeshable = Utility::isAeroMeshable(type);
+    for (int iElement = 0; iElement != numElements; ++iElement)
+    {
+        KCL::AbstractElement const* pElement = elements[iElement];
+        if (pElement->subType() == KCL::ElementSubType::AE1)
+            continue;
+
+        // Slice element parameters
+        KCL::VecN data = pElement->get();
+        int iShift = isAileron ? 1 : 0;
+        KCL::Vec2 coords0 = {data[iShift + 0], data[iShift + 1]};
+        KCL::Vec2 coords1 = {data[iShift + 2], data[iShift + 3]};
+        KCL::Vec2 coords2 = {data[iShift + 4], data[iShift + 5]};
+        int numStrips = 1;
+        int numPanels = 1;
+        if (isMeshable)
+        {
+            numStrips = data[iShift + 6];
+            numPanels = data[iShift + 7];
+        }
+
+        // Combine the vertex coordinates
+        Vector2d A = {coords0[0], coords0[1]}; // Bottom left
+        Vector2d B = {coords2[0], coords0[1]}; // Bottom right
+        Vector2d C = {coords2[1], coords1[1]}; // Top right
+        Vector2d D = {coords1[0], coords1[1]}; // Top left
+
+        // Allocate the points and their connectivity list
+        vtkNew<vtkPoints> points;
+        vtkNew<vtkCellArray> polygons;
+
+        // Create the grid of points
+        for (int s = 0; s <= numPanels; ++s)
+        {
+            double u = (double) s / numPanels;
+            for (int r = 0; r <= numStrips; ++r)
+            {
+                double v = (double) r / numStrips;
+                double x = (1.0 - v) * ((1.0 - u) * A[0] + u * B[0]) + v * ((1.0 - u) * D[0] + u * C[0]);
+                double z = (1.0 - v) * ((1.0 - u) * A[1] + u * B[1]) + v * ((1.0 - u) * D[1] + u * C[1]);
+                Vector3d position = isVertical ? Vector3d(x, z, 0) : Vector3d(x, 0, z);
+                position = transform * position;
+                points->InsertNextPoint(position[0], position[1], position[2]);
+            }
+        }
+
+        // Set the polygon data
+        for (int s = 0; s != numPanels; ++s)
+        {
+            for (int r = 0; r != numStrips; ++r)
+            {
+                vtkNew<vtkPolygon> polygon;
+                polygon->GetPointIds()->InsertNextId(s * (numStrips + 1) + r);
+                polygon->GetPointIds()->InsertNextId(s * (numStrips + 1) + r + 1);
+                polygon->GetPointIds()->InsertNextId((s + 1) * (numStrips + 1) + r + 1);
+                polygon->GetPointIds()->InsertNextId((s + 1) * (numStrips + 1) + r);
+                polygons->InsertNextCell(polygon);
+            }
+        }
+
+        // Create the polygon objects
+        vtkNew<vtkPolyData> polyData;
+        polyData->SetPoints(points);
+        polyData->SetPolys(polygons);
+
+        // Add the entity
+        ModelViewEntity entity(ModelViewEntity::kAeroTrapezium, Core::Selection(iSurface, type, iElement));
+        entity.data = polyData;
+        expandBounds(entity.data);
+        mScene.entities.push_back(entity);
+    }
+}
+
+//! Build point masses together with rods which connect them to elastic surfaces
+void ModelViewBuilder::buildMasses(Transformation const& transform, int iSurface, KCL::ElementType type)
+{
+    // Slice the elements for rendering
+    std::vector<KCL::AbstractElement const*> elements = mModel.surfaces[iSurface].elements(type);
+    if (elements.empty() || !mOptions.maskElements[type])
+        return;
+
+    // Process all the elements
+    int numElements = elements.size();
+    for (int iElement = 0; iElement != numElements; ++iElement)
+    {
+        KCL::AbstractElement const* pBaseElement = elements[iElement];
+
+        // Slice element coordinates
+        Vector3d startPosition;
+        double lengthRod = 0.0;
+        double angleRodZ = 0.0;
+        switch (pBaseElement->type())
+        {
+        case KCL::SM:
+        {
+            auto pElement = (KCL::PointMass1 const*) pBaseElement;
+            startPosition = {pElement->coords[0], 0.0, pElement->coords[1]};
+            lengthRod = pElement->lengthRod;
+            angleRodZ = pElement->angleRodZ;
+            break;
+        }
+        case KCL::M3:
+        {
+            auto pElement = (KCL::PointMass3 const*) pBaseElement;
+            startPosition = {pElement->coords[0], pElement->coords[1], pElement->coords[2]};
+            lengthRod = pElement->lengthRod;
+            angleRodZ = pElement->angleRodZ;
+            break;
+        }
+        default:
+            continue;
+        }
+
+        // Build up the additional line which connects the mass to the elastic surface
+        Vector3d endPosition;
+        if (lengthRod > 0.0)
+        {
+            // Transform the coordiantes to the global coordinate system
+            auto addTransform = Transformation::Identity();
+            addTransform.rotate(AngleAxisd(qDegreesToRadians(angleRodZ), Vector3d::UnitY()));
+            addTransform.translate(Vector3d(0, 0, lengthRod));
+            endPosition = transform * addTransform * startPosition;
+            startPosition = transform * startPosition;
+
+            // Create the points and connectivity list
+            vtkNew<vtkPoints> points;
+            points->InsertNextPoint(startPosition[0], startPosition[1], startPosition[2]);
+            points->InsertNextPoint(endPosition[0], endPosition[1], endPosition[2]);
+            vtkNew<vtkCellArray> indices;
+            indices->InsertNextCell(2);
+            indices->InsertCellPoint(0);
+            indices->InsertCellPoint(1);
+
+            // Set the polygonal data
+            vtkNew<vtkPolyData> data;
+            data->SetPoints(points);
+            data->SetLines(indices);
+
+            // Add the rod entity
+            ModelViewEntity entity(ModelViewEntity::kMassRod);
+            entity.data = data;
+            mScene.entities.push_back(entity);
+        }
+        else
+        {
+            startPosition = transform * startPosition;
+            endPosition = startPosition;
+        }
+        expandBounds(startPosition);
+        expandBounds(endPosition);
+
+        // The plane source is created on the GUI thread, since it follows the camera
+        ModelViewEntity entity(ModelViewEntity::kMass, Core::Selection(iSurface, type, iElement));
+        entity.positions = {endPosition};
+        mScene.entities.push_back(entity);
+    }
+}
+
+//! Build springs which connect elastic surfaces
+void ModelViewBuilder::buildSprings(bool isReflect, KCL::ElementType type)
+{
+    KCL::Vec3 kZeroVec = {0.0, 0.0, 0.0};
+
+    // Slice the elements for rendering
+    std::vector<KCL::AbstractElement const*> elements = mModel.specialSurface.elements(type);
+    if (elements.empty() || !mOptions.maskElements[type])
+        return;
+
+    // Process all the elements
+    int numElements = elements.size();
+    int numSurfaces = mModel.surfaces.size();
+    for (int iElement = 0; iElement != numElements; ++iElement)
+    {
+        KCL::AbstractElement const* pBaseElement = elements[iElement];
+        if (!mOptions.maskElements[pBaseElement->type()])
+            continue;
+        if (pBaseElement->type() != KCL::PR)
+            continue;
+        auto pElement = (KCL::SpringDamper const*) pBaseElement;
+
+        // Process the first elastic surface
+        int iFirstSurface = pElement->iFirstSurface - 1;
+        if (iFirstSurface < 0 || iFirstSurface >= numSurfaces)
+            continue;
+        auto const& firstSurface = mModel.surfaces[iFirstSurface];
+        auto pFirstData = (KCL::GeneralData*) firstSurface.element(KCL::OD);
+        auto firstTransform = Utility::computeTransformation(pFirstData->coords, pFirstData->dihedralAngle, pFirstData->sweepAngle,
+                                                             pFirstData->zAngle);
+        auto addFirstTransform = Utility::computeTransformation(kZeroVec, 0.0, pElement->anglesFirstRod[0], pElement->anglesFirstRod[1]);
+        if (pFirstData->iSymmetry != 0 && isReflect)
+            continue;
+        if (isReflect)
+        {
+            firstTransform = Utility::reflectTransformation(firstTransform);
+            addFirstTransform = Utility::reflectTransformation(addFirstTransform);
+        }
+        Vector3d firstPosition = firstTransform * Vector3d(pElement->coordsFirstRod[0], 0.0, pElement->coordsFirstRod[1]);
+
+        // Process the second elastic surface
+        Vector3d secondPosition = {0.0, 0.0, 0.0};
+        if (pElement->iSecondSurface > 0)
+        {
+            int iSecondSurface = pElement->iSecondSurface - 1;
+            if (iSecondSurface < 0 || iSecondSurface >= numSurfaces)
+                continue;
+            auto const& secondSurface = mModel.surfaces[iSecondSurface];
+            auto pSecondData = (KCL::GeneralData*) secondSurface.element(KCL::OD);
+            auto secondTransform = Utility::computeTransformation(pSecondData->coords, pSecondData->dihedralAngle, pSecondData->sweepAngle,
+                                                                  pSecondData->zAngle);
+            if (pSecondData->iSymmetry != 0 && isReflect)
+                continue;
+            if (isReflect)
+                secondTransform = Utility::reflectTransformation(secondTransform);
+            secondPosition = secondTransform * Vector3d(pElement->coordsSecondRod[0], 0.0, pElement->coordsSecondRod[1]);
+        }
+        else
+        {
+            auto addFirstPosition = addFirstTransform * Vector3d({0.0, 0.0, pElement->lengthFirstRod});
+            secondPosition = firstPosition + addFirstPosition;
+        }
+        expandBounds(firstPosition);
+        expandBounds(secondPosition);
+
+        // The helix is tessellated once the scene dimensions are known
+        ModelViewEntity entity(ModelViewEntity::kSpring, Core::Selection(type, iElement));
+        entity.positions = {firstPosition, secondPosition};
+        mScene.entities.push_back(entity);
+    }
+}
+
+//! Build local coordinate axes
+void ModelViewBuilder::buildLocalAxes(Transformation const& transform)
+{
+    ModelViewEntity entity(ModelViewEntity::kLocalAxes);
+    entity.transform = transform;
+    mScene.entities.push_back(entity);
+}
+
+//! Include the position into the scene boundaries
+void ModelViewBuilder::expandBounds(Vector3d const& position)
+{
+    mBounds.extend(position);
+}
+
+//! Include the dataset into the scene boundaries
+void ModelViewBuilder::expandBounds(vtkDataSet* data)
+{
+    if (!data || data->GetNumberOfPoints() == 0)
+        return;
+    double bounds[6];
+    data->GetBounds(bounds);
+    mBounds.extend(Vector3d(bounds[0], bounds[2], bounds[4]));
+    mBounds.extend(Vector3d(bounds[1], bounds[3], bounds[5]));
+}
+
+//! Compute the maximum scene dimension and tessellate the entities which depend on it
+void ModelViewBuilder::scaleEntities()
+{
+    int const kCylinderResolution = 8;
+    int const kNumTurns = 6;
+    int const kHelixResolution = 30;
+
+    // Compute the maximum dimension
+    double maxDimension = 0.0;
+    if (!mBounds.isEmpty())
+        maxDimension = mBounds.sizes().maxCoeff();
+    if (maxDimension < std::numeric_limits<double>::epsilon())
+        maxDimension = 1.0;
+    mScene.maximumDimension = maxDimension;
+
+    // Tessellate the entities
+    for (ModelViewEntity& entity : mScene.entities)
+    {
+        switch (entity.kind)
+        {
+        case ModelViewEntity::kBeamCylinder:
+        {
+            double radius = mOptions.beamScale * maxDimension;
+            entity.data = Utility::createCylinderData(entity.positions[0], entity.positions[1], radius, kCylinderResolution);
+            break;
+        }
+        case ModelViewEntity::kSpring:
+        {
+            double length = (entity.positions[1] - entity.positions[0]).norm();
+            double radius = mOptions.springScale * maxDimension * length;
+            entity.data = Utility::createHelixData(entity.positions[0], entity.positions[1], radius, kNumTurns, kHelixResolution);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef MODELVIEWBUILDER_H
+#define MODELVIEWBUILDER_H
+
+#include <QPromise>
+
+#include <kcl/model.h>
+#include <vtkDataSet.h>
+#include <vtkSmartPointer.h>
+
+#include "modelview.h"
+#include "selectionset.h"
+#include "uialiasdata.h"
+
+namespace Frontend
+{
+
+//! Geometry of a model entity prepared for rendering
+struct ModelViewEntity
+{
+    enum Kind
+    {
+        kBeamLine,
+        kBeamCylinder,
+        kPanel,
+        kShell,
+        kAeroTrapezium,
+        kMassRod,
+        kMass,
+        kSpring,
+        kLocalAxes
+    };
+
+    ModelViewEntity(Kind aKind, Backend::Core::Selection const& aSelection = Backend::Core::Selection());
+    ~ModelViewEntity() = default;
+
+    bool isSelectable() const;
+
+    Kind kind;
+    Backend::Core::Selection selection;
+    vtkSmartPointer<vtkDataSet> data;
+    QList<Eigen::Vector3d> positions;
+    Transformation transform;
+};
+
+//! Model geometry which is ready to be rendered
+struct ModelViewScene
+{
+    ModelViewScene();
+    ~ModelViewScene() = default;
+
+    double maximumDimension;
+    QList<ModelViewEntity> entities;
+};
+
+//! Class to build the geometry of a model snapshot off the GUI thread
+class ModelViewBuilder
+{
+public:
+    ModelViewBuilder(KCL::Model const& model, ModelViewOptions const& options);
+    ~ModelViewBuilder() = default;
+
+    void build(QPromise<ModelViewScene>& promise);
+
+private:
+    // Entities
+    void buildSurface(int iSurface);
+    void buildBeams(Transformation const& transform, int iSurface, KCL::ElementType type);
+    void buildPanels2D(Transformation const& transform, int iSurface, KCL::ElementType type);
+    void buildPanels3D(Transformation const& transform, int iSurface, KCL::ElementType type);
+    void buildAeroTrapeziums(Transformation const& transform, int iSurface, KCL::ElementType type);
+    void buildMasses(Transformation const& transform, int iSurface, KCL::ElementType type);
+    void buildSprings(bool isReflect, KCL::ElementType type);
+    void buildLocalAxes(Transformation const& transform);
+
+    // Dimensions
+    void expandBounds(Eigen::Vector3d const& position);
+    void expandBounds(vtkDataSet* data);
+    void scaleEntities();
+
+private:
+    KCL::Model const mModel;
+    ModelViewOptions const mOptions;
+    ModelViewScene mScene;
+    Eigen::AlignedBox3d mBounds;
+};
+}
+
+#endif // MODELVIEWBUILDER_H
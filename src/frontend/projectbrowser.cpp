@@ -84,6 +84,19 @@ void ProjectBrowser::refresh()
     connect(mpView->selectionModel(), &QItemSelectionModel::selectionChanged, this, &ProjectBrowser::processSelection);
 }
 
+//! Recreate the children of the item, leaving the rest of the tree intact
+void ProjectBrowser::refresh(HierarchyItem* pItem)
+{
+    if (!pItem)
+        return;
+    {
+        // Removed children should not alter the saved selection
+        QSignalBlocker blocker(mpView->selectionModel());
+        pItem->invalidate();
+    }
+    setItemModelState(mpFilterModel->mapFromSource(pItem->index()));
+}
+
 //! Select model items
 void ProjectBrowser::selectItems(KCL::Model const& model, QList<Backend::Core::Selection> const& selections)
 {
@@ -156,6 +169,9 @@ void ProjectBrowser::createContent()
     connect(mpEditorManager, &EditorManager::optimOptionsEdited, this, &ProjectBrowser::edited);
     connect(mpEditorManager, &EditorManager::constraintsEdited, this, &ProjectBrowser::edited);
     connect(mpEditorManager, &EditorManager::optimTargetEdited, this, &ProjectBrowser::edited);
+    connect(mpEditorManager, &EditorManager::sensitivityOptionsEdited, this, &ProjectBrowser::edited);
+    connect(mpEditorManager, &EditorManager::uncertaintyOptionsEdited, this, &ProjectBrowser::edited);
+    connect(mpEditorManager, &EditorManager::envelopeOptionsEdited, this, &ProjectBrowser::edited);
 
     // Create the view widget
     mpView = new QTreeView;
@@ -217,6 +233,9 @@ void ProjectBrowser::filterContent(QString const& pattern)
     // Set the expression
     if (expression.isValid())
     {
+        // Items have to be created in order to be matched
+        if (!pattern.isEmpty())
+            mpSourceModel->fetchAll();
         mpFilterLineEdit->setToolTip(QString());
         mpFilterModel->setFilterRegularExpression(expression);
         Utility::setTextColor(mpFilterLineEdit, Utility::textColor(style()->standardPalette()));
@@ -356,6 +375,15 @@ void ProjectBrowser::createItemEditor(HierarchyItem* pBaseItem)
     case HierarchyItem::kOptimTarget:
         mpEditorManager->createEditor(static_cast<OptimTargetHierarchyItem*>(pBaseItem)->target());
         break;
+    case HierarchyItem::kSensitivityOptions:
+        mpEditorManager->createEditor(static_cast<SensitivityOptionsHierarchyItem*>(pBaseItem)->options());
+        break;
+    case HierarchyItem::kUncertaintyOptions:
+        mpEditorManager->createEditor(static_cast<UncertaintyOptionsHierarchyItem*>(pBaseItem)->options());
+        break;
+    case HierarchyItem::kEnvelopeOptions:
+        mpEditorManager->createEditor(static_cast<EnvelopeOptionsHierarchyItem*>(pBaseItem)->options());
+        break;
     default:
         break;
     }
@@ -428,7 +456,7 @@ void ProjectBrowser::createModelActions(QMenu* pMenu, QList<HierarchyItem*> cons
 
     // Set the connections
     connect(pOpenAction, &QAction::triggered, this,
-            [this, pModel]()
+            [this, pItem, pModel]()
             {
                 QString defaultDir = Utility::getLastDirectory(mSettings).absolutePath();
                 QString pathFile = QFileDialog::getOpenFileName(this, tr("Open Model"), defaultDir, tr("Model file format (*.dat *.txt)"));
@@ -436,7 +464,7 @@ void ProjectBrowser::createModelActions(QMenu* pMenu, QList<HierarchyItem*> cons
                     return;
                 *pModel = Utility::readModel(pathFile);
                 Utility::setLastPathFile(mSettings, pathFile);
-                refresh();
+                refresh(pItem);
                 emit modelSubstituted(*pModel);
             });
     connect(pSaveAsAction, &QAction::triggered, this,
@@ -479,20 +507,21 @@ void ProjectBrowser::createSurfaceActions(QMenu* pMenu, QList<HierarchyItem*> co
     KCL::Model* pModel = pItem->kclModel();
     if (!pModel)
         return;
+    HierarchyItem* pModelItem = Utility::findParentByType(pItem, HierarchyItem::kModel);
 
     // Create the actions
     QAction* pRemoveAction = new QAction(QIcon(":/icons/list-remove.svg"), tr("&Remove"), this);
 
     // Set the connections
     connect(pRemoveAction, &QAction::triggered, this,
-            [this, pModel, iSurface]()
+            [this, pModelItem, pModel, iSurface]()
             {
                 QString title = tr("Remove elastic surface");
                 QString text = tr("Are you sure you want to remove '%1' elastic surface?").arg(pModel->surfaces[iSurface].name);
                 if (QMessageBox::Yes == QMessageBox().question(this, title, text))
                 {
                     pModel->surfaces.erase(pModel->surfaces.begin() + iSurface);
-                    refresh();
+                    refresh(pModelItem);
                     emit modelEdited(*pModel);
                 }
             });
@@ -524,17 +553,17 @@ void ProjectBrowser::createSelectorActions(QMenu* pMenu, QList<HierarchyItem*> c
 
     // Set the connections
     connect(pAddAction, &QAction::triggered, this,
-            [this, pSelector, pModel]()
+            [this, pItem, pSelector, pModel]()
             {
                 pSelector->add(*pModel);
-                refresh();
+                refresh(pItem);
                 emit edited();
             });
     connect(pClearAction, &QAction::triggered, this,
-            [this, pSelector]()
+            [this, pItem, pSelector]()
             {
                 pSelector->clear();
-                refresh();
+                refresh(pItem);
                 emit edited();
             });
 
@@ -563,18 +592,24 @@ void ProjectBrowser::createSelectionSetActions(QMenu* pMenu, QList<HierarchyItem
     KCL::Model* pModel = pItem->kclModel();
     if (!pModel)
         return;
+    HierarchyItem* pSelectorItem = (HierarchyItem*) pItem->parent();
 
     // Create the actions
     QAction* pSetAction = new QAction(QIcon(":/icons/edit-select.svg"), tr("&Set by view"), this);
     QAction* pRemoveAction = new QAction(QIcon(":/icons/list-remove.svg"), tr("&Remove"), this);
 
     // Set the connections
-    connect(pSetAction, &QAction::triggered, this, [this, pModel, pSelectionSet]() { emit requestSetSelectionByView(*pModel, *pSelectionSet); });
+    connect(pSetAction, &QAction::triggered, this,
+            [this, pSelectorItem, pModel, pSelectionSet]()
+            {
+                emit requestSetSelectionByView(*pModel, *pSelectionSet);
+                refresh(pSelectorItem);
+            });
     connect(pRemoveAction, &QAction::triggered, this,
-            [this, pSelector, iSelectionSet]()
+            [this, pSelectorItem, pSelector, iSelectionSet]()
             {
                 pSelector->remove(iSelectionSet);
-                refresh();
+                refresh(pSelectorItem);
                 emit edited();
             });
 
@@ -604,10 +639,15 @@ void ProjectBrowser::setItemModelState(QModelIndex const& index)
     QModelIndex proxyIndex = mpFilterModel->mapToSource(index);
     HierarchyItem* pItem = (HierarchyItem*) mpSourceModel->itemFromIndex(proxyIndex);
     QString id = pItem->id();
-    if (mSelectedState.contains(id) && mSelectedState[id])
+    bool isExpanded = mExpandedState.value(id, false);
+    if (mSelectedState.value(id, false))
         mpView->selectionModel()->select(index, QItemSelectionModel::Select);
     if (mExpandedState.contains(id))
-        mpView->setExpanded(index, mExpandedState[id]);
+        mpView->setExpanded(index, isExpanded);
+
+    // Populate the item only if its children need to be restored
+    if (pItem->canFetchMore() && (isExpanded || hasSelectedChildren(id)))
+        mpFilterModel->fetchMore(index);
 
     // Process the children
     uint numRows = mpFilterModel->rowCount(index);
@@ -615,6 +655,15 @@ void ProjectBrowser::setItemModelState(QModelIndex const& index)
         setItemModelState(mpFilterModel->index(iRow, 0, index));
 }
 
+//! Check if any of the item descendants was selected
+bool ProjectBrowser::hasSelectedChildren(QString const& id) const
+{
+    // Identifiers of descendants are prefixed by the parent one, so that they are adjacent in the ordered map
+    QString prefix = id + HierarchyItem::separator();
+    auto iter = mSelectedState.lowerBound(prefix);
+    return iter != mSelectedState.end() && iter.key().startsWith(prefix);
+}
+
 //! Expand or collapse selected items recursively
 void ProjectBrowser::setSelectedItemsExpandedState(bool flag)
 {
@@ -46,6 +46,7 @@ public:
     QList<HierarchyItem*> selectedItems();
 
     void refresh();
+    void refresh(HierarchyItem* pItem);
     void selectItems(KCL::Model const& model, QList<Backend::Core::Selection> const& selections);
     void editItems(KCL::Model const& model, QList<Backend::Core::Selection> const& selections);
 
@@ -81,6 +82,7 @@ private:
     // Subproject management
     void setModelState();
     void setItemModelState(QModelIndex const& index);
+    bool hasSelectedChildren(QString const& id) const;
     void setSelectedItemsExpandedState(bool flag);
 
 private:
@@ -2,6 +2,7 @@
 
 #include <kcl/model.h>
 
+#include "envelopesolver.h"
 #include "fluttersolver.h"
 #include "hierarchyitem.h"
 #include "modalsolver.h"
@@ -9,6 +10,8 @@
 #include "project.h"
 #include "projecthierarchymodel.h"
 #include "selectionset.h"
+#include "sensitivitysolver.h"
+#include "uncertaintysolver.h"
 #include "uiutility.h"
 
 using namespace Backend;
@@ -38,6 +41,46 @@ void ProjectHierarchyModel::selectItems(KCL::Model const& model, QList<Backend::
     }
 }
 
+//! Create all the items which have been deferred
+void ProjectHierarchyModel::fetchAll()
+{
+    fetchAll(invisibleRootItem());
+}
+
+//! Check if the item has children, including the ones which have not been created yet
+bool ProjectHierarchyModel::hasChildren(QModelIndex const& parent) const
+{
+    HierarchyItem* pItem = (HierarchyItem*) itemFromIndex(parent);
+    if (pItem && pItem->canFetchMore())
+        return true;
+    return QStandardItemModel::hasChildren(parent);
+}
+
+//! Check if the children of the item have been deferred
+bool ProjectHierarchyModel::canFetchMore(QModelIndex const& parent) const
+{
+    HierarchyItem* pItem = (HierarchyItem*) itemFromIndex(parent);
+    return pItem && pItem->canFetchMore();
+}
+
+//! Create the children of the item on the first request
+void ProjectHierarchyModel::fetchMore(QModelIndex const& parent)
+{
+    HierarchyItem* pItem = (HierarchyItem*) itemFromIndex(parent);
+    if (pItem)
+        pItem->fetchMore();
+}
+
+//! Populate the item and its descendants recursively
+void ProjectHierarchyModel::fetchAll(QStandardItem* pItem)
+{
+    if (pItem != invisibleRootItem())
+        static_cast<HierarchyItem*>(pItem)->fetchMore();
+    int numRows = pItem->rowCount();
+    for (int i = 0; i != numRows; ++i)
+        fetchAll(pItem->child(i));
+}
+
 //! Create all the items associated with the project
 void ProjectHierarchyModel::appendChildren()
 {
@@ -69,6 +112,15 @@ void ProjectHierarchyModel::processItemChange(QStandardItem* pItem)
     case HierarchyItem::kOptimSolver:
         static_cast<OptimSolverHierarchyItem*>(pItem)->solver()->name = text;
         break;
+    case HierarchyItem::kSensitivitySolver:
+        static_cast<SensitivitySolverHierarchyItem*>(pItem)->solver()->name = text;
+        break;
+    case HierarchyItem::kUncertaintySolver:
+        static_cast<UncertaintySolverHierarchyItem*>(pItem)->solver()->name = text;
+        break;
+    case HierarchyItem::kEnvelopeSolver:
+        static_cast<EnvelopeSolverHierarchyItem*>(pItem)->solver()->name = text;
+        break;
     case HierarchyItem::kOptimSelectionSet:
         static_cast<OptimSelectionSetHierarchyItem*>(pItem)->selectionSet().name() = text;
         break;
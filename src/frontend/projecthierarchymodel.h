@@ -26,8 +26,15 @@ public:
     virtual ~ProjectHierarchyModel() = default;
 
     void selectItems(KCL::Model const& model, QList<Backend::Core::Selection> const& selections);
+    void fetchAll();
+
+    // Lazy population
+    bool hasChildren(QModelIndex const& parent = QModelIndex()) const override;
+    bool canFetchMore(QModelIndex const& parent) const override;
+    void fetchMore(QModelIndex const& parent) override;
 
 private:
+    void fetchAll(QStandardItem* pItem);
     void appendChildren();
     void processItemChange(QStandardItem* pItem);
 
@@ -0,0 +1,119 @@
+#include <QSplitter>
+#include <QVBoxLayout>
+
+#include "customplot.h"
+#include "sensitivityview.h"
+#include "tableview.h"
+
+using namespace Backend;
+using namespace Frontend;
+
+SensitivityView::SensitivityView(Core::SensitivitySolution const& solution)
+    : mSolution(solution)
+    , mpColorMap(nullptr)
+    , mpColorScale(nullptr)
+{
+    createContent();
+}
+
+//! Clear all the items from the scene
+void SensitivityView::clear()
+{
+    mpPlot->clearPlottables();
+    mpColorMap = nullptr;
+    if (mpColorScale)
+    {
+        mpPlot->plotLayout()->remove(mpColorScale);
+        mpColorScale = nullptr;
+    }
+    mpTable->clear();
+}
+
+//! Draw the sensitivities of the frequencies, so that each row corresponds to a base mode
+void SensitivityView::plot()
+{
+    // Remove the previous data
+    clear();
+    mpTable->plot();
+    if (mSolution.isEmpty())
+    {
+        mpPlot->replot();
+        return;
+    }
+
+    // Slice dimensions
+    int const numModes = mSolution.numModes();
+    int const numParameters = mSolution.numParameters();
+
+    // Create the color map, so that the cells are centered at the integer indices
+    mpColorMap = new QCPColorMap(mpPlot->xAxis, mpPlot->yAxis);
+    mpColorMap->data()->setSize(numParameters, numModes);
+    mpColorMap->data()->setRange(QCPRange(1, numParameters), QCPRange(1, numModes));
+    double maxValue = 0.0;
+    for (int i = 0; i != numModes; ++i)
+    {
+        for (int j = 0; j != numParameters; ++j)
+        {
+            double value = mSolution.sensitivityFrequencies(i, j);
+            mpColorMap->data()->setCell(j, i, value);
+            if (!std::isnan(value))
+                maxValue = std::max(maxValue, std::abs(value));
+        }
+    }
+
+    // Make the color range symmetric, so that zero sensitivity is neutral
+    if (maxValue == 0.0)
+        maxValue = 1.0;
+    mpColorScale = new QCPColorScale(mpPlot);
+    mpColorScale->setType(QCPAxis::atRight);
+    mpColorScale->axis()->setLabel(tr("Sf"));
+    mpPlot->plotLayout()->addElement(0, 1, mpColorScale);
+    mpColorMap->setColorScale(mpColorScale);
+    mpColorMap->setGradient(QCPColorGradient::gpPolar);
+    mpColorMap->setDataRange(QCPRange(-maxValue, maxValue));
+    mpColorMap->setInterpolate(false);
+
+    // Set the axes
+    mpPlot->xAxis->setLabel(tr("Parameter"));
+    mpPlot->yAxis->setLabel(tr("Mode"));
+    mpPlot->yAxis->setRangeReversed(true);
+    mpPlot->xAxis->setRange(0.5, numParameters + 0.5);
+    mpPlot->yAxis->setRange(0.5, numModes + 0.5);
+    mpPlot->replot();
+}
+
+//! Update the scene
+void SensitivityView::refresh()
+{
+    plot();
+}
+
+//! Get the view type
+IView::Type SensitivityView::type() const
+{
+    return IView::kSensitivity;
+}
+
+//! Create all the widgets
+void SensitivityView::createContent()
+{
+    // Constants
+    int const kHandleWidth = 10;
+
+    // Create the widgets
+    mpPlot = new CustomPlot;
+    mpTable = new TableView(mSolution);
+
+    // Combine the plot and table
+    QSplitter* pSplitter = new QSplitter(Qt::Vertical);
+    pSplitter->setHandleWidth(kHandleWidth);
+    pSplitter->addWidget(mpPlot);
+    pSplitter->addWidget(mpTable);
+    pSplitter->setStretchFactor(0, 2);
+    pSplitter->setStretchFactor(1, 1);
+
+    // Set the layout
+    QVBoxLayout* pMainLayout = new QVBoxLayout;
+    pMainLayout->addWidget(pSplitter);
+    setLayout(pMainLayout);
+}
@@ -0,0 +1,43 @@
+#ifndef SENSITIVITYVIEW_H
+#define SENSITIVITYVIEW_H
+
+#include "iview.h"
+#include "sensitivitysolver.h"
+
+class QCPColorMap;
+class QCPColorScale;
+
+namespace Frontend
+{
+
+class CustomPlot;
+class TableView;
+
+//! Class to display a snapshot of the sensitivity matrix as a heat map along with its table
+class SensitivityView : public IView
+{
+    Q_OBJECT
+
+public:
+    SensitivityView(Backend::Core::SensitivitySolution const& solution);
+    virtual ~SensitivityView() = default;
+
+    void clear() override;
+    void plot() override;
+    void refresh() override;
+    IView::Type type() const override;
+
+private:
+    void createContent();
+
+private:
+    Backend::Core::SensitivitySolution mSolution;
+    CustomPlot* mpPlot;
+    TableView* mpTable;
+    QCPColorMap* mpColorMap;
+    QCPColorScale* mpColorScale;
+};
+
+}
+
+#endif // SENSITIVITYVIEW_H
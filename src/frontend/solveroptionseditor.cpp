@@ -1,10 +1,13 @@
 #include <QApplication>
 #include <QVBoxLayout>
 
+#include "envelopesolver.h"
 #include "fluttersolver.h"
 #include "modalsolver.h"
 #include "optimsolver.h"
+#include "sensitivitysolver.h"
 #include "solveroptionseditor.h"
+#include "uncertaintysolver.h"
 
 using namespace Backend;
 using namespace Frontend;
@@ -196,6 +199,12 @@ void OptimOptionsEditor::createProperties()
     mpEditor->createDoubleProperty(kPenaltyMAC, tr("Penalty MAC"), mOptions.penaltyMAC, 0.0);
     mpEditor->createDoubleProperty(kMaxRelError, tr("Maximum relative error"), mOptions.maxRelError, 0.0, 1, 5);
     mpEditor->createIntProperty(kNumModes, tr("Number of modes"), mOptions.numModes, 1);
+    mpEditor->createIntProperty(kMaxNumBroydenUpdates, tr("Maximum number of Broyden updates"), mOptions.maxNumBroydenUpdates, 0);
+    mpEditor->createDoubleProperty(kMinBroydenRatio, tr("Minimum Broyden reduction ratio"), mOptions.minBroydenRatio, 0.0, 1.0);
+    mpEditor->createDoubleProperty(kCandidateBand, tr("Frequency band of candidate modes"), mOptions.candidateBand, 0.0);
+    mpEditor->createIntProperty(kNumCandidateNeighbors, tr("Number of neighbor candidate modes"), mOptions.numCandidateNeighbors, 0);
+    mpEditor->createIntProperty(kNumSurrogateSamples, tr("Number of surrogate samples"), mOptions.numSurrogateSamples, 0);
+    mpEditor->createDoubleProperty(kSurrogateRadius, tr("Surrogate trust radius"), mOptions.surrogateRadius, 0.0);
 }
 
 //! Process changing of an integer value
@@ -212,6 +221,15 @@ void OptimOptionsEditor::setIntValue(QtProperty* pProperty, int value)
     case kNumModes:
         emit commandExecuted(new EditProperty<OptimOptions>(mOptions, "numModes", value));
         break;
+    case kMaxNumBroydenUpdates:
+        emit commandExecuted(new EditProperty<OptimOptions>(mOptions, "maxNumBroydenUpdates", value));
+        break;
+    case kNumCandidateNeighbors:
+        emit commandExecuted(new EditProperty<OptimOptions>(mOptions, "numCandidateNeighbors", value));
+        break;
+    case kNumSurrogateSamples:
+        emit commandExecuted(new EditProperty<OptimOptions>(mOptions, "numSurrogateSamples", value));
+        break;
     }
 }
 
@@ -235,5 +253,219 @@ void OptimOptionsEditor::setDoubleValue(QtProperty* pProperty, double value)
     case kMaxRelError:
         emit commandExecuted(new EditProperty<OptimOptions>(mOptions, "maxRelError", value));
         break;
+    case kMinBroydenRatio:
+        emit commandExecuted(new EditProperty<OptimOptions>(mOptions, "minBroydenRatio", value));
+        break;
+    case kCandidateBand:
+        emit commandExecuted(new EditProperty<OptimOptions>(mOptions, "candidateBand", value));
+        break;
+    case kSurrogateRadius:
+        emit commandExecuted(new EditProperty<OptimOptions>(mOptions, "surrogateRadius", value));
+        break;
+    }
+}
+
+SensitivityOptionsEditor::SensitivityOptionsEditor(SensitivityOptions& options, QString const& name, QWidget* pParent)
+    : Editor(kSensitivityOptions, name, QIcon(":/icons/options.png"), pParent)
+    , mOptions(options)
+{
+    createContent();
+    createProperties();
+    createConnections();
+}
+
+QSize SensitivityOptionsEditor::sizeHint() const
+{
+    return QSize(600, 400);
+}
+
+//! Update the editor state
+void SensitivityOptionsEditor::refresh()
+{
+    mpEditor->clear();
+    createProperties();
+}
+
+//! Create all the widgets
+void SensitivityOptionsEditor::createContent()
+{
+    QVBoxLayout* pLayout = new QVBoxLayout;
+    mpEditor = new CustomPropertyEditor;
+    pLayout->addWidget(mpEditor);
+    setLayout(pLayout);
+}
+
+//! Create interactions between widgets
+void SensitivityOptionsEditor::createConnections()
+{
+    connect(mpEditor, &CustomPropertyEditor::intValueChanged, this, &SensitivityOptionsEditor::setIntValue);
+    connect(mpEditor, &CustomPropertyEditor::doubleValueChanged, this, &SensitivityOptionsEditor::setDoubleValue);
+}
+
+//! Create the properties to view and edit
+void SensitivityOptionsEditor::createProperties()
+{
+    mpEditor->createIntProperty(kNumModes, tr("Number of modes"), mOptions.numModes, 1);
+    mpEditor->createDoubleProperty(kTimeout, tr("Timeout"), mOptions.timeout, 0.0);
+    mpEditor->createIntProperty(kNumThreads, tr("Number of threads"), mOptions.numThreads, 1);
+    mpEditor->createDoubleProperty(kStepSize, tr("Relative step size"), mOptions.stepSize, 1e-12, 1.0, 6);
+    mpEditor->createDoubleProperty(kMinMAC, tr("Minimum MAC"), mOptions.minMAC, 0.0, 1.0);
+}
+
+//! Process changing of an integer value
+void SensitivityOptionsEditor::setIntValue(QtProperty* pProperty, int value)
+{
+    switch (mpEditor->id(pProperty))
+    {
+    case kNumModes:
+        emit commandExecuted(new EditProperty<SensitivityOptions>(mOptions, "numModes", value));
+        break;
+    case kNumThreads:
+        emit commandExecuted(new EditProperty<SensitivityOptions>(mOptions, "numThreads", value));
+        break;
+    }
+}
+
+//! Process changing of a double value
+void SensitivityOptionsEditor::setDoubleValue(QtProperty* pProperty, double value)
+{
+    switch (mpEditor->id(pProperty))
+    {
+    case kTimeout:
+        emit commandExecuted(new EditProperty<SensitivityOptions>(mOptions, "timeout", value));
+        break;
+    case kStepSize:
+        emit commandExecuted(new EditProperty<SensitivityOptions>(mOptions, "stepSize", value));
+        break;
+    case kMinMAC:
+        emit commandExecuted(new EditProperty<SensitivityOptions>(mOptions, "minMAC", value));
+        break;
+    }
+}
+
+UncertaintyOptionsEditor::UncertaintyOptionsEditor(UncertaintyOptions& options, QString const& name, QWidget* pParent)
+    : Editor(kUncertaintyOptions, name, QIcon(":/icons/options.png"), pParent)
+    , mOptions(options)
+{
+    createContent();
+    createProperties();
+    createConnections();
+}
+
+QSize UncertaintyOptionsEditor::sizeHint() const
+{
+    return QSize(600, 400);
+}
+
+//! Update the editor state
+void UncertaintyOptionsEditor::refresh()
+{
+    mpEditor->clear();
+    createProperties();
+}
+
+//! Create all the widgets
+void UncertaintyOptionsEditor::createContent()
+{
+    QVBoxLayout* pLayout = new QVBoxLayout;
+    mpEditor = new CustomPropertyEditor;
+    pLayout->addWidget(mpEditor);
+    setLayout(pLayout);
+}
+
+//! Create interactions between widgets
+void UncertaintyOptionsEditor::createConnections()
+{
+    connect(mpEditor, &CustomPropertyEditor::intValueChanged, this, &UncertaintyOptionsEditor::setIntValue);
+    connect(mpEditor, &CustomPropertyEditor::doubleValueChanged, this, &UncertaintyOptionsEditor::setDoubleValue);
+}
+
+//! Create the properties to view and edit
+void UncertaintyOptionsEditor::createProperties()
+{
+    mpEditor->createIntProperty(kNumSamples, tr("Number of samples"), mOptions.numSamples, 1);
+    mpEditor->createIntProperty(kSeed, tr("Random seed"), mOptions.seed, 0);
+    mpEditor->createDoubleProperty(kDeviation, tr("Relative half-width of sampling bounds"), mOptions.deviation, 0.0, 0.99);
+    mpEditor->createIntProperty(kNumThreads, tr("Number of threads"), mOptions.numThreads, 1);
+}
+
+//! Process changing of an integer value
+void UncertaintyOptionsEditor::setIntValue(QtProperty* pProperty, int value)
+{
+    switch (mpEditor->id(pProperty))
+    {
+    case kNumSamples:
+        emit commandExecuted(new EditProperty<UncertaintyOptions>(mOptions, "numSamples", value));
+        break;
+    case kSeed:
+        emit commandExecuted(new EditProperty<UncertaintyOptions>(mOptions, "seed", value));
+        break;
+    case kNumThreads:
+        emit commandExecuted(new EditProperty<UncertaintyOptions>(mOptions, "numThreads", value));
+        break;
+    }
+}
+
+//! Process changing of a double value
+void UncertaintyOptionsEditor::setDoubleValue(QtProperty* pProperty, double value)
+{
+    switch (mpEditor->id(pProperty))
+    {
+    case kDeviation:
+        emit commandExecuted(new EditProperty<UncertaintyOptions>(mOptions, "deviation", value));
+        break;
+    }
+}
+
+EnvelopeOptionsEditor::EnvelopeOptionsEditor(EnvelopeOptions& options, QString const& name, QWidget* pParent)
+    : Editor(kEnvelopeOptions, name, QIcon(":/icons/options.png"), pParent)
+    , mOptions(options)
+{
+    createContent();
+    createProperties();
+    createConnections();
+}
+
+QSize EnvelopeOptionsEditor::sizeHint() const
+{
+    return QSize(600, 400);
+}
+
+//! Update the editor state
+void EnvelopeOptionsEditor::refresh()
+{
+    mpEditor->clear();
+    createProperties();
+}
+
+//! Create all the widgets
+void EnvelopeOptionsEditor::createContent()
+{
+    QVBoxLayout* pLayout = new QVBoxLayout;
+    mpEditor = new CustomPropertyEditor;
+    pLayout->addWidget(mpEditor);
+    setLayout(pLayout);
+}
+
+//! Create interactions between widgets
+void EnvelopeOptionsEditor::createConnections()
+{
+    connect(mpEditor, &CustomPropertyEditor::intValueChanged, this, &EnvelopeOptionsEditor::setIntValue);
+}
+
+//! Create the properties to view and edit
+void EnvelopeOptionsEditor::createProperties()
+{
+    mpEditor->createIntProperty(kNumThreads, tr("Number of threads"), mOptions.numThreads, 1);
+}
+
+//! Process changing of an integer value
+void EnvelopeOptionsEditor::setIntValue(QtProperty* pProperty, int value)
+{
+    switch (mpEditor->id(pProperty))
+    {
+    case kNumThreads:
+        emit commandExecuted(new EditProperty<EnvelopeOptions>(mOptions, "numThreads", value));
+        break;
     }
 }
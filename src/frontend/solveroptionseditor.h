@@ -87,7 +87,13 @@ public:
         kMinMAC,
         kPenaltyMAC,
         kMaxRelError,
-        kNumModes
+        kNumModes,
+        kMaxNumBroydenUpdates,
+        kMinBroydenRatio,
+        kCandidateBand,
+        kNumCandidateNeighbors,
+        kNumSurrogateSamples,
+        kSurrogateRadius
     };
 
     OptimOptionsEditor(Backend::Core::OptimOptions& options, QString const& name, QWidget* pParent = nullptr);
@@ -108,6 +114,102 @@ private:
     Backend::Core::OptimOptions& mOptions;
     CustomPropertyEditor* mpEditor;
 };
+
+//! Class to edit options of sensitivity solver
+class SensitivityOptionsEditor : public Editor
+{
+    Q_OBJECT
+
+public:
+    enum Type
+    {
+        kNumModes,
+        kTimeout,
+        kNumThreads,
+        kStepSize,
+        kMinMAC
+    };
+
+    SensitivityOptionsEditor(Backend::Core::SensitivityOptions& options, QString const& name, QWidget* pParent = nullptr);
+    virtual ~SensitivityOptionsEditor() = default;
+
+    QSize sizeHint() const override;
+    void refresh() override;
+
+private:
+    void createContent();
+    void createProperties();
+    void createConnections();
+
+    void setIntValue(QtProperty* pProperty, int value);
+    void setDoubleValue(QtProperty* pProperty, double value);
+
+private:
+    Backend::Core::SensitivityOptions& mOptions;
+    CustomPropertyEditor* mpEditor;
+};
+
+//! Class to edit options of the solver which samples the parameters uniformly within the bounds
+class UncertaintyOptionsEditor : public Editor
+{
+    Q_OBJECT
+
+public:
+    enum Type
+    {
+        kNumSamples,
+        kSeed,
+        kDeviation,
+        kNumThreads
+    };
+
+    UncertaintyOptionsEditor(Backend::Core::UncertaintyOptions& options, QString const& name, QWidget* pParent = nullptr);
+    virtual ~UncertaintyOptionsEditor() = default;
+
+    QSize sizeHint() const override;
+    void refresh() override;
+
+private:
+    void createContent();
+    void createProperties();
+    void createConnections();
+
+    void setIntValue(QtProperty* pProperty, int value);
+    void setDoubleValue(QtProperty* pProperty, double value);
+
+private:
+    Backend::Core::UncertaintyOptions& mOptions;
+    CustomPropertyEditor* mpEditor;
+};
+
+//! Class to edit options of envelope solver
+class EnvelopeOptionsEditor : public Editor
+{
+    Q_OBJECT
+
+public:
+    enum Type
+    {
+        kNumThreads
+    };
+
+    EnvelopeOptionsEditor(Backend::Core::EnvelopeOptions& options, QString const& name, QWidget* pParent = nullptr);
+    virtual ~EnvelopeOptionsEditor() = default;
+
+    QSize sizeHint() const override;
+    void refresh() override;
+
+private:
+    void createContent();
+    void createProperties();
+    void createConnections();
+
+    void setIntValue(QtProperty* pProperty, int value);
+
+private:
+    Backend::Core::EnvelopeOptions& mOptions;
+    CustomPropertyEditor* mpEditor;
+};
 }
 
 #endif // SOLVEROPTIONSEDITOR_H
@@ -1,10 +1,14 @@
 #include <QHeaderView>
 #include <QVBoxLayout>
 
-#include "customtable.h"
+#include "envelopesolver.h"
 #include "fluttersolver.h"
+#include "matrixtable.h"
 #include "modalsolver.h"
+#include "sensitivitysolver.h"
+#include "solverprogress.h"
 #include "tableview.h"
+#include "uncertaintysolver.h"
 
 using namespace Backend;
 using namespace Frontend;
@@ -32,48 +36,37 @@ TableView::TableView(Core::FlutterSolution const& solution)
     setData(solution);
 }
 
-//! Clear all the table content
-void TableView::clear()
+TableView::TableView(Core::SensitivitySolution const& solution)
+    : TableView()
 {
-    mpTable->clear();
+    setData(solution);
 }
 
-//! Display the table content
-void TableView::plot()
+TableView::TableView(Core::UncertaintySolution const& solution)
+    : TableView()
 {
-    // Remove previously created items
-    clear();
+    setData(solution);
+}
 
-    // Set table dimensions
-    int numRows = mData.rows();
-    int numCols = mData.cols();
-    mpTable->setRowCount(numRows);
-    mpTable->setColumnCount(numCols);
+TableView::TableView(Core::EnvelopeSolution const& solution)
+    : TableView()
+{
+    setData(solution);
+}
 
-    // Set headers
-    if (!mHorizontalLabels.empty())
-    {
-        mpTable->horizontalHeader()->setVisible(true);
-        mpTable->setHorizontalHeaderLabels(mHorizontalLabels);
-    }
-    if (!mVerticalLabels.empty())
-    {
-        mpTable->verticalHeader()->setVisible(true);
-        mpTable->setVerticalHeaderLabels(mVerticalLabels);
-    }
+//! Clear the presentation of the table content, so that the data could be displayed again
+void TableView::clear()
+{
+    mpTable->clearSelection();
+    mpTable->horizontalHeader()->setVisible(false);
+    mpTable->verticalHeader()->setVisible(false);
+}
 
-    // Create items
-    for (int i = 0; i != numRows; ++i)
-    {
-        for (int j = 0; j != numCols; ++j)
-        {
-            QString text = QString::number(mData(i, j), 'f', 3);
-            QTableWidgetItem* pItem = new QTableWidgetItem(text);
-            pItem->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable);
-            pItem->setTextAlignment(Qt::AlignCenter);
-            mpTable->setItem(i, j, pItem);
-        }
-    }
+//! Display the table content (values are formatted by the model on demand)
+void TableView::plot()
+{
+    mpTable->horizontalHeader()->setVisible(!mpModel->horizontalLabels().empty());
+    mpTable->verticalHeader()->setVisible(mpModel->rowCount() > 0);
 }
 
 //! Update the table
@@ -88,12 +81,61 @@ IView::Type TableView::type() const
     return IView::kTable;
 }
 
+//! Deliver the solver progress to the table
+void TableView::subscribe(Core::SolverProgressChannel& channel)
+{
+    connect(&channel, &Core::SolverProgressChannel::progressed, this, &TableView::appendProgress);
+}
+
+//! Replace the table content by the solver progress
+void TableView::setProgress(QList<Core::SolverProgress> const& progresses)
+{
+    mpModel->clear();
+    appendProgress(progresses);
+}
+
+//! Append rows associated with the solver iterations without resetting the table
+void TableView::appendProgress(QList<Core::SolverProgress> const& progresses)
+{
+    // Slice dimensions
+    int numProgresses = progresses.size();
+    if (numProgresses == 0)
+        return;
+    int numTargets = progresses.first().frequencies.size();
+    int numCols = 1 + numTargets;
+
+    // Reset the data, if the number of targets has been changed
+    if (mpModel->columnCount() != numCols)
+    {
+        QStringList horizontalLabels(numCols);
+        horizontalLabels[0] = "Cost";
+        for (int i = 0; i != numTargets; ++i)
+            horizontalLabels[1 + i] = QString("f%1 (Hz)").arg(1 + i);
+        mpModel->setMatrix(Eigen::MatrixXd(0, numCols), horizontalLabels);
+    }
+
+    // Append the data
+    Eigen::MatrixXd rows(numProgresses, numCols);
+    QStringList verticalLabels(numProgresses);
+    for (int i = 0; i != numProgresses; ++i)
+    {
+        Core::SolverProgress const& progress = progresses[i];
+        rows(i, 0) = progress.cost;
+        for (int j = 0; j != numTargets; ++j)
+            rows(i, 1 + j) = j < progress.frequencies.size() ? progress.frequencies[j] : std::numeric_limits<double>::quiet_NaN();
+        verticalLabels[i] = QString::number(progress.iteration);
+    }
+    mpModel->appendRows(rows, verticalLabels);
+    plot();
+}
+
 //! Create all the widgets
 void TableView::createContent()
 {
-    // Create the text widget
-    mpTable = new CustomTable;
-    mpTable->setSizeAdjustPolicy(QTableWidget::AdjustToContents);
+    // Create the table widget
+    mpTable = new MatrixTable;
+    mpModel = mpTable->matrixModel();
+    mpTable->setSizeAdjustPolicy(QTableView::AdjustToContents);
     mpTable->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Preferred);
     mpTable->horizontalHeader()->setVisible(false);
     mpTable->verticalHeader()->setVisible(false);
@@ -113,11 +155,7 @@ void TableView::createContent()
 //! Set vector data
 void TableView::setData(Eigen::VectorXd const& data)
 {
-    mData = data;
-    int numRows = mData.size();
-    mVerticalLabels.resize(numRows);
-    for (int i = 0; i != numRows; ++i)
-        mVerticalLabels[i] = QString::number(1 + i);
+    mpModel->setMatrix(data);
 }
 
 //! Set data using flutter solution
@@ -130,15 +168,10 @@ void TableView::setData(Backend::Core::ModalSolution const& solution)
     int const numCols = 2;
 
     // Copy the data and set the header labels
-    mData.resize(numRows, numCols);
-    mHorizontalLabels = {"f (Hz)", "OMf (rad/s)"};
-    mVerticalLabels.resize(numRows);
-    for (int i = 0; i != numRows; ++i)
-    {
-        mData(i, 0) = solution.frequencies[i];
-        mData(i, 1) = mData(i, 0) * kTwoPi;
-        mVerticalLabels[i] = QString::number(1 + i);
-    }
+    Eigen::MatrixXd data(numRows, numCols);
+    data.col(0) = solution.frequencies;
+    data.col(1) = solution.frequencies * kTwoPi;
+    mpModel->setMatrix(std::move(data), {"f (Hz)", "OMf (rad/s)"});
 }
 
 //! Set data using flutter solution
@@ -149,17 +182,67 @@ void TableView::setData(Backend::Core::FlutterSolution const& solution)
     int const numCols = 6;
 
     // Copy the data and set the header labels
-    mData.resize(numRows, numCols);
-    mHorizontalLabels = {"q", "Vtas", "f (Hz)", "OMf (rad/s)", "Sh", "dDE/dV"};
-    mVerticalLabels.resize(numRows);
-    for (int i = 0; i != numRows; ++i)
+    Eigen::MatrixXd data(numRows, numCols);
+    data.col(0) = solution.critFlow;
+    data.col(1) = solution.critSpeed;
+    data.col(2) = solution.critFrequency;
+    data.col(3) = solution.critCircFrequency;
+    data.col(4) = solution.critStrouhal;
+    data.col(5) = solution.critDamping;
+    mpModel->setMatrix(std::move(data), {"q", "Vtas", "f (Hz)", "OMf (rad/s)", "Sh", "dDE/dV"});
+}
+
+//! Set data using sensitivity solution, so that each row corresponds to a base mode
+void TableView::setData(Backend::Core::SensitivitySolution const& solution)
+{
+    // Slice dimensions
+    int const numRows = solution.numModes();
+    int const numParameters = solution.numParameters();
+    int const numCols = 1 + 2 * numParameters;
+
+    // Copy the data
+    Eigen::MatrixXd data(numRows, numCols);
+    data.col(0) = solution.frequencies;
+    data.middleCols(1, numParameters) = solution.sensitivityFrequencies;
+    data.rightCols(numParameters) = solution.errorsMAC;
+
+    // Set the header labels
+    QStringList horizontalLabels(numCols);
+    horizontalLabels[0] = "f (Hz)";
+    for (int i = 0; i != numParameters; ++i)
     {
-        mData(i, 0) = solution.critFlow[i];
-        mData(i, 1) = solution.critSpeed[i];
-        mData(i, 2) = solution.critFrequency[i];
-        mData(i, 3) = solution.critCircFrequency[i];
-        mData(i, 4) = solution.critStrouhal[i];
-        mData(i, 5) = solution.critDamping[i];
-        mVerticalLabels[i] = QString::number(1 + i);
+        horizontalLabels[1 + i] = QString("Sf/p%1").arg(1 + i);
+        horizontalLabels[1 + numParameters + i] = QString("1-MAC/p%1").arg(1 + i);
     }
+    mpModel->setMatrix(std::move(data), horizontalLabels);
+}
+
+//! Set data using uncertainty solution, so that each row corresponds to a sample
+void TableView::setData(Backend::Core::UncertaintySolution const& solution)
+{
+    // Slice dimensions
+    int const numRows = solution.numSamples();
+    int const numCols = 3;
+
+    // Copy the data and set the header labels
+    Eigen::MatrixXd data(numRows, numCols);
+    data.col(0) = solution.critFlow;
+    data.col(1) = solution.critSpeed;
+    data.col(2) = solution.critFrequency;
+    mpModel->setMatrix(std::move(data), {"q", "Vtas", "f (Hz)"});
+}
+
+//! Set data using envelope solution, so that each row corresponds to a case
+void TableView::setData(Backend::Core::EnvelopeSolution const& solution)
+{
+    // Slice dimensions
+    int const numRows = solution.numCases();
+    int const numCols = 3;
+
+    // Copy the data and set the header labels
+    Eigen::MatrixXd data(numRows, numCols);
+    data.col(0) = solution.critFlow;
+    data.col(1) = solution.critSpeed;
+    data.col(2) = solution.critFrequency;
+    mpModel->setMatrix(std::move(data), {"q", "Vtas", "f (Hz)"}, solution.names);
 }
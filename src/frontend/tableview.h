@@ -9,12 +9,18 @@ namespace Backend::Core
 {
 struct ModalSolution;
 struct FlutterSolution;
+struct SensitivitySolution;
+struct UncertaintySolution;
+struct EnvelopeSolution;
+struct SolverProgress;
+class SolverProgressChannel;
 }
 
 namespace Frontend
 {
 
-class CustomTable;
+class MatrixTable;
+class MatrixTableModel;
 
 class TableView : public IView
 {
@@ -25,6 +31,9 @@ public:
     TableView(Eigen::VectorXd const& data);
     TableView(Backend::Core::ModalSolution const& solution);
     TableView(Backend::Core::FlutterSolution const& solution);
+    TableView(Backend::Core::SensitivitySolution const& solution);
+    TableView(Backend::Core::UncertaintySolution const& solution);
+    TableView(Backend::Core::EnvelopeSolution const& solution);
     virtual ~TableView() = default;
 
     void clear() override;
@@ -32,17 +41,22 @@ public:
     void refresh() override;
     IView::Type type() const override;
 
+    void subscribe(Backend::Core::SolverProgressChannel& channel);
+    void setProgress(QList<Backend::Core::SolverProgress> const& progresses);
+    void appendProgress(QList<Backend::Core::SolverProgress> const& progresses);
+
 private:
     void createContent();
     void setData(Eigen::VectorXd const& data);
     void setData(Backend::Core::ModalSolution const& solution);
     void setData(Backend::Core::FlutterSolution const& solution);
+    void setData(Backend::Core::SensitivitySolution const& solution);
+    void setData(Backend::Core::UncertaintySolution const& solution);
+    void setData(Backend::Core::EnvelopeSolution const& solution);
 
 private:
-    Eigen::MatrixXd mData;
-    QStringList mHorizontalLabels;
-    QStringList mVerticalLabels;
-    CustomTable* mpTable;
+    MatrixTable* mpTable;
+    MatrixTableModel* mpModel;
 };
 
 }
@@ -35,6 +35,12 @@ namespace Size
 const QSize skToolBarIcon = QSize(25, 25);
 const uint skMaxRecentProjects = 5;
 
+}
+
+namespace Metrics
+{
+
+const int skPollInterval = 500;
 }
 }
 
@@ -235,6 +235,7 @@ QList<Item*> castHierarchyItems(QList<HierarchyItem*> const& items)
 //! Retrieve children of a hierarchy item
 QList<HierarchyItem*> childItems(HierarchyItem* pItem)
 {
+    pItem->fetchMore();
     int numItems = pItem->rowCount();
     QList<HierarchyItem*> result(numItems);
     for (int k = 0; k != numItems; ++k)
@@ -603,8 +604,8 @@ void setLastDepth(Matrix42d const& coords, Vector4d& depths)
 }
 
 //! Construct a helix of the given radius between two points
-vtkSmartPointer<vtkActor> createHelixActor(Eigen::Vector3d const& startPosition, Eigen::Vector3d const& endPosition, double radius, int numTurns,
-                                           int resolution)
+vtkSmartPointer<vtkPolyData> createHelixData(Eigen::Vector3d const& startPosition, Eigen::Vector3d const& endPosition, double radius,
+                                             int numTurns, int resolution)
 {
     int kNumCellPoints = 2;
     double kRunoutFactor = 0.1;
@@ -664,9 +665,16 @@ vtkSmartPointer<vtkActor> createHelixActor(Eigen::Vector3d const& startPosition,
     data->SetPoints(points);
     data->SetLines(indices);
 
+    return data;
+}
+
+//! Construct a helix actor which connects two points
+vtkSmartPointer<vtkActor> createHelixActor(Eigen::Vector3d const& startPosition, Eigen::Vector3d const& endPosition, double radius, int numTurns,
+                                           int resolution)
+{
     // Map the geometrical data
     vtkNew<vtkPolyDataMapper> mapper;
-    mapper->SetInputData(data);
+    mapper->SetInputData(createHelixData(startPosition, endPosition, radius, numTurns, resolution));
 
     // Create the actor
     vtkNew<vtkActor> actor;
@@ -705,9 +713,9 @@ vtkSmartPointer<vtkActor> createPointsActor(QList<Eigen::Vector3d> const& positi
     return actor;
 }
 
-//! Construct an oriented cylinder which connects two points
-vtkSmartPointer<vtkActor> createCylinderActor(Eigen::Vector3d const& startPosition, Eigen::Vector3d const& endPosition, double radius,
-                                              int resolution)
+//! Tessellate an oriented cylinder which connects two points
+vtkSmartPointer<vtkPolyData> createCylinderData(Eigen::Vector3d const& startPosition, Eigen::Vector3d const& endPosition, double radius,
+                                                int resolution)
 {
     // Constants
     Vector3d kBaseAxis = Vector3d::UnitY();
@@ -739,10 +747,22 @@ vtkSmartPointer<vtkActor> createCylinderActor(Eigen::Vector3d const& startPositi
     vtkNew<vtkTransformPolyDataFilter> filter;
     filter->SetTransform(sourceTransform);
     filter->SetInputConnection(source->GetOutputPort());
+    filter->Update();
+
+    // Detach the result from the pipeline
+    vtkNew<vtkPolyData> data;
+    data->ShallowCopy(filter->GetOutput());
+
+    return data;
+}
 
+//! Construct an oriented cylinder which connects two points
+vtkSmartPointer<vtkActor> createCylinderActor(Eigen::Vector3d const& startPosition, Eigen::Vector3d const& endPosition, double radius,
+                                              int resolution)
+{
     // Create the mapper
     vtkNew<vtkPolyDataMapper> mapper;
-    mapper->SetInputConnection(filter->GetOutputPort());
+    mapper->SetInputData(createCylinderData(startPosition, endPosition, radius, resolution));
 
     // Construct the actor
     vtkNew<vtkActor> actor;
@@ -751,9 +771,9 @@ vtkSmartPointer<vtkActor> createCylinderActor(Eigen::Vector3d const& startPositi
     return actor;
 }
 
-//! Construct a shell actor using coordinates of middle surface, thickness and depths
-vtkSmartPointer<vtkActor> createShellActor(Transformation const& transform, Matrix42d const& coords, Eigen::Vector4d const& depths,
-                                           double thickness)
+//! Construct a shell grid using coordinates of middle surface, thickness and depths
+vtkSmartPointer<vtkUnstructuredGrid> createShellData(Transformation const& transform, Matrix42d const& coords, Eigen::Vector4d const& depths,
+                                                     double thickness)
 {
     int kNumVertices = 8;
 
@@ -831,9 +851,16 @@ vtkSmartPointer<vtkActor> createShellActor(Transformation const& transform, Matr
         grid->InsertNextCell(hex->GetCellType(), hex->GetPointIds());
     }
 
+    return grid;
+}
+
+//! Construct a shell actor using coordinates of middle surface, thickness and depths
+vtkSmartPointer<vtkActor> createShellActor(Transformation const& transform, Matrix42d const& coords, Eigen::Vector4d const& depths,
+                                           double thickness)
+{
     // Create a mapper and actor
     vtkNew<vtkDataSetMapper> mapper;
-    mapper->SetInputData(grid);
+    mapper->SetInputData(createShellData(transform, coords, depths, thickness));
     vtkNew<vtkActor> actor;
     actor->SetMapper(mapper);
 
@@ -1026,6 +1053,12 @@ QIcon getIcon(Core::ISolver const* pSolver)
         return QIcon(":/icons/flutter.png");
     case Core::ISolver::kOptim:
         return QIcon(":/icons/optimization.png");
+    case Core::ISolver::kSensitivity:
+        return QIcon(":/icons/function.png");
+    case Core::ISolver::kUncertainty:
+        return QIcon(":/icons/crit.png");
+    case Core::ISolver::kEnvelope:
+        return QIcon(":/icons/layer.png");
     }
     return QIcon();
 }
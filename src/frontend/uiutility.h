@@ -23,7 +23,9 @@ QT_FORWARD_DECLARE_CLASS(QDir);
 class vtkActor;
 class vtkColor3d;
 class vtkLookupTable;
+class vtkPolyData;
 class vtkRenderer;
+class vtkUnstructuredGrid;
 
 namespace Backend::Core
 {
@@ -92,6 +94,12 @@ KCL::ElasticSurface createDefaultSpecialSurface();
 // Rendering
 QList<int> jarvisMarch(QList<Point> const& points);
 void setLastDepth(Matrix42d const& coords, Eigen::Vector4d& depths);
+vtkSmartPointer<vtkPolyData> createHelixData(Eigen::Vector3d const& startPosition, Eigen::Vector3d const& endPosition, double radius,
+                                             int numTurns, int resolution);
+vtkSmartPointer<vtkPolyData> createCylinderData(Eigen::Vector3d const& startPosition, Eigen::Vector3d const& endPosition, double radius,
+                                                int resolution);
+vtkSmartPointer<vtkUnstructuredGrid> createShellData(Transformation const& transform, Matrix42d const& coords, Eigen::Vector4d const& depths,
+                                                     double thickness);
 vtkSmartPointer<vtkActor> createHelixActor(Eigen::Vector3d const& startPosition, Eigen::Vector3d const& endPosition, double radius, int numTurns,
                                            int resolution);
 vtkSmartPointer<vtkActor> createPointsActor(QList<Eigen::Vector3d> const& positions, double radius);
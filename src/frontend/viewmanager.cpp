@@ -5,17 +5,23 @@
 
 #include <kcl/model.h>
 
+#include "convergenceview.h"
 #include "customtabwidget.h"
+#include "envelopesolver.h"
 #include "flutterview.h"
 #include "geometry.h"
 #include "geometryview.h"
 #include "hierarchyitem.h"
 #include "logview.h"
 #include "modelview.h"
+#include "optimsolver.h"
 #include "selectionset.h"
+#include "sensitivitysolver.h"
+#include "sensitivityview.h"
 #include "subproject.h"
 #include "tableview.h"
 #include "uiutility.h"
+#include "uncertaintysolver.h"
 #include "viewmanager.h"
 
 using namespace Backend;
@@ -109,7 +115,7 @@ IView* ViewManager::findGeometryView(Backend::Core::Geometry const& geometry)
 }
 
 //! Find the view associated with the current log
-IView* ViewManager::findLogView(QString const& log)
+IView* ViewManager::findLogView(Core::SolverLog const& log)
 {
     int count = numViews();
     for (int i = 0; i != count; ++i)
@@ -134,6 +140,19 @@ IView* ViewManager::findFlutterView(Backend::Core::FlutterSolution const& soluti
     return nullptr;
 }
 
+//! Find the view associated with the optimization solver
+IView* ViewManager::findConvergenceView(Core::OptimSolver const& solver)
+{
+    int count = numViews();
+    for (int i = 0; i != count; ++i)
+    {
+        IView* pView = view(i);
+        if (pView->type() == IView::kConvergence && &static_cast<ConvergenceView*>(pView)->solver() == &solver)
+            return pView;
+    }
+    return nullptr;
+}
+
 //! Retrieve the current view
 IView* ViewManager::currentView()
 {
@@ -202,7 +221,7 @@ IView* ViewManager::createGeometryView(Backend::Core::Geometry const& geometry,
 }
 
 //! Create the view associated with a log
-IView* ViewManager::createLogView(QString const& log, QString const& name)
+IView* ViewManager::createLogView(Core::SolverLog const& log, QString const& name)
 {
     // Set the view as the current one if it has been already created
     IView* pBaseView = findLogView(log);
@@ -283,6 +302,72 @@ IView* ViewManager::createTableView(Core::ModalSolution const& solution, QString
     return pView;
 }
 
+//! Create the table view associated with an uncertainty solution
+IView* ViewManager::createTableView(Core::UncertaintySolution const& solution, QString const& name)
+{
+    TableView* pView = new TableView(solution);
+    pView->plot();
+
+    // Add it to the tab
+    QString label = name.isEmpty() ? getDefaultViewName(IView::kTable) : name;
+    mpTabWidget->addTab(pView, QIcon(":/icons/table.png"), label);
+    mpTabWidget->setCurrentWidget(pView);
+
+    return pView;
+}
+
+//! Create the table view associated with an envelope solution
+IView* ViewManager::createTableView(Core::EnvelopeSolution const& solution, QString const& name)
+{
+    TableView* pView = new TableView(solution);
+    pView->plot();
+
+    // Add it to the tab
+    QString label = name.isEmpty() ? getDefaultViewName(IView::kTable) : name;
+    mpTabWidget->addTab(pView, QIcon(":/icons/table.png"), label);
+    mpTabWidget->setCurrentWidget(pView);
+
+    return pView;
+}
+
+//! Create the view to track convergence of an optimization solver
+IView* ViewManager::createConvergenceView(Core::OptimSolver& solver, QString const& name)
+{
+    // Set the view as the current one if it has been already created
+    IView* pBaseView = findConvergenceView(solver);
+    if (pBaseView)
+    {
+        mpTabWidget->setCurrentWidget(pBaseView);
+        mpTabWidget->setTabText(mpTabWidget->currentIndex(), name);
+        return pBaseView;
+    }
+
+    // Create the convergence view otherwise
+    ConvergenceView* pView = new ConvergenceView(solver);
+    pView->plot();
+
+    // Add it to the tab
+    QString label = name.isEmpty() ? getDefaultViewName(IView::kConvergence) : name;
+    mpTabWidget->addTab(pView, QIcon(":/icons/iterations.svg"), label);
+    mpTabWidget->setCurrentWidget(pView);
+
+    return pView;
+}
+
+//! Create the view to display the sensitivity matrix as a heat map
+IView* ViewManager::createSensitivityView(Core::SensitivitySolution const& solution, QString const& name)
+{
+    SensitivityView* pView = new SensitivityView(solution);
+    pView->plot();
+
+    // Add it to the tab
+    QString label = name.isEmpty() ? getDefaultViewName(IView::kSensitivity) : name;
+    mpTabWidget->addTab(pView, QIcon(":/icons/table.png"), label);
+    mpTabWidget->setCurrentWidget(pView);
+
+    return pView;
+}
+
 //! Remove view which is used as one of the tabs
 void ViewManager::removeView(IView* pView)
 {
@@ -335,6 +420,14 @@ void ViewManager::processItems(QList<HierarchyItem*> const& items)
             processGeometryItems(typeItems, modifiedViews);
         else if (kFlutterTypes.contains(type))
             processFlutterItems(typeItems, modifiedViews);
+        else if (type == HierarchyItem::kGroupOptimSolutions)
+            processOptimItems(typeItems, modifiedViews);
+        else if (type == HierarchyItem::kSensitivitySolution)
+            processSensitivityItems(typeItems, modifiedViews);
+        else if (type == HierarchyItem::kUncertaintySolution)
+            processUncertaintyItems(typeItems, modifiedViews);
+        else if (type == HierarchyItem::kEnvelopeSolution)
+            processEnvelopeItems(typeItems, modifiedViews);
         else if (type == HierarchyItem::kLog)
             processLogItems(typeItems, modifiedViews);
     }
@@ -436,7 +529,7 @@ void ViewManager::processModelItems(QList<HierarchyItem*> const& items, QSet<IVi
                 pView->selector().deselectAll();
 
             // Add the selection set to the view
-            pView->selector().select(pItem->selectionSet().selected());
+            pView->selector().select(pItem->selectionSet());
             break;
         }
         default:
@@ -481,7 +574,13 @@ void ViewManager::processGeometryItems(QList<HierarchyItem*> const& items, QSet<
                 if (!modifiedViews.contains(pBaseView))
                     static_cast<GeometryView*>(pBaseView)->clearFields();
             }
-            pView = (GeometryView*) createGeometryView(pItem->geometry(), field, label);
+            GeometryView* pGeometryView = (GeometryView*) createGeometryView(pItem->geometry(), field, label);
+
+            // Update the frequencies of the mode obtained by the optimization solver while it is running
+            HierarchyItem* pSolverItem = Utility::findParentByType(pItem, HierarchyItem::kOptimSolver);
+            if (pSolverItem)
+                pGeometryView->subscribe(static_cast<OptimSolverHierarchyItem*>(pSolverItem)->solver()->progressChannel());
+            pView = pGeometryView;
             modifiedViews.insert(pView);
             break;
         }
@@ -547,6 +646,57 @@ void ViewManager::processFlutterItems(QList<HierarchyItem*> const& items, QSet<I
     }
 }
 
+//! Process hierarchy items associated with the ConvergenceView
+void ViewManager::processOptimItems(QList<HierarchyItem*> const& items, QSet<IView*>& modifiedViews)
+{
+    for (HierarchyItem* pBaseItem : items)
+    {
+        HierarchyItem* pFoundItem = Utility::findParentByType(pBaseItem, HierarchyItem::kOptimSolver);
+        if (!pFoundItem)
+            continue;
+        OptimSolverHierarchyItem* pItem = (OptimSolverHierarchyItem*) pFoundItem;
+        QString label = getViewName(pBaseItem);
+        IView* pView = createConvergenceView(*pItem->solver(), label);
+        modifiedViews.insert(pView);
+    }
+}
+
+//! Process hierarchy items associated with the sensitivity views
+void ViewManager::processSensitivityItems(QList<HierarchyItem*> const& items, QSet<IView*>& modifiedViews)
+{
+    for (HierarchyItem* pBaseItem : items)
+    {
+        SensitivitySolutionHierarchyItem* pItem = (SensitivitySolutionHierarchyItem*) pBaseItem;
+        QString label = getViewName(pItem);
+        IView* pView = createSensitivityView(pItem->solution(), label);
+        modifiedViews.insert(pView);
+    }
+}
+
+//! Process hierarchy items associated with the uncertainty tables
+void ViewManager::processUncertaintyItems(QList<HierarchyItem*> const& items, QSet<IView*>& modifiedViews)
+{
+    for (HierarchyItem* pBaseItem : items)
+    {
+        UncertaintySolutionHierarchyItem* pItem = (UncertaintySolutionHierarchyItem*) pBaseItem;
+        QString label = getViewName(pItem);
+        IView* pView = createTableView(pItem->solution(), label);
+        modifiedViews.insert(pView);
+    }
+}
+
+//! Process hierarchy items associated with the envelope tables
+void ViewManager::processEnvelopeItems(QList<HierarchyItem*> const& items, QSet<IView*>& modifiedViews)
+{
+    for (HierarchyItem* pBaseItem : items)
+    {
+        EnvelopeSolutionHierarchyItem* pItem = (EnvelopeSolutionHierarchyItem*) pBaseItem;
+        QString label = getViewName(pItem);
+        IView* pView = createTableView(pItem->solution(), label);
+        modifiedViews.insert(pView);
+    }
+}
+
 //! Render all the views
 void ViewManager::refresh()
 {
@@ -627,6 +777,12 @@ QString ViewManager::getDefaultViewName(IView::Type type)
     case IView::kTable:
         prefix = tr("Table");
         break;
+    case IView::kConvergence:
+        prefix = tr("Convergence");
+        break;
+    case IView::kSensitivity:
+        prefix = tr("Sensitivity");
+        break;
     default:
         break;
     }
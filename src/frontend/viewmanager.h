@@ -21,7 +21,12 @@ class Subproject;
 struct Geometry;
 struct ModalSolution;
 struct FlutterSolution;
+struct SensitivitySolution;
+struct UncertaintySolution;
+struct EnvelopeSolution;
+class OptimSolver;
 class SelectionSet;
+class SolverLog;
 }
 
 namespace Frontend
@@ -52,15 +57,20 @@ public:
 
     IView* findModelView(KCL::Model const& model);
     IView* findGeometryView(Backend::Core::Geometry const& geometry);
-    IView* findLogView(QString const& log);
+    IView* findLogView(Backend::Core::SolverLog const& log);
     IView* findFlutterView(Backend::Core::FlutterSolution const& solution);
+    IView* findConvergenceView(Backend::Core::OptimSolver const& solver);
 
     IView* createModelView(KCL::Model const& model, QString const& name = QString());
     IView* createGeometryView(Backend::Core::Geometry const& geometry, VertexField const& field, QString const& name = QString());
-    IView* createLogView(QString const& log, QString const& name = QString());
+    IView* createLogView(Backend::Core::SolverLog const& log, QString const& name = QString());
     IView* createFlutterView(Backend::Core::FlutterSolution const& solution, QString const& name = QString());
     IView* createTableView(Backend::Core::FlutterSolution const& solution, QString const& name = QString());
     IView* createTableView(Backend::Core::ModalSolution const& solution, QString const& name = QString());
+    IView* createTableView(Backend::Core::UncertaintySolution const& solution, QString const& name = QString());
+    IView* createTableView(Backend::Core::EnvelopeSolution const& solution, QString const& name = QString());
+    IView* createConvergenceView(Backend::Core::OptimSolver& solver, QString const& name = QString());
+    IView* createSensitivityView(Backend::Core::SensitivitySolution const& solution, QString const& name = QString());
 
     void removeView(IView* pView);
 
@@ -82,6 +92,10 @@ private:
     void processGeometryItems(QList<HierarchyItem*> const& items, QSet<IView*>& modifiedViews);
     void processLogItems(QList<HierarchyItem*> const& items, QSet<IView*>& modifiedViews);
     void processFlutterItems(QList<HierarchyItem*> const& items, QSet<IView*>& modifiedViews);
+    void processOptimItems(QList<HierarchyItem*> const& items, QSet<IView*>& modifiedViews);
+    void processSensitivityItems(QList<HierarchyItem*> const& items, QSet<IView*>& modifiedViews);
+    void processUncertaintyItems(QList<HierarchyItem*> const& items, QSet<IView*>& modifiedViews);
+    void processEnvelopeItems(QList<HierarchyItem*> const& items, QSet<IView*>& modifiedViews);
     IView* createView(ModelHierarchyItem* pItem);
     QString getDefaultViewName(IView::Type type);
     QString getViewName(HierarchyItem* pItem);
@@ -0,0 +1,683 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <malloc.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "benchbackend.h"
+#include "benchcomparison.h"
+#include "config.h"
+#include "fileutility.h"
+#include "fluttersolver.h"
+#include "modalsolver.h"
+#include "optimsolver.h"
+#include "subproject.h"
+
+using namespace Tests;
+using namespace Backend;
+using namespace Backend::Core;
+using namespace Eigen;
+
+// Helper functions
+QJsonObject toJson(MemoryUsage const& usage);
+
+// Allocation counters updated by the replaced global operators
+static std::atomic<qint64> sNumAllocations = 0;
+static std::atomic<qint64> sNumAllocatedBytes = 0;
+
+//! Exit code reported to CTest, when there is no baseline to compare with
+static int const skSkipCode = 77;
+
+//! Count the allocation and request the memory aligned to the given boundary
+static void* allocate(std::size_t size, std::size_t alignment) noexcept
+{
+    sNumAllocations.fetch_add(1, std::memory_order_relaxed);
+    sNumAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0)
+        size = 1;
+    if (alignment <= alignof(std::max_align_t))
+        return std::malloc(size);
+#ifdef Q_OS_WIN
+    return _aligned_malloc(size, alignment);
+#else
+    size = (size + alignment - 1) / alignment * alignment;
+    return std::aligned_alloc(alignment, size);
+#endif
+}
+
+//! Release the memory acquired by the allocation function
+static void deallocate(void* ptr, std::size_t alignment) noexcept
+{
+#ifdef Q_OS_WIN
+    if (alignment > alignof(std::max_align_t))
+    {
+        _aligned_free(ptr);
+        return;
+    }
+#else
+    Q_UNUSED(alignment);
+#endif
+    std::free(ptr);
+}
+
+void* operator new(std::size_t size)
+{
+    if (void* ptr = allocate(size, alignof(std::max_align_t)))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void* ptr = allocate(size, (std::size_t) alignment))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+    return allocate(size, (std::size_t) alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+    return allocate(size, (std::size_t) alignment);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    deallocate(ptr, alignof(std::max_align_t));
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    deallocate(ptr, alignof(std::max_align_t));
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    deallocate(ptr, alignof(std::max_align_t));
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    deallocate(ptr, alignof(std::max_align_t));
+}
+
+void operator delete(void* ptr, std::nothrow_t const&) noexcept
+{
+    deallocate(ptr, alignof(std::max_align_t));
+}
+
+void operator delete[](void* ptr, std::nothrow_t const&) noexcept
+{
+    deallocate(ptr, alignof(std::max_align_t));
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept
+{
+    deallocate(ptr, (std::size_t) alignment);
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept
+{
+    deallocate(ptr, (std::size_t) alignment);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept
+{
+    deallocate(ptr, (std::size_t) alignment);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t alignment) noexcept
+{
+    deallocate(ptr, (std::size_t) alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+    deallocate(ptr, (std::size_t) alignment);
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+    deallocate(ptr, (std::size_t) alignment);
+}
+
+//! Interpolate the value at the given fraction of the sorted values
+static double percentile(QList<double> const& sortedValues, double fraction)
+{
+    int numValues = sortedValues.size();
+    if (numValues == 0)
+        return 0.0;
+    double position = fraction * (numValues - 1);
+    int iLower = (int) position;
+    int iUpper = std::min(iLower + 1, numValues - 1);
+    double weight = position - iLower;
+    return (1.0 - weight) * sortedValues[iLower] + weight * sortedValues[iUpper];
+}
+
+//! Retrieve the peak resident set size of the process in bytes
+static qint64 readPeakRSS()
+{
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef Q_OS_MACOS
+    return usage.ru_maxrss;
+#else
+    return usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+BenchResult::BenchResult(QString const& aName, QString const& aExample)
+    : name(aName)
+    , example(aExample)
+    , numAllocations(0)
+    , numAllocatedBytes(0)
+    , peakRSSGrowth(0)
+{
+}
+
+//! Represent the measurements as a JSON object
+QJsonObject BenchResult::toJson() const
+{
+    int numTimes = times.size();
+
+    // Compute the statistics of wall time
+    QList<double> sortedTimes = times;
+    std::sort(sortedTimes.begin(), sortedTimes.end());
+    double sumTimes = 0.0;
+    QJsonArray samples;
+    for (double value : times)
+    {
+        sumTimes += value;
+        samples.append(value);
+    }
+    QJsonObject wallTime;
+    wallTime["unit"] = "ms";
+    wallTime["samples"] = samples;
+    if (numTimes > 0)
+    {
+        wallTime["min"] = sortedTimes.first();
+        wallTime["max"] = sortedTimes.last();
+        wallTime["mean"] = sumTimes / numTimes;
+        wallTime["p50"] = percentile(sortedTimes, 0.50);
+        wallTime["p90"] = percentile(sortedTimes, 0.90);
+        wallTime["p99"] = percentile(sortedTimes, 0.99);
+    }
+
+    // Average the allocations per run
+    QJsonObject allocations;
+    allocations["count"] = numTimes > 0 ? (double) numAllocations / numTimes : 0.0;
+    allocations["bytes"] = numTimes > 0 ? (double) numAllocatedBytes / numTimes : 0.0;
+
+    // Combine the results
+    QJsonObject result;
+    result["name"] = name;
+    result["example"] = example;
+    result["numRepeats"] = numTimes;
+    result["wallTime"] = wallTime;
+    result["allocations"] = allocations;
+    result["peakRSSGrowth"] = peakRSSGrowth;
+    if (!counters.isEmpty())
+        result["counters"] = counters;
+    return result;
+}
+
+BenchBackend::BenchBackend(int numRepeats, int numWarmups, quint32 seed, QStringList const& groups)
+    : mkNumRepeats(numRepeats)
+    , mkNumWarmups(numWarmups)
+    , mkSeed(seed)
+    , mkGroups(groups)
+{
+    // Files
+    mFileNames[kSimpleWing] = "DATWEXA";
+    mFileNames[kHunterWing] = "DATW70";
+    mFileNames[kFullHunterSym] = "DATH70s";
+    mFileNames[kFullHunterASym] = "DATH70a";
+    // Subprojects
+    mSubprojectNames[kSimpleWing] = "Simple wing";
+    mSubprojectNames[kHunterWing] = "Hunter wing";
+    mSubprojectNames[kFullHunterSym] = "Full Hunter (sym)";
+    mSubprojectNames[kFullHunterASym] = "Full Hunter (asym)";
+}
+
+//! Run the benchmark cases of the enabled groups
+void BenchBackend::run()
+{
+    mResults.clear();
+    loadModels();
+
+    // Modal solvers
+    if (isEnabled("modal"))
+    {
+        benchModalSolver(kSimpleWing, 15);
+        benchModalSolver(kHunterWing, 30);
+        benchModalSolver(kFullHunterSym, 30);
+        benchModalSolver(kFullHunterASym, 30);
+    }
+
+    // Flutter solvers
+    if (isEnabled("flutter"))
+    {
+        FlutterOptions options;
+        options.numModes = 10;
+        options.flowStep = 5;
+        options.numFlowSteps = 200;
+        benchFlutterSolver(kSimpleWing, options);
+        options = FlutterOptions();
+        options.numModes = 10;
+        benchFlutterSolver(kHunterWing, options);
+        options.numModes = 20;
+        benchFlutterSolver(kFullHunterSym, options);
+        benchFlutterSolver(kFullHunterASym, options);
+    }
+
+    // Optimization solvers
+    if (isEnabled("optim"))
+        benchOptimSolver(kSimpleWing);
+
+    // Modal solutions
+    if (isEnabled("compare"))
+    {
+        for (Example example : mFileNames.keys())
+            benchCompare(example, 15);
+    }
+    if (isEnabled("modesets"))
+    {
+        for (Example example : mFileNames.keys())
+            benchReadModesets(example);
+    }
+
+    // Project
+    if (isEnabled("project"))
+        benchProject();
+}
+
+//! Combine the results of all the benchmark cases
+QJsonObject BenchBackend::report() const
+{
+    QJsonArray benchmarks;
+    for (BenchResult const& result : mResults)
+        benchmarks.append(result.toJson());
+
+    QJsonObject result;
+    result["version"] = VERSION_FULL;
+    result["numRepeats"] = mkNumRepeats;
+    result["numWarmups"] = mkNumWarmups;
+    result["seed"] = (qint64) mkSeed;
+    result["peakRSS"] = readPeakRSS();
+    result["benchmarks"] = benchmarks;
+    result["memory"] = memoryReport();
+    return result;
+}
+
+//! Estimate the memory held by the subprojects with the retained solutions
+QJsonObject BenchBackend::memoryReport() const
+{
+    QJsonArray subprojects;
+    for (Subproject const& subproject : mProject.subprojects())
+    {
+        QJsonObject object = toJson(subproject.memoryUsage());
+        object["name"] = subproject.name();
+        object["numSolvers"] = subproject.numSolvers();
+        subprojects.append(object);
+    }
+
+    QJsonObject result = toJson(mProject.memoryUsage());
+    result["unit"] = "B";
+    result["subprojects"] = subprojects;
+    return result;
+}
+
+//! Load all the models and create the subprojects
+void BenchBackend::loadModels()
+{
+    mProject = Project();
+    for (auto [key, value] : mFileNames.asKeyValueRange())
+    {
+        QString pathFile = Utility::combineFilePath(EXAMPLES_DIR, value + ".dat");
+        Subproject subproject(mSubprojectNames[key]);
+        subproject.model() = KCL::Model(pathFile.toStdString());
+        if (subproject.model().isEmpty())
+            qWarning() << QObject::tr("Could not load the model from the file: %1").arg(pathFile);
+        mProject.addSubproject(subproject);
+    }
+}
+
+//! Measure the modal solver and keep the last solution in the project
+void BenchBackend::benchModalSolver(Example example, int numModes)
+{
+    Subproject& subproject = mProject.subprojects()[example];
+    ModalSolver solver;
+    solver.options.numModes = numModes;
+    solver.model = subproject.model();
+    measure("ModalSolver::solve", mFileNames[example], [&solver]() { solver.solve(); });
+    *(ModalSolver*) subproject.addSolver(ISolver::kModal) = solver;
+}
+
+//! Measure the flutter solver and keep the last solution in the project
+void BenchBackend::benchFlutterSolver(Example example, FlutterOptions const& options)
+{
+    Subproject& subproject = mProject.subprojects()[example];
+    FlutterSolver solver;
+    solver.options = options;
+    solver.model = subproject.model();
+    measure("FlutterSolver::solve", mFileNames[example], [&solver]() { solver.solve(); });
+    *(FlutterSolver*) subproject.addSolver(ISolver::kFlutter) = solver;
+}
+
+//! Measure the update of the model using the seeded target frequencies
+void BenchBackend::benchOptimSolver(Example example)
+{
+    int const kNumModes = 3;
+    double const kError = 0.01;
+
+    Subproject& subproject = mProject.subprojects()[example];
+    KCL::Model const& model = subproject.model();
+    auto eigenSolution = model.solveEigen();
+
+    // Set the problem
+    OptimSolver solver;
+    OptimProblem& problem = solver.problem;
+    problem.model = model;
+    SelectionSet& set = problem.selector.add(model, "main");
+    set.selectAll();
+    set.setSelected(KCL::BI, true);
+    set.setSelected(KCL::DB, true);
+    set.setSelected(KCL::BK, true);
+    set.setSelected(KCL::PR, true);
+
+    // Set the options
+    OptimOptions& options = solver.options;
+    options.maxNumIterations = 32;
+    options.numThreads = 1;
+    options.diffStepSize = 1e-5;
+    options.maxRelError = 1e-1;
+    options.penaltyMAC = 0;
+    options.numModes = 10;
+
+    // Set the objectives which are reproducible between runs
+    QRandomGenerator generator(mkSeed);
+    problem.target.resize(kNumModes);
+    problem.target.indices.setLinSpaced(0, kNumModes - 1);
+    for (int i = 0; i != kNumModes; ++i)
+    {
+        double factor = 1.0 + kError * (2.0 * generator.generateDouble() - 1.0);
+        problem.target.frequencies[i] = eigenSolution.frequencies[problem.target.indices[i]] * factor;
+    }
+    problem.target.weights.setOnes();
+
+    // Run the solver starting from the same state
+    measure("OptimSolver::solve", mFileNames[example],
+            [&solver]()
+            {
+                OptimSolver tSolver(solver);
+                tSolver.solve();
+            });
+
+    // Count the eigen solves skipped at the repeated points by an extra profiled run
+    OptimSolver tSolver(solver);
+    tSolver.profiler().setEnabled(true);
+    tSolver.solve();
+    if (!tSolver.solutions.isEmpty())
+    {
+        ProfileReport profile = tSolver.solutions.last().profile;
+        qint64 numLookups = profile.phase("dedupLookups").count;
+        qint64 numHits = profile.phase("dedupHits").count;
+        QJsonObject& counters = mResults.last().counters;
+        counters["dedupLookups"] = numLookups;
+        counters["dedupHits"] = numHits;
+        counters["dedupHitRatio"] = numLookups > 0 ? (double) numHits / numLookups : 0.0;
+    }
+    *(OptimSolver*) subproject.addSolver(ISolver::kOptim) = solver;
+}
+
+//! Measure the comparison of the model solution with the perturbed one
+void BenchBackend::benchCompare(Example example, int numModes)
+{
+    double const kError = 0.01;
+
+    // Obtain the solution to compare with
+    KCL::Model const& model = mProject.subprojects()[example].model();
+    ModalSolution solution(model.solveEigen());
+    if (solution.isEmpty())
+        return;
+    numModes = std::min(numModes, solution.numModes());
+
+    // Perturb the solution
+    QRandomGenerator generator(mkSeed);
+    ModalSolution another = solution;
+    for (int i = 0; i != another.numModes(); ++i)
+    {
+        another.frequencies[i] *= 1.0 + kError * (2.0 * generator.generateDouble() - 1.0);
+        MatrixXd& modeShape = another.modeShapes[i];
+        for (int j = 0; j != modeShape.size(); ++j)
+            modeShape.data()[j] *= 1.0 + kError * (2.0 * generator.generateDouble() - 1.0);
+    }
+
+    // Match the vertices
+    int numVertices = solution.geometry.numVertices();
+    Matches matches(numVertices);
+    for (int i = 0; i != numVertices; ++i)
+        matches[i] = {i, i};
+
+    // Compare the solutions
+    VectorXi indices = VectorXi::LinSpaced(numModes, 0, numModes - 1);
+    measure("ModalSolution::compare", mFileNames[example], [&]() { solution.compare(another, indices, matches, 0.0); });
+    ModalCandidates const candidates(0.1);
+    measure("ModalSolution::compare (band)", mFileNames[example], [&]() { solution.compare(another, indices, matches, 0.0, candidates); });
+}
+
+//! Measure reading of the experimental modesets, if any
+void BenchBackend::benchReadModesets(Example example)
+{
+    QDir directory(Utility::combineFilePath(EXAMPLES_DIR, mFileNames[example]));
+    QString pathFile = Utility::combineFilePath(directory.path(), "modesets.txt");
+    if (!QFile::exists(pathFile))
+        return;
+
+    // Read the geometry once to map the vertices
+    ModalSolution solution;
+    solution.geometry.read(Utility::combineFilePath(directory.path(), "model.txt"));
+
+    // Read the modesets
+    measure("ModalSolution::readModesets", mFileNames[example],
+            [&solution, &pathFile]()
+            {
+                ModalSolution tSolution;
+                tSolution.geometry = solution.geometry;
+                tSolution.readModesets(pathFile);
+            });
+}
+
+//! Measure writing and reading of the project consisted of all the solved subprojects
+void BenchBackend::benchProject()
+{
+    QString fileName = QString("bench.%1").arg(Project::fileSuffix());
+    QString pathFile = Utility::combineFilePath(TEMPORARY_DIR, fileName);
+    measure("Project::write", "all", [this, &pathFile]() { mProject.write(pathFile); });
+    measure("Project::read", "all",
+            [&pathFile]()
+            {
+                Project project;
+                project.read(pathFile);
+            });
+    QFile::remove(pathFile);
+}
+
+//! Check whether the group of cases is requested (all the groups are run by default)
+bool BenchBackend::isEnabled(QString const& group) const
+{
+    return mkGroups.isEmpty() || mkGroups.contains(group, Qt::CaseInsensitive);
+}
+
+//! Time the repeated runs of the function
+void BenchBackend::measure(QString const& name, QString const& example, std::function<void()> fun)
+{
+    BenchResult result(name, example);
+    qInfo().noquote() << QString("Running %1 on %2").arg(result.name, result.example);
+
+    // Warm up the caches
+    qint64 peakRSS = readPeakRSS();
+    for (int i = 0; i != mkNumWarmups; ++i)
+        fun();
+
+    // Collect the samples
+    QElapsedTimer timer;
+    qint64 numAllocations = sNumAllocations.load();
+    qint64 numAllocatedBytes = sNumAllocatedBytes.load();
+    result.times.reserve(mkNumRepeats);
+    for (int i = 0; i != mkNumRepeats; ++i)
+    {
+        timer.start();
+        fun();
+        result.times.push_back(timer.nsecsElapsed() * 1e-6);
+    }
+    result.numAllocations = sNumAllocations.load() - numAllocations;
+    result.numAllocatedBytes = sNumAllocatedBytes.load() - numAllocatedBytes;
+    result.peakRSSGrowth = readPeakRSS() - peakRSS;
+    mResults.push_back(result);
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication application(argc, argv);
+
+    // Parse the arguments
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmark of the backend algorithms on the shipped example models");
+    parser.addHelpOption();
+    QCommandLineOption repeatsOption("repeats", "Number of measured runs of each case", "number", "5");
+    QCommandLineOption warmupsOption("warmups", "Number of unmeasured runs of each case", "number", "1");
+    QCommandLineOption seedOption("seed", "Seed used to generate optimization targets", "number", "0");
+    QCommandLineOption groupOption("group", "Group of cases to run: modal, flutter, optim, compare, modesets or project (repeatable)", "name");
+    QCommandLineOption baselineOption("baseline", "Baseline report. Exits with code 2 on regressions and 77 if it is missing", "file");
+    QCommandLineOption toleranceOption("tolerance", "Relative slowdown of the median accepted regardless of the noise", "ratio", "0.1");
+    QCommandLineOption madsOption("mads", "Number of scaled median absolute deviations accepted as the noise", "number", "3");
+    parser.addOptions({repeatsOption, warmupsOption, seedOption, groupOption, baselineOption, toleranceOption, madsOption});
+    parser.addPositionalArgument("output", "Path to the JSON report. It is printed to the standard output, if omitted without baseline");
+    parser.process(application);
+    int numRepeats = std::max(1, parser.value(repeatsOption).toInt());
+    int numWarmups = std::max(0, parser.value(warmupsOption).toInt());
+    quint32 seed = parser.value(seedOption).toUInt();
+
+    // Read the baseline
+    QJsonObject baseline;
+    bool isCompare = parser.isSet(baselineOption);
+    if (isCompare)
+    {
+        QString pathFile = parser.value(baselineOption);
+        if (!QFile::exists(pathFile))
+        {
+            std::cout << QObject::tr("Skipping the comparison, since the baseline is missing: %1. Record it on the reference machine by running "
+                                     "the benchmark with the report path")
+                             .arg(pathFile)
+                             .toStdString()
+                      << std::endl;
+            return skSkipCode;
+        }
+        baseline = BenchComparison::readReport(pathFile);
+        if (baseline.isEmpty())
+            return 1;
+    }
+
+    // Run the benchmarks
+    BenchBackend bench(numRepeats, numWarmups, seed, parser.values(groupOption));
+    bench.run();
+    QJsonObject report = bench.report();
+
+    // Write the report
+    QStringList arguments = parser.positionalArguments();
+    if (!arguments.isEmpty() || !isCompare)
+    {
+        QFile file;
+        bool isOpened;
+        if (arguments.isEmpty())
+        {
+            isOpened = file.open(stdout, QIODevice::WriteOnly);
+        }
+        else
+        {
+            file.setFileName(arguments.first());
+            isOpened = file.open(QIODevice::WriteOnly);
+        }
+        if (!isOpened)
+        {
+            qWarning() << QObject::tr("Could not write the report to the file: %1").arg(file.fileName());
+            return 1;
+        }
+        file.write(QJsonDocument(report).toJson());
+    }
+
+    // Compare the timings
+    if (isCompare)
+    {
+        BenchComparison comparison(parser.value(toleranceOption).toDouble(), parser.value(madsOption).toDouble());
+        comparison.compare(baseline, report);
+        std::cout << comparison.toString().toStdString() << std::flush;
+        if (comparison.isRegressed())
+            return 2;
+    }
+    return 0;
+}
+
+//! Represent the memory usage by the kind of data
+QJsonObject toJson(MemoryUsage const& usage)
+{
+    QJsonObject result;
+    result["total"] = usage.total();
+    result["models"] = usage.models;
+    result["modeShapes"] = usage.modeShapes;
+    result["roots"] = usage.roots;
+    result["critModeShapes"] = usage.critModeShapes;
+    result["solutions"] = usage.solutions;
+    result["logs"] = usage.logs;
+    result["other"] = usage.other;
+    return result;
+}
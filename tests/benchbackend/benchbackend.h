@@ -0,0 +1,92 @@
+#ifndef BENCHBACKEND_H
+#define BENCHBACKEND_H
+
+#include <QJsonObject>
+#include <QMap>
+
+#include <functional>
+
+#include "project.h"
+
+namespace Backend::Core
+{
+struct FlutterOptions;
+}
+
+namespace Tests
+{
+
+enum Example
+{
+    kSimpleWing,
+    kHunterWing,
+    kFullHunterSym,
+    kFullHunterASym
+};
+
+//! Measurements of a single benchmark case
+struct BenchResult
+{
+    BenchResult(QString const& aName, QString const& aExample);
+    ~BenchResult() = default;
+
+    QJsonObject toJson() const;
+
+    QString name;
+    QString example;
+    QList<double> times;
+    qint64 numAllocations;
+    qint64 numAllocatedBytes;
+
+    //! Growth of the process peak resident set size during the case, since the peak itself cannot be reset
+    qint64 peakRSSGrowth;
+
+    //! Counters reported by the profiler of the solver
+    QJsonObject counters;
+};
+
+//! Class to time repeated runs of the backend algorithms on the shipped examples
+class BenchBackend
+{
+public:
+    BenchBackend(int numRepeats, int numWarmups, quint32 seed, QStringList const& groups = QStringList());
+    ~BenchBackend() = default;
+
+    void run();
+    QJsonObject report() const;
+    QJsonObject memoryReport() const;
+
+private:
+    // Models
+    void loadModels();
+
+    // Solvers
+    void benchModalSolver(Example example, int numModes);
+    void benchFlutterSolver(Example example, Backend::Core::FlutterOptions const& options);
+    void benchOptimSolver(Example example);
+
+    // Modal solutions
+    void benchCompare(Example example, int numModes);
+    void benchReadModesets(Example example);
+
+    // Project
+    void benchProject();
+
+    // Measurement
+    bool isEnabled(QString const& group) const;
+    void measure(QString const& name, QString const& example, std::function<void()> fun);
+
+private:
+    int const mkNumRepeats;
+    int const mkNumWarmups;
+    quint32 const mkSeed;
+    QStringList const mkGroups;
+    Backend::Core::Project mProject;
+    QMap<Example, QString> mFileNames;
+    QMap<Example, QString> mSubprojectNames;
+    QList<BenchResult> mResults;
+};
+
+}
+
+#endif // BENCHBACKEND_H
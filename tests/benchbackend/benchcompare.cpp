@@ -0,0 +1,39 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include <iostream>
+
+#include "benchcomparison.h"
+
+using namespace Tests;
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication application(argc, argv);
+
+    // Parse the arguments
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Compare two benchmark reports. Exits with code 2, if any case regresses");
+    parser.addHelpOption();
+    QCommandLineOption toleranceOption("tolerance", "Relative slowdown of the median accepted regardless of the noise", "ratio", "0.1");
+    QCommandLineOption madsOption("mads", "Number of scaled median absolute deviations accepted as the noise", "number", "3");
+    parser.addOptions({toleranceOption, madsOption});
+    parser.addPositionalArgument("baseline", "Reference JSON report");
+    parser.addPositionalArgument("current", "JSON report to be checked");
+    parser.process(application);
+    QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 2)
+        parser.showHelp(1);
+
+    // Read the reports
+    QJsonObject baseline = BenchComparison::readReport(arguments[0]);
+    QJsonObject current = BenchComparison::readReport(arguments[1]);
+    if (baseline.isEmpty() || current.isEmpty())
+        return 1;
+
+    // Compare the timings
+    BenchComparison comparison(parser.value(toleranceOption).toDouble(), parser.value(madsOption).toDouble());
+    comparison.compare(baseline, current);
+    std::cout << comparison.toString().toStdString() << std::flush;
+    return comparison.isRegressed() ? 2 : 0;
+}
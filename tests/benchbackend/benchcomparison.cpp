@@ -0,0 +1,229 @@
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMap>
+#include <QSet>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+#include "benchcomparison.h"
+
+using namespace Tests;
+
+// Helper functions
+QList<double> getSamples(QJsonObject const& benchmark);
+QString getKey(QJsonObject const& benchmark);
+
+//! Scale factor to estimate the standard deviation of normally distributed samples by the MAD
+static double const skScaleMAD = 1.4826;
+
+BenchDelta::BenchDelta()
+    : status(kPassed)
+    , baseMedian(0.0)
+    , baseMAD(0.0)
+    , currentMedian(0.0)
+    , currentMAD(0.0)
+    , tolerance(0.0)
+{
+}
+
+//! Change of the median relative to the baseline
+double BenchDelta::delta() const
+{
+    return currentMedian - baseMedian;
+}
+
+QString BenchDelta::statusName() const
+{
+    switch (status)
+    {
+    case kPassed:
+        return "ok";
+    case kImproved:
+        return "improved";
+    case kRegressed:
+        return "REGRESSED";
+    case kMissing:
+        return "missing";
+    case kAdded:
+        return "new";
+    }
+    return QString();
+}
+
+BenchComparison::BenchComparison(double relTolerance, double numMADs, double minTolerance)
+    : mkRelTolerance(relTolerance)
+    , mkNumMADs(numMADs)
+    , mkMinTolerance(minTolerance)
+{
+}
+
+//! Compare the medians of the cases which are present in both reports
+void BenchComparison::compare(QJsonObject const& baseline, QJsonObject const& current)
+{
+    mDeltas.clear();
+
+    // Index the current cases
+    QMap<QString, QJsonObject> currentCases;
+    for (QJsonValue const& value : current["benchmarks"].toArray())
+        currentCases[getKey(value.toObject())] = value.toObject();
+
+    // Process the baseline cases
+    QSet<QString> baseKeys;
+    for (QJsonValue const& value : baseline["benchmarks"].toArray())
+    {
+        QJsonObject benchmark = value.toObject();
+        QString key = getKey(benchmark);
+        baseKeys.insert(key);
+        BenchDelta item;
+        item.name = benchmark["name"].toString();
+        item.example = benchmark["example"].toString();
+        QList<double> baseSamples = getSamples(benchmark);
+        item.baseMedian = median(baseSamples);
+        item.baseMAD = medianAbsDeviation(baseSamples);
+        if (!currentCases.contains(key))
+        {
+            item.status = BenchDelta::kMissing;
+            mDeltas.push_back(item);
+            continue;
+        }
+        QList<double> currentSamples = getSamples(currentCases[key]);
+        item.currentMedian = median(currentSamples);
+        item.currentMAD = medianAbsDeviation(currentSamples);
+
+        // Combine the relative tolerance with the noise of both runs
+        double sigma = skScaleMAD * std::hypot(item.baseMAD, item.currentMAD);
+        item.tolerance = std::max({mkRelTolerance * item.baseMedian, mkNumMADs * sigma, mkMinTolerance});
+        if (item.delta() > item.tolerance)
+            item.status = BenchDelta::kRegressed;
+        else if (item.delta() < -item.tolerance)
+            item.status = BenchDelta::kImproved;
+        else
+            item.status = BenchDelta::kPassed;
+        mDeltas.push_back(item);
+    }
+
+    // Append the cases absent in the baseline
+    for (auto [key, benchmark] : currentCases.asKeyValueRange())
+    {
+        if (baseKeys.contains(key))
+            continue;
+        BenchDelta item;
+        item.name = benchmark["name"].toString();
+        item.example = benchmark["example"].toString();
+        item.status = BenchDelta::kAdded;
+        QList<double> currentSamples = getSamples(benchmark);
+        item.currentMedian = median(currentSamples);
+        item.currentMAD = medianAbsDeviation(currentSamples);
+        mDeltas.push_back(item);
+    }
+}
+
+//! Check if any of the compared cases has slowed down beyond the tolerance
+bool BenchComparison::isRegressed() const
+{
+    return std::any_of(mDeltas.begin(), mDeltas.end(), [](BenchDelta const& item) { return item.status == BenchDelta::kRegressed; });
+}
+
+QList<BenchDelta> const& BenchComparison::deltas() const
+{
+    return mDeltas;
+}
+
+//! Represent the deltas as a table
+QString BenchComparison::toString() const
+{
+    QString result;
+    QTextStream stream(&result);
+    auto constexpr format = "{:<28} {:<12} {:>14} {:>14} {:>10} {:>10} {:>10}";
+    stream << std::format(format, "Benchmark", "Example", "Baseline, ms", "Current, ms", "Delta", "Tolerance", "Status").c_str() << Qt::endl;
+    int numRegressed = 0;
+    int numCompared = 0;
+    for (BenchDelta const& item : mDeltas)
+    {
+        std::string baseMedian = "-";
+        std::string currentMedian = "-";
+        std::string delta = "-";
+        std::string tolerance = "-";
+        if (item.status != BenchDelta::kAdded)
+            baseMedian = std::format("{:.3f}", item.baseMedian);
+        if (item.status != BenchDelta::kMissing)
+            currentMedian = std::format("{:.3f}", item.currentMedian);
+        if (item.status != BenchDelta::kAdded && item.status != BenchDelta::kMissing)
+        {
+            double factor = item.baseMedian > 0.0 ? 100.0 / item.baseMedian : 0.0;
+            delta = std::format("{:+.1f}%", factor * item.delta());
+            tolerance = std::format("{:.1f}%", factor * item.tolerance);
+            ++numCompared;
+            if (item.status == BenchDelta::kRegressed)
+                ++numRegressed;
+        }
+        std::string name = item.name.toStdString();
+        std::string example = item.example.toStdString();
+        std::string status = item.statusName().toStdString();
+        stream << std::format(format, name, example, baseMedian, currentMedian, delta, tolerance, status).c_str() << Qt::endl;
+    }
+    stream << QString("Regressed: %1 of %2 compared cases").arg(numRegressed).arg(numCompared) << Qt::endl;
+    return result;
+}
+
+//! Read the report produced by the benchmark
+QJsonObject BenchComparison::readReport(QString const& pathFile)
+{
+    QFile file(pathFile);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << QObject::tr("Could not open the benchmark report: %1").arg(pathFile);
+        return QJsonObject();
+    }
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &error);
+    if (error.error != QJsonParseError::NoError)
+    {
+        qWarning() << QObject::tr("Could not parse the benchmark report %1: %2").arg(pathFile, error.errorString());
+        return QJsonObject();
+    }
+    return document.object();
+}
+
+double BenchComparison::median(QList<double> values)
+{
+    int numValues = values.size();
+    if (numValues == 0)
+        return 0.0;
+    std::sort(values.begin(), values.end());
+    int iMiddle = numValues / 2;
+    if (numValues % 2 == 0)
+        return 0.5 * (values[iMiddle - 1] + values[iMiddle]);
+    return values[iMiddle];
+}
+
+//! Compute the median of absolute deviations from the median
+double BenchComparison::medianAbsDeviation(QList<double> const& values)
+{
+    double center = median(values);
+    QList<double> deviations;
+    deviations.reserve(values.size());
+    for (double value : values)
+        deviations.push_back(std::abs(value - center));
+    return median(deviations);
+}
+
+//! Retrieve the wall time samples of the benchmark case
+QList<double> getSamples(QJsonObject const& benchmark)
+{
+    QList<double> result;
+    for (QJsonValue const& value : benchmark["wallTime"].toObject()["samples"].toArray())
+        result.push_back(value.toDouble());
+    return result;
+}
+
+//! Identify the benchmark case
+QString getKey(QJsonObject const& benchmark)
+{
+    return benchmark["name"].toString() + "@" + benchmark["example"].toString();
+}
@@ -0,0 +1,74 @@
+#ifndef BENCHCOMPARISON_H
+#define BENCHCOMPARISON_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+namespace Tests
+{
+
+//! Difference between the baseline and current timings of a benchmark case
+struct BenchDelta
+{
+    enum Status
+    {
+        kPassed,
+        kImproved,
+        kRegressed,
+        kMissing,
+        kAdded
+    };
+
+    BenchDelta();
+    ~BenchDelta() = default;
+
+    double delta() const;
+    QString statusName() const;
+
+    QString name;
+    QString example;
+    Status status;
+
+    //! Median of the baseline samples, ms
+    double baseMedian;
+
+    //! Median absolute deviation of the baseline samples, ms
+    double baseMAD;
+
+    //! Median of the current samples, ms
+    double currentMedian;
+
+    //! Median absolute deviation of the current samples, ms
+    double currentMAD;
+
+    //! Maximum accepted change of the median, ms
+    double tolerance;
+};
+
+//! Statistical comparison of two benchmark reports
+class BenchComparison
+{
+public:
+    BenchComparison(double relTolerance = 0.1, double numMADs = 3.0, double minTolerance = 0.05);
+    ~BenchComparison() = default;
+
+    void compare(QJsonObject const& baseline, QJsonObject const& current);
+
+    bool isRegressed() const;
+    QList<BenchDelta> const& deltas() const;
+    QString toString() const;
+
+    static QJsonObject readReport(QString const& pathFile);
+    static double median(QList<double> values);
+    static double medianAbsDeviation(QList<double> const& values);
+
+private:
+    double const mkRelTolerance;
+    double const mkNumMADs;
+    double const mkMinTolerance;
+    QList<BenchDelta> mDeltas;
+};
+}
+
+#endif // BENCHCOMPARISON_H
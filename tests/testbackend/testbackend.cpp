@@ -1,12 +1,18 @@
 #include <QRandomGenerator>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
 
+#include "batchrunner.h"
 #include "config.h"
+#include "envelopesolver.h"
 #include "fileutility.h"
 #include "fluttersolver.h"
 #include "optimsolver.h"
 #include "optimselector.h"
+#include "sensitivitysolver.h"
 #include "subproject.h"
 #include "testbackend.h"
+#include "uncertaintysolver.h"
 
 using namespace Tests;
 using namespace Backend;
@@ -82,6 +88,54 @@ void TestBackend::testSelector()
     set.setSelected(0, KCL::BI, true);
     QVERIFY(set.numSelected() == 13);
 
+    // Inverse the selection
+    set.inverse();
+    QVERIFY(set.numSelected() == 71);
+    set.inverse();
+
+    // Shift the states while inserting and removing elements
+    Selection const selection(0, KCL::BI, 2);
+    set.insert(selection, 3);
+    QVERIFY(set.numSelected() == 13 && set.numElements() == 87);
+    QVERIFY(set.isSelected(Selection(0, KCL::BI, 1)) && !set.isSelected(selection) && set.isSelected(Selection(0, KCL::BI, 5)));
+    set.remove(selection, 3);
+    QVERIFY(set.numSelected() == 13 && set.numElements() == 84);
+
+    // Write and read the selection set
+    QByteArray data;
+    QXmlStreamWriter writer(&data);
+    set.serialize(writer, "selectionSet");
+    QXmlStreamReader reader(data);
+    reader.readNextStartElement();
+    SelectionSet tSet;
+    tSet.deserialize(reader);
+    QVERIFY(tSet == set);
+
+    // Combine the selection sets
+    SelectionSet surfaceSet(subproject.model(), "surface");
+    surfaceSet.setSelected(0, true);
+    QVERIFY(set.intersects(surfaceSet));
+    QVERIFY((set | surfaceSet).numSelected() == 44);
+    QVERIFY((set & surfaceSet).numSelected() == 13);
+    QVERIFY((surfaceSet - set).numSelected() == 31);
+    selector.get().push_back(surfaceSet);
+    QVERIFY(selector.allSelections().size() == 44);
+
+    // Unite the sets laid out differently, keeping the elements absent in the first one
+    SelectionSet extendedSet(subproject.model(), "extended");
+    Selection const lastSelection(0, KCL::BI, 13);
+    Selection const extraSelection((int) subproject.model().surfaces.size(), KCL::BI, 0);
+    extendedSet.insert(lastSelection);
+    extendedSet.insert(extraSelection, 2);
+    extendedSet.setSelected({lastSelection, extraSelection}, true);
+    SelectionSet unitedSet = surfaceSet | extendedSet;
+    QVERIFY(unitedSet.numElements() == 87);
+    QVERIFY(unitedSet.numSelected() == surfaceSet.numSelected() + 2);
+    QVERIFY(unitedSet.isSelected(lastSelection) && unitedSet.isSelected(extraSelection));
+    OptimSelector unitedSelector;
+    unitedSelector.get() = {surfaceSet, extendedSet};
+    QVERIFY(unitedSelector.allSelections().size() == unitedSet.numSelected());
+
     // Remove the selections
     selector.clear();
     QVERIFY(selector.isEmpty());
@@ -113,56 +167,331 @@ void TestBackend::testModalSolverFullHunterASym()
 
 //! Update the model of the simple wing
 void TestBackend::testOptimSolverSimpleWing()
+{
+    // Initialize the solver
+    OptimSolver* pSolver = createOptimSolver(Example::kSimpleWing, 3, 0.01);
+
+    // Start the solver
+    connect(pSolver, &OptimSolver::logAppended, [](QString message) { std::cout << message.toStdString() << std::endl; });
+    pSolver->solve();
+    QVERIFY(!pSolver->solutions.isEmpty());
+    QVERIFY(pSolver->solutions.last().isSuccess);
+}
+
+//! Update the model of the simple wing by the batch runner, so that the solver runs on a worker thread
+void TestBackend::testBatchOptimSolverSimpleWing()
 {
     Example const example = Example::kSimpleWing;
-    int const numModes = 3;
-    double const error = 0.01;
 
-    // Slice the subproject
-    Subproject& subproject = mProject.subprojects()[example];
+    // Initialize the solver
+    OptimSolver* pSolver = createOptimSolver(example, 3, 0.01);
+    pSolver->name = "batch";
 
-    // Obtain the initial solution
-    KCL::Model const& model = subproject.model();
-    auto eigenSolution = model.solveEigen();
+    // Run the solver
+    Batch::BatchRunner runner(mProject);
+    runner.select({mSubprojectNames[example]}, {pSolver->name});
+    QCOMPARE(runner.jobs().size(), 1);
+    QCOMPARE(runner.run(1), 0);
+    QVERIFY(!pSolver->solutions.isEmpty());
+    QVERIFY(pSolver->solutions.last().isSuccess);
+}
+
+//! Record the update of the simple wing, which ends on the tolerance of the frequency errors, and replay it
+void TestBackend::testOptimRecorderSimpleWing()
+{
+    // Initialize the solver, so that the tolerance is met before the optimizer converges
+    OptimSolver* pSolver = createOptimSolver(Example::kSimpleWing, 3, 0.01);
+    OptimOptions& options = pSolver->options;
+    options.maxRelError = 0.5;
+
+    // Record the run
+    pSolver->recorder().setEnabled(true);
+    pSolver->solve();
+    pSolver->recorder().setEnabled(false);
+    QVERIFY(!pSolver->solutions.isEmpty());
+    OptimSolution const& lastSolution = pSolver->solutions.last();
+    QVERIFY(lastSolution.isSuccess);
+    QVERIFY(lastSolution.message.contains("SOLVER_TERMINATE_SUCCESSFULLY"));
+    QVERIFY(ObjectiveFunctor::maxError(pSolver->problem.target, lastSolution.modalComparison) < options.maxRelError);
+
+    // Write and read the recording
+    QString pathFile = Utility::combineFilePath(TEMPORARY_DIR, QString("test.%1").arg(OptimRecording::fileSuffix()));
+    QVERIFY(pSolver->recorder().recording().write(pathFile));
+    OptimRecording recording;
+    QVERIFY(recording.read(pathFile));
+    QCOMPARE(recording.maxRelError, options.maxRelError);
+
+    // Replay the run, which has to stop at the same iteration
+    OptimReplayer replayer(recording);
+    ReplayStatistics statistics = replayer.replay();
+    QCOMPARE(statistics.numMisses, 0);
+    QVERIFY(statistics.isSuccess);
+    QVERIFY(statistics.isConverged);
+    QCOMPARE(statistics.numIterations, (int) recording.iterates.size());
+
+    // Refuse to replay the surrogate-assisted run
+    recording.numSurrogateSamples = 16;
+    OptimReplayer surrogateReplayer(recording);
+    QVERIFY(!surrogateReplayer.replay().isSuccess);
+}
 
+//! Optimize the surrogate model of the simple wing fitted to the concurrently obtained solutions
+void TestBackend::testOptimSurrogateSimpleWing()
+{
     // Initialize the solver
-    OptimSolver* pSolver = (OptimSolver*) subproject.addSolver(ISolver::kOptim);
+    OptimSolver* pSolver = createOptimSolver(Example::kSimpleWing, 3, 0.01);
+    OptimOptions& options = pSolver->options;
+    pSolver->profiler().setEnabled(true);
 
-    // Alias the data
-    OptimProblem& problem = pSolver->problem;
+    // Obtain the cost at the initial point
+    int const numIterations = options.maxNumIterations;
+    options.maxNumIterations = 1;
+    pSolver->solve();
+    QVERIFY(!pSolver->solutions.isEmpty());
+    double initCost = pSolver->solutions.first().cost;
+
+    // Run the solver
+    options.maxNumIterations = numIterations;
+    options.numSurrogateSamples = 16;
+    options.numThreads = 4;
+    pSolver->solve();
+    QVERIFY(!pSolver->solutions.isEmpty());
+    QVERIFY(pSolver->solutions.last().cost < initCost);
+
+    // Check that the samples are reused, so that no iteration takes more true solves than the surrogate model requires
+    int numSolves = pSolver->solutions.last().profile.phase("trueSolves").count;
+    QVERIFY(numSolves >= options.numSurrogateSamples);
+    QVERIFY(numSolves <= 1 + pSolver->solutions.size() * options.numSurrogateSamples);
+}
+
+//! Update the Jacobian by Broyden's method, so that the finite-difference ones are computed less often than once per iteration
+void TestBackend::testOptimBroydenSimpleWing()
+{
+    // Initialize the solver
+    OptimSolver* pSolver = createOptimSolver(Example::kSimpleWing, 3, 0.01);
+    pSolver->options.maxNumBroydenUpdates = 4;
+    pSolver->profiler().setEnabled(true);
+
+    // Run the solver
+    pSolver->solve();
+    QVERIFY(!pSolver->solutions.isEmpty());
+    QVERIFY(pSolver->solutions.last().isSuccess);
+    ProfileReport profile = pSolver->solutions.last().profile;
+    QVERIFY(profile.phase("broydenUpdates").count > 0);
+    QVERIFY(profile.phase("jacobianRefreshes").count < pSolver->solutions.size());
+}
+
+//! Check that the accepted iterations reuse the eigen solutions obtained at the same points while evaluating the Jacobians
+void TestBackend::testOptimDeduplicationSimpleWing()
+{
+    // Initialize the solver
+    OptimSolver* pSolver = createOptimSolver(Example::kSimpleWing, 3, 0.01);
+    pSolver->profiler().setEnabled(true);
+
+    // Run the solver
+    pSolver->solve();
+    QVERIFY(!pSolver->solutions.isEmpty());
+    ProfileReport profile = pSolver->solutions.last().profile;
+    qint64 numHits = profile.phase("dedupHits").count;
+    QVERIFY(numHits > 0);
+    QVERIFY(numHits <= profile.phase("dedupLookups").count);
+}
+
+//! Check that pairing the modes within the candidate bands gives the same result as comparing all of them
+void TestBackend::testOptimCandidatesSimpleWing()
+{
+    // Initialize the solver
+    OptimSolver* pSolver = createOptimSolver(Example::kSimpleWing, 3, 0.01);
     OptimOptions& options = pSolver->options;
-    OptimConstraints& constraints = problem.constraints;
 
-    // Set the model
-    problem.model = model;
+    // Compare all the modes
+    options.candidateBand = 0.0;
+    pSolver->solve();
+    QList<OptimSolution> const fullSolutions = pSolver->solutions;
+    QVERIFY(!fullSolutions.isEmpty());
+
+    // Compare the modes around the ones paired at the accepted iterates
+    options.candidateBand = 0.2;
+    pSolver->solve();
+    int numSolutions = fullSolutions.size();
+    QCOMPARE(pSolver->solutions.size(), numSolutions);
+    for (int i = 0; i != numSolutions; ++i)
+    {
+        ModalPairs const& pairs = pSolver->solutions[i].modalComparison.pairs;
+        QVERIFY(Utility::areEqual(pairs, fullSolutions[i].modalComparison.pairs, 1e-9));
+    }
+}
+
+//! Estimate sensitivities of the modes of the simple wing to the beam stiffnesses
+void TestBackend::testSensitivitySolverSimpleWing()
+{
+    Example const example = Example::kSimpleWing;
+
+    // Slice the subproject
+    Subproject& subproject = mProject.subprojects()[example];
+    KCL::Model const& model = subproject.model();
+
+    // Initialize the solver
+    SensitivitySolver* pSolver = (SensitivitySolver*) subproject.addSolver(ISolver::kSensitivity);
+    pSolver->model = model;
 
     // Select elements
-    SelectionSet& set = problem.selector.add(model, "main");
+    SelectionSet& set = pSolver->selector.add(model, "main");
     set.selectAll();
-    set.setSelected(KCL::BI, true);
-    set.setSelected(KCL::DB, true);
-    set.setSelected(KCL::BK, true);
-    set.setSelected(KCL::PR, true);
 
     // Set the options
-    options.maxNumIterations = 32;
-    options.diffStepSize = 1e-5;
-    options.maxRelError = 1e-1;
-    options.penaltyMAC = 0;
+    SensitivityOptions& options = pSolver->options;
     options.numModes = 10;
+    options.numThreads = 4;
 
-    // Set the objectives
-    problem.target.resize(numModes);
-    problem.target.indices.setLinSpaced(0, numModes - 1);
-    for (int i = 0; i != numModes; ++i)
-        problem.target.frequencies[i] = eigenSolution.frequencies[problem.target.indices[i]] * (1.0 + generateDouble({-error, error}));
-    problem.target.weights.setOnes();
+    // Start the solver
+    connect(pSolver, &SensitivitySolver::logAppended, [](QString message) { std::cout << message.toStdString() << std::endl; });
+    pSolver->solve();
+    SensitivitySolution const& solution = pSolver->solution;
+    QVERIFY(!solution.isEmpty());
+    QCOMPARE(solution.sensitivityFrequencies.rows(), solution.numModes());
+    QCOMPARE(solution.sensitivityFrequencies.cols(), solution.numParameters());
+    QCOMPARE(solution.errorsMAC.rows(), solution.numModes());
+    QCOMPARE(solution.errorsMAC.cols(), solution.numParameters());
+
+    // Check that stiffening the beams raises the frequencies
+    int numParameters = solution.numParameters();
+    int numStiffnesses = 0;
+    for (int j = 0; j != numParameters; ++j)
+    {
+        if (solution.types[j] != (int) VariableType::kBeamStiffness)
+            continue;
+        ++numStiffnesses;
+        Eigen::VectorXd sensitivities = solution.sensitivityFrequencies.col(j);
+        QVERIFY(sensitivities.allFinite());
+        QVERIFY(sensitivities.minCoeff() > -1e-6);
+        QVERIFY(sensitivities.maxCoeff() > 0.0);
+    }
+    QVERIFY(numStiffnesses > 0);
+}
+
+//! Propagate uncertainty of the beam stiffnesses of the simple wing to its flutter boundary
+void TestBackend::testUncertaintySolverSimpleWing()
+{
+    Example const example = Example::kSimpleWing;
+
+    // Slice the subproject
+    Subproject& subproject = mProject.subprojects()[example];
+    KCL::Model const& model = subproject.model();
+
+    // Initialize the solver
+    UncertaintySolver* pSolver = (UncertaintySolver*) subproject.addSolver(ISolver::kUncertainty);
+    pSolver->model = model;
+
+    // Select elements
+    SelectionSet& set = pSolver->selector.add(model, "main");
+    set.selectAll();
+
+    // Set the options
+    FlutterOptions& flutterOptions = pSolver->flutterOptions;
+    flutterOptions.numModes = 10;
+    flutterOptions.flowStep = 5;
+    flutterOptions.numFlowSteps = 200;
+    UncertaintyOptions& options = pSolver->options;
+    options.numSamples = 8;
+    options.seed = 1;
+    options.numThreads = 4;
 
     // Start the solver
-    connect(pSolver, &OptimSolver::logAppended, [](QString message) { std::cout << message.toStdString() << std::endl; });
+    connect(pSolver, &UncertaintySolver::logAppended, [](QString message) { std::cout << message.toStdString() << std::endl; });
     pSolver->solve();
-    QVERIFY(!pSolver->solutions.isEmpty());
-    QVERIFY(pSolver->solutions.last().isSuccess);
+    QVERIFY(!pSolver->solution.isEmpty());
+    QCOMPARE(pSolver->solution.numSamples(), options.numSamples);
+
+    // Check that the median of the critical speeds is close to the nominal one
+    UncertaintySolution solution = pSolver->solution;
+    QVERIFY(std::isfinite(solution.nominalSpeed));
+    QList<double> speeds;
+    for (double speed : solution.critSpeed)
+    {
+        if (std::isfinite(speed))
+            speeds.push_back(speed);
+    }
+    QVERIFY(!speeds.isEmpty());
+    std::sort(speeds.begin(), speeds.end());
+    double median = speeds[speeds.size() / 2];
+    QVERIFY(std::abs(median - solution.nominalSpeed) < 0.1 * solution.nominalSpeed);
+
+    // Check that the samples are reproducible
+    pSolver->solve();
+    QVERIFY(solution == pSolver->solution);
+}
+
+//! Sweep the bending stiffness of the root beam of the simple wing and find the critical flutter case
+void TestBackend::testEnvelopeSolverSimpleWing()
+{
+    Example const example = Example::kSimpleWing;
+
+    // Slice the subproject
+    Subproject& subproject = mProject.subprojects()[example];
+    KCL::Model const& model = subproject.model();
+
+    // Initialize the solver
+    EnvelopeSolver* pSolver = (EnvelopeSolver*) subproject.addSolver(ISolver::kEnvelope);
+    pSolver->model = model;
+
+    // Scale the bending stiffness of the root beam
+    EnvelopeTable& table = pSolver->table;
+    int iField = table.addField(Selection(0, KCL::BK, 0), 4, true);
+    QList<double> factors = {0.8, 1.0, 1.2};
+    for (double factor : factors)
+    {
+        int iCase = table.addCase(QString("EI x %1").arg(factor));
+        table.values(iCase, iField) = factor;
+    }
+
+    // Set the options
+    FlutterOptions& flutterOptions = pSolver->flutterOptions;
+    flutterOptions.numModes = 10;
+    flutterOptions.flowStep = 5;
+    flutterOptions.numFlowSteps = 200;
+    EnvelopeOptions& options = pSolver->options;
+    options.numThreads = 4;
+    options.isKeepSolutions = true;
+
+    // Start the solver
+    connect(pSolver, &EnvelopeSolver::logAppended, [](QString message) { std::cout << message.toStdString() << std::endl; });
+    pSolver->solve();
+    QVERIFY(!pSolver->solution.isEmpty());
+    QCOMPARE(pSolver->solution.numCases(), table.numCases());
+    QCOMPARE(pSolver->solution.solutions.size(), table.numCases());
+
+    // Check that the case with the unit factor reproduces the flutter solver
+    FlutterSolver* pFlutterSolver = (FlutterSolver*) subproject.addSolver(ISolver::kFlutter);
+    pFlutterSolver->model = model;
+    pFlutterSolver->options = flutterOptions;
+    pFlutterSolver->solve();
+    FlutterSolution const& flutterSolution = pFlutterSolver->solution;
+    QVERIFY(!flutterSolution.isEmpty());
+    EnvelopeSolution const& solution = pSolver->solution;
+    int iCase = factors.indexOf(1.0);
+    int iCrit = flutterSolution.findLowestCrit();
+    if (iCrit < 0)
+    {
+        QVERIFY(std::isnan(solution.critSpeed[iCase]));
+    }
+    else
+    {
+        QVERIFY(Utility::areEqual(solution.critFlow[iCase], flutterSolution.critFlow[iCrit], 1e-9));
+        QVERIFY(Utility::areEqual(solution.critSpeed[iCase], flutterSolution.critSpeed[iCrit], 1e-9));
+        QVERIFY(Utility::areEqual(solution.critFrequency[iCase], flutterSolution.critFrequency[iCrit], 1e-9));
+    }
+
+    // Check that the solution is empty if none of the cases could be applied
+    EnvelopeSolver* pInvalidSolver = (EnvelopeSolver*) pSolver->clone();
+    EnvelopeTable& invalidTable = pInvalidSolver->table;
+    iField = invalidTable.addField(Selection(0, KCL::BK, 0), 1000, true);
+    for (int i = 0; i != invalidTable.numCases(); ++i)
+        invalidTable.values(i, iField) = 1.0;
+    pInvalidSolver->solve();
+    QVERIFY(pInvalidSolver->solution.isEmpty());
+    QVERIFY(pInvalidSolver->log.toString().contains("None of the cases"));
+    delete pInvalidSolver;
 }
 
 void TestBackend::testFlutterSolverSimpleWing()
@@ -198,6 +527,81 @@ void TestBackend::testFlutterSolverFullHunterASym()
     testFlutterSolver(Example::kFullHunterASym, options);
 }
 
+//! Track crossing roots which are sorted by frequencies at every flow step
+void TestBackend::testTrackFlutterRoots()
+{
+    int const numSteps = 21;
+    double const flowStep = 5.0;
+
+    // Construct the roots, so that the frequencies coincide in the middle of the flow range
+    FlutterSolution solution;
+    solution.flow = Eigen::VectorXd::LinSpaced(numSteps, 0.0, flowStep * (numSteps - 1));
+    solution.roots.resize(2, numSteps);
+    for (int i = 0; i != numSteps; ++i)
+    {
+        std::complex<double> first(-1.0, 10.0 + 0.1 * solution.flow[i]);
+        std::complex<double> second(-2.0, 20.0 - 0.1 * solution.flow[i]);
+        if (first.imag() > second.imag())
+            std::swap(first, second);
+        solution.roots(0, i) = first;
+        solution.roots(1, i) = second;
+    }
+
+    // Check that the roots do not switch after the crossing point
+    QVERIFY(solution.trackRoots() > 0);
+    for (int i = 0; i != numSteps; ++i)
+    {
+        QCOMPARE(solution.roots(0, i).real(), -1.0);
+        QCOMPARE(solution.roots(1, i).real(), -2.0);
+    }
+}
+
+//! Track the roots which frequencies cross along a curved path or approach each other closely without crossing
+void TestBackend::testTrackCurvedFlutterRoots()
+{
+    int const numSteps = 21;
+    double const flowStep = 5.0;
+
+    // Construct the roots, so that the first frequency grows quadratically while crossing the second one
+    FlutterSolution crossing;
+    crossing.flow = Eigen::VectorXd::LinSpaced(numSteps, 0.0, flowStep * (numSteps - 1));
+    crossing.roots.resize(2, numSteps);
+    for (int i = 0; i != numSteps; ++i)
+    {
+        double flow = crossing.flow[i];
+        std::complex<double> first(-1.0, 10.0 + 0.004 * flow * flow);
+        std::complex<double> second(-3.0, 20.0 - 0.1 * flow);
+        if (first.imag() > second.imag())
+            std::swap(first, second);
+        crossing.roots(0, i) = first;
+        crossing.roots(1, i) = second;
+    }
+
+    // Check that the curvature does not make the roots switch
+    QVERIFY(crossing.trackRoots() > 0);
+    for (int i = 0; i != numSteps; ++i)
+    {
+        QCOMPARE(crossing.roots(0, i).real(), -1.0);
+        QCOMPARE(crossing.roots(1, i).real(), -3.0);
+    }
+
+    // Construct the roots, so that the frequencies veer away from each other in the middle of the flow range
+    FlutterSolution veering;
+    veering.flow = crossing.flow;
+    veering.roots.resize(2, numSteps);
+    for (int i = 0; i != numSteps; ++i)
+    {
+        double distance = std::sqrt(0.0025 + std::pow(0.1 * (veering.flow[i] - 50.0), 2));
+        veering.roots(0, i) = std::complex<double>(-1.0, 15.0 - distance);
+        veering.roots(1, i) = std::complex<double>(-3.0, 15.0 + distance);
+    }
+
+    // Check that the close approach does not reorder the roots
+    Eigen::MatrixXcd roots = veering.roots;
+    QCOMPARE(veering.trackRoots(), 0);
+    QVERIFY(veering.roots == roots);
+}
+
 //! Write a project consisted of several subprojects to a file
 void TestBackend::testWriteProject()
 {
@@ -227,6 +631,50 @@ double TestBackend::generateDouble(QPair<double, double> const& limits)
     return limits.first + value * (limits.second - limits.first);
 }
 
+//! Create the solver to update the model, so that the target frequencies deviate from the initial ones by the given relative error
+OptimSolver* TestBackend::createOptimSolver(Example example, int numModes, double error)
+{
+    // Slice the subproject
+    Subproject& subproject = mProject.subprojects()[example];
+
+    // Obtain the initial solution
+    KCL::Model const& model = subproject.model();
+    auto eigenSolution = model.solveEigen();
+
+    // Initialize the solver
+    OptimSolver* pSolver = (OptimSolver*) subproject.addSolver(ISolver::kOptim);
+
+    // Alias the data
+    OptimProblem& problem = pSolver->problem;
+    OptimOptions& options = pSolver->options;
+
+    // Set the model
+    problem.model = model;
+
+    // Select elements
+    SelectionSet& set = problem.selector.add(model, "main");
+    set.selectAll();
+    set.setSelected(KCL::BI, true);
+    set.setSelected(KCL::DB, true);
+    set.setSelected(KCL::BK, true);
+    set.setSelected(KCL::PR, true);
+
+    // Set the options
+    options.maxNumIterations = 32;
+    options.diffStepSize = 1e-5;
+    options.maxRelError = 1e-1;
+    options.penaltyMAC = 0;
+    options.numModes = 10;
+
+    // Set the objectives
+    problem.target.resize(numModes);
+    problem.target.indices.setLinSpaced(0, numModes - 1);
+    for (int i = 0; i != numModes; ++i)
+        problem.target.frequencies[i] = eigenSolution.frequencies[problem.target.indices[i]] * (1.0 + generateDouble({-error, error}));
+    problem.target.weights.setOnes();
+    return pSolver;
+}
+
 //! Helper function to obtaim modal solutions
 void TestBackend::testModalSolver(Example example, int numModes)
 {
@@ -9,6 +9,7 @@
 namespace Backend::Core
 {
 struct FlutterOptions;
+class OptimSolver;
 }
 
 namespace Tests
@@ -44,18 +45,36 @@ private slots:
 
     // Optimization solvers
     void testOptimSolverSimpleWing();
+    void testBatchOptimSolverSimpleWing();
+    void testOptimCandidatesSimpleWing();
+    void testOptimRecorderSimpleWing();
+    void testOptimDeduplicationSimpleWing();
+    void testOptimBroydenSimpleWing();
+    void testOptimSurrogateSimpleWing();
+
+    // Sensitivity solvers
+    void testSensitivitySolverSimpleWing();
+
+    // Uncertainty solvers
+    void testUncertaintySolverSimpleWing();
+
+    // Envelope solvers
+    void testEnvelopeSolverSimpleWing();
 
     // Flutter solvers
     void testFlutterSolverSimpleWing();
     void testFlutterSolverHunterWing();
     void testFlutterSolverFullHunterSym();
     void testFlutterSolverFullHunterASym();
+    void testTrackFlutterRoots();
+    void testTrackCurvedFlutterRoots();
 
     // Project
     void testWriteProject();
 
 private:
     double generateDouble(QPair<double, double> const& limits);
+    Backend::Core::OptimSolver* createOptimSolver(Example example, int numModes, double error);
     void testModalSolver(Example example, int numModes);
     void testFlutterSolver(Example example, Backend::Core::FlutterOptions const& options);
 
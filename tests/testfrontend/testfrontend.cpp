@@ -3,12 +3,15 @@
 #include <kcl/model.h>
 
 #include "editormanager.h"
+#include "envelopesolver.h"
 #include "fileutility.h"
 #include "fluttersolver.h"
 #include "geometryview.h"
 #include "modalsolver.h"
 #include "projectbrowser.h"
+#include "sensitivitysolver.h"
 #include "testfrontend.h"
+#include "uncertaintysolver.h"
 #include "viewmanager.h"
 
 using namespace Tests;
@@ -62,7 +65,7 @@ void TestFrontend::testViewLog()
     Core::Subproject& subproject = mpMainWindow->project().subprojects()[iSubproject];
     Core::ISolver* pBaseSolver = subproject.solvers()[iSolver];
     QVERIFY(pBaseSolver);
-    QString* pLog = nullptr;
+    Core::SolverLog* pLog = nullptr;
     switch (pBaseSolver->type())
     {
     case Core::ISolver::kModal:
@@ -74,6 +77,15 @@ void TestFrontend::testViewLog()
     case Core::ISolver::kOptim:
         pLog = &static_cast<Core::OptimSolver*>(pBaseSolver)->log;
         break;
+    case Core::ISolver::kSensitivity:
+        pLog = &static_cast<Core::SensitivitySolver*>(pBaseSolver)->log;
+        break;
+    case Core::ISolver::kUncertainty:
+        pLog = &static_cast<Core::UncertaintySolver*>(pBaseSolver)->log;
+        break;
+    case Core::ISolver::kEnvelope:
+        pLog = &static_cast<Core::EnvelopeSolver*>(pBaseSolver)->log;
+        break;
     }
     if (pLog)
         mpMainWindow->viewManager()->createLogView(*pLog);
@@ -108,6 +120,15 @@ void TestFrontend::testViewTable()
     case Core::ISolver::kFlutter:
         mpMainWindow->viewManager()->createTableView(static_cast<Core::FlutterSolver*>(pBaseSolver)->solution);
         break;
+    case Core::ISolver::kSensitivity:
+        mpMainWindow->viewManager()->createTableView(static_cast<Core::SensitivitySolver*>(pBaseSolver)->solution);
+        break;
+    case Core::ISolver::kUncertainty:
+        mpMainWindow->viewManager()->createTableView(static_cast<Core::UncertaintySolver*>(pBaseSolver)->solution);
+        break;
+    case Core::ISolver::kEnvelope:
+        mpMainWindow->viewManager()->createTableView(static_cast<Core::EnvelopeSolver*>(pBaseSolver)->solution);
+        break;
     default:
         break;
     }